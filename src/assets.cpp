@@ -0,0 +1,513 @@
+#define LOG_TAG "[" PLUGIN_NAME "][assets]"
+#include "assets.hpp"
+
+#include "core.hpp"
+#include "core_internal.hpp"
+#include "out_buffer.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <QBuffer>
+#include <QCoreApplication>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QImageReader>
+#include <QImageWriter>
+#include <QMetaObject>
+#include <QSaveFile>
+#include <QThread>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#elif defined(__APPLE__)
+#include <sys/clonefile.h>
+#endif
+
+namespace vflow {
+
+// -------------------------
+// Asset store
+// -------------------------
+
+static constexpr const char *kAssetPrefix = "asset_";
+
+// Assets handed out recently (name -> steady_ms() when stored or reused). A dialog may hold such a name
+// for a while before an item references it, so the collector leaves them alone for kAssetGraceMs.
+static constexpr int64_t kAssetGraceMs = 10 * 60 * 1000;
+static std::mutex g_asset_recent_mx;
+static std::unordered_map<std::string, int64_t> g_asset_recent;
+
+static void note_asset_handed_out(const std::string &name)
+{
+	std::lock_guard<std::mutex> lk(g_asset_recent_mx);
+	g_asset_recent[name] = steady_ms();
+}
+
+namespace {
+
+struct asset_hash_entry {
+	uintmax_t size = 0;
+	std::filesystem::file_time_type mtime;
+	uint64_t hash = 0;
+};
+
+} // namespace
+
+// Source path -> content hash, valid while size and mtime are unchanged; re-importing a large sound
+// then costs two stat calls instead of a full read.
+static std::mutex g_asset_hash_mx;
+static std::unordered_map<std::string, asset_hash_entry> g_asset_hash_cache;
+
+static bool hash_file_content(const std::filesystem::path &p, uint64_t &out)
+{
+	std::ifstream in(p, std::ios::binary);
+	if (!in)
+		return false;
+
+	std::vector<char> buf(1 << 20);
+	uint64_t h = kFnv1a64Basis;
+	while (in) {
+		in.read(buf.data(), (std::streamsize)buf.size());
+		const std::streamsize n = in.gcount();
+		if (n > 0)
+			h = fnv1a64(buf.data(), (size_t)n, h);
+	}
+	if (in.bad())
+		return false;
+	out = h;
+	return true;
+}
+
+static bool asset_hash_of(const std::filesystem::path &src, uintmax_t &size, uint64_t &hash)
+{
+	std::error_code ec;
+	size = std::filesystem::file_size(src, ec);
+	if (ec)
+		return false;
+	const auto mtime = std::filesystem::last_write_time(src, ec);
+	if (ec)
+		return false;
+
+	const std::string key = src.string();
+	{
+		std::lock_guard<std::mutex> lk(g_asset_hash_mx);
+		auto it = g_asset_hash_cache.find(key);
+		if (it != g_asset_hash_cache.end() && it->second.size == size && it->second.mtime == mtime) {
+			hash = it->second.hash;
+			return true;
+		}
+	}
+
+	if (!hash_file_content(src, hash))
+		return false;
+
+	std::lock_guard<std::mutex> lk(g_asset_hash_mx);
+	g_asset_hash_cache[key] = asset_hash_entry{size, mtime, hash};
+	return true;
+}
+
+// "asset_<hash>[-<slot>]<ext>". Slot 0 is the plain content name; a 64-bit hash collision (same name,
+// other bytes) moves the content to the next slot rather than replacing a file that may be in use.
+static std::string asset_name(uint64_t hash, std::string ext, int slot)
+{
+	std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char ch) { return (char)std::tolower(ch); });
+
+	char hex[32];
+	if (slot > 0)
+		std::snprintf(hex, sizeof(hex), "%016llx-%d", (unsigned long long)hash, slot);
+	else
+		std::snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)hash);
+	return std::string(kAssetPrefix) + hex + ext;
+}
+
+static constexpr int kAssetSlots = 8;
+
+// First slot that is free (exists = false) or already holds this content (exists = true, per 'same');
+// empty when every slot is taken by other content.
+template<class F>
+static std::string asset_slot(const std::string &dir, uint64_t hash, const std::string &ext, F &&same, bool &exists)
+{
+	for (int slot = 0; slot < kAssetSlots; ++slot) {
+		std::string name = asset_name(hash, ext, slot);
+		const std::filesystem::path p(dir + "/" + name);
+		std::error_code ec;
+		if (!std::filesystem::exists(p, ec) && !ec) {
+			exists = false;
+			return name;
+		}
+		if (same(p)) {
+			exists = true;
+			return name;
+		}
+		LOGW("Asset name %s is taken by other content", name.c_str());
+	}
+	return {};
+}
+
+// Byte compare; the sizes are checked first, so a differing file usually costs one stat.
+static bool file_has_content(const std::filesystem::path &p, const std::filesystem::path &src, uintmax_t size)
+{
+	std::error_code ec;
+	if (std::filesystem::file_size(p, ec) != size || ec)
+		return false;
+
+	std::ifstream a(p, std::ios::binary);
+	std::ifstream b(src, std::ios::binary);
+	if (!a || !b)
+		return false;
+
+	std::vector<char> bufA(1 << 20), bufB(1 << 20);
+	while (a && b) {
+		a.read(bufA.data(), (std::streamsize)bufA.size());
+		b.read(bufB.data(), (std::streamsize)bufB.size());
+		const std::streamsize n = a.gcount();
+		if (n != b.gcount() || std::memcmp(bufA.data(), bufB.data(), (size_t)n) != 0)
+			return false;
+	}
+	return !a.bad() && !b.bad() && a.eof() && b.eof();
+}
+
+static bool file_has_content(const std::filesystem::path &p, const QByteArray &data)
+{
+	std::error_code ec;
+	if (std::filesystem::file_size(p, ec) != (uintmax_t)data.size() || ec)
+		return false;
+
+	QFile f(QString::fromStdString(p.string()));
+	return f.open(QIODevice::ReadOnly) && f.readAll() == data;
+}
+
+// Copy-on-write clone where the filesystem supports it (Btrfs/XFS/overlayfs via FICLONE, APFS), else a
+// plain copy. Either way the asset is independent of the user's file, unlike a hardlink, which would
+// change with edits made to the original in place.
+static void clone_or_copy_file(const std::filesystem::path &src, const std::filesystem::path &dst,
+			       std::error_code &ec)
+{
+#ifdef __linux__
+	const int in = ::open(src.c_str(), O_RDONLY | O_CLOEXEC);
+	if (in >= 0) {
+		const int out = ::open(dst.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+		const bool cloned = out >= 0 && ::ioctl(out, FICLONE, in) == 0;
+		if (out >= 0)
+			::close(out);
+		::close(in);
+		if (cloned)
+			return;
+	}
+#elif defined(__APPLE__)
+	std::error_code ignore;
+	std::filesystem::remove(dst, ignore);
+	if (::clonefile(src.c_str(), dst.c_str(), 0) == 0)
+		return;
+#endif
+	std::filesystem::copy_file(src, dst, std::filesystem::copy_options::overwrite_existing, ec);
+}
+
+// The directory is passed in rather than read from output_dir() so workers can store assets.
+static std::string store_asset_file(const std::string &dir, const std::string &srcPath)
+{
+	const std::filesystem::path src(srcPath);
+	uintmax_t size = 0;
+	uint64_t hash = 0;
+	if (!asset_hash_of(src, size, hash)) {
+		LOGW("Asset '%s' is not readable", srcPath.c_str());
+		return {};
+	}
+
+	bool exists = false;
+	const std::string name = asset_slot(
+		dir, hash, src.extension().string(),
+		[&src, size](const std::filesystem::path &p) { return file_has_content(p, src, size); }, exists);
+	if (name.empty()) {
+		LOGW("Failed to store asset '%s': no free name", srcPath.c_str());
+		return {};
+	}
+	if (exists) {
+		LOGD("Asset '%s' already stored as %s", srcPath.c_str(), name.c_str());
+		note_asset_handed_out(name);
+		return name;
+	}
+	note_asset_handed_out(name); // before the copy, so the collector never sees an unprotected file
+
+	// Through a temp name so a crash never leaves a truncated file under a content name.
+	const std::filesystem::path dst(dir + "/" + name);
+	const std::filesystem::path tmp(dst.string() + ".tmp");
+	std::error_code ec;
+	clone_or_copy_file(src, tmp, ec);
+	if (!ec)
+		std::filesystem::rename(tmp, dst, ec);
+	if (ec) {
+		LOGW("Failed to store asset '%s' -> '%s' (%d)", srcPath.c_str(), dst.string().c_str(), (int)ec.value());
+		std::error_code ignore;
+		std::filesystem::remove(tmp, ignore);
+		return {};
+	}
+
+	checkpoint_soon();
+	LOGD("Stored asset '%s' as %s (%llu bytes)", srcPath.c_str(), name.c_str(), (unsigned long long)size);
+	return name;
+}
+
+static std::string store_asset_data(const std::string &dir, const QByteArray &data, const std::string &ext)
+{
+	bool exists = false;
+	const std::string name =
+		asset_slot(dir, fnv1a64(data.constData(), (size_t)data.size()), ext,
+			   [&data](const std::filesystem::path &p) { return file_has_content(p, data); }, exists);
+	if (name.empty())
+		return name;
+	note_asset_handed_out(name);
+	if (exists)
+		return name;
+
+	const std::string dst = dir + "/" + name;
+	QSaveFile f(QString::fromStdString(dst));
+	if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate) || f.write(data) != data.size() || !f.commit()) {
+		LOGW("Failed to store asset '%s'", dst.c_str());
+		return {};
+	}
+	checkpoint_soon();
+	return name;
+}
+
+std::string import_asset(const std::string &srcPath)
+{
+	if (!has_output_dir() || srcPath.empty())
+		return {};
+	return store_asset_file(output_dir(), srcPath);
+}
+
+std::string import_picture(const std::string &value)
+{
+	if (value.empty() || !std::filesystem::path(value).is_absolute())
+		return value;
+	return import_asset(value);
+}
+
+void release_asset(const std::string &rel)
+{
+	history_defer_file_removal(rel);
+}
+
+size_t collect_unused_assets(uint64_t *freedBytes)
+{
+	// Items and the undo history belong to the UI thread.
+	QCoreApplication *app = QCoreApplication::instance();
+	if (app && QThread::currentThread() != app->thread()) {
+		size_t removed = 0;
+		QMetaObject::invokeMethod(
+			app, [&]() { removed = collect_unused_assets(freedBytes); }, Qt::BlockingQueuedConnection);
+		return removed;
+	}
+
+	if (freedBytes)
+		*freedBytes = 0;
+	if (!has_output_dir())
+		return 0;
+
+	std::unordered_set<std::string> recent;
+	{
+		const int64_t now = steady_ms();
+		std::lock_guard<std::mutex> lk(g_asset_recent_mx);
+		for (auto it = g_asset_recent.begin(); it != g_asset_recent.end();) {
+			if (now - it->second > kAssetGraceMs) {
+				it = g_asset_recent.erase(it);
+			} else {
+				recent.insert(it->first);
+				++it;
+			}
+		}
+	}
+
+	// Reference counts over live items, data rows and every snapshot still reachable through undo/redo.
+	std::unordered_map<std::string, size_t> refs;
+	count_file_refs(refs);
+
+	size_t removed = 0;
+	std::error_code ec;
+	for (const auto &de : std::filesystem::directory_iterator(std::filesystem::path(output_dir()), ec)) {
+		const std::string name = de.path().filename().string();
+		if (name.rfind(kAssetPrefix, 0) != 0 || refs.count(name) || recent.count(name))
+			continue;
+		// Asset names carry exactly one extension; more means a copy in flight ("<name>.tmp", or the
+		// temporary name of a QSaveFile).
+		if (std::count(name.begin(), name.end(), '.') != 1)
+			continue;
+
+		std::error_code fec;
+		const uintmax_t size = de.file_size(fec);
+		if (remove_output_file(name)) {
+			++removed;
+			if (freedBytes && size != (uintmax_t)-1)
+				*freedBytes += size;
+		}
+	}
+
+	if (removed)
+		LOGI("Removed %zu unused assets", removed);
+	return removed;
+}
+
+// -------------------------
+// Image ingest
+// -------------------------
+
+static constexpr int kPictureQuality = 85;
+
+// Encoder for derived pictures: lossy keeps avatars small; transparency needs WebP or PNG.
+static const char *picture_format(bool alpha)
+{
+	static const bool webp = QImageWriter::supportedImageFormats().contains("webp");
+	if (webp)
+		return "webp";
+	return alpha ? "png" : "jpg";
+}
+
+static picture_ingest_result ingest_picture_into(const std::string &dir, const std::string &srcPath,
+						 int avatarWidth, int avatarHeight)
+{
+	const auto t0 = std::chrono::steady_clock::now();
+	const auto finish = [&t0](picture_ingest_result &res) {
+		const auto dt = std::chrono::steady_clock::now() - t0;
+		res.elapsed_ms = std::chrono::duration<double, std::milli>(dt).count();
+		return res;
+	};
+
+	picture_ingest_result res;
+	res.source = store_asset_file(dir, srcPath);
+	if (res.source.empty())
+		return finish(res);
+	res.picture = res.source;
+
+	std::error_code ec;
+	const uintmax_t srcBytes = std::filesystem::file_size(std::filesystem::path(srcPath), ec);
+	res.src_bytes = res.bytes = ec ? 0 : (uint64_t)srcBytes;
+
+	QImageReader reader(QString::fromStdString(srcPath));
+	reader.setAutoTransform(true);
+	QSize size = reader.size();
+	if (!reader.canRead() || !size.isValid()) {
+		LOGW("Picture '%s' cannot be decoded; stored unchanged", srcPath.c_str());
+		return finish(res);
+	}
+	// size() is before EXIF rotation; work in display orientation.
+	const bool rotated = (reader.transformation() & QImageIOHandler::TransformationRotate90) != 0;
+	if (rotated)
+		size.transpose();
+	res.src_width = res.width = size.width();
+	res.src_height = res.height = size.height();
+
+	// Resampling would drop the frames of an animation.
+	if (reader.supportsAnimation() && reader.imageCount() > 1)
+		return finish(res);
+
+	// Cover the 2x box (sharp on HiDPI canvases and when the template scales up a little); never upscale.
+	const int boxW = std::max(1, 2 * avatarWidth);
+	const int boxH = std::max(1, 2 * avatarHeight);
+	const double scale = std::max((double)boxW / size.width(), (double)boxH / size.height());
+	if (scale >= 1.0)
+		return finish(res);
+
+	// Decoding straight to the reduced size lets the JPEG decoder skip most of the work.
+	QSize decoded(std::max(boxW, (int)std::lround(size.width() * scale)),
+		      std::max(boxH, (int)std::lround(size.height() * scale)));
+	if (rotated)
+		decoded.transpose();
+	reader.setScaledSize(decoded);
+
+	QImage img = reader.read();
+	if (img.isNull()) {
+		LOGW("Failed to decode picture '%s' (%s); stored unchanged", srcPath.c_str(),
+		     reader.errorString().toUtf8().constData());
+		return finish(res);
+	}
+
+	const int w = std::min(boxW, img.width());
+	const int h = std::min(boxH, img.height());
+	img = img.copy((img.width() - w) / 2, (img.height() - h) / 2, w, h);
+
+	const char *fmt = picture_format(img.hasAlphaChannel());
+	QByteArray encoded;
+	{
+		QBuffer buf(&encoded);
+		if (!buf.open(QIODevice::WriteOnly) || !img.save(&buf, fmt, kPictureQuality)) {
+			LOGW("Failed to encode picture '%s' as %s; stored unchanged", srcPath.c_str(), fmt);
+			return finish(res);
+		}
+	}
+	if (res.src_bytes && (uint64_t)encoded.size() >= res.src_bytes)
+		return finish(res);
+
+	const std::string derived = store_asset_data(dir, encoded, std::string(".") + fmt);
+	if (derived.empty())
+		return finish(res);
+
+	res.picture = derived;
+	res.width = w;
+	res.height = h;
+	res.bytes = (uint64_t)encoded.size();
+	finish(res);
+	LOGI("Ingested picture '%s': %dx%d, %llu bytes -> %dx%d %s, %llu bytes (%.1f ms)", srcPath.c_str(),
+	     res.src_width, res.src_height, (unsigned long long)res.src_bytes, res.width, res.height, fmt,
+	     (unsigned long long)res.bytes, res.elapsed_ms);
+	return res;
+}
+
+picture_ingest_result ingest_picture(const std::string &srcPath, int avatarWidth, int avatarHeight)
+{
+	if (!has_output_dir() || srcPath.empty())
+		return {};
+	return ingest_picture_into(output_dir(), srcPath, avatarWidth, avatarHeight);
+}
+
+std::future<picture_ingest_result> ingest_picture_async(const std::string &srcPath, int avatarWidth,
+							int avatarHeight)
+{
+	std::string dir = has_output_dir() ? output_dir() : std::string();
+	return std::async(std::launch::async, [dir = std::move(dir), srcPath, avatarWidth, avatarHeight]() {
+		if (dir.empty() || srcPath.empty())
+			return picture_ingest_result{};
+		return ingest_picture_into(dir, srcPath, avatarWidth, avatarHeight);
+	});
+}
+
+std::string picture_source_path(const lower_third_cfg &c)
+{
+	const std::string &rel = c.profile_picture_source.empty() ? c.profile_picture : c.profile_picture_source;
+	if (rel.empty() || !has_output_dir())
+		return {};
+	return output_dir() + "/" + rel;
+}
+
+bool assign_picture(lower_third_cfg &c, const picture_ingest_result &r)
+{
+	if (r.picture.empty())
+		return false;
+
+	for (const std::string *old : {&c.profile_picture, &c.profile_picture_source}) {
+		if (*old != r.picture && *old != r.source)
+			release_asset(*old);
+	}
+	c.profile_picture = r.picture;
+	c.profile_picture_source = r.picture == r.source ? std::string() : r.source;
+	return true;
+}
+
+} // namespace vflow
@@ -0,0 +1,211 @@
+#include "cfg_types.hpp"
+
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace vflow {
+
+// -------------------------
+// Atoms
+// -------------------------
+
+namespace {
+
+// Order defines the ids of the kAtom* constants in cfg_types.hpp.
+constexpr const char *kBuiltinAtoms[] = {
+	"",
+	"custom_handled_in",
+	"custom_handled_out",
+	"animate__fadeInUp",
+	"animate__fadeOutDown",
+	"lt-pos-bottom-left",
+};
+
+// Vocabulary words beyond the builtins are interned until the table holds this many; later ones are
+// owned by their atoms. animate.css has about a hundred classes and there are seven positions.
+constexpr size_t kMaxInterned = 256;
+
+bool is_vocabulary_word(std::string_view s)
+{
+	auto starts = [s](std::string_view p) { return s.size() > p.size() && s.substr(0, p.size()) == p; };
+	if (!starts("animate__") && !starts("lt-pos-"))
+		return false;
+	if (s.size() > 48)
+		return false;
+	for (char c : s) {
+		if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '-'))
+			return false;
+	}
+	return true;
+}
+
+struct atom_table {
+	std::shared_mutex mx;
+	std::deque<std::string> strings; // push_back never moves existing elements
+	std::unordered_map<std::string_view, uint32_t> ids; // views into 'strings'
+
+	atom_table()
+	{
+		for (const char *s : kBuiltinAtoms)
+			add(s);
+	}
+
+	uint32_t add(std::string_view s)
+	{
+		const uint32_t id = (uint32_t)strings.size();
+		strings.emplace_back(s);
+		ids.emplace(std::string_view(strings.back()), id);
+		return id;
+	}
+};
+
+atom_table &atoms()
+{
+	static atom_table t;
+	return t;
+}
+
+} // namespace
+
+atom::atom(std::string_view s)
+{
+	if (s.empty())
+		return;
+
+	atom_table &t = atoms();
+	{
+		std::shared_lock<std::shared_mutex> lk(t.mx);
+		auto it = t.ids.find(s);
+		if (it != t.ids.end()) {
+			id_ = it->second;
+			return;
+		}
+	}
+
+	if (is_vocabulary_word(s)) {
+		std::unique_lock<std::shared_mutex> lk(t.mx);
+		auto it = t.ids.find(s);
+		if (it != t.ids.end()) {
+			id_ = it->second;
+			return;
+		}
+		if (t.strings.size() < kMaxInterned) {
+			id_ = t.add(s);
+			return;
+		}
+	}
+
+	id_ = kOwnedId;
+	own_ = std::make_shared<const std::string>(s);
+}
+
+const std::string &atom::str() const
+{
+	if (id_ == kOwnedId)
+		return *own_;
+
+	atom_table &t = atoms();
+	std::shared_lock<std::shared_mutex> lk(t.mx);
+	return t.strings[id_];
+}
+
+// -------------------------
+// Colors
+// -------------------------
+
+static int hex_value(char ch)
+{
+	if (ch >= '0' && ch <= '9')
+		return ch - '0';
+	if (ch >= 'a' && ch <= 'f')
+		return ch - 'a' + 10;
+	if (ch >= 'A' && ch <= 'F')
+		return ch - 'A' + 10;
+	return -1;
+}
+
+color_rgba::color_rgba(std::string_view s)
+{
+	if (s.empty())
+		return;
+
+	const size_t digits = s.size() - 1;
+	bool hex = s[0] == '#' && (digits == 3 || digits == 4 || digits == 6 || digits == 8);
+	bool upper = false, lower = false;
+	uint32_t nibbles[8] = {};
+
+	for (size_t i = 0; hex && i < digits; ++i) {
+		const char ch = s[i + 1];
+		const int v = hex_value(ch);
+		if (v < 0) {
+			hex = false;
+			break;
+		}
+		upper |= (ch >= 'A' && ch <= 'F');
+		lower |= (ch >= 'a' && ch <= 'f');
+		nibbles[i] = (uint32_t)v;
+	}
+
+	// Mixed case cannot be reproduced from a single flag; keep such strings verbatim.
+	if (!hex || (upper && lower)) {
+		verbatim_ = atom(s);
+		form_ = kVerbatim;
+		return;
+	}
+
+	uint32_t rgba = 0;
+	if (digits <= 4) {
+		for (size_t i = 0; i < digits; ++i)
+			rgba = (rgba << 8) | (nibbles[i] * 0x11);
+	} else {
+		for (size_t i = 0; i < digits; ++i)
+			rgba = (rgba << 4) | nibbles[i];
+	}
+	if (digits == 3 || digits == 6)
+		rgba = (rgba << 8) | 0xFF;
+
+	bits_ = rgba;
+	form_ = (uint8_t)(digits | (upper ? kUpper : 0));
+}
+
+color_rgba color_rgba::from_packed(uint32_t rgba, uint8_t hexForm)
+{
+	color_rgba c;
+	const uint8_t digits = hexForm & 0x0F;
+	if ((hexForm & ~(kUpper | 0x0F)) == 0 && (digits == 3 || digits == 4 || digits == 6 || digits == 8)) {
+		c.bits_ = rgba;
+		c.form_ = hexForm;
+	}
+	return c;
+}
+
+std::string color_rgba::str() const
+{
+	if (form_ == kEmpty)
+		return {};
+	if (form_ == kVerbatim)
+		return verbatim_.str();
+
+	const char *hex = (form_ & kUpper) ? "0123456789ABCDEF" : "0123456789abcdef";
+	const size_t digits = form_ & 0x0F;
+	const bool hasAlpha = digits == 4 || digits == 8;
+	const size_t channels = hasAlpha ? 4 : 3;
+
+	std::string out;
+	out.reserve(digits + 1);
+	out.push_back('#');
+	for (size_t c = 0; c < channels; ++c) {
+		const uint32_t byte = (bits_ >> (24 - 8 * c)) & 0xFF;
+		if (digits <= 4) {
+			out.push_back(hex[byte & 0x0F]);
+		} else {
+			out.push_back(hex[byte >> 4]);
+			out.push_back(hex[byte & 0x0F]);
+		}
+	}
+	return out;
+}
+
+} // namespace vflow
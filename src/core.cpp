@@ -1,17 +1,33 @@
 
 #define LOG_TAG "[" PLUGIN_NAME "][core]"
 #include "core.hpp"
+#include "core_internal.hpp"
+#include "assets.hpp"
+#include "history.hpp"
+#include "hot_dir.hpp"
+#include "json_writer.hpp"
+#include "out_buffer.hpp"
+#include "shards.hpp"
 
 #include <algorithm>
 #include <sstream>
 #include <random>
 #include <cctype>
+#include <cstring>
 #include <mutex>
 #include <unordered_set>
 #include <unordered_map>
 
+#include <atomic>
 #include <chrono>
 #include <climits>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <thread>
 
 #include <QDir>
 #include <QFile>
@@ -21,6 +37,11 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QSaveFile>
+#include <QCoreApplication>
+#include <QFileSystemWatcher>
+#include <QMetaObject>
+#include <QThread>
+#include <QTimer>
 
 #include <obs-frontend-api.h>
 #include <obs.h>
@@ -31,12 +52,22 @@
 namespace vflow {
 
 static std::string g_output_dir;
+// Hot output directory (see core.hpp): output_dir() is g_live_dir while the checkpointer runs.
+static bool g_hot_output = false;
+static std::string g_live_dir;
+static std::unique_ptr<checkpointer> g_checkpointer;
+static std::mutex g_checkpointer_mx; // set and reset on the UI thread; held by writers on other threads
 static std::string g_target_browser_source;
 static std::unordered_map<std::string, std::string> g_target_browser_source_by_collection;
+static std::unordered_map<std::string, std::string> g_output_dir_by_collection; // profiles (see profiles.hpp)
 static int g_target_browser_width = sltBrowserWidth;
 static int g_target_browser_height = sltBrowserHeight;
+static bool g_shard_by_position = false;
+static std::vector<output_variant> g_output_variants;
 static std::vector<lower_third_cfg> g_items;
 static std::vector<group_cfg> g_groups;
+static std::vector<rule_cfg> g_rules;
+static uint64_t g_rules_gen = 1;
 static std::vector<std::string> g_visible;
 static std::string g_last_html_path;
 
@@ -50,7 +81,7 @@ static std::mutex g_evt_mx;
 static std::vector<listener> g_listeners;
 static uint64_t g_next_token = 1;
 
-static void emit_event(const core_event &ev)
+void emit_event(const core_event &ev)
 {
 	std::vector<listener> copy;
 	{
@@ -85,12 +116,21 @@ void remove_event_listener(uint64_t token)
 			  g_listeners.end());
 }
 
-static std::string join_path(const std::string &a, const std::string &b)
+std::string join_path(const std::string &a, const std::string &b)
 {
 	QDir d(QString::fromStdString(a));
 	return d.filePath(QString::fromStdString(b)).toStdString();
 }
 
+// Every write of ours queues a checkpoint pass directly; the directory watch misses writes while it is
+// stopped and when the system drops events.
+void checkpoint_soon()
+{
+	std::lock_guard<std::mutex> lk(g_checkpointer_mx);
+	if (g_checkpointer)
+		g_checkpointer->schedule();
+}
+
 static bool write_text_file(const std::string &path, const std::string &data)
 {
 	QFile f(QString::fromStdString(path));
@@ -107,6 +147,7 @@ static bool write_text_file(const std::string &path, const std::string &data)
 	}
 	f.flush();
 	f.close();
+	checkpoint_soon();
 	return true;
 }
 
@@ -131,6 +172,15 @@ static bool write_text_file_atomic(const std::string &path, const std::string &d
 		     f.errorString().toUtf8().constData());
 		return false;
 	}
+	checkpoint_soon();
+	return true;
+}
+
+static bool write_buffer_atomic(const out_buffer &buf, const std::string &path)
+{
+	if (!buf.write_file_atomic(path))
+		return false;
+	checkpoint_soon();
 	return true;
 }
 
@@ -154,12 +204,12 @@ static std::string read_text_file(const std::string &path)
 	return std::string(b.constData(), (size_t)b.size());
 }
 
-static void ensure_dir(const std::string &dir)
+void ensure_dir(const std::string &dir)
 {
 	QDir().mkpath(QString::fromStdString(dir));
 }
 
-static std::string sanitize_id(const std::string &s)
+std::string sanitize_id(const std::string &s)
 {
 	std::string out;
 	out.reserve(s.size());
@@ -301,7 +351,7 @@ static void extract_keyframes_blocks(std::string &css, std::vector<extracted_key
 	}
 }
 
-static bool file_exists(const std::string &path)
+bool file_exists(const std::string &path)
 {
 	return QFileInfo(QString::fromStdString(path)).exists();
 }
@@ -324,7 +374,7 @@ static std::string module_config_path_cached()
 	return cached;
 }
 
-static std::string current_scene_collection_name()
+std::string current_scene_collection_name()
 {
 	char *name = obs_frontend_get_current_scene_collection();
 	if (!name)
@@ -335,6 +385,67 @@ static std::string current_scene_collection_name()
 	return out;
 }
 
+// Position classes of the overlay (lt.css) and their declarations; output variants reuse them.
+struct position_rule {
+	const char *cls;
+	const char *decls;
+};
+
+static const position_rule kPositionRules[] = {
+	{"lt-pos-bottom-left", "left: var(--slt-safe-margin);\n  bottom: var(--slt-safe-margin);"},
+	{"lt-pos-bottom-right", "right: var(--slt-safe-margin);\n  bottom: var(--slt-safe-margin);"},
+	{"lt-pos-top-left", "left: var(--slt-safe-margin);\n  top: var(--slt-safe-margin);"},
+	{"lt-pos-top-right", "right: var(--slt-safe-margin);\n  top: var(--slt-safe-margin);"},
+	{"lt-pos-center", "left: 50%;\n  top: 50%;\n  transform: translate(-50%, -50%);"},
+	{"lt-pos-top-center", "left: 50%;\n  top: var(--slt-safe-margin);\n  transform: translateX(-50%);"},
+	{"lt-pos-bottom-center", "left: 50%;\n  bottom: var(--slt-safe-margin);\n  transform: translateX(-50%);"},
+};
+
+static const position_rule *find_position_rule(const std::string &cls)
+{
+	for (const auto &r : kPositionRules) {
+		if (cls == r.cls)
+			return &r;
+	}
+	return nullptr;
+}
+
+// Sanitizes the name (false when nothing is left), clamps sizes and drops overrides that change nothing.
+static bool normalize_output_variant(output_variant &v)
+{
+	std::string name;
+	for (char c : v.name) {
+		if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '-')
+			name.push_back(c);
+	}
+	if (name.empty())
+		return false;
+	v.name = std::move(name);
+
+	v.width = std::clamp(v.width, 1, 16384);
+	v.height = std::clamp(v.height, 1, 16384);
+	v.safe_margin = std::clamp(v.safe_margin, -1, 4096);
+	v.scale_pct = std::clamp(v.scale_pct, 10, 1000);
+
+	std::vector<std::pair<std::string, layout_override>> items;
+	for (auto &kv : v.items) {
+		layout_override &o = kv.second;
+		if (!o.position.empty() && !find_position_rule(o.position.str()))
+			o.position = atom();
+		o.scale_pct = o.scale_pct > 0 ? std::clamp(o.scale_pct, 10, 1000) : 0;
+		if (kv.first.empty() || (o.position.empty() && o.scale_pct == 0))
+			continue;
+		const std::string id = sanitize_id(kv.first);
+		auto same = std::find_if(items.begin(), items.end(), [&id](const auto &x) { return x.first == id; });
+		if (same != items.end())
+			same->second = o;
+		else
+			items.emplace_back(id, o);
+	}
+	v.items = std::move(items);
+	return true;
+}
+
 static void load_global_config()
 {
 	const std::string pathS = module_config_path_cached();
@@ -360,6 +471,7 @@ static void load_global_config()
 		g_output_dir = out.toStdString();
 		LOGI("Loaded output_dir: '%s'", g_output_dir.c_str());
 	}
+	g_hot_output = root.value("hot_output_dir").toBool(false);
 
 	const QString tgt = root.value("target_browser_source").toString().trimmed();
 	if (!tgt.isEmpty()) {
@@ -381,12 +493,47 @@ static void load_global_config()
 			LOGI("Loaded scene_collection_browser_sources: %zu entries", g_target_browser_source_by_collection.size());
 	}
 
+	g_output_dir_by_collection.clear();
+	const QJsonObject dirs = root.value("scene_collection_output_dirs").toObject();
+	for (auto it = dirs.begin(); it != dirs.end(); ++it) {
+		const QString k = it.key().trimmed();
+		const QString v = it.value().toString().trimmed();
+		if (!k.isEmpty() && !v.isEmpty())
+			g_output_dir_by_collection[k.toStdString()] = QDir::cleanPath(v).toStdString();
+	}
+	if (!g_output_dir_by_collection.empty())
+		LOGI("Loaded scene_collection_output_dirs: %zu entries", g_output_dir_by_collection.size());
+
 	const int w = root.value("target_browser_width").toInt(sltBrowserWidth);
 	const int h = root.value("target_browser_height").toInt(sltBrowserHeight);
 	if (w > 0)
 		g_target_browser_width = w;
 	if (h > 0)
 		g_target_browser_height = h;
+	g_shard_by_position = root.value("shard_by_position").toBool(false);
+
+	g_output_variants.clear();
+	for (const QJsonValue vv : root.value("output_variants").toArray()) {
+		const QJsonObject o = vv.toObject();
+		output_variant v;
+		v.name = o.value("name").toString().toStdString();
+		v.browser_source = o.value("browser_source").toString().trimmed().toStdString();
+		v.width = o.value("width").toInt(v.width);
+		v.height = o.value("height").toInt(v.height);
+		v.safe_margin = o.value("safe_margin").toInt(-1);
+		v.scale_pct = o.value("scale_pct").toInt(100);
+		for (const QJsonValue iv : o.value("items").toArray()) {
+			const QJsonObject io = iv.toObject();
+			layout_override lo;
+			lo.position = io.value("position").toString().toStdString();
+			lo.scale_pct = io.value("scale_pct").toInt(0);
+			v.items.emplace_back(io.value("id").toString().toStdString(), lo);
+		}
+		if (normalize_output_variant(v))
+			g_output_variants.push_back(std::move(v));
+	}
+	if (!g_output_variants.empty())
+		LOGI("Loaded output_variants: %zu entries", g_output_variants.size());
 }
 
 bool save_global_config()
@@ -400,6 +547,8 @@ bool save_global_config()
 
 	QJsonObject root;
 	root["output_dir"] = QString::fromStdString(g_output_dir);
+	if (g_hot_output)
+		root["hot_output_dir"] = true;
 	root["target_browser_source"] = QString::fromStdString(g_target_browser_source);
 	{
 		QJsonObject per;
@@ -410,43 +559,74 @@ bool save_global_config()
 		if (!per.isEmpty())
 			root["scene_collection_browser_sources"] = per;
 	}
+	if (!g_output_dir_by_collection.empty()) {
+		QJsonObject dirs;
+		for (const auto &kv : g_output_dir_by_collection)
+			dirs[QString::fromStdString(kv.first)] = QString::fromStdString(kv.second);
+		root["scene_collection_output_dirs"] = dirs;
+	}
 	root["target_browser_width"] = g_target_browser_width;
 	root["target_browser_height"] = g_target_browser_height;
+	if (g_shard_by_position)
+		root["shard_by_position"] = true;
+	if (!g_output_variants.empty()) {
+		QJsonArray variants;
+		for (const auto &v : g_output_variants) {
+			QJsonObject o;
+			o["name"] = QString::fromStdString(v.name);
+			o["browser_source"] = QString::fromStdString(v.browser_source);
+			o["width"] = v.width;
+			o["height"] = v.height;
+			if (v.safe_margin >= 0)
+				o["safe_margin"] = v.safe_margin;
+			if (v.scale_pct != 100)
+				o["scale_pct"] = v.scale_pct;
+			QJsonArray items;
+			for (const auto &kv : v.items) {
+				QJsonObject io;
+				io["id"] = QString::fromStdString(kv.first);
+				if (!kv.second.position.empty())
+					io["position"] = QString::fromStdString(kv.second.position.str());
+				if (kv.second.scale_pct > 0)
+					io["scale_pct"] = kv.second.scale_pct;
+				items.append(io);
+			}
+			if (!items.isEmpty())
+				o["items"] = items;
+			variants.append(o);
+		}
+		root["output_variants"] = variants;
+	}
 
 	const QJsonDocument doc(root);
 	return write_text_file(pathS, doc.toJson(QJsonDocument::Compact).toStdString());
 }
 
-static std::string bundle_styles_name(const std::string &)
+// Bundle file names by base name: "lt" for the target source, "lt-<zone>" for shards.
+static std::string bundle_styles_name(const std::string &base)
 {
-	return "lt.css";
+	return base + ".css";
 }
-static std::string bundle_scripts_name(const std::string &)
-{
-	return "lt.js";
-}
-
-static std::string bundle_html_name_current()
+static std::string bundle_scripts_name(const std::string &base)
 {
-	return "lt.html";
+	return base + ".js";
 }
-
-static std::string bundle_styles_path(const std::string &ts)
+static std::string bundle_html_name(const std::string &base)
 {
-	return has_output_dir() ? join_path(output_dir(), bundle_styles_name(ts)) : std::string();
+	return base + ".html";
 }
 
-static std::string bundle_scripts_path(const std::string &ts)
+static std::string bundle_html_name_current()
 {
-	return has_output_dir() ? join_path(output_dir(), bundle_scripts_name(ts)) : std::string();
+	return bundle_html_name("lt");
 }
 
-static std::string bundle_html_current_path()
+std::string bundle_html_current_path()
 {
 	return has_output_dir() ? join_path(output_dir(), bundle_html_name_current()) : std::string();
 }
 
-static lower_third_cfg default_cfg()
+lower_third_cfg default_cfg()
 {
 	lower_third_cfg c;
 	c.id = new_id();
@@ -464,11 +644,11 @@ static lower_third_cfg default_cfg()
 	c.avatar_width = 100;
 	c.avatar_height = 100;
 
-	c.anim_in = "animate__fadeInUp";
-	c.anim_out = "animate__fadeOutDown";
+	c.anim_in = kAtomDefaultAnimIn;
+	c.anim_out = kAtomDefaultAnimOut;
 
 	c.font_family = "Inter";
-	c.lt_position = "lt-pos-bottom-left";
+	c.lt_position = kAtomDefaultPosition;
 
 	c.primary_color = "#111827";
 	c.secondary_color = "#1F2937";
@@ -601,16 +781,16 @@ static lower_third_cfg default_cfg()
 
 static std::string resolve_in_class(const lower_third_cfg &c)
 {
-	if (c.anim_in == "custom_handled_in")
+	if (c.anim_in == kAtomCustomIn)
 		return std::string();
-	return c.anim_in;
+	return c.anim_in.str();
 }
 
 static std::string resolve_out_class(const lower_third_cfg &c)
 {
-	if (c.anim_out == "custom_handled_out")
+	if (c.anim_out == kAtomCustomOut)
 		return std::string();
-	return c.anim_out;
+	return c.anim_out.str();
 }
 
 using slt_repl_map = std::unordered_map<std::string, std::string>;
@@ -620,12 +800,15 @@ static slt_repl_map build_placeholder_map(const lower_third_cfg &c)
 	slt_repl_map m;
 	m.reserve(32);
 	m["{{ID}}"] = c.id;
-	m["{{PRIMARY_COLOR}}"] = c.primary_color;
-	m["{{SECONDARY_COLOR}}"] = c.secondary_color;
-	m["{{TITLE_COLOR}}"] = c.title_color;
-	m["{{SUBTITLE_COLOR}}"] = c.subtitle_color;
-	m["{{TITLE}}"] = c.title;
-	m["{{SUBTITLE}}"] = c.subtitle;
+	m["{{PRIMARY_COLOR}}"] = c.primary_color.str();
+	m["{{SECONDARY_COLOR}}"] = c.secondary_color.str();
+	m["{{TITLE_COLOR}}"] = c.title_color.str();
+	m["{{SUBTITLE_COLOR}}"] = c.subtitle_color.str();
+	// Instanced items render their active row; the overlay swaps other rows in (see kRowPlaceholders).
+	const data_row *row = c.instanced ? active_row_of(c) : nullptr;
+	m["{{ROW_ID}}"] = row ? row->id : std::string();
+	m["{{TITLE}}"] = row ? row->title : c.title;
+	m["{{SUBTITLE}}"] = row ? row->subtitle : c.subtitle;
 	m["{{OPACITY}}"] = std::to_string(c.opacity);
 	m["{{RADIUS}}"] = std::to_string(c.radius);
 	m["{{FONT_FAMILY}}"] = c.font_family.empty() ? "Inter" : c.font_family;
@@ -633,16 +816,17 @@ static slt_repl_map build_placeholder_map(const lower_third_cfg &c)
 	m["{{SUBTITLE_SIZE}}"] = std::to_string(c.subtitle_size);
 	m["{{AVATAR_WIDTH}}"] = std::to_string(c.avatar_width);
 	m["{{AVATAR_HEIGHT}}"] = std::to_string(c.avatar_height);
-	m["{{ANIM_IN}}"] = c.anim_in;
-	m["{{ANIM_OUT}}"] = c.anim_out;
-	const std::string pic = c.profile_picture.empty() ? "./" : ("./" + c.profile_picture);
+	m["{{ANIM_IN}}"] = c.anim_in.str();
+	m["{{ANIM_OUT}}"] = c.anim_out.str();
+	const std::string &picFile = row ? row->profile_picture : c.profile_picture;
+	const std::string pic = picFile.empty() ? "./" : ("./" + picFile);
 	m["{{PROFILE_PICTURE_URL}}"] = pic;
 	const std::string sIn = c.anim_in_sound.empty() ? "" : ("./" + c.anim_in_sound);
 	const std::string sOut = c.anim_out_sound.empty() ? "" : ("./" + c.anim_out_sound);
 	m["{{SOUND_IN_URL}}"] = sIn;
 	m["{{SOUND_OUT_URL}}"] = sOut;
-	m["{{BG_COLOR}}"] = c.primary_color;
-	m["{{TEXT_COLOR}}"] = c.title_color;
+	m["{{BG_COLOR}}"] = m["{{PRIMARY_COLOR}}"];
+	m["{{TEXT_COLOR}}"] = m["{{TITLE_COLOR}}"];
 	return m;
 }
 
@@ -678,6 +862,8 @@ html,body{ margin:0; padding:0; background:transparent; overflow:hidden; }
 /* These ensure the display property is toggled correctly */
 .slt-visible { display: block !important; }
 .slt-hidden  { display: none !important; }
+/* Nothing on screen: nothing left to composite or paint */
+#slt-root.slt-idle { display: none; }
 )CSS";
 }
 
@@ -729,11 +915,8 @@ static inline std::string scope_selector_part_best_effort(std::string part, cons
 	return orig.substr(0, lead_len) + "#" + id + " " + trimmed;
 }
 
-static std::string scope_css_best_effort(const lower_third_cfg &c)
+static std::string scope_css_best_effort(const lower_third_cfg &c, std::string css, const slt_repl_map &repl)
 {
-	std::string css = c.css_template;
-
-	const auto repl = build_placeholder_map(c);
 	css = replace_placeholders(std::move(css), repl);
 
 	if (css.find("#" + c.id) != std::string::npos) {
@@ -779,58 +962,54 @@ static std::string scope_css_best_effort(const lower_third_cfg &c)
 	return out;
 }
 
-static std::string build_base_script(const std::vector<lower_third_cfg> &items)
+static void build_base_script(const std::vector<lower_third_cfg> &items, out_buffer &out)
 {
-	std::string map = "{\n";
-	for (const auto &c : items) {
-		const bool inCustom = (c.anim_in == "custom_handled_in");
-		const bool outCustom = (c.anim_out == "custom_handled_out");
-
-		const std::string inCls = inCustom ? std::string() : c.anim_in;
-		const std::string outCls = outCustom ? std::string() : c.anim_out;
-
-		const std::string inSound = c.anim_in_sound.empty() ? std::string() : ("./" + c.anim_in_sound);
-		const std::string outSound = c.anim_out_sound.empty() ? std::string() : ("./" + c.anim_out_sound);
-		const bool bridgeEnabled = c.api_bridge_enabled;
-		const std::string paramsFile = bridgeEnabled ? ("./parameters_" + c.id + ".json") : std::string();
-
-		int delay = 0;
-
-		map += "  \"" + c.id +
-		       "\": { "
-		       "inCustom: " +
-		       std::string(inCustom ? "true" : "false") +
-		       ", "
-		       "outCustom: " +
-		       std::string(outCustom ? "true" : "false") +
-		       ", "
-		       "inCls: " +
-		       (inCls.empty() ? "null" : ("\"" + inCls + "\"")) +
-		       ", "
-		       "outCls: " +
-		       (outCls.empty() ? "null" : ("\"" + outCls + "\"")) +
-		       ", "
-		       "inSound: " +
-		       (inSound.empty() ? "null" : ("\"" + inSound + "\"")) +
-		       ", "
-		       "outSound: " +
-		       (outSound.empty() ? "null" : ("\"" + outSound + "\"")) +
-		       ", "
-		       "paramsFile: " +
-		       (paramsFile.empty() ? "null" : ("\"" + paramsFile + "\"")) +
-		       ", "
-		       "delay: " +
-		       std::to_string(delay) + " },\n";
-	}
-	map += "};\n";
-
-	return std::string(R"JS(
+	out << R"JS(
 /* VinciFlow – Base Animation Script (simple polling + per-item transition lock) */
 (() => {
   const VISIBLE_URL = "./lt-visible.json";
   const PARAMS_URL  = "./parameters.json";
-  const animMap = )JS") +
-	       map + std::string(R"JS(
+  const ROWS_URL    = "./lt-rows.json";
+  const SCHEDULE_URL = "./lt-schedule.json";
+  const animMap = )JS";
+
+	// Emits `"<prefix><v>"` or `null` for an empty value.
+	auto quoted_or_null = [&out](std::string_view prefix, std::string_view v) {
+		if (v.empty()) {
+			out << "null";
+			return;
+		}
+		out << '"' << prefix << v << '"';
+	};
+
+	out << "{\n";
+	for (const auto &c : items) {
+		const bool inCustom = (c.anim_in == kAtomCustomIn);
+		const bool outCustom = (c.anim_out == kAtomCustomOut);
+		const int delay = 0;
+
+		out << "  \"" << c.id << "\": { inCustom: " << (inCustom ? "true" : "false")
+		    << ", outCustom: " << (outCustom ? "true" : "false") << ", inCls: ";
+		quoted_or_null({}, inCustom ? std::string_view() : std::string_view(c.anim_in.str()));
+		out << ", outCls: ";
+		quoted_or_null({}, outCustom ? std::string_view() : std::string_view(c.anim_out.str()));
+		out << ", inSound: ";
+		quoted_or_null("./", c.anim_in_sound);
+		out << ", outSound: ";
+		quoted_or_null("./", c.anim_out_sound);
+		out << ", paramsFile: ";
+		if (c.api_bridge_enabled)
+			out << "\"./parameters_" << c.id << ".json\"";
+		else
+			out << "null";
+		out << ", instanced: " << (c.instanced ? "true" : "false");
+		out << ", delay: ";
+		out.append_int(delay);
+		out << " },\n";
+	}
+	out << "};\n";
+
+	out << R"JS(
   // Safety bounds (avoid deadlocks if a template forgets to resolve)
   const MAX_CUSTOM_WAIT_MS = 8000;
   const MAX_ANIM_WAIT_MS   = 2000;
@@ -880,41 +1059,186 @@ static std::string build_base_script(const std::vector<lower_third_cfg> &items)
         }
       }
 
-      // Apply to DOM (change-only updates)
-      const els = Array.from(document.querySelectorAll("#slt-root > li[id]"));
-      for (const el of els) {
-        const cfg = animMap[el.id] || {};
-        const url = (cfg && cfg.paramsFile) ? cfg.paramsFile : PARAMS_URL;
-        const data = __paramsData[url];
-        if (!data || typeof data !== 'object') continue;
-        const obj = (url === PARAMS_URL) ? (data[el.id] || null) : data;
-        if (!obj || typeof obj !== 'object') continue;
-
-        el.__slt_param_cache = (el.__slt_param_cache && typeof el.__slt_param_cache === 'object')
-          ? el.__slt_param_cache
-          : Object.create(null);
-
-        for (const key in obj) {
-          if (!Object.prototype.hasOwnProperty.call(obj, key)) continue;
-          if (!isSafeParamKey(key)) continue;
-          const val = obj[key];
-          const sval = (val === null || val === undefined) ? "" : String(val);
-          if (el.__slt_param_cache[key] === sval) continue;
-
-          const nodes = el.querySelectorAll(`[data-${key}]`);
-          if (!nodes || nodes.length === 0) {
-            el.__slt_param_cache[key] = sval;
-            continue;
-          }
-          nodes.forEach(n => { try { n.innerHTML = sval; } catch (e) {} });
+      applyParameters();
+    } finally {
+      __paramsBusy = false;
+    }
+  }
+
+  // Apply to DOM (change-only updates)
+  function applyParameters() {
+    const els = Array.from(document.querySelectorAll("#slt-root > li[id]"));
+    for (const el of els) {
+      const cfg = animMap[el.id] || {};
+      const url = (cfg && cfg.paramsFile) ? cfg.paramsFile : PARAMS_URL;
+      const data = __paramsData[url];
+      if (!data || typeof data !== 'object') continue;
+      const obj = (url === PARAMS_URL) ? (data[el.id] || null) : data;
+      if (!obj || typeof obj !== 'object') continue;
+
+      el.__slt_param_cache = (el.__slt_param_cache && typeof el.__slt_param_cache === 'object')
+        ? el.__slt_param_cache
+        : Object.create(null);
+
+      for (const key in obj) {
+        if (!Object.prototype.hasOwnProperty.call(obj, key)) continue;
+        if (!isSafeParamKey(key)) continue;
+        const val = obj[key];
+        const sval = (val === null || val === undefined) ? "" : String(val);
+        if (el.__slt_param_cache[key] === sval) continue;
+
+        const nodes = el.querySelectorAll(`[data-${key}]`);
+        if (!nodes || nodes.length === 0) {
           el.__slt_param_cache[key] = sval;
+          continue;
         }
+        nodes.forEach(n => { try { n.innerHTML = sval; } catch (e) {} });
+        el.__slt_param_cache[key] = sval;
       }
-    } finally {
-      __paramsBusy = false;
     }
   }
 
+  // Scheduled changes (lt-schedule.json): each entry is armed once and fires on the first animation
+  // frame at or after its 'at' (Unix ms). Until the core has applied it, which drops it from the file
+  // after lt-visible.json / the parameters are written, its visibility overrides lt-visible.json.
+  const SCHEDULE_ARM_LEAD_MS = 50; // coarse timer until this close, then frame by frame
+  let __schedText = null;
+  const __schedArmed = new Map();    // seq -> entry
+  const __schedOverride = new Map(); // item id -> { seq, visible }
+
+  function wallNow() { return performance.timeOrigin + performance.now(); }
+
+  async function pollSchedule() {
+    let list;
+    try {
+      const txt = await fetchJsonText(SCHEDULE_URL);
+      if (txt === null || txt === __schedText) return;
+      list = JSON.parse(txt);
+      if (!Array.isArray(list)) return;
+      __schedText = txt;
+    } catch (e) {
+      return;
+    }
+
+    const live = new Set();
+    for (const ch of list) {
+      if (!ch || typeof ch.seq !== "number" || typeof ch.id !== "string") continue;
+      live.add(ch.seq);
+      if (!__schedArmed.has(ch.seq)) armChange(ch);
+    }
+    for (const seq of Array.from(__schedArmed.keys())) {
+      if (!live.has(seq)) __schedArmed.delete(seq);
+    }
+    for (const [id, o] of Array.from(__schedOverride.entries())) {
+      if (!live.has(o.seq)) __schedOverride.delete(id);
+    }
+  }
+
+  function armChange(ch) {
+    __schedArmed.set(ch.seq, ch);
+    const at = Number(ch.at) || 0;
+    const onFrame = (ts) => {
+      if (!__schedArmed.has(ch.seq)) return; // cancelled
+      // Fire on the frame closest to the target: within half a frame counts as on time.
+      if (performance.timeOrigin + ts + 8 >= at) fireChange(ch);
+      else requestAnimationFrame(onFrame);
+    };
+    const lead = at - wallNow();
+    if (lead <= 0) fireChange(ch);
+    else setTimeout(() => requestAnimationFrame(onFrame), Math.max(0, lead - SCHEDULE_ARM_LEAD_MS));
+  }
+
+  function fireChange(ch) {
+    const el = document.getElementById(ch.id);
+    if (!el) return;
+    const cfg = animMap[ch.id] || {};
+
+    if (ch.params && typeof ch.params === "object") {
+      // Also replace the polled snapshot, so the next poll does not put the old values back before the
+      // core has rewritten the parameters file.
+      const url = (cfg && cfg.paramsFile) ? cfg.paramsFile : PARAMS_URL;
+      if (url === PARAMS_URL) {
+        const data = (__paramsData[url] && typeof __paramsData[url] === "object") ? __paramsData[url] : {};
+        data[ch.id] = ch.params;
+        __paramsData[url] = data;
+      } else {
+        __paramsData[url] = ch.params;
+      }
+      applyParameters();
+    }
+
+    if (typeof ch.visible === "boolean") {
+      __schedOverride.set(ch.id, { seq: ch.seq, visible: ch.visible });
+      reconcile(el, cfg, ch.visible);
+    }
+  }
+
+  // Instanced items: a single DOM instance whose active data row is swapped in on show.
+  const hasInstanced = Object.keys(animMap).some(k => animMap[k] && animMap[k].instanced);
+  let __rowsText = null;
+  let __rows = null; // item id -> { active, rows: { row id -> { title, subtitle, picture } } }
+
+  async function pollRows() {
+    try {
+      const txt = await fetchJsonText(ROWS_URL);
+      if (txt === null || txt === __rowsText) return;
+      const json = JSON.parse(txt);
+      if (json && typeof json === 'object') {
+        __rowsText = txt;
+        __rows = json;
+      }
+    } catch (e) {
+      // Keep the previous table (external writer may be mid-update)
+    }
+  }
+
+  function activeRowOf(el) {
+    const t = __rows && __rows[el.id];
+    return (t && typeof t.active === 'string') ? t.active : null;
+  }
+
+  function rowText(el, rowId) {
+    const t = __rows && __rows[el.id];
+    const row = (t && t.rows) ? t.rows[rowId] : null;
+    return row ? JSON.stringify(row) : null;
+  }
+
+  // True when the element does not show rowId's current data. The build-time render is taken as
+  // current for its own row until the first table is seen.
+  function rowStale(el, rowId) {
+    if (rowId === null) return false;
+    if (el.dataset.row !== rowId) return true;
+    if (el.__slt_row_text === undefined) {
+      el.__slt_row_text = rowText(el, rowId);
+      return false;
+    }
+    return el.__slt_row_text !== rowText(el, rowId);
+  }
+
+  function applyRow(el, rowId) {
+    const tpl = document.getElementById("slt-row-tpl-" + el.id);
+    const t = __rows && __rows[el.id];
+    const row = (t && t.rows) ? t.rows[rowId] : null;
+    if (!tpl || !row) return;
+
+    // Same substitution as a build-time render; only quotes are escaped so attribute values stay intact.
+    const vals = {
+      "{{ROW_ID}}": rowId,
+      "{{TITLE}}": row.title,
+      "{{SUBTITLE}}": row.subtitle,
+      "{{PROFILE_PICTURE_URL}}": row.picture || "./",
+    };
+    let html = tpl.innerHTML;
+    for (const k in vals) {
+      const v = (vals[k] === null || vals[k] === undefined) ? "" : String(vals[k]);
+      html = html.split(k).join(v.replace(/"/g, "&quot;"));
+    }
+    el.innerHTML = html;
+    el.dataset.row = rowId;
+    el.__slt_row_text = JSON.stringify(row);
+    el.__slt_param_cache = null; // re-apply parameters to the fresh nodes
+  }
+
   function playCue(url) {
     if (!url || !String(url).trim()) return;
     try {
@@ -1034,7 +1358,18 @@ static std::string build_base_script(const std::vector<lower_third_cfg> &items)
     }
   }
 
+  // Idle while nothing is shown or animating; items may listen to "slt:idle" to pause their own timers.
+  let __idle = false;
+  function setIdle(idle) {
+    if (idle === __idle) return;
+    __idle = idle;
+    const root = document.getElementById("slt-root");
+    if (root) root.classList.toggle("slt-idle", idle);
+    document.dispatchEvent(new CustomEvent("slt:idle", { detail: { idle } }));
+  }
+
   async function doShow(el, cfg) {
+    setIdle(false);
     setMounted(el, true);
     stripAnimate(el);
 
@@ -1042,6 +1377,7 @@ static std::string build_base_script(const std::vector<lower_third_cfg> &items)
 
     if (cfg && cfg.inCustom) {
       await runHookWithTimeout(el, "__slt_show", MAX_CUSTOM_WAIT_MS);
+      warnIfClipped(el);
       return;
     }
 
@@ -1054,6 +1390,18 @@ static std::string build_base_script(const std::vector<lower_third_cfg> &items)
       await waitOwnAnimationEnd(el, MAX_ANIM_WAIT_MS);
       stripAnimate(el);
     }
+    warnIfClipped(el);
+  }
+
+  // Shard pages are sized to a zone, not the frame; an item larger than its zone is cut off there.
+  function warnIfClipped(el) {
+    if (el.__slt_clip_warned) return;
+    const r = el.getBoundingClientRect();
+    if (r.width <= 0 || r.height <= 0) return;
+    if (r.left >= -1 && r.top >= -1 && r.right <= window.innerWidth + 1 && r.bottom <= window.innerHeight + 1) return;
+    el.__slt_clip_warned = true;
+    console.warn("VinciFlow: item", el.id, "(" + Math.round(r.width) + "x" + Math.round(r.height) + ") exceeds the " +
+      window.innerWidth + "x" + window.innerHeight + " page and is clipped");
   }
 
   async function doHide(el, cfg) {
@@ -1083,6 +1431,10 @@ static std::string build_base_script(const std::vector<lower_third_cfg> &items)
   }
 
   async function tick() {
+    // Fetched alongside the visible set so a row switch and its show land in the same tick.
+    const rowsReady = hasInstanced ? pollRows() : null;
+    // Before the visible set: the core writes it before dropping an applied entry from the schedule.
+    await pollSchedule();
     let visibleIds;
     try {
       const r = await fetch(VISIBLE_URL + "?t=" + Date.now(), { cache: "no-store" });
@@ -1091,34 +1443,55 @@ static std::string build_base_script(const std::vector<lower_third_cfg> &items)
     } catch (e) {
       return;
     }
+    if (rowsReady) await rowsReady;
 
     const visibleSet = new Set(visibleIds.map(String));
     const els = Array.from(document.querySelectorAll("#slt-root > li[id]"));
 
+    let active = false;
     for (const el of els) {
       const cfg = animMap[el.id] || {};
-      const want = visibleSet.has(el.id);
+      const o = __schedOverride.get(el.id);
+      const want = o ? o.visible : visibleSet.has(el.id);
+      reconcile(el, cfg, want);
+      active = active || want || el.dataset.busy === "1" || el.classList.contains("slt-visible");
+    }
+    if (!active) setIdle(true);
+  }
 
-      el.dataset.want = want ? "1" : "0";
+  function reconcile(el, cfg, want) {
+    el.dataset.want = want ? "1" : "0";
 
-      const isMounted = el.classList.contains("slt-visible") || el.style.display === "block";
+    const isMounted = el.classList.contains("slt-visible") || el.style.display === "block";
 
-      if (want && isMounted) continue;
-      if (!want && !isMounted) continue;
+    // A shown instanced item whose active row (or that row's data) changed plays out and back in with
+    // the new data.
+    const rowId = cfg.instanced ? activeRowOf(el) : null;
+    const rowSwap = want && isMounted && rowStale(el, rowId);
 
-      if (el.dataset.busy === "1") continue;
+    if (want && isMounted && !rowSwap) return;
+    if (!want && !isMounted) return;
 
-      el.dataset.busy = "1";
-      enqueue(el, async () => {
-        try {
-          const stillWant = el.dataset.want === "1";
-          if (stillWant) await doShow(el, cfg);
-          else await doHide(el, cfg);
-        } finally {
-          el.dataset.busy = "0";
+    if (el.dataset.busy === "1") return;
+
+    el.dataset.busy = "1";
+    enqueue(el, async () => {
+      try {
+        const stillWant = el.dataset.want === "1";
+        if (stillWant) {
+          const next = cfg.instanced ? activeRowOf(el) : null;
+          if (rowStale(el, next)) {
+            if (el.classList.contains("slt-visible")) await doHide(el, cfg);
+            applyRow(el, next);
+          }
+          await doShow(el, cfg);
+        } else {
+          await doHide(el, cfg);
         }
-      });
-    }
+      } finally {
+        el.dataset.busy = "0";
+      }
+    });
   }
 
   document.addEventListener("DOMContentLoaded", () => {
@@ -1129,64 +1502,336 @@ static std::string build_base_script(const std::vector<lower_third_cfg> &items)
     setInterval(pollParameters, PARAMS_POLL_MS);
   });
 })();
-)JS");
+)JS";
 }
 
-static std::string build_item_script(const lower_third_cfg &c)
+static void build_item_script(const lower_third_cfg &c, const slt_repl_map &repl, out_buffer &out)
 {
-	std::string js = c.js_template;
-	const auto repl = build_placeholder_map(c);
-	js = replace_placeholders(std::move(js), repl);
+	const std::string js = replace_placeholders(c.js_template, repl);
+
+	out << "\n/* ---- " << c.id << " ---- */\n";
+	out << "(() => {\n";
+	out << "  const root = document.getElementById(\"" << c.id << "\");\n";
+	out << "  if (!root) return;\n";
+	out << "  try {\n";
+	out << js;
+	out << "\n  } catch(e) { console.error(\"SLT script error for " << c.id << "\", e); }\n";
+	out << "})();\n";
+}
 
-	std::string out;
-	out += "\n/* ---- " + c.id + " ---- */\n";
-	out += "(() => {\n";
-	out += "  const root = document.getElementById(\"" + c.id + "\");\n";
-	out += "  if (!root) return;\n";
-	out += "  try {\n";
-	out += js;
-	out += "\n  } catch(e) { console.error(\"SLT script error for " + c.id + "\", e); }\n";
-	out += "})();\n";
-	return out;
+// Left in an instanced item's <template>; the base script fills them from lt-rows.json.
+static constexpr const char *kRowPlaceholders[] = {"{{ROW_ID}}", "{{TITLE}}", "{{SUBTITLE}}",
+						   "{{PROFILE_PICTURE_URL}}"};
+
+// Row placeholders in the CSS or JS are baked into the bundle with the active row's values; only the
+// markup is swapped by the overlay.
+static bool row_placeholders_outside_html(const lower_third_cfg &c)
+{
+	for (const char *k : kRowPlaceholders) {
+		if (c.css_template.str().find(k) != std::string::npos || c.js_template.str().find(k) != std::string::npos)
+			return true;
+	}
+	return false;
 }
 
-static std::string build_full_html(const std::string &ts, const std::string &cssFile, const std::string &jsFile)
+static std::string render_item_inner(const lower_third_cfg &c, const slt_repl_map &repl)
 {
+	std::string inner = replace_placeholders(c.html_template, repl);
+
+	if (inner.find("onerror") == std::string::npos) {
+		inner = replace_all(std::move(inner), "<img ", "<img onerror=\"this.style.display='none'\" ");
+	}
+	return inner;
+}
+
+static void build_item_html(const lower_third_cfg &c, const slt_repl_map &repl, out_buffer &out)
+{
+	const bool customMode = (c.anim_in == kAtomCustomIn) || (c.anim_out == kAtomCustomOut);
+
+	out << "  <li id=\"" << c.id << "\" class=\"" << c.lt_position.str() << '"';
+	if (customMode)
+		out << " data-slt-mode=\"custom\"";
+	if (c.instanced) {
+		auto it = repl.find("{{ROW_ID}}");
+		out << " data-slt-instanced=\"1\" data-row=\"" << (it != repl.end() ? it->second : std::string()) << '"';
+	}
+	out << '>';
+	out << render_item_inner(c, repl);
+	out << "</li>\n";
+
+	// One template per instanced item regardless of its row count.
+	if (c.instanced) {
+		slt_repl_map tplRepl = repl;
+		for (const char *k : kRowPlaceholders)
+			tplRepl.erase(k);
+		out << "  <template id=\"slt-row-tpl-" << c.id << "\">" << render_item_inner(c, tplRepl)
+		    << "</template>\n";
+	}
+}
+
+// -------------------------
+// Bundle rendering
+// -------------------------
+
+// Per-item script/markup buffers are small and spliced into the bundle buffers without copying.
+static constexpr size_t kItemChunkBytes = 2 * 1024;
+
+// Per-item output slots. Each slot is written by exactly one worker, so no locking is needed.
+struct item_render {
+	std::string css; // placeholders applied, keyframes extracted
+	std::vector<extracted_keyframes> keyframes;
+	std::vector<std::pair<std::string, std::string>> kf_renames; // old -> new (collisions)
+	std::string scoped_css;
+	out_buffer script{kItemChunkBytes};
+	out_buffer html{kItemChunkBytes};
+};
+
+// Phase-1 output of one item, kept across rebuilds. While an item still points at the same interned
+// template bodies (a pointer compare) with the same placeholder values and position class, the next
+// render reuses this instead of redoing substitution and keyframe extraction.
+struct item_phase1 {
+	std::shared_ptr<const std::string> html_tpl;
+	std::shared_ptr<const std::string> css_tpl;
+	std::shared_ptr<const std::string> js_tpl;
+	slt_repl_map repl;
+	atom lt_position;
+	bool instanced = false;
+
+	std::string css;
+	std::vector<extracted_keyframes> keyframes;
+	std::string script;
 	std::string html;
-	html += "<!doctype html>\n<html>\n<head>\n<meta charset=\"utf-8\"/>\n";
-	html += "<meta name=\"viewport\" content=\"width=device-width, initial-scale=1\"/>\n";
-	html += "<link rel=\"stylesheet\" href=\"./" + cssFile + "?v=" + ts + "\"/>\n";
 
-	const std::string animateLocalAbs = path_animate_css();
-	if (!animateLocalAbs.empty() && file_exists(animateLocalAbs)) {
-		LOGI("Using local animate.min.css");
-		html += "<link rel=\"stylesheet\" href=\"./animate.min.css\"/>\n";
-	} else {
-		LOGI("Using CDN animate.css (local animate.min.css not found)");
-		html += "<link rel=\"stylesheet\" href=\"https://cdnjs.cloudflare.com/ajax/libs/animate.css/4.1.1/animate.min.css\"/>\n";
+	bool matches(const lower_third_cfg &c, const slt_repl_map &r) const
+	{
+		return html_tpl == c.html_template.shared() && css_tpl == c.css_template.shared() &&
+		       js_tpl == c.js_template.shared() && lt_position == c.lt_position &&
+		       instanced == c.instanced && repl == r;
 	}
+};
 
-	html += "</head>\n<body>\n<ul id=\"slt-root\">\n";
+// Keyed by item id; replaced wholesale by each render so removed items drop out.
+using phase1_cache = std::unordered_map<std::string, std::shared_ptr<const item_phase1>>;
+static std::mutex g_phase1_mx;
+static phase1_cache g_phase1_cache;
 
-	for (const auto &c : g_items) {
-		std::string inner = c.html_template;
-		const auto repl = build_placeholder_map(c);
-		inner = replace_placeholders(std::move(inner), repl);
+struct rendered_bundle {
+	out_buffer css;
+	out_buffer js;
+	out_buffer html;
+};
+
+static constexpr size_t kRenderItemsPerWorker = 16;
+
+// 'fixed' (benchmarks) asks for exactly that many workers, still at most one per item and per core.
+static size_t render_worker_count(size_t n, size_t fixed = 0)
+{
+	const size_t hw = std::max<size_t>(1, (size_t)std::thread::hardware_concurrency());
+	const size_t wanted = fixed ? std::min(fixed, n) : (n + kRenderItemsPerWorker - 1) / kRenderItemsPerWorker;
+	return std::max<size_t>(1, std::min(hw, wanted));
+}
+
+// Render workers: started on first use, at most hardware_concurrency - 1 of them (the caller of
+// parallel_for always works too), and kept until shutdown_rebuilds().
+struct render_pool {
+	std::mutex mx;
+	std::condition_variable cv;
+	std::deque<std::function<void()>> tasks;
+	std::vector<std::thread> threads;
+	bool stopped = false;
+};
+
+static render_pool g_pool;
+
+static void render_pool_loop()
+{
+	for (;;) {
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lk(g_pool.mx);
+			g_pool.cv.wait(lk, []() { return g_pool.stopped || !g_pool.tasks.empty(); });
+			if (g_pool.tasks.empty())
+				return; // stopped and drained
+			task = std::move(g_pool.tasks.front());
+			g_pool.tasks.pop_front();
+		}
+		task();
+	}
+}
+
+static void stop_render_pool()
+{
+	std::vector<std::thread> threads;
+	{
+		std::lock_guard<std::mutex> lk(g_pool.mx);
+		g_pool.stopped = true;
+		threads.swap(g_pool.threads);
+	}
+	g_pool.cv.notify_all();
+	for (auto &t : threads)
+		t.join();
+}
+
+// Runs fn(i) for every i in [0, n) on the render workers and the calling thread. Indices are claimed
+// through an atomic cursor; results go to per-index slots so order is preserved. Helpers that start
+// late (the pool is busy with another render) find nothing left and return at once.
+static void parallel_for(size_t n, const std::function<void(size_t)> &fn, size_t fixedWorkers = 0)
+{
+	const size_t workers = render_worker_count(n, fixedWorkers);
+	if (workers <= 1) {
+		for (size_t i = 0; i < n; ++i)
+			fn(i);
+		return;
+	}
+
+	std::atomic<size_t> next{0};
+	auto run = [&]() {
+		for (size_t i = next.fetch_add(1); i < n; i = next.fetch_add(1))
+			fn(i);
+	};
 
-		if (inner.find("onerror") == std::string::npos) {
-			inner = replace_all(inner, "<img ", "<img onerror=\"this.style.display='none'\" ");
+	std::mutex doneMx;
+	std::condition_variable doneCv;
+	size_t pending = 0;
+	{
+		std::lock_guard<std::mutex> lk(g_pool.mx);
+		if (!g_pool.stopped) {
+			pending = workers - 1;
+			while (g_pool.threads.size() < pending)
+				g_pool.threads.emplace_back(render_pool_loop);
+			for (size_t w = 0; w < pending; ++w) {
+				g_pool.tasks.emplace_back([&]() {
+					run();
+					std::lock_guard<std::mutex> dl(doneMx);
+					if (--pending == 0)
+						doneCv.notify_one();
+				});
+			}
 		}
+	}
+	g_pool.cv.notify_all();
+
+	run();
+	std::unique_lock<std::mutex> lk(doneMx);
+	doneCv.wait(lk, [&]() { return pending == 0; });
+}
+
+// Splices each item's markup buffer into out; parts[i].html is left empty.
+static void build_full_html(const std::string &ts, const std::string &cssFile, const std::string &jsFile,
+			    bool localAnimateCss, std::vector<item_render> &parts, out_buffer &out)
+{
+	out << "<!doctype html>\n<html>\n<head>\n<meta charset=\"utf-8\"/>\n";
+	out << "<meta name=\"viewport\" content=\"width=device-width, initial-scale=1\"/>\n";
+	out << "<link rel=\"stylesheet\" href=\"./" << cssFile << "?v=" << ts << "\"/>\n";
+
+	if (localAnimateCss) {
+		out << "<link rel=\"stylesheet\" href=\"./animate.min.css\"/>\n";
+	} else {
+		out << "<link rel=\"stylesheet\" href=\"https://cdnjs.cloudflare.com/ajax/libs/animate.css/4.1.1/animate.min.css\"/>\n";
+	}
+
+	out << "</head>\n<body>\n<ul id=\"slt-root\">\n";
+
+	for (auto &p : parts)
+		out.splice(std::move(p.html));
+
+	out << "</ul>\n<script defer src=\"./" << jsFile << "?v=" << ts << "\"></script>\n</body>\n</html>\n";
+}
+
+// -------------------------
+// External change detection
+// -------------------------
+// In-memory state is authoritative. The stamps record what lt-state.json / lt-visible.json looked like
+// when we last loaded or saved them, so CRUD helpers only re-read a file that changed underneath us.
+
+// Saves run on any thread (websocket requests, scheduled changes) while the watcher reads the stamps on
+// the UI thread: g_state_stamp, g_visible_stamp and g_param_stamps are only touched under g_stamp_mx.
+static std::mutex g_stamp_mx;
+static file_stamp g_state_stamp;
+static file_stamp g_visible_stamp;
+
+static file_stamp get_stamp(const file_stamp &shared)
+{
+	std::lock_guard<std::mutex> lk(g_stamp_mx);
+	return shared;
+}
+
+static void set_stamp(file_stamp &shared, const file_stamp &value)
+{
+	std::lock_guard<std::mutex> lk(g_stamp_mx);
+	shared = value;
+}
+
+static file_stamp stamp_written_file(const std::string &path, uint64_t hash)
+{
+	const QFileInfo fi(QString::fromStdString(path));
+	if (!fi.exists())
+		return {};
+	return file_stamp{true, (int64_t)fi.size(), (int64_t)fi.lastModified().toMSecsSinceEpoch(), hash};
+}
+
+// Size + mtime equal to the stamp is the O(1) fast path. Otherwise the content hash decides, so a
+// touch or a rewrite with identical bytes does not discard in-memory state.
+static bool file_changed_since(const std::string &path, file_stamp &st)
+{
+	const QFileInfo fi(QString::fromStdString(path));
+	if (!fi.exists())
+		return st.valid;
+	if (!st.valid)
+		return true;
 
-		const bool customMode = (c.anim_in == "custom_handled_in") || (c.anim_out == "custom_handled_out");
+	const int64_t size = (int64_t)fi.size();
+	const int64_t mtime = (int64_t)fi.lastModified().toMSecsSinceEpoch();
+	if (size == st.size && mtime == st.mtime_ms)
+		return false;
+	if (size != st.size)
+		return true;
+
+	const std::string txt = read_text_file(path);
+	if (fnv1a64(txt.data(), txt.size()) != st.hash)
+		return true;
 
-		html += "  <li id=\"" + c.id + "\" class=\"" + c.lt_position + "\"" +
-			(customMode ? " data-slt-mode=\"custom\"" : "") + ">";
-		html += inner;
-		html += "</li>\n";
+	st.mtime_ms = mtime;
+	return false;
+}
+
+// file_changed_since() against a shared stamp: the check runs on a copy (file I/O outside the lock), and
+// a touch it detected is recorded unless the stamp was replaced meanwhile.
+static bool stamp_changed(const std::string &path, file_stamp &shared)
+{
+	const file_stamp before = get_stamp(shared);
+	file_stamp st = before;
+	if (file_changed_since(path, st))
+		return true;
+	if (st.mtime_ms != before.mtime_ms) {
+		std::lock_guard<std::mutex> lk(g_stamp_mx);
+		if (shared.valid && shared.size == before.size && shared.mtime_ms == before.mtime_ms &&
+		    shared.hash == before.hash)
+			shared.mtime_ms = st.mtime_ms;
 	}
+	return false;
+}
+
+// Parameter files we wrote or last observed (absolute path -> stamp), so the watcher can tell external
+// writers apart from our own writes. Guarded by g_stamp_mx.
+static std::unordered_map<std::string, file_stamp> g_param_stamps;
+
+static std::unordered_map<std::string, file_stamp> param_stamps_copy()
+{
+	std::lock_guard<std::mutex> lk(g_stamp_mx);
+	return g_param_stamps;
+}
+
+static bool write_parameters_file(const std::string &path, const QJsonObject &obj)
+{
+	const std::string txt = QJsonDocument(obj).toJson(QJsonDocument::Indented).toStdString();
+	if (!write_text_file_atomic(path, txt))
+		return false;
 
-	html += "</ul>\n<script defer src=\"./" + jsFile + "?v=" + ts + "\"></script>\n</body>\n</html>\n";
-	return html;
+	const file_stamp st = stamp_written_file(path, fnv1a64(txt.data(), txt.size()));
+	std::lock_guard<std::mutex> lk(g_stamp_mx);
+	g_param_stamps[path] = st;
+	return true;
 }
 
 bool has_output_dir()
@@ -1195,40 +1840,97 @@ bool has_output_dir()
 }
 
 std::string output_dir()
+{
+	return g_live_dir.empty() ? g_output_dir : g_live_dir;
+}
+
+std::string configured_output_dir()
 {
 	return g_output_dir;
 }
 
+std::unordered_map<std::string, std::string> &output_dir_bindings()
+{
+	return g_output_dir_by_collection;
+}
+
+// Deletes a top-level file of output_dir(). In hot mode the checkpointer deletes it, since that is the
+// only way a deletion reaches the configured folder.
+bool remove_output_file(const std::string &name)
+{
+	{
+		std::lock_guard<std::mutex> lk(g_checkpointer_mx);
+		if (g_checkpointer)
+			return g_checkpointer->remove(name);
+	}
+	std::error_code ec;
+	return std::filesystem::remove(std::filesystem::path(join_path(output_dir(), name)), ec);
+}
+
 std::string path_state_json()
 {
-	return has_output_dir() ? join_path(g_output_dir, "lt-state.json") : "";
+	return has_output_dir() ? join_path(output_dir(), "lt-state.json") : "";
+}
+
+// Snapshots are named after the lt-state.json they mirror, so a new one never replaces a file that may
+// still be mapped (Windows refuses that) and finding the current one needs only a stat of the JSON.
+static std::string state_bin_name(int64_t jsonSize, int64_t jsonMtimeMs)
+{
+	const int64_t key[2] = {jsonSize, jsonMtimeMs};
+	char name[40];
+	std::snprintf(name, sizeof(name), "lt-state-%016llx.bin", (unsigned long long)fnv1a64(key, sizeof(key)));
+	return name;
+}
+
+// Snapshot path for the lt-state.json in 'dir'; empty when there is none.
+static std::string state_bin_path(const std::string &dir)
+{
+	const QFileInfo fi(QString::fromStdString(join_path(dir, "lt-state.json")));
+	if (!fi.exists())
+		return {};
+	return join_path(dir, state_bin_name((int64_t)fi.size(), (int64_t)fi.lastModified().toMSecsSinceEpoch()));
+}
+
+std::string path_state_bin()
+{
+	return has_output_dir() ? state_bin_path(output_dir()) : "";
 }
 
 std::string path_visible_json()
 {
-	return has_output_dir() ? join_path(g_output_dir, "lt-visible.json") : "";
+	return has_output_dir() ? join_path(output_dir(), "lt-visible.json") : "";
+}
+
+std::string path_schedule_json()
+{
+	return has_output_dir() ? join_path(output_dir(), "lt-schedule.json") : "";
+}
+
+std::string path_rows_json()
+{
+	return has_output_dir() ? join_path(output_dir(), "lt-rows.json") : "";
 }
 
 std::string path_styles_css()
 {
-	return has_output_dir() ? join_path(g_output_dir, "lt.css") : "";
+	return has_output_dir() ? join_path(output_dir(), "lt.css") : "";
 }
 
 std::string path_scripts_js()
 {
-	return has_output_dir() ? join_path(g_output_dir, "lt.js") : "";
+	return has_output_dir() ? join_path(output_dir(), "lt.js") : "";
 }
 
 std::string path_parameters_json()
 {
-	return has_output_dir() ? join_path(g_output_dir, "parameters.json") : "";
+	return has_output_dir() ? join_path(output_dir(), "parameters.json") : "";
 }
 
 std::string path_parameters_lt_json(const std::string &id)
 {
 	if (!has_output_dir())
 		return {};
-	return join_path(g_output_dir, "parameters_" + id + ".json");
+	return join_path(output_dir(), "parameters_" + id + ".json");
 }
 
 bool set_template_parameters(const std::string &id, const QJsonObject &data)
@@ -1237,11 +1939,11 @@ bool set_template_parameters(const std::string &id, const QJsonObject &data)
 		return false;
 
 	const std::string sid = sanitize_id(id);
-	if (sid.empty() || !get_by_id(sid))
+	if (sid.empty() || !get_by_id_const(sid))
 		return false;
 
 	const std::string perPath = path_parameters_lt_json(sid);
-	if (!write_text_file_atomic(perPath, QJsonDocument(data).toJson(QJsonDocument::Indented).toStdString()))
+	if (!write_parameters_file(perPath, data))
 		return false;
 
 	const std::string combinedPath = path_parameters_json();
@@ -1252,13 +1954,16 @@ bool set_template_parameters(const std::string &id, const QJsonObject &data)
 			const std::string txt = read_text_file(combinedPath);
 			if (parse_json_object_text(txt, combinedRoot)) {
 				combinedRoot[QString::fromStdString(sid)] = data;
-				write_text_file_atomic(
-					combinedPath,
-					QJsonDocument(combinedRoot).toJson(QJsonDocument::Indented).toStdString());
+				write_parameters_file(combinedPath, combinedRoot);
 			}
 		}
 	}
 
+	core_event ev;
+	ev.type = event_type::ParametersChanged;
+	ev.id = sid;
+	emit_event(ev);
+
 	return true;
 }
 
@@ -1269,7 +1974,7 @@ bool get_template_parameters(const std::string &id, QJsonObject &out)
 		return false;
 
 	const std::string sid = sanitize_id(id);
-	if (sid.empty() || !get_by_id(sid))
+	if (sid.empty() || !get_by_id_const(sid))
 		return false;
 
 	const std::string perPath = path_parameters_lt_json(sid);
@@ -1299,19 +2004,114 @@ bool get_template_parameters(const std::string &id, QJsonObject &out)
 	return true;
 }
 
-std::string path_animate_css()
+// -------------------------
+// Scheduled changes
+// -------------------------
+
+static std::vector<scheduled_change> g_schedule; // pending, in seq order
+static uint64_t g_schedule_seq = 0;
+
+static bool save_schedule_json()
 {
-	return has_output_dir() ? join_path(g_output_dir, "animate.min.css") : "";
+	if (!has_output_dir())
+		return false;
+
+	QJsonArray a;
+	for (const auto &c : g_schedule) {
+		QJsonObject o;
+		o["seq"] = (double)c.seq;
+		o["id"] = QString::fromStdString(c.id);
+		o["at"] = (double)c.at_ms;
+		if (c.visible >= 0)
+			o["visible"] = c.visible == 1;
+		if (c.has_params)
+			o["params"] = c.params;
+		a.append(o);
+	}
+	return write_text_file(path_schedule_json(), QJsonDocument(a).toJson(QJsonDocument::Compact).toStdString());
 }
 
-std::string now_timestamp_string()
+static void emit_schedule_changed(const std::string &id)
 {
-	const qint64 ts = QDateTime::currentMSecsSinceEpoch();
-	return std::to_string((long long)ts);
+	core_event ev;
+	ev.type = event_type::ScheduleChanged;
+	ev.id = id;
+	ev.count = (int64_t)g_schedule.size();
+	emit_event(ev);
 }
 
-std::string new_id()
+uint64_t schedule_change(scheduled_change c)
 {
+	c.id = sanitize_id(c.id);
+	if (!has_output_dir() || c.id.empty() || !get_by_id_const(c.id) || (c.visible < 0 && !c.has_params))
+		return 0;
+
+	c.seq = ++g_schedule_seq;
+	const uint64_t seq = c.seq;
+	const std::string id = c.id;
+	g_schedule.push_back(std::move(c));
+	save_schedule_json();
+	emit_schedule_changed(id);
+	return seq;
+}
+
+size_t cancel_scheduled_changes(const std::string &id)
+{
+	const size_t before = g_schedule.size();
+	g_schedule.erase(std::remove_if(g_schedule.begin(), g_schedule.end(),
+					[&id](const scheduled_change &c) { return id.empty() || c.id == id; }),
+			 g_schedule.end());
+	const size_t n = before - g_schedule.size();
+	if (n) {
+		save_schedule_json();
+		emit_schedule_changed(id);
+	}
+	return n;
+}
+
+std::vector<scheduled_change> scheduled_changes()
+{
+	return g_schedule;
+}
+
+bool apply_scheduled_change(uint64_t seq)
+{
+	auto it = std::find_if(g_schedule.begin(), g_schedule.end(),
+			       [seq](const scheduled_change &c) { return c.seq == seq; });
+	if (it == g_schedule.end())
+		return false;
+
+	const scheduled_change c = std::move(*it);
+	g_schedule.erase(it);
+
+	// lt-visible.json / parameters are written before the entry leaves lt-schedule.json. The overlay
+	// reads the schedule first, so it never sees the entry gone while the old visibility is still live.
+	if (c.visible >= 0)
+		set_visible_persist(c.id, c.visible == 1);
+	if (c.has_params)
+		set_template_parameters(c.id, c.params);
+
+	save_schedule_json();
+	emit_schedule_changed(c.id);
+	return true;
+}
+
+std::string path_animate_css()
+{
+	return has_output_dir() ? join_path(output_dir(), "animate.min.css") : "";
+}
+
+std::string now_timestamp_string()
+{
+	const qint64 ts = QDateTime::currentMSecsSinceEpoch();
+	return std::to_string((long long)ts);
+}
+
+std::string new_id()
+{
+	// Also called by the profile preload worker (items without an id).
+	static std::mutex mx;
+	std::lock_guard<std::mutex> lk(mx);
 	static std::mt19937_64 rng{std::random_device{}()};
 	static std::uniform_int_distribution<uint64_t> dist;
 	uint64_t a = dist(rng);
@@ -1324,6 +2124,7 @@ std::string new_id()
 
 std::vector<lower_third_cfg> &all()
 {
+	history_touch_all();
 	return g_items;
 }
 
@@ -1332,9 +2133,24 @@ const std::vector<lower_third_cfg> &all_const()
 	return g_items;
 }
 
+std::vector<lower_third_cfg> &live_items()
+{
+	return g_items;
+}
+
 lower_third_cfg *get_by_id(const std::string &id)
 {
 	for (auto &c : g_items)
+		if (c.id == id) {
+			history_touch(id);
+			return &c;
+		}
+	return nullptr;
+}
+
+const lower_third_cfg *get_by_id_const(const std::string &id)
+{
+	for (const auto &c : g_items)
 		if (c.id == id)
 			return &c;
 	return nullptr;
@@ -1403,65 +2219,80 @@ void toggle_visible_nosave(const std::string &id)
 	set_visible_nosave(id, !is_visible(id));
 }
 
+// Visible members of id's exclusive group other than id itself.
+static std::vector<std::string> exclusive_peers(const std::string &id)
+{
+	std::vector<std::string> hidden;
+	const auto owners = groups_containing(id);
+	if (owners.empty())
+		return hidden;
+
+	group_cfg *g = get_group_by_id(owners.front());
+	if (!g || !g->exclusive)
+		return hidden;
+
+	std::unordered_set<std::string> memberSet;
+	memberSet.reserve(g->members.size() * 2 + 1);
+	for (const auto &m : g->members)
+		memberSet.insert(m);
+
+	for (const auto &vid : g_visible) {
+		if (vid == id)
+			continue;
+		if (memberSet.find(vid) != memberSet.end())
+			hidden.push_back(vid);
+	}
+	return hidden;
+}
+
 bool set_visible_persist(const std::string &id, bool visible)
 {
 	if (!has_output_dir() || id.empty())
 		return false;
 
-	if (!get_by_id(id))
+	if (!get_by_id_const(id))
 		return false;
 
-	const bool before = is_visible(id);
-	if (before == visible) {
-		return true;
-	}
+	return set_visible_batch({{id, visible}});
+}
 
-	std::vector<std::string> hidden;
+bool set_visible_batch(const std::vector<std::pair<std::string, bool>> &changes)
+{
+	if (!has_output_dir())
+		return false;
 
-	if (visible && !before) {
-		const auto owners = groups_containing(id);
-		if (!owners.empty()) {
-			group_cfg *g = get_group_by_id(owners.front());
-			if (g && g->exclusive) {
-				std::unordered_set<std::string> memberSet;
-				memberSet.reserve(g->members.size() * 2 + 1);
-				for (const auto &m : g->members)
-					memberSet.insert(m);
-
-				for (const auto &vid : g_visible) {
-					if (vid == id)
-						continue;
-					if (memberSet.find(vid) != memberSet.end())
-						hidden.push_back(vid);
-				}
+	// Every effective change, exclusive-group hides first, in the order the events go out.
+	std::vector<std::pair<std::string, bool>> applied;
+	for (const auto &ch : changes) {
+		const std::string &id = ch.first;
+		if (id.empty() || !get_by_id_const(id) || is_visible(id) == ch.second)
+			continue;
+
+		if (ch.second) {
+			for (const auto &hid : exclusive_peers(id)) {
+				set_visible_nosave(hid, false);
+				applied.emplace_back(hid, false);
 			}
 		}
+		set_visible_nosave(id, ch.second);
+		applied.emplace_back(id, ch.second);
 	}
 
-	for (const auto &hid : hidden)
-		set_visible_nosave(hid, false);
-
-	set_visible_nosave(id, visible);
+	if (applied.empty())
+		return true;
 	if (!save_visible_json())
 		return false;
 
 	const auto visNow = visible_ids();
-	for (const auto &hid : hidden) {
+	for (const auto &a : applied) {
 		core_event ev;
 		ev.type = event_type::VisibilityChanged;
-		ev.id = hid;
-		ev.visible = false;
+		ev.id = a.first;
+		ev.visible = a.second;
 		ev.visible_ids = visNow;
 		emit_event(ev);
 	}
 
-	core_event ev;
-	ev.type = event_type::VisibilityChanged;
-	ev.id = id;
-	ev.visible = visible;
-	ev.visible_ids = visNow;
-	emit_event(ev);
-
 	return true;
 }
 
@@ -1470,7 +2301,7 @@ bool toggle_visible_persist(const std::string &id)
 	if (!has_output_dir() || id.empty())
 		return false;
 
-	if (!get_by_id(id))
+	if (!get_by_id_const(id))
 		return false;
 
 	const bool after = !is_visible(id);
@@ -1492,6 +2323,8 @@ bool ensure_output_artifacts_exist()
 		g_visible.clear();
 		save_visible_json();
 	}
+	// Pending changes live in memory only; a file left by an earlier session is stale.
+	save_schedule_json();
 	if (!QFile::exists(QString::fromStdString(path_styles_css()))) {
 		write_text_file(path_styles_css(), "/* generated */\n");
 	}
@@ -1524,9 +2357,10 @@ static bool ensure_parameters_files_from_api_templates()
 
 		if (!lt.api_bridge_enabled) {
 			// Bridge disabled: remove stale file if present.
-			const QString qp = QString::fromStdString(perPath);
-			if (QFile::exists(qp))
-				QFile::remove(qp);
+			if (QFile::exists(QString::fromStdString(perPath)))
+				remove_output_file(std::filesystem::path(perPath).filename().string());
+			std::lock_guard<std::mutex> lk(g_stamp_mx);
+			g_param_stamps.erase(perPath);
 			continue;
 		}
 
@@ -1567,7 +2401,7 @@ static bool ensure_parameters_files_from_api_templates()
 		}
 
 		if (perDirty) {
-			write_text_file_atomic(perPath, QJsonDocument(perObj).toJson(QJsonDocument::Indented).toStdString());
+			write_parameters_file(perPath, perObj);
 		}
 
 		// Optional combined parameters.json (kept only for tooling convenience).
@@ -1592,425 +2426,1201 @@ static bool ensure_parameters_files_from_api_templates()
 	}
 
 	if (allowCombinedWrite && (combinedDirty || !combinedExists)) {
-		write_text_file_atomic(combinedPath, QJsonDocument(combinedRoot).toJson(QJsonDocument::Indented).toStdString());
+		write_parameters_file(combinedPath, combinedRoot);
 	}
 
 	return true;
 }
 
 
-bool load_state_json()
+// -------------------------
+// Instanced rows (lt-rows.json)
+// -------------------------
+// { "<item id>": { "active": "<row id>", "rows": { "<row id>": { title, subtitle, picture } } } }
+// Derived from g_items and rewritten whenever state is loaded or saved; the overlay polls it.
+
+static uint64_t g_rows_hash = 0;
+
+static std::string new_row_id()
 {
-	if (!has_output_dir())
-		return false;
+	return "row_" + new_id().substr(3);
+}
 
-	const std::string p = path_state_json();
-	if (!QFile::exists(QString::fromStdString(p))) {
-		g_items.clear();
-		g_groups.clear();
-		return true;
+const data_row *active_row_of(const lower_third_cfg &c)
+{
+	if (c.rows.empty())
+		return nullptr;
+	for (const auto &r : c.rows) {
+		if (r.id == c.active_row)
+			return &r;
 	}
+	return &c.rows.front();
+}
 
-	const std::string txt = read_text_file(p);
-	if (txt.empty()) {
-		g_items.clear();
-		g_groups.clear();
-		return true;
+// Sanitizes row ids and gives missing or duplicate ones a fresh id.
+static void normalize_rows(lower_third_cfg &c)
+{
+	std::unordered_set<std::string> seen;
+	seen.reserve(c.rows.size() * 2 + 1);
+	for (auto &r : c.rows) {
+		std::string rid = r.id.empty() ? std::string() : sanitize_id(r.id);
+		if (rid.empty() || !seen.insert(rid).second) {
+			rid = new_row_id();
+			seen.insert(rid);
+		}
+		r.id = std::move(rid);
 	}
+	if (!c.active_row.empty() && seen.find(c.active_row) == seen.end())
+		c.active_row.clear();
+}
 
-	QJsonParseError err{};
-	const QJsonDocument doc = QJsonDocument::fromJson(QByteArray::fromStdString(txt), &err);
-	if (err.error != QJsonParseError::NoError || !doc.isObject()) {
-		LOGW("Invalid lt-state.json; reset");
-		g_items.clear();
-		g_groups.clear();
+bool publish_rows_json()
+{
+	if (!has_output_dir())
 		return false;
-	}
-
-	const QJsonObject root = doc.object();
-	const QJsonObject hkRoot = root.value("hotkeys").toObject();
-	const QJsonObject hkItems = hkRoot.value("items").toObject();
-	const QJsonObject hkGroups = hkRoot.value("groups").toObject();
-
-	const QJsonArray items = root.value("items").toArray();
-	const QJsonArray cars = root.contains("groups") ? root.value("groups").toArray() : root.value("carousels").toArray();
 
-	std::vector<lower_third_cfg> out;
-	out.reserve((size_t)items.size());
-
-	for (const QJsonValue v : items) {
-		if (!v.isObject())
+	out_buffer buf;
+	json_writer w(buf);
+	w.begin_object();
+	for (const auto &c : g_items) {
+		const data_row *active = c.instanced ? active_row_of(c) : nullptr;
+		if (!active)
 			continue;
-		const QJsonObject o = v.toObject();
-
-		lower_third_cfg c;
-		c.id = sanitize_id(o.value("id").toString().toStdString());
-		if (c.id.empty())
-			c.id = new_id();
-
-		c.label = o.value("label").toString().toStdString();
-		c.order = o.value("order").toInt(-1);
-
-		c.title = o.value("title").toString().toStdString();
-		c.subtitle = o.value("subtitle").toString().toStdString();
-		c.profile_picture = o.value("profile_picture").toString().toStdString();
-		c.anim_in_sound = o.value("anim_in_sound").toString().toStdString();
-		c.anim_out_sound = o.value("anim_out_sound").toString().toStdString();
 
-		c.title_size = o.value("title_size").toInt(46);
-		c.subtitle_size = o.value("subtitle_size").toInt(24);
-		c.title_size = std::max(6, std::min(200, c.title_size));
-		c.subtitle_size = std::max(6, std::min(200, c.subtitle_size));
+		w.key(c.id);
+		w.begin_object();
+		w.field("active", active->id);
+		w.key("rows");
+		w.begin_object();
+		for (const auto &r : c.rows) {
+			w.key(r.id);
+			w.begin_object();
+			w.field("title", r.title);
+			w.field("subtitle", r.subtitle);
+			w.field("picture", r.profile_picture.empty() ? std::string("./") : "./" + r.profile_picture);
+			w.end_object();
+		}
+		w.end_object();
+		w.end_object();
+	}
+	w.end_object();
+	buf << '\n';
 
-		c.avatar_width = o.value("avatar_width").toInt(100);
-		c.avatar_height = o.value("avatar_height").toInt(100);
-		c.avatar_width = std::max(10, std::min(400, c.avatar_width));
-		c.avatar_height = std::max(10, std::min(400, c.avatar_height));
+	const std::string p = path_rows_json();
+	const uint64_t h = buf.hash();
+	if (h == g_rows_hash && QFile::exists(QString::fromStdString(p)))
+		return true;
 
-		c.anim_in = o.value("anim_in").toString().toStdString();
-		c.anim_out = o.value("anim_out").toString().toStdString();
+	if (!write_buffer_atomic(buf, p)) {
+		LOGW("Failed writing %s", p.c_str());
+		return false;
+	}
+	g_rows_hash = h;
+	return true;
+}
 
-		c.font_family = o.value("font_family").toString().toStdString();
-		c.lt_position = o.value("lt_position").toString().toStdString();
+// Range checks for the packed small-int fields; they run on the full int before it is narrowed.
+static uint8_t font_px_from(int v)
+{
+	return (uint8_t)std::clamp(v, 6, 200);
+}
 
-		c.primary_color = o.value("primary_color").toString().toStdString();
-		c.secondary_color = o.value("secondary_color").toString().toStdString();
-		c.title_color = o.value("title_color").toString().toStdString();
-		c.subtitle_color = o.value("subtitle_color").toString().toStdString();
+static uint16_t avatar_px_from(int v)
+{
+	return (uint16_t)std::clamp(v, kAvatarMinPx, kAvatarMaxPx);
+}
 
-		if (c.primary_color.empty())
-			c.primary_color = o.value("bg_color").toString().toStdString();
-		if (c.title_color.empty())
-			c.title_color = o.value("text_color").toString().toStdString();
-		if (c.secondary_color.empty())
-			c.secondary_color = c.primary_color;
-		if (c.subtitle_color.empty())
-			c.subtitle_color = c.title_color;
-		c.opacity = o.value("opacity").toInt(0);
-		c.radius = o.value("radius").toInt(0);
-
-		if (c.opacity < 0 || c.opacity > 100)
-			c.opacity = 85;
-		if (c.radius < 0 || c.radius > 100)
-			c.radius = 5;
+static uint8_t percent_from(int v, uint8_t fallback)
+{
+	return (v < 0 || v > 100) ? fallback : (uint8_t)v;
+}
 
-		c.html_template = o.value("html_template").toString().toStdString();
-		c.css_template = o.value("css_template").toString().toStdString();
-		c.js_template = o.value("js_template").toString().toStdString();
-		c.api_template = o.value("api_template").toString().toStdString();
-		c.api_bridge_enabled = o.value("api_bridge_enabled").toBool(o.value("api_bridge").toBool(false));
-		// Backward compatibility: if a legacy api_template exists and no explicit flag was set, assume enabled.
-		if (!o.contains("api_bridge_enabled") && !o.contains("api_bridge")) {
-			if (!QString::fromStdString(c.api_template).trimmed().isEmpty())
-				c.api_bridge_enabled = true;
-		}
+// Clamps and defaults shared by the JSON and binary snapshot loaders.
+static void normalize_loaded_item(lower_third_cfg &c)
+{
+	c.title_size = font_px_from(c.title_size);
+	c.subtitle_size = font_px_from(c.subtitle_size);
+	c.avatar_width = avatar_px_from(c.avatar_width);
+	c.avatar_height = avatar_px_from(c.avatar_height);
+
+	if (c.secondary_color.empty())
+		c.secondary_color = c.primary_color;
+	if (c.subtitle_color.empty())
+		c.subtitle_color = c.title_color;
+
+	c.opacity = percent_from(c.opacity, 85);
+	c.radius = percent_from(c.radius, 5);
+
+	if (c.repeat_every_sec < 0)
+		c.repeat_every_sec = 0;
+	if (c.repeat_visible_sec < 0)
+		c.repeat_visible_sec = 0;
+
+	if (c.html_template.empty() || c.css_template.empty()) {
+		auto d = default_cfg();
+		if (c.html_template.empty())
+			c.html_template = d.html_template;
+		if (c.css_template.empty())
+			c.css_template = d.css_template;
+		if (c.js_template.empty())
+			c.js_template = d.js_template;
+	}
 
+	if (c.lt_position.empty())
+		c.lt_position = kAtomDefaultPosition;
+	if (c.anim_in.empty())
+		c.anim_in = kAtomDefaultAnimIn;
+	if (c.anim_out.empty())
+		c.anim_out = kAtomDefaultAnimOut;
+	if (c.primary_color.empty())
+		c.primary_color = "#111827";
+	if (c.secondary_color.empty())
+		c.secondary_color = "#1F2937";
+	if (c.title_color.empty())
+		c.title_color = "#F9FAFB";
+	if (c.subtitle_color.empty())
+		c.subtitle_color = "#D1D5DB";
 
-		c.hotkey = o.value("hotkey").toString().toStdString();
-		if (c.hotkey.empty()) {
-			const QString k = hkItems.value(QString::fromStdString(c.id)).toString().trimmed();
-			if (!k.isEmpty())
-				c.hotkey = k.toStdString();
-		}
-		if (c.hotkey.empty()) {
-			const QString fallback = hkItems.value(QString::fromStdString(c.id)).toString();
-			if (!fallback.isEmpty())
-				c.hotkey = fallback.toStdString();
-		}
-		c.repeat_every_sec = o.value("repeat_every_sec").toInt(0);
-		c.repeat_visible_sec = o.value("repeat_visible_sec").toInt(0);
+	if (c.label.empty())
+		c.label = c.title.empty() ? c.id : c.title;
 
-		if (c.repeat_every_sec < 0)
-			c.repeat_every_sec = 0;
-		if (c.repeat_visible_sec < 0)
-			c.repeat_visible_sec = 0;
+	normalize_rows(c);
+}
 
-		if (c.html_template.empty() || c.css_template.empty()) {
-			auto d = default_cfg();
-			if (c.html_template.empty())
-				c.html_template = d.html_template;
-			if (c.css_template.empty())
-				c.css_template = d.css_template;
-			if (c.js_template.empty())
-				c.js_template = d.js_template;
-		}
-
-		if (c.lt_position.empty())
-			c.lt_position = "lt-pos-bottom-left";
-		if (c.anim_in.empty())
-			c.anim_in = "animate__fadeInUp";
-		if (c.anim_out.empty())
-			c.anim_out = "animate__fadeOutDown";
-		if (c.primary_color.empty())
-			c.primary_color = "#111827";
-		if (c.secondary_color.empty())
-			c.secondary_color = "#1F2937";
-		if (c.title_color.empty())
-			c.title_color = "#F9FAFB";
-		if (c.subtitle_color.empty())
-			c.subtitle_color = "#D1D5DB";
+static void normalize_loaded_group(group_cfg &c)
+{
+	if (c.visible_ms < 250)
+		c.visible_ms = 250;
+	if (c.interval_ms < 0)
+		c.interval_ms = 0;
+	if (c.order_mode != 1)
+		c.order_mode = 0;
+	if (c.order_mode < 0 || c.order_mode > 1)
+		c.order_mode = 0;
+
+	if (c.title.empty())
+		c.title = "Group";
+}
 
-		if (c.label.empty())
-			c.label = c.title.empty() ? c.id : c.title;
+// State read from a folder's lt-state.json, not installed anywhere yet.
+struct loaded_state {
+	std::vector<lower_third_cfg> items;
+	std::vector<group_cfg> groups;
+	std::vector<rule_cfg> rules;
+	file_stamp stamp;
+	bool parsed = false; // read from the JSON text: no snapshot mirrored it
+};
 
-		out.push_back(std::move(c));
-	}
+// Orders items/groups and drops duplicate group memberships. Touches no globals.
+static void order_loaded_state(loaded_state &st)
+{
+	std::vector<lower_third_cfg> &items = st.items;
+	std::vector<group_cfg> &groups = st.groups;
 
 	int nextOrder = 0;
-	for (auto &c : out) {
+	for (auto &c : items) {
 		if (c.order < 0)
 			c.order = nextOrder;
 		nextOrder = std::max(nextOrder, c.order + 1);
 	}
-	std::sort(out.begin(), out.end(), [](const lower_third_cfg &a, const lower_third_cfg &b) {
+	std::sort(items.begin(), items.end(), [](const lower_third_cfg &a, const lower_third_cfg &b) {
 		if (a.order != b.order)
 			return a.order < b.order;
 		return a.id < b.id;
 	});
 
-	std::vector<group_cfg> outCars;
-	outCars.reserve((size_t)cars.size());
-	for (const QJsonValue v : cars) {
-		if (!v.isObject())
-			continue;
-		const QJsonObject o = v.toObject();
-
-		group_cfg c;
-		c.id = sanitize_id(o.value("id").toString().toStdString());
-		if (c.id.empty())
-			c.id = new_id();
-
-		c.title = o.value("title").toString().toStdString();
-		c.order = o.value("order").toInt(-1);
-		c.order_mode = o.value("order_mode").toInt(0);
-		c.loop = o.value("loop").toBool(true);
-		c.exclusive = o.value("exclusive").toBool(false);
-		c.toggle_hotkey = o.value("toggle_hotkey").toString().toStdString();
-		if (c.toggle_hotkey.empty()) {
-			const QString start = o.value("start_hotkey").toString().trimmed();
-			const QString stop = o.value("stop_hotkey").toString().trimmed();
-			if (!start.isEmpty())
-				c.toggle_hotkey = start.toStdString();
-			else if (!stop.isEmpty())
-				c.toggle_hotkey = stop.toStdString();
-		}
-		if (c.toggle_hotkey.empty()) {
-			const QString fallback = hkGroups.value(QString::fromStdString(c.id)).toString();
-			if (!fallback.isEmpty())
-				c.toggle_hotkey = fallback.toStdString();
-		}
-
-		c.visible_ms = o.value("visible_ms").toInt(15000);
-		c.interval_ms = o.value("interval_ms").toInt(5000);
-		c.dock_color = o.value("dock_color").toString().toStdString();
-
-		if (c.visible_ms < 250)
-			c.visible_ms = 250;
-		if (c.interval_ms < 0)
-			c.interval_ms = 0;
-		if (c.order_mode != 1)
-			c.order_mode = 0;
-		if (c.order_mode < 0 || c.order_mode > 1)
-			c.order_mode = 0;
-
-		const QJsonArray mem = o.value("members").toArray();
-		for (const QJsonValue mv : mem) {
-			const std::string mid = sanitize_id(mv.toString().toStdString());
-			if (!mid.empty())
-				c.members.push_back(mid);
-		}
-
-		if (c.title.empty())
-			c.title = "Group";
-
-		outCars.push_back(std::move(c));
-	}
-
 	int nextCarOrder = 0;
-	for (auto &c : outCars) {
+	for (auto &c : groups) {
 		if (c.order < 0)
 			c.order = nextCarOrder;
 		nextCarOrder = std::max(nextCarOrder, c.order + 1);
 	}
-	std::sort(outCars.begin(), outCars.end(), [](const group_cfg &a, const group_cfg &b) {
+	std::sort(groups.begin(), groups.end(), [](const group_cfg &a, const group_cfg &b) {
 		if (a.order != b.order)
 			return a.order < b.order;
 		return a.id < b.id;
 	});
 
-	g_groups = std::move(outCars);
-
-	{
-		std::unordered_set<std::string> claimed;
-		for (auto &car : g_groups) {
-			std::vector<std::string> uniq;
-			uniq.reserve(car.members.size());
-			for (const auto &midRaw : car.members) {
-				const std::string mid = sanitize_id(midRaw);
-				if (mid.empty())
-					continue;
-				if (claimed.find(mid) != claimed.end())
-					continue;
-				claimed.insert(mid);
-				uniq.push_back(mid);
-			}
-			car.members = std::move(uniq);
+	std::unordered_set<std::string> claimed;
+	for (auto &car : groups) {
+		std::vector<std::string> uniq;
+		uniq.reserve(car.members.size());
+		for (const auto &midRaw : car.members) {
+			const std::string mid = sanitize_id(midRaw);
+			if (mid.empty())
+				continue;
+			if (claimed.find(mid) != claimed.end())
+				continue;
+			claimed.insert(mid);
+			uniq.push_back(mid);
 		}
+		car.members = std::move(uniq);
 	}
 
-	g_items = std::move(out);
-
-	for (const auto &car : g_groups) {
-		for (const auto &mid : car.members) {
-			if (auto *lt = get_by_id(mid)) {
-				lt->repeat_every_sec = 0;
-				lt->repeat_visible_sec = 0;
-			}
+	// Group members are shown by their group, not on their own.
+	for (auto &c : items) {
+		if (claimed.count(c.id)) {
+			c.repeat_every_sec = 0;
+			c.repeat_visible_sec = 0;
 		}
 	}
-	return true;
 }
 
-bool save_state_json()
+// Orders the loaded state and installs it as current state.
+static void finalize_loaded_state(loaded_state st)
 {
-	if (!has_output_dir())
-		return false;
+	order_loaded_state(st);
 
-	QJsonObject root;
-	root["version"] = 4;
+	g_rules = std::move(st.rules);
+	++g_rules_gen;
+	g_groups = std::move(st.groups);
+	g_items = std::move(st.items);
+	set_stamp(g_state_stamp, st.stamp);
 
-	QJsonArray items;
-	for (const auto &c : g_items) {
-		QJsonObject o;
-		o["id"] = QString::fromStdString(c.id);
-		o["label"] = QString::fromStdString(c.label);
-		o["order"] = c.order;
-		o["title"] = QString::fromStdString(c.title);
-		o["subtitle"] = QString::fromStdString(c.subtitle);
-		o["profile_picture"] = QString::fromStdString(c.profile_picture);
-		o["anim_in_sound"] = QString::fromStdString(c.anim_in_sound);
-		o["anim_out_sound"] = QString::fromStdString(c.anim_out_sound);
+	publish_rows_json();
+	history_rebase();
+}
 
-		o["title_size"] = c.title_size;
-		o["subtitle_size"] = c.subtitle_size;
-		o["avatar_width"] = c.avatar_width;
-		o["avatar_height"] = c.avatar_height;
+// Re-reads state/visibility only when their files were changed by someone else since we last touched them.
+void reload_if_changed_on_disk()
+{
+	const bool stateChanged = stamp_changed(path_state_json(), g_state_stamp);
+	if (stateChanged) {
+		LOGI("lt-state.json changed on disk; reloading");
+		load_state_json();
+		reset_history_after_external_load();
+	}
+	if (stateChanged || stamp_changed(path_visible_json(), g_visible_stamp))
+		load_visible_json();
+}
 
-		o["anim_in"] = QString::fromStdString(c.anim_in);
-		o["anim_out"] = QString::fromStdString(c.anim_out);
+// -------------------------
+// Template flyweights
+// -------------------------
+// The table holds weak references only: a body lives exactly as long as some item, dialog copy or
+// render snapshot uses it. Expired slots are dropped on lookup and swept whenever the table doubles.
 
-		o["font_family"] = QString::fromStdString(c.font_family);
-		o["lt_position"] = QString::fromStdString(c.lt_position);
+static std::mutex g_intern_mx;
+static std::unordered_multimap<uint64_t, std::weak_ptr<const std::string>> g_interned;
+static size_t g_intern_sweep_at = 64;
 
-		o["primary_color"] = QString::fromStdString(c.primary_color);
-		o["secondary_color"] = QString::fromStdString(c.secondary_color);
-		o["title_color"] = QString::fromStdString(c.title_color);
-		o["subtitle_color"] = QString::fromStdString(c.subtitle_color);
+// 'owned' (may be null) is moved into the new body on a miss; otherwise 'text' is copied.
+static std::shared_ptr<const std::string> intern_text(std::string_view text, std::string *owned)
+{
+	if (text.empty())
+		return nullptr;
 
-		o["bg_color"] = QString::fromStdString(c.primary_color);
-		o["text_color"] = QString::fromStdString(c.title_color);
-		o["opacity"] = c.opacity;
-		o["radius"] = c.radius;
+	const uint64_t h = fnv1a64(text.data(), text.size());
+	std::lock_guard<std::mutex> lk(g_intern_mx);
 
-		o["html_template"] = QString::fromStdString(c.html_template);
-		o["css_template"] = QString::fromStdString(c.css_template);
-		o["js_template"] = QString::fromStdString(c.js_template);
-		o["api_bridge_enabled"] = c.api_bridge_enabled;
-		o["api_template"] = QString::fromStdString(c.api_template);
+	auto range = g_interned.equal_range(h);
+	for (auto it = range.first; it != range.second;) {
+		if (auto body = it->second.lock()) {
+			if (*body == text)
+				return body;
+			++it;
+		} else {
+			it = g_interned.erase(it);
+		}
+	}
 
-		o["hotkey"] = QString::fromStdString(c.hotkey);
-		o["repeat_every_sec"] = c.repeat_every_sec;
-		o["repeat_visible_sec"] = c.repeat_visible_sec;
+	auto body = owned ? std::make_shared<const std::string>(std::move(*owned))
+			  : std::make_shared<const std::string>(text);
+	g_interned.emplace(h, body);
 
-		items.append(o);
+	if (g_interned.size() >= g_intern_sweep_at) {
+		for (auto it = g_interned.begin(); it != g_interned.end();)
+			it = it->second.expired() ? g_interned.erase(it) : std::next(it);
+		g_intern_sweep_at = std::max<size_t>(64, g_interned.size() * 2);
+		LOGD("Template intern table: %zu live bodies", g_interned.size());
 	}
+	return body;
+}
 
-	QJsonArray cars;
-	for (const auto &c : g_groups) {
-		QJsonObject o;
-		o["id"] = QString::fromStdString(c.id);
-		o["title"] = QString::fromStdString(c.title);
-		o["order"] = c.order;
-		o["order_mode"] = c.order_mode;
-		o["loop"] = c.loop;
-		o["exclusive"] = c.exclusive;
-		o["toggle_hotkey"] = QString::fromStdString(c.toggle_hotkey);
-		o["visible_ms"] = c.visible_ms;
-		o["interval_ms"] = c.interval_ms;
-		o["dock_color"] = QString::fromStdString(c.dock_color);
+std::shared_ptr<const std::string> intern_template(std::string s)
+{
+	const std::string_view view(s);
+	return intern_text(view, &s);
+}
+
+// -------------------------
+// Binary state snapshot (lt-state-<key>.bin)
+// -------------------------
+// Layout (native byte order; it is a local cache next to lt-state.json, never interchanged):
+//   header: magic "VFSB", u32 version, u64 json size, i64 json mtime (ms), u64 json FNV-1a,
+//           u32 item count, u32 group count, u32 rule count, u64 index checksum
+//   payload: items then groups then rules; strings are u32 length + bytes, small ints keep their packed
+//            width and colors are a u8 hex form + u32 RGBA (or form 0 + string). Template bodies are left
+//            in place and referenced by offset, so they are only decoded when first used.
+// Files are written once under a new name and renamed into place, so a snapshot is never torn. The index
+// checksum is FNV-1a over the header before it and the payload minus the template bodies (their length
+// prefixes are included): every field is verified on load, the bodies stay unread until used.
+
+static constexpr char kStateBinMagic[4] = {'V', 'F', 'S', 'B'};
+static constexpr uint32_t kStateBinVersion = 9;
+static constexpr size_t kStateBinHeaderSize = 4 + 4 + 8 + 8 + 8 + 4 + 4 + 4 + 8;
+
+struct state_blob {
+	QFile file;
+	uchar *data = nullptr;
+	qint64 size = 0;
+
+	~state_blob()
+	{
+		if (data)
+			file.unmap(data);
+	}
+};
+
+void template_text::materialize() const
+{
+	// Decoding straight into the intern table: a hit allocates nothing.
+	text_ = intern_text(std::string_view(reinterpret_cast<const char *>(blob_->data) + off_, len_), nullptr);
+	blob_.reset();
+}
+
+struct bin_writer {
+	std::string buf;
+	uint64_t sum = kFnv1a64Basis; // index checksum of buf up to 'mark'
+	size_t mark = 0;
+
+	template<typename T> void put(T v) { buf.append(reinterpret_cast<const char *>(&v), sizeof(v)); }
+	void put_str(const std::string &v)
+	{
+		put<uint32_t>((uint32_t)v.size());
+		buf.append(v);
+	}
+	// A template body: its length prefix is checksummed, the bytes are not.
+	void put_body(const std::string &v)
+	{
+		put<uint32_t>((uint32_t)v.size());
+		sum = fnv1a64(buf.data() + mark, buf.size() - mark, sum);
+		buf.append(v);
+		mark = buf.size();
+	}
+	uint64_t checksum() const { return fnv1a64(buf.data() + mark, buf.size() - mark, sum); }
+};
+
+struct bin_reader {
+	const uchar *base = nullptr;
+	size_t pos = 0;
+	size_t end = 0;
+	bool ok = true;
+
+	template<typename T> T get()
+	{
+		T v{};
+		if (!ok || end - pos < sizeof(T)) {
+			ok = false;
+			return v;
+		}
+		std::memcpy(&v, base + pos, sizeof(T));
+		pos += sizeof(T);
+		return v;
+	}
+
+	uint64_t sum = kFnv1a64Basis; // index checksum of the bytes up to 'mark'
+	size_t mark = 0;
+
+	// Returns the offset of a length-prefixed string and skips over it.
+	size_t skip_str(size_t &len)
+	{
+		len = get<uint32_t>();
+		if (!ok || end - pos < len) {
+			ok = false;
+			len = 0;
+			return pos;
+		}
+		const size_t off = pos;
+		pos += len;
+		return off;
+	}
+
+	std::string get_str() { return std::string(get_view()); }
+
+	// Valid while the mapping is; for values that are copied or interned right away.
+	std::string_view get_view()
+	{
+		size_t len = 0;
+		const size_t off = skip_str(len);
+		return ok ? std::string_view(reinterpret_cast<const char *>(base) + off, len) : std::string_view();
+	}
+
+	// skip_str() for a template body, which bin_writer::put_body() left out of the checksum.
+	size_t skip_body(size_t &len)
+	{
+		len = get<uint32_t>();
+		if (!ok || end - pos < len) {
+			ok = false;
+			len = 0;
+			return pos;
+		}
+		sum = fnv1a64(base + mark, pos - mark, sum);
+		const size_t off = pos;
+		pos += len;
+		mark = pos;
+		return off;
+	}
+	uint64_t checksum() const { return fnv1a64(base + mark, pos - mark, sum); }
+};
+
+static void put_color(bin_writer &w, const color_rgba &v)
+{
+	w.put<uint8_t>(v.hex_form());
+	if (v.hex_form())
+		w.put<uint32_t>(v.rgba());
+	else
+		w.put_str(v.str());
+}
+
+static color_rgba get_color(bin_reader &r)
+{
+	const uint8_t form = r.get<uint8_t>();
+	if (form)
+		return color_rgba::from_packed(r.get<uint32_t>(), form);
+	return color_rgba(r.get_view());
+}
+
+static void put_item(bin_writer &w, const lower_third_cfg &c, bool withTemplates = true)
+{
+	w.put_str(c.id);
+	w.put_str(c.label);
+	w.put<int32_t>(c.order);
+	w.put_str(c.title);
+	w.put_str(c.subtitle);
+	w.put_str(c.profile_picture);
+	w.put_str(c.profile_picture_source);
+	w.put_str(c.anim_in_sound);
+	w.put_str(c.anim_out_sound);
+	w.put<uint8_t>(c.title_size);
+	w.put<uint8_t>(c.subtitle_size);
+	w.put<uint16_t>(c.avatar_width);
+	w.put<uint16_t>(c.avatar_height);
+	w.put_str(c.anim_in);
+	w.put_str(c.anim_out);
+	w.put_str(c.font_family);
+	w.put_str(c.lt_position);
+	put_color(w, c.primary_color);
+	put_color(w, c.secondary_color);
+	put_color(w, c.title_color);
+	put_color(w, c.subtitle_color);
+	w.put<uint8_t>(c.opacity);
+	w.put<uint8_t>(c.radius);
+	if (withTemplates) {
+		w.put_body(c.html_template);
+		w.put_body(c.css_template);
+		w.put_body(c.js_template);
+	}
+	w.put<uint8_t>(c.api_bridge_enabled ? 1 : 0);
+	w.put_str(c.api_template);
+	w.put_str(c.hotkey);
+	w.put<int32_t>(c.repeat_every_sec);
+	w.put<int32_t>(c.repeat_visible_sec);
+	w.put<uint8_t>(c.instanced ? 1 : 0);
+	w.put<uint8_t>(c.native ? 1 : 0);
+	w.put_str(c.active_row);
+	w.put<uint32_t>((uint32_t)c.rows.size());
+	for (const auto &r : c.rows) {
+		w.put_str(r.id);
+		w.put_str(r.title);
+		w.put_str(r.subtitle);
+		w.put_str(r.profile_picture);
+	}
+}
+
+static lower_third_cfg get_item(bin_reader &r, const std::shared_ptr<const state_blob> &blob)
+{
+	auto lazy = [&r, &blob]() {
+		size_t len = 0;
+		const size_t off = r.skip_body(len);
+		return template_text(blob, off, len);
+	};
+
+	lower_third_cfg c;
+	c.id = r.get_str();
+	c.label = r.get_str();
+	c.order = r.get<int32_t>();
+	c.title = r.get_str();
+	c.subtitle = r.get_str();
+	c.profile_picture = r.get_str();
+	c.profile_picture_source = r.get_str();
+	c.anim_in_sound = r.get_str();
+	c.anim_out_sound = r.get_str();
+	c.title_size = r.get<uint8_t>();
+	c.subtitle_size = r.get<uint8_t>();
+	c.avatar_width = r.get<uint16_t>();
+	c.avatar_height = r.get<uint16_t>();
+	c.anim_in = r.get_view();
+	c.anim_out = r.get_view();
+	c.font_family = r.get_str();
+	c.lt_position = r.get_view();
+	c.primary_color = get_color(r);
+	c.secondary_color = get_color(r);
+	c.title_color = get_color(r);
+	c.subtitle_color = get_color(r);
+	c.opacity = r.get<uint8_t>();
+	c.radius = r.get<uint8_t>();
+	c.html_template = lazy();
+	c.css_template = lazy();
+	c.js_template = lazy();
+	c.api_bridge_enabled = r.get<uint8_t>() != 0;
+	c.api_template = r.get_str();
+	c.hotkey = r.get_str();
+	c.repeat_every_sec = r.get<int32_t>();
+	c.repeat_visible_sec = r.get<int32_t>();
+	c.instanced = r.get<uint8_t>() != 0;
+	c.native = r.get<uint8_t>() != 0;
+	c.active_row = r.get_str();
+	const uint32_t rowCount = r.get<uint32_t>();
+	// Each row takes at least four length prefixes; reject counts the payload cannot hold.
+	if (r.ok && rowCount <= (r.end - r.pos) / (4 * sizeof(uint32_t))) {
+		c.rows.resize(rowCount);
+		for (auto &row : c.rows) {
+			row.id = r.get_str();
+			row.title = r.get_str();
+			row.subtitle = r.get_str();
+			row.profile_picture = r.get_str();
+		}
+	} else {
+		r.ok = false;
+	}
+	return c;
+}
+
+static void put_group(bin_writer &w, const group_cfg &g)
+{
+	w.put_str(g.id);
+	w.put_str(g.title);
+	w.put<int32_t>(g.order);
+	w.put<int32_t>(g.order_mode);
+	w.put<uint8_t>(g.loop ? 1 : 0);
+	w.put<uint8_t>(g.exclusive ? 1 : 0);
+	w.put_str(g.toggle_hotkey);
+	w.put<int32_t>(g.visible_ms);
+	w.put<int32_t>(g.interval_ms);
+	w.put_str(g.dock_color);
+	w.put<uint32_t>((uint32_t)g.members.size());
+	for (const auto &m : g.members)
+		w.put_str(m);
+}
+
+static group_cfg get_group(bin_reader &r)
+{
+	group_cfg g;
+	g.id = r.get_str();
+	g.title = r.get_str();
+	g.order = r.get<int32_t>();
+	g.order_mode = r.get<int32_t>();
+	g.loop = r.get<uint8_t>() != 0;
+	g.exclusive = r.get<uint8_t>() != 0;
+	g.toggle_hotkey = r.get_str();
+	g.visible_ms = r.get<int32_t>();
+	g.interval_ms = r.get<int32_t>();
+	g.dock_color = r.get_str();
+	const uint32_t n = r.get<uint32_t>();
+	for (uint32_t i = 0; i < n && r.ok; ++i)
+		g.members.push_back(r.get_str());
+	return g;
+}
+
+static void put_rule(bin_writer &w, const rule_cfg &c)
+{
+	w.put_str(c.id);
+	w.put<uint8_t>(c.enabled ? 1 : 0);
+	w.put<uint8_t>((uint8_t)c.trigger);
+	w.put_str(c.scene);
+	w.put<uint8_t>((uint8_t)c.action);
+	w.put_str(c.target);
+	w.put<int32_t>(c.delay_ms);
+}
+
+static rule_cfg get_rule(bin_reader &r)
+{
+	rule_cfg c;
+	c.id = r.get_str();
+	c.enabled = r.get<uint8_t>() != 0;
+	c.trigger = (rule_trigger)r.get<uint8_t>();
+	c.scene = r.get_str();
+	c.action = (rule_action)r.get<uint8_t>();
+	c.target = r.get_str();
+	c.delay_ms = r.get<int32_t>();
+	return c;
+}
+
+// Removes the snapshots other than 'keep' (and the unversioned lt-state.bin of older releases). One that
+// is still mapped cannot be removed on Windows; it goes on a later pass.
+static void remove_stale_state_snapshots(const std::string &keep)
+{
+	const QDir d(QString::fromStdString(output_dir()));
+	for (const QString &n : d.entryList({QStringLiteral("lt-state*.bin")}, QDir::Files)) {
+		if (n.toStdString() != keep)
+			remove_output_file(n.toStdString());
+	}
+}
+
+// Writes the snapshot for the current state, keyed to the lt-state.json last loaded or saved.
+static bool write_state_snapshot()
+{
+	const file_stamp stamp = get_stamp(g_state_stamp);
+	if (!stamp.valid)
+		return false;
+
+	const std::string name = state_bin_name(stamp.size, stamp.mtime_ms);
+	const std::string path = join_path(output_dir(), name);
+	if (file_exists(path)) {
+		remove_stale_state_snapshots(name);
+		return true; // already mirrors this lt-state.json (possibly mapped right now)
+	}
+
+	bin_writer w;
+	w.buf.append(kStateBinMagic, sizeof(kStateBinMagic));
+	w.put<uint32_t>(kStateBinVersion);
+	w.put<uint64_t>((uint64_t)stamp.size);
+	w.put<int64_t>(stamp.mtime_ms);
+	w.put<uint64_t>(stamp.hash);
+	w.put<uint32_t>((uint32_t)g_items.size());
+	w.put<uint32_t>((uint32_t)g_groups.size());
+	w.put<uint32_t>((uint32_t)g_rules.size());
+
+	bin_writer payload;
+	payload.sum = w.checksum(); // the checksum runs on from the header into the payload
+	for (const auto &c : g_items)
+		put_item(payload, c);
+	for (const auto &g : g_groups)
+		put_group(payload, g);
+	for (const auto &c : g_rules)
+		put_rule(payload, c);
+
+	w.put<uint64_t>(payload.checksum());
+	w.buf.reserve(kStateBinHeaderSize + payload.buf.size());
+	w.buf.append(payload.buf);
+
+	if (!write_text_file_atomic(path, w.buf))
+		return false;
+	remove_stale_state_snapshots(name);
+	return true;
+}
+
+// Maps the snapshot of dir's lt-state.json into 'out' if it still matches.
+static bool load_state_snapshot(const std::string &dir, loaded_state &out)
+{
+	const QFileInfo jsonInfo(QString::fromStdString(join_path(dir, "lt-state.json")));
+	const QString binPath = QString::fromStdString(state_bin_path(dir));
+	if (!jsonInfo.exists() || binPath.isEmpty() || !QFile::exists(binPath))
+		return false;
+
+	const auto t0 = std::chrono::steady_clock::now();
+
+	auto blob = std::make_shared<state_blob>();
+	blob->file.setFileName(binPath);
+	if (!blob->file.open(QIODevice::ReadOnly))
+		return false;
+	blob->size = blob->file.size();
+	if (blob->size < (qint64)kStateBinHeaderSize)
+		return false;
+	blob->data = blob->file.map(0, blob->size);
+	if (!blob->data)
+		return false;
+
+	bin_reader r;
+	r.base = blob->data;
+	r.end = (size_t)blob->size;
+
+	if (std::memcmp(r.base, kStateBinMagic, sizeof(kStateBinMagic)) != 0)
+		return false;
+	r.pos = sizeof(kStateBinMagic);
+
+	const uint32_t version = r.get<uint32_t>();
+	const uint64_t jsonSize = r.get<uint64_t>();
+	const int64_t jsonMtime = r.get<int64_t>();
+	const uint64_t jsonHash = r.get<uint64_t>();
+	const uint32_t itemCount = r.get<uint32_t>();
+	const uint32_t groupCount = r.get<uint32_t>();
+	const uint32_t ruleCount = r.get<uint32_t>();
+	r.sum = r.checksum();
+	const uint64_t checksum = r.get<uint64_t>();
+	r.mark = r.pos;
+
+	if (version != kStateBinVersion)
+		return false;
+	if (jsonSize != (uint64_t)jsonInfo.size() || jsonMtime != (int64_t)jsonInfo.lastModified().toMSecsSinceEpoch())
+		return false;
+
+	std::vector<lower_third_cfg> items;
+	items.reserve(itemCount);
+	for (uint32_t i = 0; i < itemCount && r.ok; ++i) {
+		lower_third_cfg c = get_item(r, blob);
+		normalize_loaded_item(c);
+		items.push_back(std::move(c));
+	}
+
+	std::vector<group_cfg> groups;
+	groups.reserve(groupCount);
+	for (uint32_t i = 0; i < groupCount && r.ok; ++i) {
+		group_cfg g = get_group(r);
+		normalize_loaded_group(g);
+		groups.push_back(std::move(g));
+	}
+
+	std::vector<rule_cfg> rules;
+	rules.reserve(ruleCount);
+	for (uint32_t i = 0; i < ruleCount && r.ok; ++i)
+		rules.push_back(get_rule(r));
+
+	if (!r.ok || r.pos != r.end) {
+		LOGW("%s is truncated or malformed; falling back to lt-state.json", binPath.toUtf8().constData());
+		return false;
+	}
+	if (r.checksum() != checksum) {
+		LOGW("%s fails its checksum; falling back to lt-state.json", binPath.toUtf8().constData());
+		return false;
+	}
+
+	out.items = std::move(items);
+	out.groups = std::move(groups);
+	out.rules = std::move(rules);
+	out.stamp = file_stamp{true, (int64_t)jsonSize, jsonMtime, jsonHash};
+
+	const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0);
+	LOGD("Loaded state snapshot: %u items, %u groups, %lld bytes in %lld ms", itemCount, groupCount,
+	     (long long)blob->size, (long long)ms.count());
+	return true;
+}
+
+// Reads dir's lt-state.json (or its snapshot) into 'out' without touching the live state. A missing or
+// empty file reads as empty state; false when the file is not valid JSON ('out' is empty then).
+static bool read_state_files(const std::string &dir, loaded_state &out)
+{
+	const std::string p = join_path(dir, "lt-state.json");
+	if (!QFile::exists(QString::fromStdString(p)))
+		return true;
+
+	if (load_state_snapshot(dir, out))
+		return true;
+
+	const std::string txt = read_text_file(p);
+	out.stamp = stamp_written_file(p, fnv1a64(txt.data(), txt.size()));
+	if (txt.empty())
+		return true;
+
+	QJsonParseError err{};
+	const QJsonDocument doc = QJsonDocument::fromJson(QByteArray::fromStdString(txt), &err);
+	if (err.error != QJsonParseError::NoError || !doc.isObject()) {
+		LOGW("Invalid %s; reset", p.c_str());
+		return false;
+	}
+
+	const QJsonObject root = doc.object();
+	const QJsonObject hkRoot = root.value("hotkeys").toObject();
+	const QJsonObject hkItems = hkRoot.value("items").toObject();
+	const QJsonObject hkGroups = hkRoot.value("groups").toObject();
+
+	const QJsonArray items = root.value("items").toArray();
+	const QJsonArray cars = root.contains("groups") ? root.value("groups").toArray() : root.value("carousels").toArray();
+
+	std::vector<lower_third_cfg> outItems;
+	outItems.reserve((size_t)items.size());
+
+	for (const QJsonValue v : items) {
+		if (!v.isObject())
+			continue;
+		const QJsonObject o = v.toObject();
+
+		lower_third_cfg c;
+		c.id = sanitize_id(o.value("id").toString().toStdString());
+		if (c.id.empty())
+			c.id = new_id();
+
+		c.label = o.value("label").toString().toStdString();
+		c.order = o.value("order").toInt(-1);
+
+		c.title = o.value("title").toString().toStdString();
+		c.subtitle = o.value("subtitle").toString().toStdString();
+		c.profile_picture = o.value("profile_picture").toString().toStdString();
+		c.profile_picture_source = o.value("profile_picture_source").toString().toStdString();
+		c.anim_in_sound = o.value("anim_in_sound").toString().toStdString();
+		c.anim_out_sound = o.value("anim_out_sound").toString().toStdString();
+
+		c.title_size = font_px_from(o.value("title_size").toInt(46));
+		c.subtitle_size = font_px_from(o.value("subtitle_size").toInt(24));
+
+		c.avatar_width = avatar_px_from(o.value("avatar_width").toInt(100));
+		c.avatar_height = avatar_px_from(o.value("avatar_height").toInt(100));
+
+		c.anim_in = o.value("anim_in").toString().toStdString();
+		c.anim_out = o.value("anim_out").toString().toStdString();
+
+		c.font_family = o.value("font_family").toString().toStdString();
+		c.lt_position = o.value("lt_position").toString().toStdString();
+
+		c.primary_color = o.value("primary_color").toString().toStdString();
+		c.secondary_color = o.value("secondary_color").toString().toStdString();
+		c.title_color = o.value("title_color").toString().toStdString();
+		c.subtitle_color = o.value("subtitle_color").toString().toStdString();
+
+		if (c.primary_color.empty())
+			c.primary_color = o.value("bg_color").toString().toStdString();
+		if (c.title_color.empty())
+			c.title_color = o.value("text_color").toString().toStdString();
+		c.opacity = percent_from(o.value("opacity").toInt(0), 85);
+		c.radius = percent_from(o.value("radius").toInt(0), 5);
+
+		c.html_template = o.value("html_template").toString().toStdString();
+		c.css_template = o.value("css_template").toString().toStdString();
+		c.js_template = o.value("js_template").toString().toStdString();
+		c.api_template = o.value("api_template").toString().toStdString();
+		c.api_bridge_enabled = o.value("api_bridge_enabled").toBool(o.value("api_bridge").toBool(false));
+		// Backward compatibility: if a legacy api_template exists and no explicit flag was set, assume enabled.
+		if (!o.contains("api_bridge_enabled") && !o.contains("api_bridge")) {
+			if (!QString::fromStdString(c.api_template).trimmed().isEmpty())
+				c.api_bridge_enabled = true;
+		}
+
+
+		c.hotkey = o.value("hotkey").toString().toStdString();
+		if (c.hotkey.empty()) {
+			const QString k = hkItems.value(QString::fromStdString(c.id)).toString().trimmed();
+			if (!k.isEmpty())
+				c.hotkey = k.toStdString();
+		}
+		if (c.hotkey.empty()) {
+			const QString fallback = hkItems.value(QString::fromStdString(c.id)).toString();
+			if (!fallback.isEmpty())
+				c.hotkey = fallback.toStdString();
+		}
+		c.repeat_every_sec = o.value("repeat_every_sec").toInt(0);
+		c.repeat_visible_sec = o.value("repeat_visible_sec").toInt(0);
+
+		c.instanced = o.value("instanced").toBool(false);
+		c.native = o.value("native").toBool(false);
+		c.active_row = o.value("active_row").toString().toStdString();
+		const QJsonArray rowsArr = o.value("rows").toArray();
+		c.rows.reserve((size_t)rowsArr.size());
+		for (const QJsonValue rv : rowsArr) {
+			if (!rv.isObject())
+				continue;
+			const QJsonObject ro = rv.toObject();
+			data_row r;
+			r.id = ro.value("id").toString().toStdString();
+			r.title = ro.value("title").toString().toStdString();
+			r.subtitle = ro.value("subtitle").toString().toStdString();
+			r.profile_picture = ro.value("profile_picture").toString().toStdString();
+			c.rows.push_back(std::move(r));
+		}
+
+		normalize_loaded_item(c);
+
+		outItems.push_back(std::move(c));
+	}
+
+	std::vector<group_cfg> outCars;
+	outCars.reserve((size_t)cars.size());
+	for (const QJsonValue v : cars) {
+		if (!v.isObject())
+			continue;
+		const QJsonObject o = v.toObject();
+
+		group_cfg c;
+		c.id = sanitize_id(o.value("id").toString().toStdString());
+		if (c.id.empty())
+			c.id = new_id();
+
+		c.title = o.value("title").toString().toStdString();
+		c.order = o.value("order").toInt(-1);
+		c.order_mode = o.value("order_mode").toInt(0);
+		c.loop = o.value("loop").toBool(true);
+		c.exclusive = o.value("exclusive").toBool(false);
+		c.toggle_hotkey = o.value("toggle_hotkey").toString().toStdString();
+		if (c.toggle_hotkey.empty()) {
+			const QString start = o.value("start_hotkey").toString().trimmed();
+			const QString stop = o.value("stop_hotkey").toString().trimmed();
+			if (!start.isEmpty())
+				c.toggle_hotkey = start.toStdString();
+			else if (!stop.isEmpty())
+				c.toggle_hotkey = stop.toStdString();
+		}
+		if (c.toggle_hotkey.empty()) {
+			const QString fallback = hkGroups.value(QString::fromStdString(c.id)).toString();
+			if (!fallback.isEmpty())
+				c.toggle_hotkey = fallback.toStdString();
+		}
+
+		c.visible_ms = o.value("visible_ms").toInt(15000);
+		c.interval_ms = o.value("interval_ms").toInt(5000);
+		c.dock_color = o.value("dock_color").toString().toStdString();
+
+		const QJsonArray mem = o.value("members").toArray();
+		for (const QJsonValue mv : mem) {
+			const std::string mid = sanitize_id(mv.toString().toStdString());
+			if (!mid.empty())
+				c.members.push_back(mid);
+		}
+
+		normalize_loaded_group(c);
+		outCars.push_back(std::move(c));
+	}
+
+	std::vector<rule_cfg> outRules;
+	for (const QJsonValue v : root.value("rules").toArray()) {
+		const QJsonObject o = v.toObject();
+		rule_cfg c;
+		c.id = sanitize_id(o.value("id").toString().toStdString());
+		if (c.id.empty())
+			c.id = new_id();
+		c.enabled = o.value("enabled").toBool(true);
+		c.scene = o.value("scene").toString().toStdString();
+		c.target = sanitize_id(o.value("target").toString().toStdString());
+		c.delay_ms = std::max(0, o.value("delay_ms").toInt(0));
+		if (!rule_trigger_from_name(o.value("trigger").toString().toStdString(), c.trigger) ||
+		    !rule_action_from_name(o.value("action").toString().toStdString(), c.action)) {
+			LOGW("Ignoring rule '%s' with an unknown trigger or action", c.id.c_str());
+			continue;
+		}
+		outRules.push_back(std::move(c));
+	}
+
+	out.items = std::move(outItems);
+	out.groups = std::move(outCars);
+	out.rules = std::move(outRules);
+	out.parsed = true;
+	return true;
+}
+
+bool load_state_json()
+{
+	if (!has_output_dir())
+		return false;
 
-		QJsonArray mem;
+	loaded_state st;
+	const bool ok = read_state_files(output_dir(), st);
+	const bool parsed = st.parsed;
+	finalize_loaded_state(std::move(st));
+	if (parsed)
+		write_state_snapshot();
+	return ok;
+}
+
+// Streams the lt-state.json document straight into buf: no QJsonObject tree, no intermediate
+// QByteArray/std::string copies of the whole document.
+static void write_state_json(out_buffer &buf, const std::vector<lower_third_cfg> &items,
+			     const std::vector<group_cfg> &groups, const std::vector<rule_cfg> &rules)
+{
+	json_writer w(buf);
+
+	w.begin_object();
+	w.field("version", 4);
+
+	w.key("groups");
+	w.begin_array();
+	for (const auto &c : groups) {
+		w.begin_object();
+		w.field("id", c.id);
+		w.field("title", c.title);
+		w.field("order", c.order);
+		w.field("order_mode", c.order_mode);
+		w.field("loop", c.loop);
+		w.field("exclusive", c.exclusive);
+		w.field("toggle_hotkey", c.toggle_hotkey);
+		w.field("visible_ms", c.visible_ms);
+		w.field("interval_ms", c.interval_ms);
+		w.field("dock_color", c.dock_color);
+
+		w.key("members");
+		w.begin_array();
 		for (const auto &mid : c.members)
-			mem.append(QString::fromStdString(mid));
-		o["members"] = mem;
+			w.value(mid);
+		w.end_array();
 
-		cars.append(o);
+		w.end_object();
+	}
+	w.end_array();
+
+	// Omitted when empty, so files without rules keep their shape.
+	if (!rules.empty()) {
+		w.key("rules");
+		w.begin_array();
+		for (const auto &c : rules) {
+			w.begin_object();
+			w.field("id", c.id);
+			w.field("enabled", c.enabled);
+			w.field("trigger", rule_trigger_name(c.trigger));
+			w.field("scene", c.scene);
+			w.field("action", rule_action_name(c.action));
+			w.field("target", c.target);
+			w.field("delay_ms", c.delay_ms);
+			w.end_object();
+		}
+		w.end_array();
 	}
-	root["groups"] = cars;
 
-	root["items"] = items;
+	w.key("items");
+	w.begin_array();
+	for (const auto &c : items) {
+		w.begin_object();
+		w.field("id", c.id);
+		w.field("label", c.label);
+		w.field("order", c.order);
+		w.field("title", c.title);
+		w.field("subtitle", c.subtitle);
+		w.field("profile_picture", c.profile_picture);
+		if (!c.profile_picture_source.empty())
+			w.field("profile_picture_source", c.profile_picture_source);
+		w.field("anim_in_sound", c.anim_in_sound);
+		w.field("anim_out_sound", c.anim_out_sound);
+
+		w.field("title_size", (int)c.title_size);
+		w.field("subtitle_size", (int)c.subtitle_size);
+		w.field("avatar_width", (int)c.avatar_width);
+		w.field("avatar_height", (int)c.avatar_height);
+
+		w.field("anim_in", c.anim_in.str());
+		w.field("anim_out", c.anim_out.str());
+
+		w.field("font_family", c.font_family);
+		w.field("lt_position", c.lt_position.str());
+
+		const std::string primary = c.primary_color.str();
+		const std::string title = c.title_color.str();
+		w.field("primary_color", primary);
+		w.field("secondary_color", c.secondary_color.str());
+		w.field("title_color", title);
+		w.field("subtitle_color", c.subtitle_color.str());
+
+		w.field("bg_color", primary);
+		w.field("text_color", title);
+		w.field("opacity", (int)c.opacity);
+		w.field("radius", (int)c.radius);
+
+		w.field("html_template", c.html_template.str());
+		w.field("css_template", c.css_template.str());
+		w.field("js_template", c.js_template.str());
+		w.field("api_bridge_enabled", c.api_bridge_enabled);
+		w.field("api_template", c.api_template);
+
+		w.field("hotkey", c.hotkey);
+		w.field("repeat_every_sec", c.repeat_every_sec);
+		w.field("repeat_visible_sec", c.repeat_visible_sec);
+
+		if (c.native)
+			w.field("native", true);
+
+		// Regular items keep their exact pre-instancing shape.
+		if (c.instanced || !c.rows.empty()) {
+			w.field("instanced", c.instanced);
+			w.field("active_row", c.active_row);
+			w.key("rows");
+			w.begin_array();
+			for (const auto &r : c.rows) {
+				w.begin_object();
+				w.field("id", r.id);
+				w.field("title", r.title);
+				w.field("subtitle", r.subtitle);
+				w.field("profile_picture", r.profile_picture);
+				w.end_object();
+			}
+			w.end_array();
+		}
+		w.end_object();
+	}
+	w.end_array();
 
-	QJsonObject hkRoot;
-	QJsonObject hkItems;
-	for (const auto &c : g_items) {
+	w.key("hotkeys");
+	w.begin_object();
+	w.key("items");
+	w.begin_object();
+	for (const auto &c : items) {
 		if (!c.hotkey.empty())
-			hkItems[QString::fromStdString(c.id)] = QString::fromStdString(c.hotkey);
+			w.field(c.id, c.hotkey);
 	}
-	QJsonObject hkGroups;
-	for (const auto &g : g_groups) {
+	w.end_object();
+	w.key("groups");
+	w.begin_object();
+	for (const auto &g : groups) {
 		if (!g.toggle_hotkey.empty())
-			hkGroups[QString::fromStdString(g.id)] = QString::fromStdString(g.toggle_hotkey);
+			w.field(g.id, g.toggle_hotkey);
 	}
-	hkRoot["items"] = hkItems;
-	hkRoot["groups"] = hkGroups;
-	root["hotkeys"] = hkRoot;
+	w.end_object();
+	w.end_object();
 
-	const QJsonDocument doc(root);
-	return write_text_file(path_state_json(), doc.toJson(QJsonDocument::Indented).toStdString());
+	w.end_object();
+	buf << '\n';
 }
 
-bool load_visible_json()
+bool save_state_json()
 {
 	if (!has_output_dir())
 		return false;
 
-	const std::string p = path_visible_json();
-	if (!QFile::exists(QString::fromStdString(p))) {
-		g_visible.clear();
+	const auto t0 = std::chrono::steady_clock::now();
+
+	out_buffer buf;
+	write_state_json(buf, g_items, g_groups, g_rules);
+
+	if (!write_buffer_atomic(buf, path_state_json()))
+		return false;
+	set_stamp(g_state_stamp, stamp_written_file(path_state_json(), buf.hash()));
+
+	const auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t0);
+	LOGD("Saved lt-state.json: %zu items, %zu bytes in %lld us (%llu chunk allocations)", g_items.size(),
+	     buf.size(), (long long)us.count(), (unsigned long long)buf.allocations());
+
+	// Before the snapshot rewrite, so baseline copies of loaded items let go of the old mapping first.
+	history_capture();
+	write_state_snapshot();
+	publish_rows_json();
+	return true;
+}
+
+// Reads dir's lt-visible.json, keeping the ids of 'items'. False when the file is not valid JSON.
+static bool read_visible_json(const std::string &dir, const std::vector<lower_third_cfg> &items,
+			      std::vector<std::string> &out, file_stamp &stamp)
+{
+	out.clear();
+	stamp = {};
+	const std::string p = join_path(dir, "lt-visible.json");
+	if (!QFile::exists(QString::fromStdString(p)))
 		return true;
-	}
 
 	const std::string txt = read_text_file(p);
-	if (txt.empty()) {
-		g_visible.clear();
+	stamp = stamp_written_file(p, fnv1a64(txt.data(), txt.size()));
+	if (txt.empty())
 		return true;
-	}
 
 	QJsonParseError err{};
 	const QJsonDocument doc = QJsonDocument::fromJson(QByteArray::fromStdString(txt), &err);
 	if (err.error != QJsonParseError::NoError) {
-		LOGW("Invalid lt-visible.json; reset");
-		g_visible.clear();
+		LOGW("Invalid %s; reset", p.c_str());
 		return false;
 	}
+	if (!doc.isArray())
+		return true;
 
-	std::vector<std::string> ids;
-	if (doc.isArray()) {
-		const QJsonArray a = doc.array();
-		for (const QJsonValue v : a) {
-			if (v.isString())
-				ids.push_back(sanitize_id(v.toString().toStdString()));
-		}
+	std::unordered_set<std::string> known;
+	known.reserve(items.size());
+	for (const auto &c : items)
+		known.insert(c.id);
+
+	for (const QJsonValue v : doc.array()) {
+		if (!v.isString())
+			continue;
+		std::string id = sanitize_id(v.toString().toStdString());
+		if (known.count(id))
+			out.push_back(std::move(id));
 	}
+	return true;
+}
 
-	std::vector<std::string> keep;
-	keep.reserve(ids.size());
-	for (const auto &id : ids)
-		if (get_by_id(id))
-			keep.push_back(id);
+bool load_visible_json()
+{
+	if (!has_output_dir())
+		return false;
 
-	g_visible = std::move(keep);
-	return true;
+	std::vector<std::string> ids;
+	file_stamp stamp;
+	const bool ok = read_visible_json(output_dir(), g_items, ids, stamp);
+	g_visible = std::move(ids);
+	set_stamp(g_visible_stamp, stamp);
+	return ok;
 }
 
 bool save_visible_json()
@@ -2028,80 +3638,150 @@ bool save_visible_json()
 		a.append(QString::fromStdString(id));
 
 	const QJsonDocument doc(a);
-	return write_text_file(path_visible_json(), doc.toJson(QJsonDocument::Indented).toStdString());
-}
-
-static bool regenerate_merged_css_js(const std::string &ts, std::string &outCssFile, std::string &outJsFile)
-{
-	if (!has_output_dir())
+	const std::string txt = doc.toJson(QJsonDocument::Indented).toStdString();
+	if (!write_text_file(path_visible_json(), txt))
 		return false;
 
-	outCssFile = bundle_styles_name(ts);
-	outJsFile = bundle_scripts_name(ts);
-
-	std::string css;
-	css += build_shared_css();
+	set_stamp(g_visible_stamp, stamp_written_file(path_visible_json(), fnv1a64(txt.data(), txt.size())));
+	return true;
+}
 
-	css += R"CSS(
+// -------------------------
+// Folder state (profiles)
+// -------------------------
 
-/* Position classes */
-.lt-pos-bottom-left  {
-  left: var(--slt-safe-margin);
-  bottom: var(--slt-safe-margin);
+void take_live_state(folder_state &out)
+{
+	out.dir = g_output_dir;
+	out.items = std::move(g_items);
+	out.groups = std::move(g_groups);
+	out.rules = std::move(g_rules);
+	out.visible = std::move(g_visible);
+	out.state_stamp = get_stamp(g_state_stamp);
+	out.visible_stamp = get_stamp(g_visible_stamp);
+	out.rows_hash = g_rows_hash;
+
+	g_items.clear();
+	g_groups.clear();
+	g_rules.clear();
+	g_visible.clear();
+	set_stamp(g_state_stamp, {});
+	set_stamp(g_visible_stamp, {});
+	g_rows_hash = 0;
 }
 
-.lt-pos-bottom-right {
-  right: var(--slt-safe-margin);
-  bottom: var(--slt-safe-margin);
+void install_live_state(folder_state &s)
+{
+	g_items = std::move(s.items);
+	g_groups = std::move(s.groups);
+	g_rules = std::move(s.rules);
+	++g_rules_gen;
+	g_visible = std::move(s.visible);
+	set_stamp(g_state_stamp, s.state_stamp);
+	set_stamp(g_visible_stamp, s.visible_stamp);
+	g_rows_hash = s.rows_hash;
 }
 
-.lt-pos-top-left {
-  left: var(--slt-safe-margin);
-  top: var(--slt-safe-margin);
+bool read_folder_state(const std::string &dir, folder_state &out)
+{
+	loaded_state st;
+	if (!read_state_files(dir, st))
+		return false;
+	order_loaded_state(st);
+
+	out.dir = dir;
+	out.items = std::move(st.items);
+	out.groups = std::move(st.groups);
+	out.rules = std::move(st.rules);
+	out.state_stamp = st.stamp;
+	read_visible_json(dir, out.items, out.visible, out.visible_stamp);
+	return true;
 }
 
-.lt-pos-top-right {
-  right: var(--slt-safe-margin);
-  top: var(--slt-safe-margin);
+bool live_files_changed_since(folder_state &s)
+{
+	return file_changed_since(path_state_json(), s.state_stamp) ||
+	       file_changed_since(path_visible_json(), s.visible_stamp);
 }
 
-.lt-pos-center {
-  left: 50%;
-  top: 50%;
-  transform: translate(-50%, -50%);
+static std::string build_position_css()
+{
+	std::string css = "\n\n/* Position classes */\n";
+	for (const auto &r : kPositionRules) {
+		css += '.';
+		css += r.cls;
+		css += " {\n  ";
+		css += r.decls;
+		css += "\n}\n\n";
+	}
+	return css;
 }
 
-.lt-pos-top-center {
-  left: 50%;
-  top: var(--slt-safe-margin);
-  transform: translateX(-50%);
+// The current layout settings, without a folder or items. UI thread.
+render_snapshot render_layout()
+{
+	render_snapshot snap;
+	snap.shard_by_position = g_shard_by_position;
+	snap.frame_width = g_target_browser_width;
+	snap.frame_height = g_target_browser_height;
+	snap.variants = g_output_variants;
+	return snap;
 }
 
-.lt-pos-bottom-center {
-  left: 50%;
-  bottom: var(--slt-safe-margin);
-  transform: translateX(-50%);
-}
+// 'layout' rendering 'items' into 'dir'. Materializes the items' templates, so call it on the thread
+// that owns them (the UI thread for the live state).
+render_snapshot render_snapshot_of(render_snapshot layout, const std::string &dir,
+				   const std::vector<lower_third_cfg> &items)
+{
+	// Workers read templates concurrently, so decode any still-mapped bodies here first.
+	for (const auto &c : items) {
+		(void)c.html_template.str();
+		(void)c.css_template.str();
+		(void)c.js_template.str();
+	}
 
-)CSS";
+	render_snapshot snap = std::move(layout);
+	snap.output_dir = dir;
+	// Native items are drawn by their own sources (native_source.hpp), not by the page.
+	snap.items.reserve(items.size());
+	for (const auto &c : items) {
+		if (!c.native)
+			snap.items.push_back(c);
+	}
 
-	css += "\n/* Per-LT scoped styles */\n";
+	snap.local_animate_css = file_exists(join_path(dir, "animate.min.css"));
+	if (snap.local_animate_css)
+		LOGI("Using local animate.min.css");
+	else
+		LOGI("Using CDN animate.css (local animate.min.css not found)");
 
-	std::unordered_map<std::string, std::string> kfNameToNorm;
-	std::unordered_map<std::string, std::string> kfNameToBlock;
-	std::vector<std::string> kfOrder;
+	return snap;
+}
 
-	for (const auto &c : g_items) {
+// Snapshot of 'items' rendering into 'dir' with the current layout settings.
+static render_snapshot render_snapshot_of(const std::string &dir, const std::vector<lower_third_cfg> &items)
+{
+	return render_snapshot_of(render_layout(), dir, items);
+}
 
-		std::string per = c.css_template;
+static render_snapshot take_render_snapshot()
+{
+	return render_snapshot_of(output_dir(), g_items);
+}
 
-		const auto repl = build_placeholder_map(c);
-		per = replace_placeholders(std::move(per), repl);
+// Folds every item's extracted keyframes into one deduped set, in item order. Same-named blocks with
+// different bodies are renamed per item; the renames are recorded so phase 3 can patch that item's CSS.
+static void dedupe_keyframes(const render_snapshot &snap, std::vector<item_render> &parts,
+			     std::vector<std::string> &kfOrder,
+			     std::unordered_map<std::string, std::string> &kfNameToBlock)
+{
+	std::unordered_map<std::string, std::string> kfNameToNorm;
 
-		std::vector<extracted_keyframes> extracted;
-		extract_keyframes_blocks(per, extracted);
+	for (size_t i = 0; i < parts.size(); ++i) {
+		const lower_third_cfg &c = snap.items[i];
+		item_render &part = parts[i];
 
-		for (auto &kf : extracted) {
+		for (auto &kf : part.keyframes) {
 
 			if (kf.name.empty()) {
 				const std::string sig = kf.norm;
@@ -2145,19 +3825,117 @@ static bool regenerate_merged_css_js(const std::string &ts, std::string &outCssF
 			kf.name = newName;
 			kf.norm = normalize_ws_no_space(kf.block);
 
-			per = replace_whole_ident(per, oldName, newName);
+			part.kf_renames.emplace_back(oldName, newName);
 
 			kfNameToNorm[kf.name] = kf.norm;
 			kfNameToBlock[kf.name] = kf.block;
 			kfOrder.push_back(kf.name);
 		}
+	}
+}
+
+// Renders lt.css / lt.js / lt.html from a snapshot. Per-item work (placeholder substitution, CSS
+// scoping, script wrapping) runs on the worker pool; keyframe dedupe and concatenation stay serial
+// and in item order, so the output is byte-identical to a serial render. The phase-1 cache belongs to the
+// live folder: Merge keeps the entries of items outside the snapshot (shards render the items in several
+// passes), Off neither reads nor updates it (another folder's state).
+enum class phase1_use { Replace, Merge, Off };
+
+static void render_bundle(const render_snapshot &snap, const std::string &ts, rendered_bundle &out,
+			  phase1_use cacheUse = phase1_use::Replace)
+{
+	const auto t0 = std::chrono::steady_clock::now();
+	const size_t n = snap.items.size();
+	std::vector<item_render> parts(n);
+
+	phase1_cache prev;
+	if (cacheUse != phase1_use::Off) {
+		std::lock_guard<std::mutex> lk(g_phase1_mx);
+		prev = g_phase1_cache;
+	}
+	std::vector<std::shared_ptr<const item_phase1>> phase1(n);
+	std::atomic<size_t> reused{0};
+
+	// Phase 1 (parallel): substitute placeholders, pull keyframes out of the CSS, build script + markup.
+	// Templates were materialized by take_render_snapshot, so shared() only reads here.
+	parallel_for(n, [&](size_t i) {
+		const lower_third_cfg &c = snap.items[i];
+		item_render &part = parts[i];
+		auto repl = build_placeholder_map(c);
+
+		auto hit = prev.find(c.id);
+		if (hit != prev.end() && hit->second->matches(c, repl)) {
+			const item_phase1 &p = *hit->second;
+			part.css = p.css;
+			part.keyframes = p.keyframes;
+			part.script.append(p.script);
+			part.html.append(p.html);
+			phase1[i] = hit->second;
+			reused.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
 
-		lower_third_cfg tmp = c;
-		tmp.css_template = per;
-		css += "\n" + scope_css_best_effort(tmp);
+		auto p = std::make_shared<item_phase1>();
+		p->html_tpl = c.html_template.shared();
+		p->css_tpl = c.css_template.shared();
+		p->js_tpl = c.js_template.shared();
+		p->lt_position = c.lt_position;
+		p->instanced = c.instanced;
+
+		p->css = replace_placeholders(c.css_template, repl);
+		extract_keyframes_blocks(p->css, p->keyframes);
+
+		build_item_script(c, repl, part.script);
+		build_item_html(c, repl, part.html);
+
+		part.css = p->css;
+		part.keyframes = p->keyframes;
+		p->script = part.script.str();
+		p->html = part.html.str();
+		p->repl = std::move(repl);
+		phase1[i] = std::move(p);
+	}, snap.workers);
+
+	if (cacheUse == phase1_use::Merge) {
+		std::lock_guard<std::mutex> lk(g_phase1_mx);
+		for (size_t i = 0; i < n; ++i)
+			g_phase1_cache[snap.items[i].id] = std::move(phase1[i]);
+	} else if (cacheUse == phase1_use::Replace) {
+		phase1_cache next;
+		next.reserve(n);
+		for (size_t i = 0; i < n; ++i)
+			next.emplace(snap.items[i].id, std::move(phase1[i]));
+		std::lock_guard<std::mutex> lk(g_phase1_mx);
+		g_phase1_cache.swap(next);
 	}
 
-	css += "\n/* Keyframes (deduped) */\n";
+	// Phase 2 (serial): keyframe dedupe depends on every earlier item.
+	std::vector<std::string> kfOrder;
+	std::unordered_map<std::string, std::string> kfNameToBlock;
+	dedupe_keyframes(snap, parts, kfOrder, kfNameToBlock);
+
+	// Phase 3 (parallel): apply keyframe renames and scope selectors to the item id.
+	parallel_for(n, [&](size_t i) {
+		const lower_third_cfg &c = snap.items[i];
+		item_render &part = parts[i];
+
+		std::string per = std::move(part.css);
+		for (const auto &rn : part.kf_renames)
+			per = replace_whole_ident(per, rn.first, rn.second);
+
+		part.scoped_css = scope_css_best_effort(c, std::move(per), build_placeholder_map(c));
+	}, snap.workers);
+
+	// Ordered concatenation straight into the output buffers; per-item buffers are spliced, not copied.
+	out_buffer &css = out.css;
+	css << build_shared_css();
+	css << build_position_css();
+
+	css << "\n/* Per-LT scoped styles */\n";
+	for (const auto &part : parts)
+		css << '\n' << part.scoped_css;
+
+	css << "\n/* Keyframes (deduped) */\n";
 	{
 		std::unordered_set<std::string> emitted;
 		for (const auto &name : kfOrder) {
@@ -2165,86 +3943,510 @@ static bool regenerate_merged_css_js(const std::string &ts, std::string &outCssF
 				continue;
 			auto it = kfNameToBlock.find(name);
 			if (it != kfNameToBlock.end()) {
-				css += "\n" + it->second + "\n";
+				css << '\n' << it->second << '\n';
 			}
 		}
 	}
 
-	const std::string cssPath = bundle_styles_path(ts);
-	if (cssPath.empty() || !write_text_file(cssPath, css)) {
-		LOGW("Failed writing %s", cssPath.empty() ? "<empty css path>" : cssPath.c_str());
-		return false;
-	}
-
-	std::string js;
-	js += build_base_script(g_items);
-	js += "\n\n/* Per-LT scripts */\n";
-	for (const auto &c : g_items)
-		js += build_item_script(c);
+	out_buffer &js = out.js;
+	build_base_script(snap.items, js);
+	js << "\n\n/* Per-LT scripts */\n";
+	for (auto &part : parts)
+		js.splice(std::move(part.script));
 
-	const std::string jsPath = bundle_scripts_path(ts);
-	if (jsPath.empty() || !write_text_file(jsPath, js)) {
-		LOGW("Failed writing %s", jsPath.empty() ? "<empty js path>" : jsPath.c_str());
-		return false;
-	}
+	build_full_html(ts, bundle_styles_name(snap.name), bundle_scripts_name(snap.name), snap.local_animate_css, parts,
+			out.html);
 
-	return true;
+	const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0);
+	LOGD("Rendered bundle: %zu items (%zu reused) on %zu workers in %lld ms (%zu bytes, %llu chunk allocations)",
+	     n, reused.load(), render_worker_count(n, snap.workers), (long long)ms.count(),
+	     out.css.size() + out.js.size() + out.html.size(),
+	     (unsigned long long)(out.css.allocations() + out.js.allocations() + out.html.allocations()));
 }
 
-static std::string generate_bundle_html(const std::string &ts, const std::string &cssFile, const std::string &jsFile)
+// Writes a rendered bundle into the snapshot's output dir. Returns the absolute lt.html path or empty.
+static std::string write_bundle(const render_snapshot &snap, const rendered_bundle &b)
 {
-	if (!has_output_dir())
+	if (snap.output_dir.empty())
 		return {};
 
-	const std::string absCur = bundle_html_current_path();
-	if (absCur.empty())
+	const std::string cssPath = join_path(snap.output_dir, bundle_styles_name(snap.name));
+	if (!write_buffer_atomic(b.css, cssPath)) {
+		LOGW("Failed writing %s", cssPath.c_str());
 		return {};
+	}
 
-	const std::string html = build_full_html(ts, cssFile, jsFile);
+	const std::string jsPath = join_path(snap.output_dir, bundle_scripts_name(snap.name));
+	if (!write_buffer_atomic(b.js, jsPath)) {
+		LOGW("Failed writing %s", jsPath.c_str());
+		return {};
+	}
 
-	if (!write_text_file(absCur, html))
+	const std::string htmlPath = join_path(snap.output_dir, bundle_html_name(snap.name));
+	if (!write_buffer_atomic(b.html, htmlPath))
 		return {};
 
-	return absCur;
+	return htmlPath;
 }
 
-static obs_source_t *get_target_browser_source()
+// -------------------------
+// Output variants
+// -------------------------
+// A variant page is lt.html plus one more stylesheet, lt@<name>.css, which only holds the variant's
+// layout: safe margin, scale and per-item position / scale overrides. Everything else is the shared
+// lt.css / lt.js, so a variant costs a string splice per rebuild rather than a render.
+
+struct variant_page {
+	output_variant variant;
+	std::string css;
+	std::string html;
+};
+
+static std::string variant_base_name(const std::string &name)
+{
+	return "lt@" + name;
+}
+
+// `#slt-root > li[id="<id>"]`: an attribute selector works for ids a bare #<id> cannot name (leading
+// digit), and the root prefix keeps the override at least as specific as a #<id> rule.
+static std::string variant_item_selector(const std::string &id)
+{
+	std::string sel = "#slt-root > li[id=\"";
+	for (char ch : id) {
+		if (ch == '"' || ch == '\\')
+			sel += '\\';
+		sel += ch;
+	}
+	return sel + "\"]";
+}
+
+// Ids and position classes are sanitized, so both are safe to emit as selectors and declarations.
+static std::string build_variant_css(const output_variant &v)
+{
+	std::string css = "/* VinciFlow - output variant '" + v.name + "' (" + std::to_string(v.width) + "x" +
+			  std::to_string(v.height) + ") */\n";
+	if (v.safe_margin >= 0)
+		css += ":root{ --slt-safe-margin: " + std::to_string(v.safe_margin) + "px; }\n";
+	if (v.scale_pct != 100)
+		css += "#slt-root > li{ zoom: " + std::to_string(v.scale_pct) + "%; }\n";
+
+	for (const auto &kv : v.items) {
+		const layout_override &o = kv.second;
+		if (const position_rule *r = o.position.empty() ? nullptr : find_position_rule(o.position.str())) {
+			// Clears whatever the item's own position class set before applying the override.
+			css += "\n" + variant_item_selector(kv.first) + " {\n  left: auto;\n  right: auto;\n  top: auto;\n  bottom: auto;\n";
+			css += "  transform: none;\n  ";
+			css += r->decls;
+			css += "\n}\n";
+		}
+		if (o.scale_pct > 0)
+			css += variant_item_selector(kv.first) + "{ zoom: " + std::to_string(o.scale_pct) + "%; }\n";
+	}
+	return css;
+}
+
+// Derives the variant pages from the rendered full-frame bundle.
+static std::vector<variant_page> render_variant_pages(const render_snapshot &snap, const rendered_bundle &b,
+						      const std::string &ts)
+{
+	std::vector<variant_page> pages;
+	if (snap.variants.empty())
+		return pages;
+
+	const std::string mainHtml = b.html.str();
+	const size_t headEnd = mainHtml.find("</head>");
+	pages.reserve(snap.variants.size());
+	for (const auto &v : snap.variants) {
+		variant_page &p = pages.emplace_back();
+		p.variant = v;
+		p.css = build_variant_css(v);
+
+		const std::string link = "<link rel=\"stylesheet\" href=\"./" +
+					 bundle_styles_name(variant_base_name(v.name)) + "?v=" + ts + "\"/>\n";
+		p.html = mainHtml;
+		p.html.insert(headEnd == std::string::npos ? 0 : headEnd, link);
+	}
+	return pages;
+}
+
+// -------------------------
+// Sharded bundles
+// -------------------------
+// With shard_by_position, the items of each known position render into their own bundle
+// (lt-<zone>.*) for a zone of the target's frame; items of other positions stay in lt.*. Zones are
+// anchored so that the position classes put items at the same canvas spot as the full frame would:
+// top / bottom bands a third of the height, left / right halves, centered two thirds. Item sizes are only
+// known to the page, so a shown item that overflows its zone logs a console warning there (the browser
+// source's log) instead of silently losing its edges.
+
+// A rendered bundle and where it goes. Hashes skip rewriting (and reloading) unchanged pages.
+struct bundle_render {
+	render_snapshot snap;
+	rendered_bundle bundle;
+	uint64_t hash = 0;
+	shard_output zone;                  // shards only
+	std::vector<variant_page> variants; // lt.* only
+	// Sharded builds with variants: the full-frame render (lt-full.*) the variant pages load instead of
+	// lt.*, which then only holds the items without a zone.
+	rendered_bundle full_frame;
+};
+
+static constexpr const char *kFullFrameName = "lt-full";
+
+// Last written content hash per bundle name; guarded by g_rb_write_mx (see the rebuild section).
+static std::unordered_map<std::string, uint64_t> g_bundle_hashes;
+
+static bool zone_of(atom position, int w, int h, shard_output &out)
+{
+	const int bandH = h / 3;
+	const int halfW = w / 2;
+	const int midW = w * 2 / 3;
+	const int midX = (w - midW) / 2;
+	struct zone {
+		const char *position;
+		const char *slug;
+		int x, y, width, height;
+	};
+	const zone zones[] = {
+		{"lt-pos-bottom-left", "bottom-left", 0, h - bandH, halfW, bandH},
+		{"lt-pos-bottom-right", "bottom-right", w - halfW, h - bandH, halfW, bandH},
+		{"lt-pos-bottom-center", "bottom-center", midX, h - bandH, midW, bandH},
+		{"lt-pos-top-left", "top-left", 0, 0, halfW, bandH},
+		{"lt-pos-top-right", "top-right", w - halfW, 0, halfW, bandH},
+		{"lt-pos-top-center", "top-center", midX, 0, midW, bandH},
+		{"lt-pos-center", "center", midX, (h - bandH) / 2, midW, bandH},
+	};
+
+	const std::string &pos = position.str();
+	for (const zone &z : zones) {
+		if (pos != z.position)
+			continue;
+		out.slug = z.slug;
+		out.x = z.x;
+		out.y = z.y;
+		out.width = z.width;
+		out.height = z.height;
+		return true;
+	}
+	return false;
+}
+
+// The timestamp only busts caches; it is left out so an unchanged page hashes the same.
+static uint64_t bundle_content_hash(const rendered_bundle &b, const std::string &ts)
+{
+	const std::string html = replace_all(b.html.str(), ts, std::string());
+	uint64_t h = b.css.hash();
+	const uint64_t js = b.js.hash();
+	h = fnv1a64(&js, sizeof(js), h);
+	return fnv1a64(html.data(), html.size(), h);
+}
+
+// Renders the snapshot: lt.* first, then one bundle per used zone when sharding.
+static std::vector<bundle_render> render_bundles(const render_snapshot &snap, const std::string &ts)
+{
+	std::vector<bundle_render> out(1);
+	out[0].snap = snap;
+	if (!snap.shard_by_position) {
+		render_bundle(snap, ts, out[0].bundle);
+		out[0].variants = render_variant_pages(snap, out[0].bundle, ts);
+		return out;
+	}
+	out[0].snap.items.clear();
+	std::unordered_map<std::string, size_t> bySlug;
+	for (const auto &c : snap.items) {
+		shard_output z;
+		if (!zone_of(c.lt_position, snap.frame_width, snap.frame_height, z)) {
+			out[0].snap.items.push_back(c);
+			continue;
+		}
+		auto it = bySlug.find(z.slug);
+		if (it == bySlug.end()) {
+			it = bySlug.emplace(z.slug, out.size()).first;
+			bundle_render &r = out.emplace_back();
+			r.snap.output_dir = snap.output_dir;
+			r.snap.name = "lt-" + z.slug;
+			r.snap.local_animate_css = snap.local_animate_css;
+			r.zone = std::move(z);
+		}
+		out[it->second].snap.items.push_back(c);
+	}
+
+	for (auto &r : out) {
+		render_bundle(r.snap, ts, r.bundle, phase1_use::Merge);
+		r.hash = bundle_content_hash(r.bundle, ts);
+	}
+
+	// Variants lay out every item on their own canvas, so they derive from a full-frame render; its
+	// per-item work is all phase-1 cache hits after the passes above.
+	if (!snap.variants.empty()) {
+		render_snapshot full = snap;
+		full.name = kFullFrameName;
+		render_bundle(full, ts, out[0].full_frame, phase1_use::Merge);
+		out[0].variants = render_variant_pages(full, out[0].full_frame, ts);
+	}
+
+	// Merged passes keep entries of deleted items; drop them.
+	{
+		std::unordered_set<std::string> live;
+		for (const auto &c : snap.items)
+			live.insert(c.id);
+		std::lock_guard<std::mutex> lk(g_phase1_mx);
+		for (auto it = g_phase1_cache.begin(); it != g_phase1_cache.end();)
+			it = live.count(it->first) ? std::next(it) : g_phase1_cache.erase(it);
+	}
+	return out;
+}
+
+struct variant_output {
+	std::string browser_source;
+	std::string html_path;
+	int width = 0;
+	int height = 0;
+};
+
+// What a rebuild wrote, for the swap on the UI thread.
+struct rebuild_output {
+	std::string html;      // lt.html; empty on failure
+	bool swap_main = true; // false when lt.html did not change (sharded builds only)
+	bool sharded = false;
+	std::vector<shard_output> shards;
+	std::vector<variant_output> variants; // swapped along with lt.html
+};
+
+// A variant that fails to write is skipped; the full-frame page stays valid either way.
+static void write_variant_pages(const bundle_render &main, rebuild_output &out)
+{
+	for (const auto &p : main.variants) {
+		const std::string base = variant_base_name(p.variant.name);
+		const std::string cssPath = join_path(main.snap.output_dir, bundle_styles_name(base));
+		const std::string htmlPath = join_path(main.snap.output_dir, bundle_html_name(base));
+		if (!write_text_file_atomic(cssPath, p.css) || !write_text_file_atomic(htmlPath, p.html)) {
+			LOGW("Failed writing output variant '%s'", p.variant.name.c_str());
+			continue;
+		}
+		out.variants.push_back({p.variant.browser_source, htmlPath, p.variant.width, p.variant.height});
+	}
+}
+
+// Must hold g_rb_write_mx. Unsharded builds always rewrite lt.*; sharded builds only rewrite bundles
+// whose content changed (or whose files went missing, e.g. after an output dir switch).
+static bool write_bundles_locked(std::vector<bundle_render> &bundles, rebuild_output &out)
+{
+	out.sharded = bundles.front().snap.shard_by_position;
+	if (!out.sharded) {
+		g_bundle_hashes.clear();
+		out.html = write_bundle(bundles.front().snap, bundles.front().bundle);
+		if (out.html.empty())
+			return false;
+		write_variant_pages(bundles.front(), out);
+		return true;
+	}
+
+	std::unordered_map<std::string, uint64_t> written;
+	for (size_t i = 0; i < bundles.size(); ++i) {
+		bundle_render &r = bundles[i];
+		const std::string path = join_path(r.snap.output_dir, bundle_html_name(r.snap.name));
+		auto prev = g_bundle_hashes.find(r.snap.name);
+		const bool changed = prev == g_bundle_hashes.end() || prev->second != r.hash || !file_exists(path);
+		if (changed && write_bundle(r.snap, r.bundle).empty())
+			return false;
+		written[r.snap.name] = r.hash;
+
+		if (i == 0) {
+			out.html = path;
+			out.swap_main = changed;
+			if (!r.variants.empty()) {
+				render_snapshot full;
+				full.output_dir = r.snap.output_dir;
+				full.name = kFullFrameName;
+				if (!write_bundle(full, r.full_frame).empty())
+					write_variant_pages(r, out);
+				else
+					LOGW("Failed writing %s; output variants not updated", kFullFrameName);
+			}
+		} else {
+			r.zone.html_path = path;
+			r.zone.changed = changed;
+			out.shards.push_back(r.zone);
+		}
+	}
+	g_bundle_hashes.swap(written);
+	return true;
+}
+
+std::shared_ptr<bundle_render> render_folder_bundle(render_snapshot snap, const std::string &ts)
+{
+	auto r = std::make_shared<bundle_render>();
+	r->snap = std::move(snap);
+	render_bundle(r->snap, ts, r->bundle, phase1_use::Off);
+	r->variants = render_variant_pages(r->snap, r->bundle, ts);
+	return r;
+}
+
+bool write_folder_bundle(const bundle_render &r)
+{
+	rebuild_output out;
+	out.html = write_bundle(r.snap, r.bundle);
+	if (out.html.empty())
+		return false;
+	write_variant_pages(r, out);
+	return true;
+}
+
+// -------------------------
+// Browser source registry
+// -------------------------
+// Browser sources by name, kept up to date from the global source signals so that listing and looking
+// up the target never walks every source of the collection. Entries are weak references: the registry
+// never keeps a source alive. Signals arrive on whichever thread creates, renames or destroys a
+// source, hence the lock.
+
+static std::mutex g_browser_sources_mtx;
+static std::unordered_map<std::string, obs_weak_source_t *> g_browser_sources;
+static std::vector<std::string> g_browser_source_names; // sorted; rebuilt on demand after a change
+static bool g_browser_source_names_dirty = true;
+static signal_handler_t *g_browser_sources_signals = nullptr;
+
+static bool is_slt_browser_source(obs_source_t *src)
+{
+	const char *id = src ? obs_source_get_id(src) : nullptr;
+	return id && strcmp(id, sltBrowserSourceId) == 0;
+}
+
+static void browser_source_add_locked(const std::string &name, obs_source_t *src)
 {
-	const std::string name = target_browser_source_name();
 	if (name.empty())
-		return nullptr;
+		return;
 
-	return obs_get_source_by_name(name.c_str());
+	obs_weak_source_t *&slot = g_browser_sources[name];
+	if (slot) {
+		if (obs_weak_source_references_source(slot, src))
+			return;
+		obs_weak_source_release(slot);
+	}
+	slot = obs_source_get_weak_source(src);
+	g_browser_source_names_dirty = true;
 }
 
-std::vector<std::string> list_browser_source_names()
+// Only drops the entry when it still refers to 'src' (a new source may already own the name).
+static void browser_source_remove_locked(const std::string &name, obs_source_t *src)
 {
-	std::vector<std::string> out;
+	auto it = g_browser_sources.find(name);
+	if (it == g_browser_sources.end() || !obs_weak_source_references_source(it->second, src))
+		return;
 
-	auto enum_cb = [](void *param, obs_source_t *src) -> bool {
-		if (!src)
-			return true;
+	obs_weak_source_release(it->second);
+	g_browser_sources.erase(it);
+	g_browser_source_names_dirty = true;
+}
 
-		const char *id = obs_source_get_id(src);
-		if (!id)
-			return true;
+static void on_browser_source_created(void *, calldata_t *cd)
+{
+	auto *src = static_cast<obs_source_t *>(calldata_ptr(cd, "source"));
+	if (!is_slt_browser_source(src))
+		return;
 
-		if (std::string(id) != sltBrowserSourceId)
-			return true;
+	const char *name = obs_source_get_name(src);
+	std::lock_guard<std::mutex> lk(g_browser_sources_mtx);
+	browser_source_add_locked(name ? name : "", src);
+}
 
-		const char *name = obs_source_get_name(src);
-		if (name && *name) {
-			auto *vec = static_cast<std::vector<std::string> *>(param);
-			vec->push_back(std::string(name));
+// source_remove (deleted by the user) and source_destroy (last reference gone).
+static void on_browser_source_gone(void *, calldata_t *cd)
+{
+	auto *src = static_cast<obs_source_t *>(calldata_ptr(cd, "source"));
+	if (!is_slt_browser_source(src))
+		return;
+
+	const char *name = obs_source_get_name(src);
+	std::lock_guard<std::mutex> lk(g_browser_sources_mtx);
+	browser_source_remove_locked(name ? name : "", src);
+}
+
+static void on_browser_source_renamed(void *, calldata_t *cd)
+{
+	auto *src = static_cast<obs_source_t *>(calldata_ptr(cd, "source"));
+	if (!is_slt_browser_source(src))
+		return;
+
+	const char *prevName = calldata_string(cd, "prev_name");
+	const char *newName = calldata_string(cd, "new_name");
+	std::lock_guard<std::mutex> lk(g_browser_sources_mtx);
+	browser_source_remove_locked(prevName ? prevName : "", src);
+	browser_source_add_locked(newName ? newName : "", src);
+}
+
+void start_browser_source_registry()
+{
+	if (g_browser_sources_signals)
+		return;
+
+	g_browser_sources_signals = obs_get_signal_handler();
+	if (!g_browser_sources_signals)
+		return;
+
+	// Connected before the initial walk, so a source created meanwhile is not missed (adding is idempotent).
+	signal_handler_connect(g_browser_sources_signals, "source_create", on_browser_source_created, nullptr);
+	signal_handler_connect(g_browser_sources_signals, "source_remove", on_browser_source_gone, nullptr);
+	signal_handler_connect(g_browser_sources_signals, "source_destroy", on_browser_source_gone, nullptr);
+	signal_handler_connect(g_browser_sources_signals, "source_rename", on_browser_source_renamed, nullptr);
+
+	auto enum_cb = [](void *, obs_source_t *src) -> bool {
+		if (is_slt_browser_source(src)) {
+			const char *name = obs_source_get_name(src);
+			std::lock_guard<std::mutex> lk(g_browser_sources_mtx);
+			browser_source_add_locked(name ? name : "", src);
 		}
 		return true;
 	};
+	obs_enum_sources(enum_cb, nullptr);
+}
 
-	obs_enum_sources(enum_cb, &out);
+void stop_browser_source_registry()
+{
+	if (!g_browser_sources_signals)
+		return;
 
-	std::sort(out.begin(), out.end());
-	out.erase(std::unique(out.begin(), out.end()), out.end());
-	return out;
+	signal_handler_disconnect(g_browser_sources_signals, "source_create", on_browser_source_created, nullptr);
+	signal_handler_disconnect(g_browser_sources_signals, "source_remove", on_browser_source_gone, nullptr);
+	signal_handler_disconnect(g_browser_sources_signals, "source_destroy", on_browser_source_gone, nullptr);
+	signal_handler_disconnect(g_browser_sources_signals, "source_rename", on_browser_source_renamed, nullptr);
+	g_browser_sources_signals = nullptr;
+
+	std::lock_guard<std::mutex> lk(g_browser_sources_mtx);
+	for (auto &kv : g_browser_sources)
+		obs_weak_source_release(kv.second);
+	g_browser_sources.clear();
+	g_browser_source_names.clear();
+	g_browser_source_names_dirty = true;
+}
+
+// Strong reference to the target Browser Source (release it), or nullptr when it does not exist.
+// References are taken under the registry lock but never released under it: dropping what may be the
+// last one destroys the source, and its source_destroy handler takes the same lock.
+static obs_source_t *get_target_browser_source()
+{
+	const std::string name = target_browser_source_name();
+	if (name.empty())
+		return nullptr;
+
+	std::lock_guard<std::mutex> lk(g_browser_sources_mtx);
+	auto it = g_browser_sources.find(name);
+	return it == g_browser_sources.end() ? nullptr : obs_weak_source_get_source(it->second);
+}
+
+std::vector<std::string> list_browser_source_names()
+{
+	std::lock_guard<std::mutex> lk(g_browser_sources_mtx);
+	if (g_browser_source_names_dirty) {
+		g_browser_source_names.clear();
+		g_browser_source_names.reserve(g_browser_sources.size());
+		for (const auto &kv : g_browser_sources)
+			g_browser_source_names.push_back(kv.first);
+		std::sort(g_browser_source_names.begin(), g_browser_source_names.end());
+		g_browser_source_names_dirty = false;
+	}
+	return g_browser_source_names;
 }
 
 std::string target_browser_source_name()
@@ -2261,6 +4463,10 @@ std::string target_browser_source_name()
 
 bool set_target_browser_source_name(const std::string &name)
 {
+	// The previous target may have been disabled by auto-idle (restores only what idle disabled).
+	if (name != target_browser_source_name())
+		set_target_browser_source_enabled(true);
+
 	g_target_browser_source = name;
 
 	const std::string col = current_scene_collection_name();
@@ -2303,20 +4509,137 @@ bool set_target_browser_dimensions(int width, int height)
 		obs_source_release(src);
 	}
 
+	// Zones are laid out on the target's frame.
+	if (g_shard_by_position)
+		request_rebuild();
+	return save_global_config();
+}
+
+bool shard_by_position()
+{
+	return g_shard_by_position;
+}
+
+bool set_shard_by_position(bool enabled)
+{
+	if (enabled == g_shard_by_position)
+		return true;
+
+	g_shard_by_position = enabled;
+	LOGI("Sharding by position %s", enabled ? "enabled" : "disabled");
+	request_rebuild(); // creates or removes the shard sources
+	return save_global_config();
+}
+
+const std::vector<output_variant> &output_variants()
+{
+	return g_output_variants;
+}
+
+std::string upsert_output_variant(const output_variant &v)
+{
+	output_variant c = v;
+	if (!normalize_output_variant(c))
+		return {};
+
+	auto it = std::find_if(g_output_variants.begin(), g_output_variants.end(),
+			       [&c](const output_variant &x) { return x.name == c.name; });
+	if (it != g_output_variants.end())
+		*it = c;
+	else
+		g_output_variants.push_back(c);
+
+	LOGI("Output variant '%s': %dx%d on '%s', %zu item overrides", c.name.c_str(), c.width, c.height,
+	     c.browser_source.c_str(), c.items.size());
+	request_rebuild();
+	if (!save_global_config())
+		return {};
+	return c.name;
+}
+
+bool remove_output_variant(const std::string &name)
+{
+	auto it = std::find_if(g_output_variants.begin(), g_output_variants.end(),
+			       [&name](const output_variant &x) { return x.name == name; });
+	if (it == g_output_variants.end())
+		return false;
+	g_output_variants.erase(it);
+
+	if (has_output_dir()) {
+		const std::string base = variant_base_name(name);
+		remove_output_file(bundle_styles_name(base));
+		remove_output_file(bundle_html_name(base));
+	}
+	LOGI("Output variant '%s' removed", name.c_str());
 	return save_global_config();
 }
 
 bool target_browser_source_exists()
 {
+	// Registered browser sources only; the weak reference tells whether it is still alive.
 	obs_source_t *src = get_target_browser_source();
+	obs_source_release(src); // after the registry lock (see get_target_browser_source)
+	return src != nullptr;
+}
+
+// Auto-idle marks what it disables in the source's private settings, which are saved with the scene
+// collection, so waking (also after a restart or collection switch) re-enables exactly those sources
+// and never one the user turned off.
+static constexpr const char *kIdleDisabledKey = "vflow_idle_disabled";
+
+static void idle_disable_source(obs_source_t *src)
+{
+	if (!src || !obs_source_enabled(src))
+		return;
+	obs_data_t *priv = obs_source_get_private_settings(src);
+	obs_data_set_bool(priv, kIdleDisabledKey, true);
+	obs_data_release(priv);
+	obs_source_set_enabled(src, false);
+}
+
+static void idle_restore_source(obs_source_t *src)
+{
 	if (!src)
-		return false;
+		return;
+	obs_data_t *priv = obs_source_get_private_settings(src);
+	const bool mine = obs_data_get_bool(priv, kIdleDisabledKey);
+	if (mine)
+		obs_data_erase(priv, kIdleDisabledKey);
+	obs_data_release(priv);
+	if (mine && !obs_source_enabled(src))
+		obs_source_set_enabled(src, true);
+}
 
-	const char *id = obs_source_get_id(src);
-	const bool ok = (id && std::string(id) == sltBrowserSourceId);
+bool set_target_browser_source_enabled(bool enabled)
+{
+	if (enabled) {
+		// Every browser source, so a former target or shard disabled before a switch is restored too.
+		for (const auto &name : list_browser_source_names()) {
+			obs_source_t *src = obs_get_source_by_name(name.c_str());
+			idle_restore_source(src);
+			obs_source_release(src);
+		}
+		return true;
+	}
 
+	obs_source_t *src = get_target_browser_source();
+	if (!src)
+		return false;
+	idle_disable_source(src);
 	obs_source_release(src);
-	return ok;
+
+	std::vector<std::string> names = shard_source_names();
+	for (const auto &v : g_output_variants) {
+		if (!v.browser_source.empty())
+			names.push_back(v.browser_source);
+	}
+	for (const auto &name : names) {
+		obs_source_t *s = obs_get_source_by_name(name.c_str());
+		if (s && is_slt_browser_source(s))
+			idle_disable_source(s);
+		obs_source_release(s);
+	}
+	return true;
 }
 
 static void refreshSourceSettings(obs_source_t *s)
@@ -2358,31 +4681,581 @@ bool swap_target_browser_source_to_file(const std::string &absoluteHtmlPath)
 		return false;
 	}
 
-	obs_data_t *s = obs_source_get_settings(src);
-	const char *prevPathC = obs_data_get_string(s, "local_file");
-	const std::string prevPath = prevPathC ? std::string(prevPathC) : std::string();
+	const bool ok = swap_browser_source_to_file(src, absoluteHtmlPath, g_target_browser_width,
+						    g_target_browser_height);
+	obs_source_release(src);
+	return ok;
+}
+
+bool swap_browser_source_to_file(obs_source_t *src, const std::string &absoluteHtmlPath, int width, int height)
+{
+	if (!src || absoluteHtmlPath.empty())
+		return false;
+
+	obs_data_t *s = obs_source_get_settings(src);
+	const char *prevPathC = obs_data_get_string(s, "local_file");
+	const std::string prevPath = prevPathC ? std::string(prevPathC) : std::string();
+
+	if (!prevPath.empty() && prevPath == absoluteHtmlPath) {
+		obs_data_set_string(s, "local_file", "");
+		obs_source_update(src, s);
+	}
+	obs_data_set_bool(s, "is_local_file", true);
+	obs_data_set_string(s, "local_file", absoluteHtmlPath.c_str());
+
+	obs_data_set_bool(s, "is_control_audio", true);
+	obs_data_set_bool(s, "control_audio", true);
+	obs_data_set_bool(s, "reroute_audio", true);
+
+	obs_data_set_bool(s, "vflow_managed", true);
+	obs_data_set_int(s, "width", (int64_t)width);
+	obs_data_set_int(s, "height", (int64_t)height);
+	obs_source_update(src, s);
+
+	obs_data_release(s);
+
+	refreshSourceSettings(src);
+	return true;
+}
+
+// -------------------------
+// Output dir watcher (external edits)
+// -------------------------
+
+static constexpr int kWatchDebounceMs = 250;
+// Above this many changed items a single Reload event replaces per-item events.
+static constexpr size_t kWatchMaxItemEvents = 16;
+
+static QFileSystemWatcher *g_watcher = nullptr;
+static QTimer *g_watch_debounce = nullptr;
+
+item_fingerprint::item_fingerprint(const lower_third_cfg &c)
+	: html(c.html_template), css(c.css_template), js(c.js_template)
+{
+	// Decode now so the copies do not pin an old snapshot mapping.
+	(void)html.shared();
+	(void)css.shared();
+	(void)js.shared();
+
+	bin_writer w;
+	put_item(w, c, false);
+	fields = std::move(w.buf);
+}
+
+// Same, leaving out fields the page does not use (dock label, hotkey, auto-repeat timing, the picture's
+// original): an edit limited to them needs no rebuild.
+static item_fingerprint render_fingerprint(lower_third_cfg c)
+{
+	c.label.clear();
+	c.hotkey.clear();
+	c.repeat_every_sec = 0;
+	c.repeat_visible_sec = 0;
+	c.profile_picture_source.clear();
+	return item_fingerprint(c);
+}
+
+std::string groups_fingerprint()
+{
+	bin_writer w;
+	for (const auto &g : g_groups)
+		put_group(w, g);
+	return std::move(w.buf);
+}
+
+void emit_list_change(list_change_reason reason, const std::string &id)
+{
+	core_event l;
+	l.type = event_type::ListChanged;
+	l.reason = reason;
+	l.id = id;
+	l.count = (int64_t)g_items.size();
+	emit_event(l);
+}
+
+// Reloads externally edited state/visibility files and emits events only for what actually differs.
+static void apply_external_state_edits()
+{
+	const bool stateChanged = stamp_changed(path_state_json(), g_state_stamp);
+	const bool visibleChanged = stateChanged || stamp_changed(path_visible_json(), g_visible_stamp);
+	if (!visibleChanged)
+		return;
+
+	// Previous items by id, with their index in 'previous'.
+	std::unordered_map<std::string, std::pair<item_fingerprint, size_t>> before;
+	std::vector<lower_third_cfg> previous;
+	std::vector<std::string> idsBefore; // page order
+	std::string groupsBefore;
+	if (stateChanged) {
+		previous = g_items;
+		before.reserve(previous.size());
+		for (size_t i = 0; i < previous.size(); ++i) {
+			before.emplace(previous[i].id, std::make_pair(item_fingerprint(previous[i]), i));
+			idsBefore.push_back(previous[i].id);
+		}
+		groupsBefore = groups_fingerprint();
+	}
+	const std::unordered_set<std::string> visBefore(g_visible.begin(), g_visible.end());
+
+	if (stateChanged) {
+		LOGI("lt-state.json changed on disk; applying external edits");
+		load_state_json();
+		reset_history_after_external_load();
+	}
+	load_visible_json();
+
+	// Per item: unchanged items keep their current object (decoded templates, cached render phase);
+	// only added, removed or page-relevant edits rebuild the bundle.
+	std::vector<std::pair<list_change_reason, std::string>> changes;
+	bool renderChanged = false;
+	if (stateChanged) {
+		std::unordered_set<std::string> seen;
+		for (auto &c : g_items) {
+			seen.insert(c.id);
+			auto it = before.find(c.id);
+			if (it == before.end()) {
+				changes.emplace_back(list_change_reason::Create, c.id);
+				renderChanged = true;
+				continue;
+			}
+			lower_third_cfg &old = previous[it->second.second];
+			if (it->second.first == item_fingerprint(c)) {
+				c = std::move(old);
+				continue;
+			}
+			changes.emplace_back(list_change_reason::Update, c.id);
+			if (render_fingerprint(old) != render_fingerprint(c))
+				renderChanged = true;
+		}
+		for (const auto &kv : before) {
+			if (seen.find(kv.first) == seen.end()) {
+				changes.emplace_back(list_change_reason::Delete, kv.first);
+				renderChanged = true;
+			}
+		}
+		for (size_t i = 0; i < g_items.size() && !renderChanged; ++i)
+			renderChanged = g_items[i].id != idsBefore[i];
+
+		if (changes.size() > kWatchMaxItemEvents) {
+			emit_list_change(list_change_reason::Reload, {});
+		} else {
+			for (const auto &ch : changes)
+				emit_list_change(ch.first, ch.second);
+			if (changes.empty() && groupsBefore != groups_fingerprint())
+				emit_list_change(list_change_reason::Update, {});
+		}
+	}
+
+	const std::vector<std::string> visNow = visible_ids();
+	const std::unordered_set<std::string> visAfter(visNow.begin(), visNow.end());
+	auto emit_vis = [&visNow](const std::string &id, bool visible) {
+		core_event v;
+		v.type = event_type::VisibilityChanged;
+		v.id = id;
+		v.visible = visible;
+		v.visible_ids = visNow;
+		emit_event(v);
+	};
+	for (const auto &id : visNow) {
+		if (visBefore.find(id) == visBefore.end())
+			emit_vis(id, true);
+	}
+	for (const auto &id : visBefore) {
+		if (visAfter.find(id) == visAfter.end())
+			emit_vis(id, false);
+	}
+
+	if (renderChanged)
+		request_rebuild();
+	else if (!changes.empty())
+		LOGD("External edits of %zu items need no rebuild", changes.size());
+}
+
+// Compares parameters*.json against the last stamps. The overlay polls these files itself, so a
+// change only needs a ParametersChanged event; 'emitEvents' is false for the initial baseline.
+static void scan_parameters_files(bool emitEvents)
+{
+	const QDir d(QString::fromStdString(output_dir()));
+	const QStringList names = d.entryList(QStringList{QStringLiteral("parameters*.json")}, QDir::Files);
+
+	// Checked against a copy; writers on other threads only ever add or refresh entries meanwhile.
+	std::unordered_map<std::string, file_stamp> stamps = param_stamps_copy();
+	std::unordered_set<std::string> present;
+	for (const QString &n : names) {
+		const std::string path = join_path(output_dir(), n.toStdString());
+		present.insert(path);
+
+		file_stamp &st = stamps[path];
+		if (!file_changed_since(path, st))
+			continue;
+
+		const std::string txt = read_text_file(path);
+		st = stamp_written_file(path, fnv1a64(txt.data(), txt.size()));
+		{
+			std::lock_guard<std::mutex> lk(g_stamp_mx);
+			g_param_stamps[path] = st;
+		}
+		if (!emitEvents)
+			continue;
+
+		// parameters_<id>.json -> id; the combined parameters.json -> empty id.
+		std::string id;
+		if (n.startsWith(QStringLiteral("parameters_")))
+			id = sanitize_id(n.mid(11, n.size() - 11 - 5).toStdString());
+
+		core_event ev;
+		ev.type = event_type::ParametersChanged;
+		ev.id = id;
+		emit_event(ev);
+	}
+
+	std::lock_guard<std::mutex> lk(g_stamp_mx);
+	for (const auto &kv : stamps) {
+		if (present.find(kv.first) == present.end())
+			g_param_stamps.erase(kv.first);
+	}
+}
+
+// Atomic writers replace files by rename, which drops per-file watches; re-arm them after every scan.
+static void watch_known_files()
+{
+	if (!g_watcher)
+		return;
+
+	const QStringList watched = g_watcher->files();
+	QStringList add;
+	auto want = [&](const std::string &p) {
+		const QString q = QString::fromStdString(p);
+		if (QFile::exists(q) && !watched.contains(q))
+			add << q;
+	};
+	want(path_state_json());
+	want(path_visible_json());
+	for (const auto &kv : param_stamps_copy())
+		want(kv.first);
+
+	if (!add.isEmpty())
+		g_watcher->addPaths(add);
+}
+
+// True when lt-state.json, lt-visible.json or a parameters file differs from its stamp. Our own writes
+// (bundles, assets, snapshots, .tmp renames, and state files we stamped) all answer false.
+static bool external_edit_pending()
+{
+	if (stamp_changed(path_state_json(), g_state_stamp) || stamp_changed(path_visible_json(), g_visible_stamp))
+		return true;
+
+	const QDir d(QString::fromStdString(output_dir()));
+	const QStringList names = d.entryList(QStringList{QStringLiteral("parameters*.json")}, QDir::Files);
+	std::unordered_map<std::string, file_stamp> stamps = param_stamps_copy();
+	if ((size_t)names.size() != stamps.size())
+		return true;
+	for (const QString &n : names) {
+		auto it = stamps.find(join_path(output_dir(), n.toStdString()));
+		if (it == stamps.end() || file_changed_since(it->first, it->second))
+			return true;
+	}
+	return false;
+}
+
+static void on_output_dir_event()
+{
+	if (!has_output_dir() || !g_watch_debounce)
+		return;
+
+	// External writes only reach the checkpointer this way; ours schedule it themselves.
+	checkpoint_soon();
+
+	if (external_edit_pending()) {
+		g_watch_debounce->start();
+		return;
+	}
+	// Our atomic writes replace files by rename, which drops their watches.
+	watch_known_files();
+}
+
+static void on_output_dir_changed()
+{
+	if (!has_output_dir())
+		return;
+
+	apply_external_state_edits();
+	scan_parameters_files(true);
+	watch_known_files();
+}
+
+void stop_output_watcher()
+{
+	delete g_watch_debounce;
+	g_watch_debounce = nullptr;
+	delete g_watcher;
+	g_watcher = nullptr;
+}
+
+void restart_output_watcher()
+{
+	stop_output_watcher();
+	if (!has_output_dir() || !QCoreApplication::instance())
+		return;
+
+	g_watcher = new QFileSystemWatcher();
+	g_watch_debounce = new QTimer();
+	g_watch_debounce->setSingleShot(true);
+	g_watch_debounce->setInterval(kWatchDebounceMs);
+
+	QObject::connect(g_watch_debounce, &QTimer::timeout, g_watch_debounce, []() { on_output_dir_changed(); });
+	auto kick = [](const QString &) { on_output_dir_event(); };
+	QObject::connect(g_watcher, &QFileSystemWatcher::directoryChanged, g_watcher, kick);
+	QObject::connect(g_watcher, &QFileSystemWatcher::fileChanged, g_watcher, kick);
+
+	g_watcher->addPath(QString::fromStdString(output_dir()));
+	scan_parameters_files(false);
+	watch_known_files();
+}
+
+// -------------------------
+// Rebuild scheduling
+// -------------------------
+
+// Requests arriving within this window are folded into one rebuild.
+static constexpr int kRebuildDebounceMs = 60;
+// Minimum spacing between two browser-source swaps (each one is a full CEF reload).
+static constexpr qint64 kMinSwapIntervalMs = 500;
+
+struct rebuild_batch {
+	std::promise<bool> promise;
+	std::shared_future<bool> future;
+	std::atomic<bool> resolved{false};
+
+	// A batch dropped unresolved (its posted swap was cancelled at shutdown) counts as failed.
+	~rebuild_batch()
+	{
+		if (!resolved)
+			promise.set_value(false);
+	}
+};
+
+static std::mutex g_rb_mx;
+static uint64_t g_rb_requested_gen = 0;             // last generation handed out
+static std::atomic<uint64_t> g_rb_completed_gen{0}; // last generation swapped (or superseded)
+static std::shared_ptr<rebuild_batch> g_rb_batch;   // requests not yet picked up by a job
+static bool g_rb_armed = false;
+static bool g_rb_running = false;
+static int64_t g_rb_last_swap_ms = -kMinSwapIntervalMs; // steady_ms()
+static std::thread g_rb_worker;
+// Receives the posted starts and swaps (UI thread); deleting it on shutdown drops whatever is queued.
+static QObject *g_rb_ctx = nullptr;
+static bool g_rb_stopped = false;
+
+// Serializes writes of the fixed-name bundle files; g_rb_written_gen stops an older job from
+// overwriting output produced for a newer generation.
+static std::mutex g_rb_write_mx;
+static uint64_t g_rb_written_gen = 0;
+
+static void start_rebuild_job();
+
+// Monotonic, so wall clock adjustments neither stall nor burst swaps.
+int64_t steady_ms()
+{
+	using namespace std::chrono;
+	return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static void swap_to_rebuilt_html(const std::string &newHtml)
+{
+	if (target_browser_source_exists()) {
+		swap_target_browser_source_to_file(newHtml);
+	} else {
+		if (g_target_browser_source.empty()) {
+			LOGW("Rebuilt artifacts but did not swap: no target Browser Source selected.");
+		} else {
+			LOGW("Rebuilt artifacts but did not swap: target Browser Source '%s' missing or not a Browser Source.",
+			     g_target_browser_source.c_str());
+		}
+	}
+
+	g_last_html_path = newHtml;
+	g_rb_last_swap_ms = steady_ms();
+}
+
+// Applies a written rebuild: reloads the target (and the shards) whose pages changed.
+static void apply_rebuild_output(const rebuild_output &out)
+{
+	if (out.swap_main)
+		swap_to_rebuilt_html(out.html);
+	else
+		g_last_html_path = out.html;
+
+	for (const auto &v : out.variants) {
+		if (v.browser_source.empty())
+			continue;
+		obs_source_t *src = obs_get_source_by_name(v.browser_source.c_str());
+		if (src && is_slt_browser_source(src) && v.browser_source != target_browser_source_name())
+			swap_browser_source_to_file(src, v.html_path, v.width, v.height);
+		else
+			LOGW("Output variant page written but not shown: '%s' is not a Browser Source of its own",
+			     v.browser_source.c_str());
+		obs_source_release(src);
+	}
+
+	if (out.sharded)
+		shards_sync(out.shards);
+	else
+		shards_remove_all();
+}
+
+// Writes the bundles unless a newer generation already reached the disk. out.html is the lt.html path,
+// or empty on failure; 'superseded' is set when the write was skipped for that reason.
+static void write_bundles_for_generation(uint64_t gen, std::vector<bundle_render> &bundles, rebuild_output &out,
+					 bool &superseded)
+{
+	std::lock_guard<std::mutex> lk(g_rb_write_mx);
+	superseded = gen < g_rb_written_gen;
+	if (superseded)
+		return;
+
+	if (write_bundles_locked(bundles, out))
+		g_rb_written_gen = gen;
+	else
+		out.html.clear();
+}
+
+static void resolve_rebuild_batch(const std::shared_ptr<rebuild_batch> &batch, bool ok)
+{
+	if (batch && !batch->resolved.exchange(true))
+		batch->promise.set_value(ok);
+}
+
+// Must hold g_rb_mx. Posts a single-shot start on the UI thread, delayed so that swaps stay at least
+// kMinSwapIntervalMs apart.
+static void arm_rebuild_locked()
+{
+	if (g_rb_armed || g_rb_running || g_rb_stopped)
+		return;
+
+	QCoreApplication *app = QCoreApplication::instance();
+	if (!app)
+		return;
+	if (!g_rb_ctx) {
+		g_rb_ctx = new QObject();
+		g_rb_ctx->moveToThread(app->thread());
+	}
+	g_rb_armed = true;
+
+	QObject *ctx = g_rb_ctx;
+	const int64_t sinceSwap = steady_ms() - g_rb_last_swap_ms;
+	const int delayMs = (int)std::max<int64_t>(kRebuildDebounceMs, kMinSwapIntervalMs - sinceSwap);
+	QMetaObject::invokeMethod(
+		ctx, [ctx, delayMs]() { QTimer::singleShot(delayMs, ctx, []() { start_rebuild_job(); }); },
+		Qt::QueuedConnection);
+}
+
+static void finish_rebuild_job(uint64_t gen, std::shared_ptr<rebuild_batch> batch, const rebuild_output &out,
+			       bool superseded)
+{
+	const bool ok = superseded || !out.html.empty();
+	// A job started before a scene collection profile switch wrote the folder switched away from.
+	if (!out.html.empty() && out.html == bundle_html_current_path())
+		apply_rebuild_output(out);
+	else if (!out.html.empty())
+		LOGD("Rebuild of '%s' not shown: the output folder changed meanwhile", out.html.c_str());
+
+	uint64_t prev = g_rb_completed_gen.load();
+	while (prev < gen && !g_rb_completed_gen.compare_exchange_weak(prev, gen)) {
+	}
+
+	resolve_rebuild_batch(batch, ok);
+
+	std::lock_guard<std::mutex> lk(g_rb_mx);
+	g_rb_running = false;
+	if (g_rb_batch)
+		arm_rebuild_locked();
+}
+
+// UI thread. Snapshots state and hands rendering + writing to the worker; the swap is posted back.
+static void start_rebuild_job()
+{
+	std::shared_ptr<rebuild_batch> batch;
+	uint64_t gen = 0;
+	{
+		std::lock_guard<std::mutex> lk(g_rb_mx);
+		g_rb_armed = false;
+		if (!g_rb_batch || g_rb_running)
+			return;
+		batch = std::move(g_rb_batch);
+		gen = g_rb_requested_gen;
+		g_rb_running = true;
+	}
+
+	if (g_rb_worker.joinable())
+		g_rb_worker.join();
+
+	if (!has_output_dir()) {
+		finish_rebuild_job(gen, batch, rebuild_output{}, false);
+		return;
+	}
+
+	ensure_output_artifacts_exist();
+	ensure_parameters_files_from_api_templates();
+
+	std::string ts = now_timestamp_string();
+	render_snapshot snap = take_render_snapshot();
 
-	if (!prevPath.empty() && prevPath == absoluteHtmlPath) {
-		obs_data_set_string(s, "local_file", "");
-		obs_source_update(src, s);
+	g_rb_worker = std::thread([gen, batch, ts = std::move(ts), snap = std::move(snap)]() {
+		std::vector<bundle_render> bundles = render_bundles(snap, ts);
+
+		bool superseded = false;
+		rebuild_output out;
+		write_bundles_for_generation(gen, bundles, out, superseded);
+
+		std::lock_guard<std::mutex> lk(g_rb_mx);
+		if (!g_rb_ctx) {
+			resolve_rebuild_batch(batch, !out.html.empty() || superseded);
+			return;
+		}
+		QMetaObject::invokeMethod(
+			g_rb_ctx,
+			[gen, batch, out = std::move(out), superseded]() { finish_rebuild_job(gen, batch, out, superseded); },
+			Qt::QueuedConnection);
+	});
+}
+
+rebuild_ticket request_rebuild()
+{
+	std::lock_guard<std::mutex> lk(g_rb_mx);
+	if (!g_rb_batch) {
+		g_rb_batch = std::make_shared<rebuild_batch>();
+		g_rb_batch->future = g_rb_batch->promise.get_future().share();
 	}
-	obs_data_set_bool(s, "is_local_file", true);
-	obs_data_set_string(s, "local_file", absoluteHtmlPath.c_str());
 
-	obs_data_set_bool(s, "is_control_audio", true);
-	obs_data_set_bool(s, "control_audio", true);
-	obs_data_set_bool(s, "reroute_audio", true);
+	rebuild_ticket t;
+	t.generation = ++g_rb_requested_gen;
+	t.done = g_rb_batch->future;
 
-	obs_data_set_bool(s, "vflow_managed", true);
-	obs_data_set_int(s, "width", (int64_t)g_target_browser_width);
-	obs_data_set_int(s, "height", (int64_t)g_target_browser_height);
-	obs_source_update(src, s);
+	arm_rebuild_locked();
+	return t;
+}
 
-	obs_data_release(s);
+uint64_t completed_rebuild_generation()
+{
+	return g_rb_completed_gen.load();
+}
 
-	refreshSourceSettings(src);
-	obs_source_release(src);
-	return true;
+void shutdown_rebuilds()
+{
+	if (g_rb_worker.joinable())
+		g_rb_worker.join();
+	stop_render_pool();
+
+	std::shared_ptr<rebuild_batch> batch;
+	{
+		std::lock_guard<std::mutex> lk(g_rb_mx);
+		batch = std::move(g_rb_batch);
+		g_rb_stopped = true;
+		// Cancels the armed single-shot and the posted starts/swaps; their batches resolve as failed.
+		delete g_rb_ctx;
+		g_rb_ctx = nullptr;
+	}
+	resolve_rebuild_batch(batch, false);
 }
 
 bool rebuild_and_swap()
@@ -2393,31 +5266,63 @@ bool rebuild_and_swap()
 	ensure_output_artifacts_exist();
 	ensure_parameters_files_from_api_templates();
 
+	// A synchronous rebuild renders the current state, so it also satisfies every request queued so far.
+	std::shared_ptr<rebuild_batch> batch;
+	uint64_t gen = 0;
+	{
+		std::lock_guard<std::mutex> lk(g_rb_mx);
+		batch = std::move(g_rb_batch);
+		gen = ++g_rb_requested_gen;
+	}
+
 	const std::string ts = now_timestamp_string();
-	std::string cssFile, jsFile;
-	if (!regenerate_merged_css_js(ts, cssFile, jsFile))
-		return false;
+	const render_snapshot snap = take_render_snapshot();
+
+	std::vector<bundle_render> bundles = render_bundles(snap, ts);
 
-	const std::string newHtml = generate_bundle_html(ts, cssFile, jsFile);
-	if (newHtml.empty())
+	bool superseded = false;
+	rebuild_output out;
+	write_bundles_for_generation(gen, bundles, out, superseded);
+	if (out.html.empty()) {
+		resolve_rebuild_batch(batch, false);
 		return false;
+	}
 
+	apply_rebuild_output(out);
 
-	if (target_browser_source_exists()) {
-		swap_target_browser_source_to_file(newHtml);
-	} else {
-		if (g_target_browser_source.empty()) {
-			LOGW("Rebuilt artifacts but did not swap: no target Browser Source selected.");
-		} else {
-			LOGW("Rebuilt artifacts but did not swap: target Browser Source '%s' missing or not a Browser Source.",
-			     g_target_browser_source.c_str());
-		}
+	uint64_t prev = g_rb_completed_gen.load();
+	while (prev < gen && !g_rb_completed_gen.compare_exchange_weak(prev, gen)) {
 	}
-
-	g_last_html_path = newHtml;
+	resolve_rebuild_batch(batch, true);
 	return true;
 }
 
+bool rebuilds_idle()
+{
+	std::lock_guard<std::mutex> lk(g_rb_mx);
+	return !g_rb_batch && !g_rb_running && g_rb_completed_gen.load() >= g_rb_requested_gen;
+}
+
+void show_written_bundle()
+{
+	ensure_parameters_files_from_api_templates(); // rebuild_and_swap() does this otherwise
+
+	rebuild_output out;
+	out.html = bundle_html_current_path();
+	for (const auto &v : g_output_variants) {
+		const std::string path = join_path(output_dir(), bundle_html_name(variant_base_name(v.name)));
+		if (file_exists(path))
+			out.variants.push_back({v.browser_source, path, v.width, v.height});
+	}
+	apply_rebuild_output(out);
+}
+
+void forget_bundle_hashes()
+{
+	std::lock_guard<std::mutex> lk(g_rb_write_mx);
+	g_bundle_hashes.clear();
+}
+
 void notify_list_updated(const std::string &id)
 {
 	core_event l;
@@ -2434,6 +5339,7 @@ bool reload_from_disk_and_rebuild()
 		return false;
 
 	ensure_output_artifacts_exist();
+	clear_history();
 
 	const bool okState = load_state_json();
 	const bool okVis = load_visible_json();
@@ -2455,14 +5361,113 @@ bool reload_from_disk_and_rebuild()
 	return ok;
 }
 
-bool set_output_dir_and_load(const std::string &dir)
+// -------------------------
+// Hot output directory
+// -------------------------
+
+static constexpr int kCheckpointIntervalMs = 2000;
+
+static void remove_hot_dir(const std::string &hot)
 {
-	if (dir.empty())
+	std::error_code ec;
+	if (!hot.empty())
+		std::filesystem::remove_all(std::filesystem::path(hot), ec);
+}
+
+// Final checkpoint of the current hot directory; output_dir() reverts to the configured folder. The hot
+// directory is deleted once everything is safely on disk; after a failed checkpoint it is kept, and
+// the next attach restores whatever is newer.
+static void detach_hot_output()
+{
+	if (!g_checkpointer)
+		return;
+
+	const std::string hot = g_live_dir;
+	std::unique_ptr<checkpointer> cp;
+	{
+		std::lock_guard<std::mutex> lk(g_checkpointer_mx);
+		cp = std::move(g_checkpointer);
+	}
+	const bool ok = cp->flush();
+	cp.reset();
+	g_live_dir.clear();
+	if (ok)
+		remove_hot_dir(hot);
+}
+
+// Serves g_output_dir from its hot directory, restored from the folder first. Falls back to serving
+// the folder itself when no hot directory can be created.
+static void attach_hot_output()
+{
+	detach_hot_output();
+	if (!g_hot_output || g_output_dir.empty())
+		return;
+
+	const std::string hot = hot_dir_for(g_output_dir);
+	if (hot.empty()) {
+		LOGW("Hot output directory unavailable; serving '%s' directly", g_output_dir.c_str());
+		return;
+	}
+
+	ensure_dir(g_output_dir);
+	auto cp = std::make_unique<checkpointer>(hot, g_output_dir, kCheckpointIntervalMs);
+	const size_t restored = cp->restore();
+	g_live_dir = hot;
+	{
+		std::lock_guard<std::mutex> lk(g_checkpointer_mx);
+		g_checkpointer = std::move(cp);
+	}
+	LOGI("Serving live files from '%s' (%zu restored); checkpoints go to '%s'", hot.c_str(), restored,
+	     g_output_dir.c_str());
+}
+
+bool hot_output_enabled()
+{
+	return g_hot_output;
+}
+
+bool set_hot_output_enabled(bool enabled)
+{
+	if (enabled == g_hot_output)
+		return true;
+
+	if (enabled && !hot_dir_supported()) {
+		LOGW("Hot output directory needs a RAM-backed filesystem (/dev/shm); not enabled");
 		return false;
+	}
+
+	g_hot_output = enabled;
+	if (!has_output_dir())
+		return save_global_config();
+	return set_output_dir_and_load(g_output_dir);
+}
+
+void shutdown_hot_output()
+{
+	detach_hot_output();
+}
 
+void enter_output_dir(const std::string &dir)
+{
+	detach_hot_output();
 	g_output_dir = dir;
+	attach_hot_output();
 	ensure_dir(output_dir());
+}
+
+bool set_output_dir_and_load(const std::string &dir)
+{
+	if (dir.empty())
+		return false;
+
+	clear_history(); // deferred file removals belong to the previous folder
+	cancel_scheduled_changes({});
+	enter_output_dir(dir);
 
+	forget_profile(dir);
+	auto bound = g_output_dir_by_collection.find(current_scene_collection_name());
+	if (bound != g_output_dir_by_collection.end())
+		bound->second = QDir::cleanPath(QString::fromStdString(dir)).toStdString();
 	save_global_config();
 
 	ensure_output_artifacts_exist();
@@ -2471,6 +5476,7 @@ bool set_output_dir_and_load(const std::string &dir)
 
 	save_state_json();
 	save_visible_json();
+	collect_unused_assets();
 
 	const bool ok = rebuild_and_swap();
 
@@ -2480,6 +5486,8 @@ bool set_output_dir_and_load(const std::string &dir)
 	l.count = (int64_t)g_items.size();
 	emit_event(l);
 
+	restart_output_watcher();
+	schedule_profile_preload();
 	return ok;
 }
 
@@ -2487,13 +5495,19 @@ void init_from_disk()
 {
 	load_global_config();
 
+	auto bound = g_output_dir_by_collection.find(current_scene_collection_name());
+	if (bound != g_output_dir_by_collection.end())
+		g_output_dir = bound->second;
+
 	if (g_output_dir.empty())
 		return;
 
+	attach_hot_output();
 	ensure_dir(output_dir());
 	ensure_output_artifacts_exist();
 	load_state_json();
 	load_visible_json();
+	collect_unused_assets();
 
 	g_last_html_path = bundle_html_current_path();
 
@@ -2507,6 +5521,23 @@ void init_from_disk()
 			}
 		}
 	}
+
+	restart_output_watcher();
+	schedule_profile_preload();
+}
+
+group_cfg default_group_cfg()
+{
+	group_cfg c;
+	c.id = new_id();
+	c.title = "Group";
+	c.order_mode = 0;
+	c.loop = true;
+
+	c.visible_ms = 15000;
+	c.interval_ms = 5000;
+	c.dock_color = "#2EA043";
+	return c;
 }
 
 std::string add_default_group()
@@ -2515,10 +5546,9 @@ std::string add_default_group()
 		return {};
 
 	ensure_output_artifacts_exist();
-	load_state_json();
+	reload_if_changed_on_disk();
 
-	group_cfg c;
-	c.id = new_id();
+	group_cfg c = default_group_cfg();
 	while (get_group_by_id(c.id))
 		c.id = new_id();
 
@@ -2527,14 +5557,6 @@ std::string add_default_group()
 		maxOrder = std::max(maxOrder, it.order);
 	c.order = maxOrder + 1;
 
-	c.title = "Group";
-	c.order_mode = 0;
-	c.loop = true;
-
-	c.visible_ms = 15000;
-	c.interval_ms = 5000;
-	c.dock_color = "#2EA043";
-
 	g_groups.push_back(c);
 	std::sort(g_groups.begin(), g_groups.end(), [](const group_cfg &a, const group_cfg &b) {
 		if (a.order != b.order)
@@ -2560,7 +5582,7 @@ bool update_group(const group_cfg &c)
 		return false;
 
 	ensure_output_artifacts_exist();
-	load_state_json();
+	reload_if_changed_on_disk();
 
 	group_cfg *dst = get_group_by_id(c.id);
 	if (!dst)
@@ -2581,106 +5603,251 @@ bool update_group(const group_cfg &c)
 	core_event l;
 	l.type = event_type::ListChanged;
 	l.reason = list_change_reason::Update;
-	l.id = c.id;
+	l.id = c.id;
+	l.count = (int64_t)g_items.size();
+	emit_event(l);
+
+	return true;
+}
+
+bool remove_group(const std::string &group_id)
+{
+	if (!has_output_dir())
+		return false;
+
+	ensure_output_artifacts_exist();
+	reload_if_changed_on_disk();
+
+	const std::string sid = sanitize_id(group_id);
+	const auto before = g_groups.size();
+
+	g_groups.erase(std::remove_if(g_groups.begin(), g_groups.end(),
+					 [&](const group_cfg &c) { return c.id == sid; }),
+			  g_groups.end());
+
+	const bool removed = (g_groups.size() != before);
+	if (!removed)
+		return false;
+
+	save_state_json();
+
+	core_event l;
+	l.type = event_type::ListChanged;
+	l.reason = list_change_reason::Update;
+	l.id = sid;
+	l.count = (int64_t)g_items.size();
+	emit_event(l);
+
+	return true;
+}
+
+bool set_group_members(const std::string &group_id, const std::vector<std::string> &members)
+{
+	if (!has_output_dir())
+		return false;
+
+	ensure_output_artifacts_exist();
+	reload_if_changed_on_disk();
+
+	group_cfg *c = get_group_by_id(group_id);
+	if (!c)
+		return false;
+
+	c->members.clear();
+	c->members.reserve(members.size());
+	for (const auto &m : members) {
+		const std::string mid = sanitize_id(m);
+		if (mid.empty())
+			continue;
+
+		bool ownedByOther = false;
+		for (const auto &other : g_groups) {
+			if (other.id == c->id)
+				continue;
+			if (std::find(other.members.begin(), other.members.end(), mid) != other.members.end()) {
+				ownedByOther = true;
+				break;
+			}
+		}
+		if (ownedByOther)
+			continue;
+
+		c->members.push_back(mid);
+
+		if (auto *lt = get_by_id(mid)) {
+			lt->repeat_every_sec = 0;
+			lt->repeat_visible_sec = 0;
+		}
+	}
+
+	save_state_json();
+
+	core_event l;
+	l.type = event_type::ListChanged;
+	l.reason = list_change_reason::Update;
+	l.id = c->id;
+	l.count = (int64_t)g_items.size();
+	emit_event(l);
+
+	return true;
+}
+
+// -------------------------
+// Rules
+// -------------------------
+
+static const std::pair<rule_trigger, const char *> kRuleTriggerNames[] = {
+	{rule_trigger::SceneActivated, "scene_activated"},
+	{rule_trigger::SceneDeactivated, "scene_deactivated"},
+	{rule_trigger::TransitionStarted, "transition_started"},
+	{rule_trigger::StreamingStarted, "streaming_started"},
+	{rule_trigger::StreamingStopped, "streaming_stopped"},
+	{rule_trigger::RecordingStarted, "recording_started"},
+	{rule_trigger::RecordingStopped, "recording_stopped"},
+};
+
+static const std::pair<rule_action, const char *> kRuleActionNames[] = {
+	{rule_action::Show, "show"},          {rule_action::Hide, "hide"},
+	{rule_action::Toggle, "toggle"},      {rule_action::RunGroup, "run_group"},
+	{rule_action::StopGroup, "stop_group"},
+};
+
+const char *rule_trigger_name(rule_trigger t)
+{
+	for (const auto &n : kRuleTriggerNames) {
+		if (n.first == t)
+			return n.second;
+	}
+	return "";
+}
+
+bool rule_trigger_from_name(const std::string &name, rule_trigger &out)
+{
+	for (const auto &n : kRuleTriggerNames) {
+		if (name == n.second) {
+			out = n.first;
+			return true;
+		}
+	}
+	return false;
+}
+
+const char *rule_action_name(rule_action a)
+{
+	for (const auto &n : kRuleActionNames) {
+		if (n.first == a)
+			return n.second;
+	}
+	return "";
+}
+
+bool rule_action_from_name(const std::string &name, rule_action &out)
+{
+	for (const auto &n : kRuleActionNames) {
+		if (name == n.second) {
+			out = n.first;
+			return true;
+		}
+	}
+	return false;
+}
+
+const std::vector<rule_cfg> &rules_const()
+{
+	return g_rules;
+}
+
+uint64_t rules_generation()
+{
+	return g_rules_gen;
+}
+
+static void normalize_rule(rule_cfg &r)
+{
+	r.id = sanitize_id(r.id);
+	if (r.id.empty())
+		r.id = new_id();
+	r.target = sanitize_id(r.target);
+	r.delay_ms = std::max(0, r.delay_ms);
+}
+
+static void rules_changed(const std::string &id)
+{
+	++g_rules_gen;
+	save_state_json();
+
+	core_event l;
+	l.type = event_type::ListChanged;
+	l.reason = list_change_reason::Update;
+	l.id = id;
 	l.count = (int64_t)g_items.size();
 	emit_event(l);
-
-	return true;
 }
 
-bool remove_group(const std::string &group_id)
+bool set_rules(std::vector<rule_cfg> rules)
 {
 	if (!has_output_dir())
 		return false;
 
 	ensure_output_artifacts_exist();
-	load_state_json();
-
-	const std::string sid = sanitize_id(group_id);
-	const auto before = g_groups.size();
+	reload_if_changed_on_disk();
 
-	g_groups.erase(std::remove_if(g_groups.begin(), g_groups.end(),
-					 [&](const group_cfg &c) { return c.id == sid; }),
-			  g_groups.end());
+	for (auto &r : rules)
+		normalize_rule(r);
+	g_rules = std::move(rules);
+	rules_changed({});
+	return true;
+}
 
-	const bool removed = (g_groups.size() != before);
-	if (!removed)
-		return false;
+std::string upsert_rule(const rule_cfg &r)
+{
+	if (!has_output_dir())
+		return {};
 
-	save_state_json();
+	ensure_output_artifacts_exist();
+	reload_if_changed_on_disk();
 
-	core_event l;
-	l.type = event_type::ListChanged;
-	l.reason = list_change_reason::Update;
-	l.id = sid;
-	l.count = (int64_t)g_items.size();
-	emit_event(l);
+	rule_cfg c = r;
+	normalize_rule(c);
+	auto it = std::find_if(g_rules.begin(), g_rules.end(), [&c](const rule_cfg &x) { return x.id == c.id; });
+	if (it != g_rules.end())
+		*it = c;
+	else
+		g_rules.push_back(c);
 
-	return true;
+	rules_changed(c.id);
+	return c.id;
 }
 
-bool set_group_members(const std::string &group_id, const std::vector<std::string> &members)
+bool remove_rule(const std::string &rule_id)
 {
 	if (!has_output_dir())
 		return false;
 
 	ensure_output_artifacts_exist();
-	load_state_json();
+	reload_if_changed_on_disk();
 
-	group_cfg *c = get_group_by_id(group_id);
-	if (!c)
+	const std::string sid = sanitize_id(rule_id);
+	const auto before = g_rules.size();
+	g_rules.erase(std::remove_if(g_rules.begin(), g_rules.end(), [&](const rule_cfg &c) { return c.id == sid; }),
+		      g_rules.end());
+	if (g_rules.size() == before)
 		return false;
 
-	c->members.clear();
-	c->members.reserve(members.size());
-	for (const auto &m : members) {
-		const std::string mid = sanitize_id(m);
-		if (mid.empty())
-			continue;
-
-		bool ownedByOther = false;
-		for (const auto &other : g_groups) {
-			if (other.id == c->id)
-				continue;
-			if (std::find(other.members.begin(), other.members.end(), mid) != other.members.end()) {
-				ownedByOther = true;
-				break;
-			}
-		}
-		if (ownedByOther)
-			continue;
-
-		c->members.push_back(mid);
-
-		if (auto *lt = get_by_id(mid)) {
-			lt->repeat_every_sec = 0;
-			lt->repeat_visible_sec = 0;
-		}
-	}
-
-	save_state_json();
-
-	core_event l;
-	l.type = event_type::ListChanged;
-	l.reason = list_change_reason::Update;
-	l.id = c->id;
-	l.count = (int64_t)g_items.size();
-	emit_event(l);
-
+	rules_changed(sid);
 	return true;
 }
 
-std::string add_default_lower_third()
+std::string add_default_lower_third(rebuild_ticket *rebuild)
 {
 	if (!has_output_dir())
 		return {};
 
 	ensure_output_artifacts_exist();
-	load_state_json();
-	load_visible_json();
+	reload_if_changed_on_disk();
 
 	lower_third_cfg c = default_cfg();
-	while (get_by_id(c.id))
+	while (get_by_id_const(c.id))
 		c.id = new_id();
 
 	int maxOrder = -1;
@@ -2690,6 +5857,7 @@ std::string add_default_lower_third()
 	if (c.label.empty())
 		c.label = c.title.empty() ? c.id : c.title;
 
+	history_touch(c.id);
 	g_items.push_back(c);
 	std::sort(g_items.begin(), g_items.end(), [](const lower_third_cfg &a, const lower_third_cfg &b) {
 		if (a.order != b.order)
@@ -2702,8 +5870,9 @@ std::string add_default_lower_third()
 		return {};
 	save_visible_json();
 
-	if (!rebuild_and_swap())
-		return {};
+	const rebuild_ticket ticket = request_rebuild();
+	if (rebuild)
+		*rebuild = ticket;
 
 	{
 		core_event l;
@@ -2724,14 +5893,13 @@ std::string add_default_lower_third()
 	return c.id;
 }
 
-std::string clone_lower_third(const std::string &id)
+std::string clone_lower_third(const std::string &id, rebuild_ticket *rebuild)
 {
 	if (!has_output_dir())
 		return {};
 
 	ensure_output_artifacts_exist();
-	load_state_json();
-	load_visible_json();
+	reload_if_changed_on_disk();
 
 	const std::string sid = sanitize_id(id);
 	lower_third_cfg *src = get_by_id(sid);
@@ -2740,7 +5908,7 @@ std::string clone_lower_third(const std::string &id)
 
 	lower_third_cfg c = *src;
 	c.id = new_id();
-	while (get_by_id(c.id))
+	while (get_by_id_const(c.id))
 		c.id = new_id();
 
 	if (!c.title.empty())
@@ -2753,41 +5921,12 @@ std::string clone_lower_third(const std::string &id)
 	else
 		c.label += " (Copy)";
 
-	if (!c.profile_picture.empty()) {
-		const std::string srcRel = c.profile_picture;
-		const std::string srcPath = output_dir() + "/" + srcRel;
-
-		std::string ext;
-		const auto dot = srcRel.find_last_of('.');
-		if (dot != std::string::npos && dot + 1 < srcRel.size())
-			ext = srcRel.substr(dot + 1);
-
-		using namespace std::chrono;
-		const auto ts = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
-		std::string newName = c.id + "_" + std::to_string((long long)ts);
-		if (!ext.empty())
-			newName += "." + ext;
-
-		const std::string dstPath = output_dir() + "/" + newName;
-
-		std::error_code ec;
-		if (std::filesystem::exists(std::filesystem::path(srcPath), ec) && !ec) {
-			ec.clear();
-			std::filesystem::copy_file(std::filesystem::path(srcPath), std::filesystem::path(dstPath),
-						   std::filesystem::copy_options::overwrite_existing, ec);
-			if (!ec) {
-				c.profile_picture = newName;
-			} else {
-				LOGW("clone_lower_third: failed to copy profile picture '%s' -> '%s' (%d)",
-				     srcPath.c_str(), dstPath.c_str(), (int)ec.value());
-
-				c.profile_picture.clear();
-			}
-		} else {
-
-			c.profile_picture.clear();
-		}
-	}
+	// Pictures and sounds are shared with the source: files are only removed once nothing references
+	// them, so a clone needs no copy.
+	if (!c.profile_picture.empty() && !file_exists(output_dir() + "/" + c.profile_picture))
+		c.profile_picture.clear();
+	if (c.profile_picture.empty())
+		c.profile_picture_source.clear();
 
 	int maxOrder = -1;
 	for (const auto &it : g_items)
@@ -2796,6 +5935,7 @@ std::string clone_lower_third(const std::string &id)
 
 	const std::string newId = c.id;
 
+	history_touch(newId);
 	g_items.push_back(c);
 	std::sort(g_items.begin(), g_items.end(), [](const lower_third_cfg &a, const lower_third_cfg &b) {
 		if (a.order != b.order)
@@ -2808,8 +5948,9 @@ std::string clone_lower_third(const std::string &id)
 		return {};
 	save_visible_json();
 
-	if (!rebuild_and_swap())
-		return {};
+	const rebuild_ticket ticket = request_rebuild();
+	if (rebuild)
+		*rebuild = ticket;
 
 	{
 		core_event l;
@@ -2831,24 +5972,25 @@ std::string clone_lower_third(const std::string &id)
 	return newId;
 }
 
-bool remove_lower_third(const std::string &id)
+bool remove_lower_third(const std::string &id, rebuild_ticket *rebuild)
 {
 	if (!has_output_dir())
 		return false;
 
 	ensure_output_artifacts_exist();
-	load_state_json();
-	load_visible_json();
+	reload_if_changed_on_disk();
 
 	const std::string sid = sanitize_id(id);
 	const auto before = g_items.size();
 
 	std::string profileToDelete;
+	std::string profileSourceToDelete;
 	std::string animInSoundToDelete;
 	std::string animOutSoundToDelete;
 	for (const auto &c : g_items) {
 		if (c.id == sid) {
 			profileToDelete = c.profile_picture;
+			profileSourceToDelete = c.profile_picture_source;
 			animInSoundToDelete = c.anim_in_sound;
 			animOutSoundToDelete = c.anim_out_sound;
 			break;
@@ -2857,6 +5999,7 @@ bool remove_lower_third(const std::string &id)
 
 	const bool wasVisible = is_visible(sid);
 
+	history_touch(sid);
 	g_items.erase(std::remove_if(g_items.begin(), g_items.end(),
 				     [&](const lower_third_cfg &c) { return c.id == sid; }),
 		      g_items.end());
@@ -2865,22 +6008,11 @@ bool remove_lower_third(const std::string &id)
 	if (!removed)
 		return false;
 
-	if (!profileToDelete.empty()) {
-		const std::string fullPath = output_dir() + "/" + profileToDelete;
-		std::error_code ec;
-		(void)std::filesystem::remove(std::filesystem::path(fullPath), ec);
-	}
-
-	if (!animInSoundToDelete.empty()) {
-		const std::string fullPath = output_dir() + "/" + animInSoundToDelete;
-		std::error_code ec;
-		(void)std::filesystem::remove(std::filesystem::path(fullPath), ec);
-	}
-	if (!animOutSoundToDelete.empty()) {
-		const std::string fullPath = output_dir() + "/" + animOutSoundToDelete;
-		std::error_code ec;
-		(void)std::filesystem::remove(std::filesystem::path(fullPath), ec);
-	}
+	// Kept on disk while the deletion can still be undone.
+	history_defer_file_removal(profileToDelete);
+	history_defer_file_removal(profileSourceToDelete);
+	history_defer_file_removal(animInSoundToDelete);
+	history_defer_file_removal(animOutSoundToDelete);
 
 	set_visible_nosave(sid, false);
 
@@ -2891,7 +6023,9 @@ bool remove_lower_third(const std::string &id)
 	save_state_json();
 	save_visible_json();
 
-	const bool ok = rebuild_and_swap();
+	const rebuild_ticket ticket = request_rebuild();
+	if (rebuild)
+		*rebuild = ticket;
 
 	{
 		core_event l;
@@ -2911,7 +6045,7 @@ bool remove_lower_third(const std::string &id)
 		}
 	}
 
-	return ok;
+	return true;
 }
 
 bool move_lower_third(const std::string &id, int delta)
@@ -2920,8 +6054,7 @@ bool move_lower_third(const std::string &id, int delta)
 		return false;
 
 	ensure_output_artifacts_exist();
-	load_state_json();
-	load_visible_json();
+	reload_if_changed_on_disk();
 
 	const std::string sid = sanitize_id(id);
 	if (sid.empty())
@@ -2944,6 +6077,7 @@ bool move_lower_third(const std::string &id, int delta)
 	if (newIdx < 0 || newIdx >= (int)g_items.size())
 		return false;
 
+	history_touch_all(); // orders are renumbered
 	std::swap(g_items[(size_t)idx], g_items[(size_t)newIdx]);
 	for (int i = 0; i < (int)g_items.size(); ++i)
 		g_items[(size_t)i].order = i;
@@ -2967,8 +6101,7 @@ bool sort_lower_thirds_by_group()
 		return false;
 
 	ensure_output_artifacts_exist();
-	load_state_json();
-	load_visible_json();
+	reload_if_changed_on_disk();
 
 	if (g_items.size() < 2)
 		return true;
@@ -3015,6 +6148,7 @@ bool sort_lower_thirds_by_group()
 		return a.original_index < b.original_index;
 	});
 
+	history_touch_all();
 	for (size_t i = 0; i < tmp.size(); ++i) {
 		g_items[i] = std::move(tmp[i].cfg);
 		g_items[i].order = (int)i;
@@ -3033,5 +6167,367 @@ bool sort_lower_thirds_by_group()
 	return true;
 }
 
+
+// -------------------------
+// Instanced rows (CRUD)
+// -------------------------
+// Row edits only rewrite lt-state.json and lt-rows.json: the bundle holds the item's template, not
+// its rows. The exception is an item whose CSS or JS uses row placeholders: those hold the active
+// row's values, so a change of the active row or of its data requests a rebuild.
+
+static lower_third_cfg *instanced_target(const std::string &id)
+{
+	if (!has_output_dir())
+		return nullptr;
+
+	ensure_output_artifacts_exist();
+	reload_if_changed_on_disk();
+
+	const std::string sid = sanitize_id(id);
+	return sid.empty() ? nullptr : get_by_id(sid);
+}
+
+static data_row active_row_copy(const lower_third_cfg &c)
+{
+	const data_row *r = active_row_of(c);
+	return r ? *r : data_row();
+}
+
+static void rebuild_if_active_row_baked(const lower_third_cfg &c, const data_row &before)
+{
+	const data_row after = active_row_copy(c);
+	const bool same = before.id == after.id && before.title == after.title && before.subtitle == after.subtitle &&
+			  before.profile_picture == after.profile_picture;
+	if (!same && row_placeholders_outside_html(c))
+		request_rebuild();
+}
+
+static bool persist_rows(const lower_third_cfg &c, const data_row &activeBefore)
+{
+	if (!save_state_json())
+		return false;
+	rebuild_if_active_row_baked(c, activeBefore);
+	emit_list_change(list_change_reason::Update, c.id);
+	return true;
+}
+
+bool set_rows(const std::string &id, std::vector<data_row> rows)
+{
+	lower_third_cfg *c = instanced_target(id);
+	if (!c)
+		return false;
+
+	for (auto &r : rows)
+		r.profile_picture = import_picture(r.profile_picture);
+	const data_row before = active_row_copy(*c);
+	c->rows = std::move(rows);
+	normalize_rows(*c);
+	return persist_rows(*c, before);
+}
+
+std::string upsert_row(const std::string &id, data_row row)
+{
+	lower_third_cfg *c = instanced_target(id);
+	if (!c)
+		return {};
+
+	row.profile_picture = import_picture(row.profile_picture);
+
+	const data_row before = active_row_copy(*c);
+	const std::string rid = row.id.empty() ? std::string() : sanitize_id(row.id);
+	auto it = std::find_if(c->rows.begin(), c->rows.end(), [&rid](const data_row &r) { return r.id == rid; });
+	if (it != c->rows.end()) {
+		row.id = rid;
+		*it = std::move(row);
+	} else {
+		row.id = rid.empty() ? new_row_id() : rid;
+		c->rows.push_back(std::move(row));
+		it = c->rows.end() - 1;
+	}
+
+	const std::string out = it->id;
+	return persist_rows(*c, before) ? out : std::string();
+}
+
+bool remove_row(const std::string &id, const std::string &row_id)
+{
+	lower_third_cfg *c = instanced_target(id);
+	if (!c)
+		return false;
+
+	auto it = std::find_if(c->rows.begin(), c->rows.end(),
+			       [&row_id](const data_row &r) { return r.id == row_id; });
+	if (it == c->rows.end())
+		return false;
+
+	const data_row before = active_row_copy(*c);
+	c->rows.erase(it);
+	if (c->active_row == row_id)
+		c->active_row.clear();
+	return persist_rows(*c, before);
+}
+
+bool set_active_row(const std::string &id, const std::string &row_id)
+{
+	lower_third_cfg *c = instanced_target(id);
+	if (!c)
+		return false;
+
+	const bool known = std::any_of(c->rows.begin(), c->rows.end(),
+				       [&row_id](const data_row &r) { return r.id == row_id; });
+	if (!known)
+		return false;
+	if (c->active_row == row_id)
+		return true;
+
+	const data_row before = active_row_copy(*c);
+	c->active_row = row_id;
+	history_set_untracked(true); // a row switch is a playout action, not an edit to undo
+	const bool saved = save_state_json();
+	history_set_untracked(false);
+	if (!saved)
+		return false;
+	rebuild_if_active_row_baked(*c, before);
+
+	core_event ev;
+	ev.type = event_type::ActiveRowChanged;
+	ev.id = c->id;
+	ev.id2 = row_id;
+	emit_event(ev);
+	return true;
+}
+
+// -------------------------
+// Benchmarks
+// -------------------------
+
+// 'count' copies of the base item (or the built-in default) with distinct ids and texts, templates
+// materialized so workers only read them. UI thread.
+static bool benchmark_items(size_t count, const std::string &baseId, std::vector<lower_third_cfg> &out,
+			    std::string &error)
+{
+	QCoreApplication *app = QCoreApplication::instance();
+	if (app && QThread::currentThread() != app->thread()) {
+		bool ok = false;
+		QMetaObject::invokeMethod(
+			app, [&]() { ok = benchmark_items(count, baseId, out, error); }, Qt::BlockingQueuedConnection);
+		return ok;
+	}
+
+	lower_third_cfg base;
+	if (baseId.empty()) {
+		base = default_cfg();
+	} else if (const lower_third_cfg *c = get_by_id_const(baseId)) {
+		base = *c;
+	} else {
+		error = "unknown base id";
+		return false;
+	}
+	(void)base.html_template.str();
+	(void)base.css_template.str();
+	(void)base.js_template.str();
+	base.native = false;
+	base.hotkey.clear();
+
+	out.clear();
+	out.reserve(count);
+	for (size_t i = 0; i < count; ++i) {
+		lower_third_cfg c = base;
+		c.id = "bench" + std::to_string(i);
+		c.order = (int)i;
+		c.title = "Benchmark " + std::to_string(i);
+		c.subtitle = "Item " + std::to_string(i) + " of " + std::to_string(count);
+		out.push_back(std::move(c));
+	}
+	return true;
+}
+
+render_benchmark benchmark_render(size_t items, size_t max_workers, int repeats, const std::string &base_id)
+{
+	render_benchmark b;
+	b.items = items;
+	if (items == 0) {
+		b.error = "items must be > 0";
+		return b;
+	}
+
+	render_snapshot snap;
+	if (!benchmark_items(items, base_id, snap.items, b.error))
+		return b;
+
+	const size_t hw = std::max<size_t>(1, (size_t)std::thread::hardware_concurrency());
+	const size_t top = std::min(max_workers ? max_workers : hw, std::min(hw, items));
+	repeats = std::max(1, repeats);
+
+	for (size_t w = 1; w <= top; ++w) {
+		snap.workers = w;
+		render_benchmark_run run;
+		run.workers = w;
+		for (int r = 0; r < repeats; ++r) {
+			rendered_bundle out;
+			const auto t0 = std::chrono::steady_clock::now();
+			render_bundle(snap, "0", out, phase1_use::Off);
+			const double ms =
+				std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+			if (r == 0 || ms < run.ms)
+				run.ms = ms;
+			run.bytes = out.css.size() + out.js.size() + out.html.size();
+			run.css_chunks = out.css.allocations();
+			run.js_chunks = out.js.allocations();
+			run.html_chunks = out.html.allocations();
+		}
+		b.runs.push_back(run);
+	}
+
+	LOGI("Render benchmark: %zu items, 1..%zu workers, best of %d", items, top, repeats);
+	b.ok = true;
+	return b;
+}
+
+// The lt-state.json document as save_state_json() built it before the streaming writer: a QJsonObject
+// tree serialized with toJson(Indented) and copied into a std::string. Only kept for the benchmark.
+static std::string state_json_via_document(const std::vector<lower_third_cfg> &items,
+					   const std::vector<group_cfg> &groups, size_t &byteArrayBytes)
+{
+	QJsonObject root;
+	root["version"] = 4;
+
+	QJsonArray arr;
+	for (const auto &c : items) {
+		QJsonObject o;
+		o["id"] = QString::fromStdString(c.id);
+		o["label"] = QString::fromStdString(c.label);
+		o["order"] = c.order;
+		o["title"] = QString::fromStdString(c.title);
+		o["subtitle"] = QString::fromStdString(c.subtitle);
+		o["profile_picture"] = QString::fromStdString(c.profile_picture);
+		o["anim_in_sound"] = QString::fromStdString(c.anim_in_sound);
+		o["anim_out_sound"] = QString::fromStdString(c.anim_out_sound);
+
+		o["title_size"] = c.title_size;
+		o["subtitle_size"] = c.subtitle_size;
+		o["avatar_width"] = c.avatar_width;
+		o["avatar_height"] = c.avatar_height;
+
+		o["anim_in"] = QString::fromStdString(c.anim_in.str());
+		o["anim_out"] = QString::fromStdString(c.anim_out.str());
+
+		o["font_family"] = QString::fromStdString(c.font_family);
+		o["lt_position"] = QString::fromStdString(c.lt_position.str());
+
+		o["primary_color"] = QString::fromStdString(c.primary_color.str());
+		o["secondary_color"] = QString::fromStdString(c.secondary_color.str());
+		o["title_color"] = QString::fromStdString(c.title_color.str());
+		o["subtitle_color"] = QString::fromStdString(c.subtitle_color.str());
+
+		o["bg_color"] = QString::fromStdString(c.primary_color.str());
+		o["text_color"] = QString::fromStdString(c.title_color.str());
+		o["opacity"] = c.opacity;
+		o["radius"] = c.radius;
+
+		o["html_template"] = QString::fromStdString(c.html_template.str());
+		o["css_template"] = QString::fromStdString(c.css_template.str());
+		o["js_template"] = QString::fromStdString(c.js_template.str());
+		o["api_bridge_enabled"] = c.api_bridge_enabled;
+		o["api_template"] = QString::fromStdString(c.api_template);
+
+		o["hotkey"] = QString::fromStdString(c.hotkey);
+		o["repeat_every_sec"] = c.repeat_every_sec;
+		o["repeat_visible_sec"] = c.repeat_visible_sec;
+
+		arr.append(o);
+	}
+
+	QJsonArray garr;
+	for (const auto &c : groups) {
+		QJsonObject o;
+		o["id"] = QString::fromStdString(c.id);
+		o["title"] = QString::fromStdString(c.title);
+		o["order"] = c.order;
+		o["order_mode"] = c.order_mode;
+		o["loop"] = c.loop;
+		o["exclusive"] = c.exclusive;
+		o["toggle_hotkey"] = QString::fromStdString(c.toggle_hotkey);
+		o["visible_ms"] = c.visible_ms;
+		o["interval_ms"] = c.interval_ms;
+		o["dock_color"] = QString::fromStdString(c.dock_color);
+
+		QJsonArray mem;
+		for (const auto &mid : c.members)
+			mem.append(QString::fromStdString(mid));
+		o["members"] = mem;
+
+		garr.append(o);
+	}
+	root["groups"] = garr;
+	root["items"] = arr;
+
+	QJsonObject hkItems;
+	for (const auto &c : items) {
+		if (!c.hotkey.empty())
+			hkItems[QString::fromStdString(c.id)] = QString::fromStdString(c.hotkey);
+	}
+	QJsonObject hkGroups;
+	for (const auto &g : groups) {
+		if (!g.toggle_hotkey.empty())
+			hkGroups[QString::fromStdString(g.id)] = QString::fromStdString(g.toggle_hotkey);
+	}
+	QJsonObject hkRoot;
+	hkRoot["items"] = hkItems;
+	hkRoot["groups"] = hkGroups;
+	root["hotkeys"] = hkRoot;
+
+	const QByteArray bytes = QJsonDocument(root).toJson(QJsonDocument::Indented);
+	byteArrayBytes = (size_t)bytes.size();
+	return bytes.toStdString();
+}
+
+state_save_benchmark benchmark_state_save(size_t items, int repeats, const std::string &base_id)
+{
+	state_save_benchmark b;
+	b.items = items;
+	if (items == 0) {
+		b.error = "items must be > 0";
+		return b;
+	}
+
+	std::vector<lower_third_cfg> list;
+	if (!benchmark_items(items, base_id, list, b.error))
+		return b;
+	const std::vector<group_cfg> noGroups;
+	const std::vector<rule_cfg> noRules;
+	repeats = std::max(1, repeats);
+
+	for (int r = 0; r < repeats; ++r) {
+		const auto t0 = std::chrono::steady_clock::now();
+		out_buffer buf;
+		write_state_json(buf, list, noGroups, noRules);
+		const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+		if (r == 0 || ms < b.stream_ms)
+			b.stream_ms = ms;
+		b.stream_bytes = buf.size();
+		b.stream_chunk_allocations = buf.allocations();
+		b.stream_peak_bytes = buf.capacity();
+	}
+
+	for (int r = 0; r < repeats; ++r) {
+		const auto t0 = std::chrono::steady_clock::now();
+		size_t byteArrayBytes = 0;
+		const std::string doc = state_json_via_document(list, noGroups, byteArrayBytes);
+		const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+		if (r == 0 || ms < b.dom_ms)
+			b.dom_ms = ms;
+		b.dom_bytes = doc.size();
+		// At toStdString() the tree, the QByteArray and the std::string are all alive.
+		b.dom_peak_bytes = 2 * b.stream_bytes + byteArrayBytes + doc.size();
+	}
+
+	LOGI("State save benchmark: %zu items, stream %.2f ms / %llu bytes peak, document %.2f ms / %llu bytes peak",
+	     items, b.stream_ms, (unsigned long long)b.stream_peak_bytes, b.dom_ms,
+	     (unsigned long long)b.dom_peak_bytes);
+	b.ok = true;
+	return b;
+}
+
 } // namespace vflow
 
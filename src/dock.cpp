@@ -3,6 +3,10 @@
 #include "dock.hpp"
 
 #include "core.hpp"
+#include "history.hpp"
+#include "import.hpp"
+#include "profiles.hpp"
+#include "scheduler.hpp"
 #include "settings.hpp"
 #include "widget.hpp"
 
@@ -16,6 +20,7 @@
 #include <QAbstractItemView>
 #include <QColorDialog>
 #include <QDialog>
+#include <QDialogButtonBox>
 #include <QFormLayout>
 #include <QListWidget>
 #include <QLabel>
@@ -28,6 +33,7 @@
 #include <QFileDialog>
 #include <QStyle>
 #include <QFrame>
+#include <QHeaderView>
 #include <QEvent>
 #include <QShortcut>
 #include <QMouseEvent>
@@ -36,7 +42,6 @@
 #include <QVariant>
 #include <QSizePolicy>
 #include <QTimer>
-#include <QDateTime>
 #include <QComboBox>
 #include <QSpinBox>
 #include <QMetaObject>
@@ -44,24 +49,12 @@
 #include <QAbstractButton>
 #include <QDesktopServices>
 #include <QMessageBox>
-#include <QRandomGenerator>
 #include <QKeySequenceEdit>
 #include <QSettings>
+#include <QTableWidget>
 
 static QWidget *g_dockWidget = nullptr;
 
-struct GroupRuntime {
-	bool running = false;
-	int index = 0;
-	bool phaseShow = true;
-	QString currentId;
-	qint64 hideAtMs = 0;
-	QVector<int> seq;
-};
-
-static QHash<QString, GroupRuntime> g_groupRuns;
-static QHash<QString, qint64> g_groupHideAtMs;
-
 static constexpr const char *kDockUiSettingsGroup = "LowerThirdDock";
 static constexpr const char *kDockUiCarouselVisibleKey = "widgetCarouselVisible";
 
@@ -130,133 +123,6 @@ static void updateWidgetCarouselToggleUi(QPushButton *btn, QWidget *carousel, QS
 	btn->blockSignals(false);
 }
 
-static void stopGroupRun(const QString &groupId)
-{
-	auto it = g_groupRuns.find(groupId);
-	if (it == g_groupRuns.end())
-		return;
-
-	if (!it->currentId.isEmpty()) {
-		g_groupHideAtMs.remove(it->currentId);
-		vflow::set_visible_persist(it->currentId.toStdString(), false);
-	}
-
-	it->running = false;
-	it->index = 0;
-	it->phaseShow = true;
-	it->currentId.clear();
-	it->hideAtMs = 0;
-	it->seq.clear();
-}
-
-static void scheduleGroupStep(vflow::ui::LowerThirdDock *dock, const QString &groupId);
-
-static void startGroupRun(vflow::ui::LowerThirdDock *dock, const QString &groupId)
-{
-	if (!dock)
-		return;
-
-	auto *car = vflow::get_group_by_id(groupId.toStdString());
-	if (!car || car->members.empty())
-		return;
-
-	auto &rt = g_groupRuns[groupId];
-	rt.running = true;
-	rt.index = 0;
-	rt.phaseShow = true;
-	rt.currentId.clear();
-	rt.hideAtMs = 0;
-	rt.seq.clear();
-
-	scheduleGroupStep(dock, groupId);
-}
-
-static void scheduleGroupStep(vflow::ui::LowerThirdDock *dock, const QString &groupId)
-{
-	if (!dock)
-		return;
-
-	auto it = g_groupRuns.find(groupId);
-	if (it == g_groupRuns.end() || !it->running)
-		return;
-
-	auto *car = vflow::get_group_by_id(groupId.toStdString());
-	if (!car || car->members.empty()) {
-		stopGroupRun(groupId);
-		return;
-	}
-
-	const int visibleMs = std::max(0, car->visible_ms);
-	const int intervalMs = std::max(0, car->interval_ms);
-	const int count = (int)car->members.size();
-
-	if (it->seq.size() != count) {
-		it->seq.clear();
-		it->seq.reserve(count);
-		for (int i = 0; i < count; ++i)
-			it->seq.push_back(i);
-		if (car->order_mode == 1) {
-			auto *rng = QRandomGenerator::global();
-			for (int i = count - 1; i > 0; --i) {
-				const int j = (int)rng->bounded((quint32)(i + 1));
-				std::swap(it->seq[i], it->seq[j]);
-			}
-		}
-		it->index = 0;
-	}
-
-	if (it->phaseShow) {
-		if (!it->currentId.isEmpty()) {
-			g_groupHideAtMs.remove(it->currentId);
-			vflow::set_visible_persist(it->currentId.toStdString(), false);
-		}
-
-		if (!car->loop && it->index >= count) {
-			stopGroupRun(groupId);
-			return;
-		}
-
-		if (it->index >= count) {
-			it->index = 0;
-			if (car->order_mode == 1) {
-				auto *rng = QRandomGenerator::global();
-				for (int i = count - 1; i > 0; --i) {
-					const int j = (int)rng->bounded((quint32)(i + 1));
-					std::swap(it->seq[i], it->seq[j]);
-				}
-			}
-		}
-
-		const int memberIdx = it->seq.value(it->index, 0);
-		const QString nextId = QString::fromStdString(car->members[(size_t)memberIdx]);
-		it->currentId = nextId;
-		it->hideAtMs = QDateTime::currentMSecsSinceEpoch() + (qint64)visibleMs;
-		g_groupHideAtMs[nextId] = it->hideAtMs;
-
-		vflow::set_visible_persist(nextId.toStdString(), true);
-
-		it->phaseShow = false;
-		QTimer::singleShot(visibleMs, dock, [dock, groupId]() { scheduleGroupStep(dock, groupId); });
-	} else {
-		if (!it->currentId.isEmpty()) {
-			g_groupHideAtMs.remove(it->currentId);
-			vflow::set_visible_persist(it->currentId.toStdString(), false);
-		}
-
-		it->currentId.clear();
-		it->hideAtMs = 0;
-		it->index++;
-
-		if (!car->loop && it->index >= count) {
-			stopGroupRun(groupId);
-			return;
-		}
-
-		it->phaseShow = true;
-		QTimer::singleShot(intervalMs, dock, [dock, groupId]() { scheduleGroupStep(dock, groupId); });
-	}
-}
-
 namespace vflow::ui {
 
 void LowerThirdDock::coreEventThunk(const vflow::core_event &ev, void *user)
@@ -309,7 +175,8 @@ void LowerThirdDock::onCoreEvent(const vflow::core_event &ev)
 	}
 
 	case vflow::event_type::ListChanged:
-	case vflow::event_type::Reloaded: {
+	case vflow::event_type::Reloaded:
+	case vflow::event_type::ActiveRowChanged: {
 		rebuildList();
 		updateRowCountdowns();
 		break;
@@ -445,7 +312,15 @@ QScrollArea#LowerThirdContent QPushButton:hover { background: rgba(255,255,255,0
 		outputBrowseBtn->setFlat(true);
 		outputBrowseBtn->setIcon(st->standardIcon(QStyle::SP_DirOpenIcon));
 
+		hotOutputBtn = new QPushButton(tr("RAM"), right);
+		hotOutputBtn->setCursor(Qt::PointingHandCursor);
+		hotOutputBtn->setCheckable(true);
+		hotOutputBtn->setFlat(true);
+		hotOutputBtn->setToolTip(tr("Serve live files from a RAM copy of the output folder;\n"
+					    "changes are checkpointed back to the folder every few seconds"));
+
 		rightRow->addWidget(outputPathEdit, 1);
+		rightRow->addWidget(hotOutputBtn);
 		rightRow->addWidget(outputBrowseBtn);
 
 		grid->addWidget(lbl, 0, 0);
@@ -454,6 +329,7 @@ QScrollArea#LowerThirdContent QPushButton:hover { background: rgba(255,255,255,0
 		rootLayout->addLayout(grid);
 
 		connect(outputBrowseBtn, &QPushButton::clicked, this, &LowerThirdDock::onBrowseOutputFolder);
+		connect(hotOutputBtn, &QPushButton::toggled, this, &LowerThirdDock::onHotOutputToggled);
 	}
 
 	{
@@ -489,7 +365,15 @@ QScrollArea#LowerThirdContent QPushButton:hover { background: rgba(255,255,255,0
 			refresh = st->standardIcon(QStyle::SP_BrowserReload);
 		refreshSourcesBtn->setIcon(refresh);
 
+		shardBtn = new QPushButton(tr("Zones"), right);
+		shardBtn->setCursor(Qt::PointingHandCursor);
+		shardBtn->setCheckable(true);
+		shardBtn->setFlat(true);
+		shardBtn->setToolTip(tr("Render each position (bottom left, top right, ...) in its own Browser Source,\n"
+					"sized to its zone and placed above the selected source in its scenes"));
+
 		rightRow->addWidget(browserSourceCombo, 1);
+		rightRow->addWidget(shardBtn);
 		rightRow->addWidget(refreshSourcesBtn);
 
 		grid->addWidget(lbl, 0, 0);
@@ -498,6 +382,7 @@ QScrollArea#LowerThirdContent QPushButton:hover { background: rgba(255,255,255,0
 		rootLayout->addLayout(grid);
 
 		connect(refreshSourcesBtn, &QPushButton::clicked, this, [this]() { populateBrowserSources(true); });
+		connect(shardBtn, &QPushButton::toggled, this, &LowerThirdDock::onShardToggled);
 		connect(browserSourceCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
 			&LowerThirdDock::onBrowserSourceChanged);
 	}
@@ -597,6 +482,37 @@ QScrollArea#LowerThirdContent QPushButton:hover { background: rgba(255,255,255,0
 		addBtn->setToolTip(tr("Add new lower third"));
 		addBtn->setFlat(true);
 
+		importBtn = new QPushButton(this);
+		importBtn->setCursor(Qt::PointingHandCursor);
+		importBtn->setToolTip(tr("Import lower thirds from CSV / JSON"));
+		importBtn->setFlat(true);
+		{
+			QIcon imp = QIcon::fromTheme(QStringLiteral("document-import"));
+			if (imp.isNull())
+				imp = st->standardIcon(QStyle::SP_DialogOpenButton);
+			importBtn->setIcon(imp);
+		}
+
+		undoBtn = new QPushButton(this);
+		undoBtn->setCursor(Qt::PointingHandCursor);
+		undoBtn->setFlat(true);
+		{
+			QIcon ico = QIcon::fromTheme(QStringLiteral("edit-undo"));
+			if (ico.isNull())
+				ico = st->standardIcon(QStyle::SP_ArrowBack);
+			undoBtn->setIcon(ico);
+		}
+
+		redoBtn = new QPushButton(this);
+		redoBtn->setCursor(Qt::PointingHandCursor);
+		redoBtn->setFlat(true);
+		{
+			QIcon ico = QIcon::fromTheme(QStringLiteral("edit-redo"));
+			if (ico.isNull())
+				ico = st->standardIcon(QStyle::SP_ArrowForward);
+			redoBtn->setIcon(ico);
+		}
+
 		manageGroupsBtn_ = new QPushButton(this);
 		manageGroupsBtn_->setCursor(Qt::PointingHandCursor);
 		manageGroupsBtn_->setToolTip(tr("Manage groups"));
@@ -616,6 +532,9 @@ QScrollArea#LowerThirdContent QPushButton:hover { background: rgba(255,255,255,0
 
 		row->addWidget(infoBtn);
 		row->addWidget(addBtn);
+		row->addWidget(importBtn);
+		row->addWidget(undoBtn);
+		row->addWidget(redoBtn);
 		row->addWidget(manageGroupsBtn_);
 		rootLayout->addLayout(row);
 
@@ -628,6 +547,17 @@ QScrollArea#LowerThirdContent QPushButton:hover { background: rgba(255,255,255,0
 		});
 
 		connect(addBtn, &QPushButton::clicked, this, &LowerThirdDock::onAddLowerThird);
+		connect(importBtn, &QPushButton::clicked, this, &LowerThirdDock::onImportLowerThirds);
+		connect(undoBtn, &QPushButton::clicked, this, &LowerThirdDock::onUndo);
+		connect(redoBtn, &QPushButton::clicked, this, &LowerThirdDock::onRedo);
+
+		// Scoped to the dock so OBS keeps its own Ctrl+Z elsewhere.
+		auto *undoSc = new QShortcut(QKeySequence::Undo, this);
+		undoSc->setContext(Qt::WidgetWithChildrenShortcut);
+		connect(undoSc, &QShortcut::activated, this, &LowerThirdDock::onUndo);
+		auto *redoSc = new QShortcut(QKeySequence::Redo, this);
+		redoSc->setContext(Qt::WidgetWithChildrenShortcut);
+		connect(redoSc, &QShortcut::activated, this, &LowerThirdDock::onRedo);
 		connect(manageGroupsBtn_, &QPushButton::clicked, this, &LowerThirdDock::onManageGroups);
 		connect(infoBtn, &QPushButton::clicked, this, [this]() { show_troubleshooting_dialog(this); });
 	}
@@ -637,6 +567,7 @@ QScrollArea#LowerThirdContent QPushButton:hover { background: rgba(255,255,255,0
 
 	const bool hasDir = vflow::has_output_dir();
 	addBtn->setEnabled(hasDir);
+	importBtn->setEnabled(hasDir);
 	if (browserSourceCombo)
 		browserSourceCombo->setEnabled(true);
 	if (refreshSourcesBtn)
@@ -646,12 +577,21 @@ QScrollArea#LowerThirdContent QPushButton:hover { background: rgba(255,255,255,0
 bool LowerThirdDock::init()
 {
 	if (vflow::has_output_dir())
-		outputPathEdit->setText(QString::fromStdString(vflow::output_dir()));
+		outputPathEdit->setText(QString::fromStdString(vflow::configured_output_dir()));
 	else
 		outputPathEdit->clear();
 
+	hotOutputBtn->blockSignals(true);
+	hotOutputBtn->setChecked(vflow::hot_output_enabled());
+	hotOutputBtn->blockSignals(false);
+
+	shardBtn->blockSignals(true);
+	shardBtn->setChecked(vflow::shard_by_position());
+	shardBtn->blockSignals(false);
+
 	const bool hasDir = vflow::has_output_dir();
 	addBtn->setEnabled(hasDir);
+	importBtn->setEnabled(hasDir);
 
 	if (hasDir)
 		vflow::ensure_output_artifacts_exist();
@@ -675,7 +615,7 @@ bool LowerThirdDock::init()
 		coreListenerToken_ = vflow::add_event_listener(&LowerThirdDock::coreEventThunk, this);
 	}
 
-	ensureRepeatTimerStarted();
+	ensureCountdownTimerStarted();
 	connectObsSignals();
 	return true;
 }
@@ -738,7 +678,7 @@ void LowerThirdDock::onBrowserSourceChanged(int index)
 	vflow::set_target_browser_source_name(name.toStdString());
 
 	if (!name.isEmpty() && vflow::has_output_dir()) {
-		vflow::rebuild_and_swap();
+		vflow::request_rebuild();
 	}
 
 	emit requestSave();
@@ -757,141 +697,19 @@ void LowerThirdDock::onBrowserSizeChanged()
 	emit requestSave();
 }
 
-void LowerThirdDock::ensureRepeatTimerStarted()
-{
-	if (repeatTimer_)
-		return;
-
-	repeatTimer_ = new QTimer(this);
-	repeatTimer_->setInterval(250);
-	connect(repeatTimer_, &QTimer::timeout, this, &LowerThirdDock::repeatTick);
-	repeatTimer_->start();
-
-	updateRowCountdowns();
-}
-
-void LowerThirdDock::repeatTick()
+void LowerThirdDock::ensureCountdownTimerStarted()
 {
-	if (!vflow::has_output_dir())
+	if (countdownTimer_)
 		return;
 
-	const qint64 now = QDateTime::currentMSecsSinceEpoch();
-
-	const auto &items = vflow::all();
-	{
-		QSet<QString> alive;
-		alive.reserve((int)items.size());
-		for (const auto &c : items)
-			alive.insert(QString::fromStdString(c.id));
-
-		for (auto it = nextOnMs_.begin(); it != nextOnMs_.end();) {
-			if (!alive.contains(it.key()))
-				it = nextOnMs_.erase(it);
-			else
-				++it;
-		}
-		for (auto it = offAtMs_.begin(); it != offAtMs_.end();) {
-			if (!alive.contains(it.key()))
-				it = offAtMs_.erase(it);
-			else
-				++it;
-		}
-		for (auto it = reShowAtMs_.begin(); it != reShowAtMs_.end();) {
-			if (!alive.contains(it.key()))
-				it = reShowAtMs_.erase(it);
-			else
-				++it;
-		}
-	}
-
-	for (const auto &c : items) {
-		const QString qid = QString::fromStdString(c.id);
-
-		{
-			const auto owners = vflow::groups_containing(c.id);
-			bool inRunningGroup = false;
-			for (const auto &gid : owners) {
-				const QString qgid = QString::fromStdString(gid);
-				auto grt = g_groupRuns.find(qgid);
-				if (grt != g_groupRuns.end() && grt->running) {
-					inRunningGroup = true;
-					break;
-				}
-			}
-			if (inRunningGroup) {
-				nextOnMs_.remove(qid);
-				offAtMs_.remove(qid);
-				reShowAtMs_.remove(qid);
-				continue;
-			}
-		}
-
-		const int every = c.repeat_every_sec;
-		int visibleSec = c.repeat_visible_sec;
-
-		if (every <= 0) {
-			nextOnMs_.remove(qid);
-
-			if (visibleSec <= 0) {
-				offAtMs_.remove(qid);
-				continue;
-			}
-
-			if (vflow::is_visible(c.id)) {
-				if (!offAtMs_.contains(qid))
-					offAtMs_[qid] = now + (qint64)visibleSec * 1000;
-			} else {
-				offAtMs_.remove(qid);
-			}
-
-		} else {
-			if (visibleSec <= 0)
-				visibleSec = 3;
-
-			if (!nextOnMs_.contains(qid))
-				nextOnMs_[qid] = now + (qint64)every * 1000;
-		}
-
-		if (offAtMs_.contains(qid) && now >= offAtMs_[qid]) {
-			offAtMs_.remove(qid);
-			if (vflow::is_visible(c.id)) {
-				vflow::set_visible_persist(c.id, false);
-				emit requestSave();
-			}
-		}
-
-		if (reShowAtMs_.contains(qid) && now >= reShowAtMs_[qid]) {
-			reShowAtMs_.remove(qid);
-			if (!vflow::is_visible(c.id)) {
-				vflow::set_visible_persist(c.id, true);
-				if (visibleSec > 0)
-					offAtMs_[qid] = now + (qint64)visibleSec * 1000;
-				emit requestSave();
-			}
-		}
-
-		if (every > 0 && nextOnMs_.contains(qid) && now >= nextOnMs_[qid]) {
-			qint64 next = nextOnMs_[qid];
-			const qint64 step = (qint64)every * 1000;
-			while (next <= now)
-				next += step;
-			nextOnMs_[qid] = next;
-
-			if (!vflow::is_visible(c.id)) {
-				vflow::set_visible_persist(c.id, true);
-				if (visibleSec > 0)
-					offAtMs_[qid] = now + (qint64)visibleSec * 1000;
-				emit requestSave();
-			} else {
-				if (!reShowAtMs_.contains(qid)) {
-					vflow::set_visible_persist(c.id, false);
-					offAtMs_.remove(qid);
-					reShowAtMs_[qid] = now + 150;
-					emit requestSave();
-				}
-			}
-		}
-	}
+	// Display only: repeats and group runs are timed by the core scheduler.
+	countdownTimer_ = new QTimer(this);
+	countdownTimer_->setInterval(500);
+	connect(countdownTimer_, &QTimer::timeout, this, [this]() {
+		if (isVisible())
+			updateRowCountdowns();
+	});
+	countdownTimer_->start();
 
 	updateRowCountdowns();
 }
@@ -904,14 +722,11 @@ void LowerThirdDock::onBrowseOutputFolder()
 
 	vflow::set_output_dir_and_load(dir.toStdString());
 
-	nextOnMs_.clear();
-	offAtMs_.clear();
-	reShowAtMs_.clear();
-
 	outputPathEdit->setText(dir);
 
 	const bool hasDir = vflow::has_output_dir();
 	addBtn->setEnabled(hasDir);
+	importBtn->setEnabled(hasDir);
 
 	populateBrowserSources(true);
 
@@ -921,6 +736,27 @@ void LowerThirdDock::onBrowseOutputFolder()
 	emit requestSave();
 }
 
+void LowerThirdDock::onHotOutputToggled(bool checked)
+{
+	// Reloads from the new location and repoints the browser source. Refused without a RAM-backed
+	// filesystem; the button then shows the actual setting again.
+	if (!vflow::set_hot_output_enabled(checked) && vflow::hot_output_enabled() != checked) {
+		hotOutputBtn->blockSignals(true);
+		hotOutputBtn->setChecked(vflow::hot_output_enabled());
+		hotOutputBtn->blockSignals(false);
+	}
+
+	rebuildList();
+	updateRowCountdowns();
+	updateRowActiveStyles();
+}
+
+void LowerThirdDock::onShardToggled(bool checked)
+{
+	// The next rebuild creates (or removes) the shard sources.
+	vflow::set_shard_by_position(checked);
+}
+
 void LowerThirdDock::onAddLowerThird()
 {
 	if (!vflow::has_output_dir())
@@ -932,6 +768,83 @@ void LowerThirdDock::onAddLowerThird()
 	emit requestSave();
 }
 
+void LowerThirdDock::onImportLowerThirds()
+{
+	if (!vflow::has_output_dir())
+		return;
+
+	const QString file = QFileDialog::getOpenFileName(
+		this, tr("Import Lower Thirds"), QString(),
+		tr("CSV / JSON (*.csv *.tsv *.txt *.json *.jsonl *.ndjson);;All files (*)"));
+	if (file.isEmpty())
+		return;
+
+	QDialog dlg(this);
+	dlg.setWindowTitle(tr("Import Lower Thirds"));
+	dlg.setModal(true);
+
+	auto *form = new QFormLayout(&dlg);
+
+	auto *fileLbl = new QLabel(QDir::toNativeSeparators(file), &dlg);
+	fileLbl->setWordWrap(true);
+	form->addRow(tr("File"), fileLbl);
+
+	auto *baseCmb = new QComboBox(&dlg);
+	baseCmb->addItem(tr("Default template"), QString());
+	for (const auto &c : vflow::all_const())
+		baseCmb->addItem(QString::fromStdString(c.label.empty() ? c.id : c.label), QString::fromStdString(c.id));
+	baseCmb->setToolTip(tr("Templates and styling are copied from this lower third"));
+	form->addRow(tr("Base"), baseCmb);
+
+	auto *groupCmb = new QComboBox(&dlg);
+	groupCmb->addItem(tr("None"), QString());
+	for (const auto &g : vflow::groups_const())
+		groupCmb->addItem(QString::fromStdString(g.title.empty() ? g.id : g.title), QString::fromStdString(g.id));
+	groupCmb->setToolTip(tr("Group for records without a \"group\" column"));
+	form->addRow(tr("Group"), groupCmb);
+
+	auto *visibleChk = new QCheckBox(tr("Show imported lower thirds"), &dlg);
+	form->addRow(QString(), visibleChk);
+
+	auto *help = new QLabel(tr("Columns / keys: id, label, title, subtitle, picture, group, hotkey."), &dlg);
+	help->setWordWrap(true);
+	help->setStyleSheet(QStringLiteral("color: rgba(255,255,255,0.65);"));
+	form->addRow(help);
+
+	auto *box = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, Qt::Horizontal, &dlg);
+	form->addRow(box);
+	connect(box, &QDialogButtonBox::accepted, &dlg, &QDialog::accept);
+	connect(box, &QDialogButtonBox::rejected, &dlg, &QDialog::reject);
+
+	if (dlg.exec() != QDialog::Accepted)
+		return;
+
+	vflow::import_options opt;
+	opt.base_id = baseCmb->currentData().toString().toStdString();
+	opt.group_id = groupCmb->currentData().toString().toStdString();
+	opt.visible = visibleChk->isChecked();
+
+	const vflow::import_result res = vflow::import_lower_thirds_file(file.toStdString(), opt);
+
+	if (res.ids.empty()) {
+		QMessageBox::warning(this, tr("Import Failed"), QString::fromStdString(res.error));
+		return;
+	}
+
+	QString msg = tr("Imported %1 lower third(s) in %2 ms.").arg((int)res.ids.size()).arg(res.elapsed_ms, 0, 'f', 0);
+	if (res.skipped)
+		msg += "\n" + tr("Skipped %1 empty or malformed record(s).").arg((int)res.skipped);
+	if (res.groups_created)
+		msg += "\n" + tr("Created %1 group(s).").arg((int)res.groups_created);
+	if (!res.ok)
+		msg += "\n\n" + QString::fromStdString(res.error);
+	QMessageBox::information(this, tr("Import Lower Thirds"), msg);
+
+	rebuildShortcuts();
+	updateRowCountdowns();
+	emit requestSave();
+}
+
 void LowerThirdDock::onManageGroups()
 {
 	if (!vflow::has_output_dir()) {
@@ -1103,10 +1016,7 @@ void LowerThirdDock::onManageGroups()
 			return;
 		}
 
-		bool running = false;
-		auto rt = g_groupRuns.find(qid);
-		if (rt != g_groupRuns.end())
-			running = rt->running;
+		const bool running = vflow::group_run_active(qid.toStdString());
 
 		bool hasMembers = false;
 		if (auto *car = vflow::get_group_by_id(qid.toStdString()))
@@ -1202,7 +1112,7 @@ void LowerThirdDock::onManageGroups()
 		if (res != QMessageBox::Yes)
 			return;
 
-		stopGroupRun(qid);
+		vflow::stop_group_run(qid.toStdString());
 		vflow::remove_group(qid.toStdString());
 		refreshList();
 		if (carList->count() > 0)
@@ -1217,7 +1127,7 @@ void LowerThirdDock::onManageGroups()
 		const QString qid = it->data(Qt::UserRole).toString();
 		if (qid.isEmpty())
 			return;
-		startGroupRun(this, qid);
+		vflow::start_group_run(qid.toStdString());
 		updateStartStopButtons();
 	});
 
@@ -1228,7 +1138,7 @@ void LowerThirdDock::onManageGroups()
 		const QString qid = it->data(Qt::UserRole).toString();
 		if (qid.isEmpty())
 			return;
-		stopGroupRun(qid);
+		vflow::stop_group_run(qid.toStdString());
 		updateStartStopButtons();
 	});
 
@@ -1317,7 +1227,7 @@ void LowerThirdDock::rebuildList()
 	}
 	rows.clear();
 
-	const auto &items = vflow::all();
+	const auto &items = vflow::all_const();
 	const QString outDir = QString::fromStdString(vflow::output_dir());
 
 	for (const auto &cfg : items) {
@@ -1382,7 +1292,11 @@ void LowerThirdDock::rebuildList()
 		labelColLayout->setContentsMargins(0, 0, 0, 0);
 		labelColLayout->setSpacing(0);
 
-		const QString displayLabel = QString::fromStdString(cfg.label.empty() ? cfg.title : cfg.label);
+		QString displayLabel = QString::fromStdString(cfg.label.empty() ? cfg.title : cfg.label);
+		if (cfg.instanced) {
+			if (const vflow::data_row *active = vflow::active_row_of(cfg))
+				displayLabel += QStringLiteral(" · ") + QString::fromStdString(active->title);
+		}
 		auto *label = new QLabel(displayLabel, labelCol);
 		label->setObjectName(QStringLiteral("sltRowLabel"));
 		label->setAlignment(Qt::AlignVCenter | Qt::AlignLeft);
@@ -1457,6 +1371,21 @@ void LowerThirdDock::rebuildList()
 		h->addWidget(downBtn);
 		h->addWidget(cloneBtn);
 		h->addWidget(settingsBtn);
+
+		if (cfg.instanced) {
+			auto *rowsBtn = new QPushButton(rowFrame);
+			rowsBtn->setCursor(Qt::PointingHandCursor);
+			rowsBtn->setIcon(st->standardIcon(QStyle::SP_FileDialogListView));
+			rowsBtn->setToolTip(tr("Edit data rows (%1)").arg((int)cfg.rows.size()));
+			rowsBtn->setFlat(true);
+			rowsBtn->setIconSize(QSize(16, 16));
+			h->addWidget(rowsBtn);
+			ui.rowsBtn = rowsBtn;
+
+			const QString rowsId = ui.id;
+			connect(rowsBtn, &QPushButton::clicked, this, [this, rowsId]() { handleEditRows(rowsId); });
+		}
+
 		h->addWidget(removeBtn);
 
 		listLayout->addWidget(rowFrame);
@@ -1493,6 +1422,41 @@ void LowerThirdDock::rebuildList()
 	rebuildShortcuts();
 	updateRowActiveStyles();
 	updateRowCountdowns();
+	updateHistoryButtons();
+}
+
+void LowerThirdDock::updateHistoryButtons()
+{
+	if (!undoBtn || !redoBtn)
+		return;
+
+	const vflow::history_info h = vflow::history_state();
+	undoBtn->setEnabled(h.undo_count > 0);
+	redoBtn->setEnabled(h.redo_count > 0);
+	undoBtn->setToolTip(h.undo_count ? tr("Undo: %1").arg(QString::fromStdString(h.undo_label)) : tr("Undo"));
+	redoBtn->setToolTip(h.redo_count ? tr("Redo: %1").arg(QString::fromStdString(h.redo_label)) : tr("Redo"));
+}
+
+void LowerThirdDock::onUndo()
+{
+	if (!vflow::can_undo())
+		return;
+
+	vflow::undo();
+
+	updateRowCountdowns();
+	emit requestSave();
+}
+
+void LowerThirdDock::onRedo()
+{
+	if (!vflow::can_redo())
+		return;
+
+	vflow::redo();
+
+	updateRowCountdowns();
+	emit requestSave();
 }
 
 void LowerThirdDock::updateRowActiveStyles()
@@ -1546,7 +1510,7 @@ void LowerThirdDock::rebuildShortcuts()
 {
 	clearShortcuts();
 
-	const auto &items = vflow::all();
+	const auto &items = vflow::all_const();
 	for (const auto &cfg : items) {
 		if (cfg.hotkey.empty())
 			continue;
@@ -1581,11 +1545,11 @@ void LowerThirdDock::rebuildShortcuts()
 		sc->setContext(Qt::ApplicationShortcut);
 		shortcuts_.push_back(sc);
 		connect(sc, &QShortcut::activated, this, [this, groupId]() {
-			auto it = g_groupRuns.find(groupId);
-			if (it != g_groupRuns.end() && it->running)
-				stopGroupRun(groupId);
+			const std::string gid = groupId.toStdString();
+			if (vflow::group_run_active(gid))
+				vflow::stop_group_run(gid);
 			else
-				startGroupRun(this, groupId);
+				vflow::start_group_run(gid);
 			updateRowCountdowns();
 			updateRowActiveStyles();
 		});
@@ -1596,53 +1560,13 @@ void LowerThirdDock::handleToggleVisible(const QString &id)
 {
 	const std::string sid = id.toStdString();
 
-	for (const auto &g : vflow::groups_const()) {
-		bool isMember = false;
-		for (const auto &m : g.members) {
-			if (m == sid) {
-				isMember = true;
-				break;
-			}
-		}
-		if (!isMember)
-			continue;
-
-		const QString groupId = QString::fromStdString(g.id);
-		auto it = g_groupRuns.find(groupId);
-		if (it != g_groupRuns.end() && it->running) {
-			stopGroupRun(groupId);
-		}
-	}
-	const bool wasVisible = vflow::is_visible(sid);
-	const bool ok = vflow::toggle_visible_persist(sid);
+	// A manual toggle takes the item out of any group run; the scheduler arms its automatic hide.
+	for (const auto &gid : vflow::groups_containing(sid))
+		vflow::stop_group_run(gid);
 
-	if (!ok)
+	if (!vflow::toggle_visible_persist(sid))
 		return;
 
-	const bool nowVisible = vflow::is_visible(sid);
-
-	if (!wasVisible && nowVisible) {
-		if (auto *cfg = vflow::get_by_id(sid)) {
-			const int every = cfg->repeat_every_sec;
-			int visibleSec = cfg->repeat_visible_sec;
-
-			if (every > 0 || visibleSec > 0) {
-				if (every > 0 && visibleSec <= 0)
-					visibleSec = 3;
-
-				if (visibleSec > 0) {
-					const qint64 now = QDateTime::currentMSecsSinceEpoch();
-					offAtMs_[id] = now + (qint64)visibleSec * 1000;
-				}
-
-				if (every > 0 && !nextOnMs_.contains(id)) {
-					const qint64 now = QDateTime::currentMSecsSinceEpoch();
-					nextOnMs_[id] = now + (qint64)every * 1000;
-				}
-			}
-		}
-	}
-
 	updateRowCountdowns();
 	emit requestSave();
 }
@@ -1669,6 +1593,124 @@ void LowerThirdDock::handleOpenSettings(const QString &id)
 	rebuildList();
 }
 
+void LowerThirdDock::handleEditRows(const QString &id)
+{
+	if (!vflow::has_output_dir())
+		return;
+
+	const std::string sid = id.toStdString();
+	const vflow::lower_third_cfg *cfg = vflow::get_by_id_const(sid);
+	if (!cfg || !cfg->instanced)
+		return;
+
+	QDialog dlg(this);
+	dlg.setWindowTitle(tr("Data Rows: %1").arg(QString::fromStdString(cfg->label.empty() ? cfg->id : cfg->label)));
+	dlg.setModal(true);
+	dlg.resize(720, 420);
+
+	auto *root = new QVBoxLayout(&dlg);
+
+	auto *table = new QTableWidget(0, 3, &dlg);
+	table->setHorizontalHeaderLabels({tr("Title"), tr("Subtitle"), tr("Picture")});
+	table->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+	table->verticalHeader()->setVisible(false);
+	table->setSelectionBehavior(QAbstractItemView::SelectRows);
+	table->setSelectionMode(QAbstractItemView::SingleSelection);
+	root->addWidget(table, 1);
+
+	const QString activeId = QString::fromStdString(cfg->active_row);
+
+	// Row id lives in the title cell's UserRole; empty for rows added in this dialog.
+	auto addRow = [table, activeId](const vflow::data_row &r) {
+		const int n = table->rowCount();
+		table->insertRow(n);
+
+		auto *title = new QTableWidgetItem(QString::fromStdString(r.title));
+		title->setData(Qt::UserRole, QString::fromStdString(r.id));
+		if (!r.id.empty() && QString::fromStdString(r.id) == activeId) {
+			QFont f = title->font();
+			f.setBold(true);
+			title->setFont(f);
+		}
+		table->setItem(n, 0, title);
+		table->setItem(n, 1, new QTableWidgetItem(QString::fromStdString(r.subtitle)));
+		table->setItem(n, 2, new QTableWidgetItem(QString::fromStdString(r.profile_picture)));
+	};
+
+	for (const auto &r : cfg->rows)
+		addRow(r);
+
+	auto *btns = new QHBoxLayout();
+	auto *btnAdd = new QPushButton(tr("Add"), &dlg);
+	btnAdd->setCursor(Qt::PointingHandCursor);
+	auto *btnDel = new QPushButton(tr("Remove"), &dlg);
+	btnDel->setCursor(Qt::PointingHandCursor);
+	auto *btnActive = new QPushButton(tr("Set active"), &dlg);
+	btnActive->setCursor(Qt::PointingHandCursor);
+	btnActive->setToolTip(tr("Save rows and show the selected row in the overlay"));
+	btns->addWidget(btnAdd);
+	btns->addWidget(btnDel);
+	btns->addStretch(1);
+	btns->addWidget(btnActive);
+	root->addLayout(btns);
+
+	auto *box = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, Qt::Horizontal, &dlg);
+	root->addWidget(box);
+
+	connect(btnAdd, &QPushButton::clicked, &dlg, [table, addRow]() {
+		addRow(vflow::data_row{});
+		table->setCurrentCell(table->rowCount() - 1, 0);
+		table->editItem(table->item(table->rowCount() - 1, 0));
+	});
+	connect(btnDel, &QPushButton::clicked, &dlg, [table]() {
+		const int r = table->currentRow();
+		if (r >= 0)
+			table->removeRow(r);
+	});
+
+	auto collect = [table]() {
+		std::vector<vflow::data_row> out;
+		out.reserve((size_t)table->rowCount());
+		for (int i = 0; i < table->rowCount(); ++i) {
+			auto text = [table, i](int col) {
+				auto *it = table->item(i, col);
+				return it ? it->text().trimmed().toStdString() : std::string();
+			};
+			vflow::data_row r;
+			if (auto *it = table->item(i, 0))
+				r.id = it->data(Qt::UserRole).toString().toStdString();
+			r.title = text(0);
+			r.subtitle = text(1);
+			r.profile_picture = text(2);
+			out.push_back(std::move(r));
+		}
+		return out;
+	};
+
+	connect(btnActive, &QPushButton::clicked, &dlg, [&dlg, table, collect, sid]() {
+		const int sel = table->currentRow();
+		if (sel < 0)
+			return;
+
+		// New rows get their ids from set_rows(); read the stored list back to resolve the selection.
+		vflow::set_rows(sid, collect());
+		const vflow::lower_third_cfg *c = vflow::get_by_id_const(sid);
+		if (c && sel < (int)c->rows.size())
+			vflow::set_active_row(sid, c->rows[(size_t)sel].id);
+		dlg.accept();
+	});
+
+	connect(box, &QDialogButtonBox::accepted, &dlg, [&dlg, collect, sid]() {
+		vflow::set_rows(sid, collect());
+		dlg.accept();
+	});
+	connect(box, &QDialogButtonBox::rejected, &dlg, &QDialog::reject);
+
+	dlg.exec();
+
+	rebuildList();
+}
+
 void LowerThirdDock::handleRemove(const QString &id)
 {
 	if (!vflow::has_output_dir())
@@ -1690,10 +1732,6 @@ void LowerThirdDock::handleRemove(const QString &id)
 
 	vflow::remove_lower_third(id.toStdString());
 
-	nextOnMs_.remove(id);
-	offAtMs_.remove(id);
-	reShowAtMs_.remove(id);
-
 	emit requestSave();
 }
 
@@ -1712,74 +1750,30 @@ void LowerThirdDock::updateRowCountdownFor(const LowerThirdRowUi &rowUi)
 	if (!rowUi.subLbl)
 		return;
 
-	const auto *cfg = vflow::get_by_id(rowUi.id.toStdString());
+	const auto *cfg = vflow::get_by_id_const(rowUi.id.toStdString());
 	if (!cfg) {
 		rowUi.subLbl->clear();
 		rowUi.subLbl->setVisible(false);
 		return;
 	}
 
-	const qint64 now = QDateTime::currentMSecsSinceEpoch();
-	const QString qid = rowUi.id;
-
-	if (g_groupHideAtMs.contains(qid) && vflow::is_visible(cfg->id)) {
-		rowUi.subLbl->setVisible(true);
-		const qint64 leftHide = g_groupHideAtMs.value(qid) - now;
-		rowUi.subLbl->setText(QStringLiteral("Hides in ") + formatCountdownMs(leftHide));
-		return;
-	}
-
-	const int every = cfg->repeat_every_sec;
-	const int keepVisible = cfg->repeat_visible_sec;
-
-	if (every <= 0) {
-		if (keepVisible <= 0) {
-			rowUi.subLbl->clear();
-			rowUi.subLbl->setVisible(false);
-			return;
-		}
-
-		const bool isVis = vflow::is_visible(cfg->id);
-		if (!isVis) {
-			rowUi.subLbl->clear();
-			rowUi.subLbl->setVisible(false);
-			return;
-		}
-
-		rowUi.subLbl->setVisible(true);
-
-		if (!offAtMs_.contains(qid))
-			offAtMs_[qid] = now + (qint64)keepVisible * 1000;
-
-		const qint64 leftHide = offAtMs_[qid] - now;
-		rowUi.subLbl->setText(QStringLiteral("Hides in ") + formatCountdownMs(leftHide));
-		return;
-	}
-
-	rowUi.subLbl->setVisible(true);
-
-	if (!nextOnMs_.contains(qid)) {
-		nextOnMs_[qid] = now + (qint64)every * 1000;
-	}
-
+	const vflow::repeat_status st = vflow::repeat_status_of(cfg->id);
 	const bool isVis = vflow::is_visible(cfg->id);
 
 	QStringList parts;
-
-	if (isVis && offAtMs_.contains(qid)) {
-		const qint64 leftHide = offAtMs_[qid] - now;
-		parts << (QStringLiteral("Hides in ") + formatCountdownMs(leftHide));
-	} else if (isVis) {
+	if (isVis && st.hide_in_ms >= 0)
+		parts << (QStringLiteral("Hides in ") + formatCountdownMs(st.hide_in_ms));
+	else if (isVis && cfg->repeat_every_sec > 0 && !st.in_group_run)
 		parts << QStringLiteral("Visible");
-	}
 
-	if (nextOnMs_.contains(qid)) {
-		const qint64 leftNext = nextOnMs_[qid] - now;
-		parts << (QStringLiteral("Next in ") + formatCountdownMs(leftNext));
-	} else {
-		parts << QStringLiteral("Repeating");
+	if (!st.in_group_run && cfg->repeat_every_sec > 0) {
+		if (st.next_in_ms >= 0)
+			parts << (QStringLiteral("Next in ") + formatCountdownMs(st.next_in_ms));
+		else
+			parts << QStringLiteral("Repeating");
 	}
 
+	rowUi.subLbl->setVisible(!parts.isEmpty());
 	rowUi.subLbl->setText(parts.join(QStringLiteral(" • ")));
 }
 
@@ -1850,9 +1844,17 @@ void LowerThirdDock::onSceneCollectionChanged()
 {
 	populateBrowserSources(false);
 
+	// A bound folder comes with its own bundle (the list follows from the reload event).
+	if (vflow::activate_collection_profile()) {
+		outputPathEdit->setText(QString::fromStdString(vflow::configured_output_dir()));
+		addBtn->setEnabled(true);
+		importBtn->setEnabled(true);
+		return;
+	}
+
 	const QString selected = QString::fromStdString(vflow::target_browser_source_name());
 	if (!selected.isEmpty() && vflow::has_output_dir()) {
-		vflow::rebuild_and_swap();
+		vflow::request_rebuild();
 	}
 }
 
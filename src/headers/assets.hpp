@@ -0,0 +1,59 @@
+// assets.hpp
+#pragma once
+
+#include <cstdint>
+#include <future>
+#include <string>
+#include <vector>
+
+namespace vflow {
+
+struct lower_third_cfg;
+
+// -------------------------
+// Asset store
+// -------------------------
+// Pictures and sounds live in output_dir as "asset_<content hash>.<ext>", so each distinct file is stored
+// once however many items, rows or clones use it. import_asset() hashes the source (cached by path, size
+// and mtime), reuses an existing byte-identical copy, else clones it in (copy-on-write where the
+// filesystem supports it, a plain copy otherwise; never a hardlink to the user's file). A hash collision
+// stores the content as "asset_<hash>-<n>.<ext>" instead of replacing the other file. Returns the file
+// name relative to output_dir, empty on failure. Asset files are never deleted directly: release_asset()
+// hands a no-longer-used name to the undo history, which removes it once nothing (items, rows, history)
+// references it, and collect_unused_assets() sweeps unreferenced asset_* files (run on load; any thread,
+// it runs on the UI thread). Names handed out in the last ten minutes and copies still in flight are kept,
+// so a picture a dialog stored but has not saved to an item yet survives a sweep.
+std::string import_asset(const std::string &srcPath);
+void release_asset(const std::string &rel);
+size_t collect_unused_assets(uint64_t *freedBytes = nullptr);
+// Output-dir files the page loads for an item: picture, sounds and row pictures.
+std::vector<std::string> page_files_of(const lower_third_cfg &c);
+
+// -------------------------
+// Image ingest
+// -------------------------
+// Profile pictures are stored pre-sized for the page. ingest_picture() stores the original with
+// import_asset(), decodes it (EXIF orientation applied; JPEGs decoded at reduced scale), resamples it to
+// cover 2x the avatar box, center-crops and re-encodes it (WebP when Qt has the plugin, else JPEG, PNG
+// for images with transparency) as a second asset. Pictures that already fit, animated images and
+// anything Qt cannot decode are used unchanged (picture == source). The original stays referenced by
+// lower_third_cfg::profile_picture_source so a new avatar size can be re-derived from it.
+// ingest_picture_async() runs the same on a worker thread; apply the result on the UI thread.
+struct picture_ingest_result {
+	std::string picture; // asset the page loads; empty on failure
+	std::string source;  // original asset
+	int src_width = 0, src_height = 0;
+	int width = 0, height = 0;
+	uint64_t src_bytes = 0, bytes = 0;
+	double elapsed_ms = 0.0;
+};
+
+picture_ingest_result ingest_picture(const std::string &srcPath, int avatarWidth, int avatarHeight);
+std::future<picture_ingest_result> ingest_picture_async(const std::string &srcPath, int avatarWidth,
+							int avatarHeight);
+// File to (re-)derive c's picture from: the stored original, else the picture itself; empty if none.
+std::string picture_source_path(const lower_third_cfg &c);
+// Points c at an ingest result and releases the pictures it replaces; false (c unchanged) on failure.
+bool assign_picture(lower_third_cfg &c, const picture_ingest_result &r);
+
+} // namespace vflow
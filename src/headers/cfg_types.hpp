@@ -0,0 +1,95 @@
+// cfg_types.hpp
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace vflow {
+
+// String for the small, repetitive vocabularies in lower_third_cfg (animation classes, position
+// classes). Vocabulary words (animate.css and lt-pos-* classes, up to a fixed table size) are interned:
+// ids are process-local and never freed, and equality is an integer compare. Anything else (custom
+// classes from templates or the API, verbatim colors) is held by the atom itself and freed with it, so
+// the table cannot grow without bound. Strings are produced only when serializing or rendering.
+// Thread-safe.
+class atom {
+public:
+	atom() = default; // ""
+	atom(std::string_view s);
+	atom(const std::string &s) : atom(std::string_view(s)) {}
+	atom(const char *s) : atom(std::string_view(s ? s : "")) {}
+
+	// Interned ids only (see the builtin table in cfg_types.cpp).
+	static atom from_id(uint32_t id)
+	{
+		atom a;
+		a.id_ = id;
+		return a;
+	}
+
+	const std::string &str() const;
+	operator const std::string &() const { return str(); }
+
+	// kOwnedId for strings outside the vocabularies.
+	uint32_t id() const { return id_; }
+	bool empty() const { return id_ == 0; }
+
+	bool operator==(const atom &o) const { return id_ == o.id_ && (id_ != kOwnedId || *own_ == *o.own_); }
+	bool operator!=(const atom &o) const { return !(*this == o); }
+
+	static constexpr uint32_t kOwnedId = UINT32_MAX;
+
+private:
+	uint32_t id_ = 0;
+	std::shared_ptr<const std::string> own_; // id_ == kOwnedId
+};
+
+// Pre-registered atoms; ids match the builtin table in cfg_types.cpp.
+inline const atom kAtomCustomIn = atom::from_id(1);         // "custom_handled_in"
+inline const atom kAtomCustomOut = atom::from_id(2);        // "custom_handled_out"
+inline const atom kAtomDefaultAnimIn = atom::from_id(3);    // "animate__fadeInUp"
+inline const atom kAtomDefaultAnimOut = atom::from_id(4);   // "animate__fadeOutDown"
+inline const atom kAtomDefaultPosition = atom::from_id(5);  // "lt-pos-bottom-left"
+
+// Packed RGBA color. "#rgb", "#rgba", "#rrggbb" and "#rrggbbaa" are stored as 0xRRGGBBAA plus the
+// digit count and letter case, so str() gives back the exact input; anything else (named colors,
+// rgb()/rgba(), mixed-case hex) is kept verbatim as an atom. Empty means "unset".
+class color_rgba {
+public:
+	color_rgba() = default;
+	color_rgba(std::string_view s);
+	color_rgba(const std::string &s) : color_rgba(std::string_view(s)) {}
+	color_rgba(const char *s) : color_rgba(std::string_view(s ? s : "")) {}
+
+	std::string str() const;
+	operator std::string() const { return str(); }
+
+	bool empty() const { return form_ == kEmpty; }
+	bool is_hex() const { return form_ != kEmpty && form_ != kVerbatim; }
+	// 0xRRGGBBAA (alpha 0xFF when the input had none); 0 unless is_hex().
+	uint32_t rgba() const { return is_hex() ? bits_ : 0; }
+
+	// Compact serialization of the hex forms (lt-state.bin): hex_form() is 0 for empty/verbatim colors,
+	// which must be stored as str() instead. from_packed() returns an empty color for an invalid form.
+	uint8_t hex_form() const { return is_hex() ? form_ : 0; }
+	static color_rgba from_packed(uint32_t rgba, uint8_t hexForm);
+
+	bool operator==(const color_rgba &o) const
+	{
+		return bits_ == o.bits_ && form_ == o.form_ && (form_ != kVerbatim || verbatim_ == o.verbatim_);
+	}
+	bool operator!=(const color_rgba &o) const { return !(*this == o); }
+
+private:
+	static constexpr uint8_t kEmpty = 0;
+	static constexpr uint8_t kVerbatim = 0xFF; // text in verbatim_
+	static constexpr uint8_t kUpper = 0x10;    // OR'd with the digit count (3, 4, 6 or 8)
+
+	uint32_t bits_ = 0;
+	uint8_t form_ = kEmpty;
+	atom verbatim_;
+};
+
+} // namespace vflow
@@ -2,14 +2,19 @@
 #pragma once
 
 #include <string>
+#include <utility>
 #include <vector>
 #include <cstdint>
+#include <future>
+#include <iosfwd>
+#include <memory>
 
 #include <obs.h>
 #include <obs-module.h>
 
 #include <QJsonObject>
 #include "config.hpp"
+#include "cfg_types.hpp"
 
 #ifndef LOG_TAG
 #define LOG_TAG "[" PLUGIN_NAME "]"
@@ -30,11 +35,94 @@ inline constexpr const char *sltBrowserSourceName = "VinciFlow Source";
 inline constexpr int sltBrowserWidth = 1920;
 inline constexpr int sltBrowserHeight = 1080;
 
+// Accepted avatar sizes; loaders, imports and the settings spin boxes all clamp to this range.
+inline constexpr int kAvatarMinPx = 10;
+inline constexpr int kAvatarMaxPx = 400;
+
 inline constexpr const char *sltDockId = "vflow_dock";
 inline constexpr const char *sltDockTitle = "VinciFlow Controller";
 
 namespace vflow {
 
+// Mapped lt-state.bin (see load_state_json). Opaque outside core.cpp.
+struct state_blob;
+
+// Returns the shared, immutable copy of a template body. Bodies are interned by content hash, so every
+// item using the same text points at one allocation; it is freed when the last user lets go.
+// Returns null for an empty body. Thread-safe.
+std::shared_ptr<const std::string> intern_template(std::string s);
+
+// Template body (html/css/js), held as an interned flyweight: copies (clones, dialog and render
+// snapshots) share one body, and assigning new text interns it rather than mutating the shared one.
+// When state comes from the binary snapshot the text still lives in the mapped file and is decoded on
+// first access; copies share the mapping until they are materialized.
+// First access is not synchronized: materialize on the UI thread before handing copies to workers.
+class template_text {
+public:
+	template_text() = default;
+	template_text(std::string s) : text_(intern_template(std::move(s))) {}
+	template_text(std::shared_ptr<const state_blob> blob, size_t off, size_t len)
+		: blob_(std::move(blob)), off_(off), len_(len)
+	{
+	}
+
+	template_text &operator=(std::string s)
+	{
+		text_ = intern_template(std::move(s));
+		blob_.reset();
+		return *this;
+	}
+
+	const std::string &str() const { return shared() ? *text_ : empty_text(); }
+	operator const std::string &() const { return str(); }
+
+	// The interned body (null when empty). Identity is content equality, so callers may cache on it.
+	const std::shared_ptr<const std::string> &shared() const
+	{
+		if (blob_)
+			materialize();
+		return text_;
+	}
+
+	// Content equality as a pointer compare (the same still-mapped range compares equal without decoding).
+	bool same_as(const template_text &o) const
+	{
+		if (blob_ && blob_ == o.blob_ && off_ == o.off_ && len_ == o.len_)
+			return true;
+		return shared() == o.shared();
+	}
+
+	size_t size() const { return blob_ ? len_ : (text_ ? text_->size() : 0); }
+	bool empty() const { return size() == 0; }
+	bool is_lazy() const { return (bool)blob_; }
+	void clear()
+	{
+		text_.reset();
+		blob_.reset();
+	}
+
+private:
+	void materialize() const;
+	static const std::string &empty_text()
+	{
+		static const std::string kEmpty;
+		return kEmpty;
+	}
+
+	mutable std::shared_ptr<const std::string> text_;
+	mutable std::shared_ptr<const state_blob> blob_;
+	size_t off_ = 0;
+	size_t len_ = 0;
+};
+
+// One data row of an instanced lower third (see "Instanced items" below).
+struct data_row {
+	std::string id; // unique within the item
+	std::string title;
+	std::string subtitle;
+	std::string profile_picture; // file name in output_dir, like lower_third_cfg::profile_picture
+};
+
 struct lower_third_cfg {
 	std::string id;
 	// Display-only label for the dock list (does not affect overlay content)
@@ -45,35 +133,41 @@ struct lower_third_cfg {
 	std::string title;
 	std::string subtitle;
 	std::string profile_picture;
+	// Original the profile picture was resampled from (ingest_picture, assets.hpp); empty if stored as-is.
+	std::string profile_picture_source;
 
 	// Optional audio cues (copied into output_dir; stored as filename)
 	std::string anim_in_sound;
 	std::string anim_out_sound;
 
-	// Optional font sizes (px). Used by {{TITLE_SIZE}} / {{SUBTITLE_SIZE}} placeholders.
-	int title_size = 46;
-	int subtitle_size = 24;
-
-	// Optional avatar size (px). Used by {{AVATAR_WIDTH}} / {{AVATAR_HEIGHT}} placeholders.
-	int avatar_width = 100;
-	int avatar_height = 100;
-
-	std::string anim_in;  // animate.css class OR "custom_handled_in"
-	std::string anim_out; // animate.css class OR "custom_handled_out"
-
 	std::string font_family;
-	std::string lt_position; // class name: e.g. "lt-pos-bottom-left"
-
-	std::string primary_color;
-	std::string secondary_color;
-	std::string title_color;
-	std::string subtitle_color;
-	int opacity = 85; // 0..100
-	int radius  = 5;  // 0..100
 
-	std::string html_template; // inner HTML for <li id="{{ID}}">
-	std::string css_template;  // should be scoped to #{{ID}} (we also do best-effort)
-	std::string js_template;   // wrapped with root = document.getElementById("{{ID}}")
+	// Animation / position classes, interned (see cfg_types.hpp). Compare against kAtom* constants.
+	atom anim_in;     // animate.css class OR "custom_handled_in"
+	atom anim_out;    // animate.css class OR "custom_handled_out"
+	atom lt_position; // class name: e.g. "lt-pos-bottom-left"
+
+	// Packed colors; str() reproduces the stored text exactly.
+	color_rgba primary_color;
+	color_rgba secondary_color;
+	color_rgba title_color;
+	color_rgba subtitle_color;
+
+	// Small ints, packed. Ranges are enforced where values are read (loaders, settings dialog).
+	// Optional font sizes (px, 6..200). Used by {{TITLE_SIZE}} / {{SUBTITLE_SIZE}} placeholders.
+	uint8_t title_size = 46;
+	uint8_t subtitle_size = 24;
+	uint8_t opacity = 85; // 0..100
+	uint8_t radius  = 5;  // 0..100
+
+	// Optional avatar size (px), kAvatarMinPx..kAvatarMaxPx. Used by {{AVATAR_WIDTH}} / {{AVATAR_HEIGHT}}
+	// placeholders.
+	uint16_t avatar_width = 100;
+	uint16_t avatar_height = 100;
+
+	template_text html_template; // inner HTML for <li id="{{ID}}">
+	template_text css_template;  // should be scoped to #{{ID}} (we also do best-effort)
+	template_text js_template;   // wrapped with root = document.getElementById("{{ID}}")
 
 	// API Bridge: when enabled, the core maintains a per-LT parameters file:
 	//   parameters_<ID>.json
@@ -87,6 +181,15 @@ struct lower_third_cfg {
 
 	int repeat_every_sec   = 0; // 0 = disabled
 	int repeat_visible_sec = 0; // how long to keep visible when auto-shown
+
+	// Instanced: one template instance in the overlay; the active row's data is swapped in on show.
+	bool instanced = false;
+	std::vector<data_row> rows;
+	std::string active_row; // row id; empty or unknown = first row
+
+	// Native: drawn by the "VinciFlow Lower Third" source from the fields above (native_source.hpp)
+	// instead of the overlay page; templates are not used.
+	bool native = false;
 };
 
 
@@ -125,6 +228,36 @@ struct group_cfg {
 	std::vector<std::string> members;
 };
 
+// Automatic visibility rule: when 'trigger' happens (for scene triggers: on 'scene', or any scene when
+// empty), apply 'action' to 'target' after 'delay_ms'. Evaluated by the rule engine (rules.hpp).
+enum class rule_trigger : uint8_t {
+	SceneActivated    = 0, // 'scene' became the program scene
+	SceneDeactivated  = 1, // 'scene' stopped being the program scene
+	TransitionStarted = 2, // a transition to 'scene' started
+	StreamingStarted  = 3,
+	StreamingStopped  = 4,
+	RecordingStarted  = 5,
+	RecordingStopped  = 6,
+};
+
+enum class rule_action : uint8_t {
+	Show      = 0, // target: lower third, or group (all members)
+	Hide      = 1, // idem
+	Toggle    = 2, // idem
+	RunGroup  = 3, // target: group
+	StopGroup = 4, // target: group
+};
+
+struct rule_cfg {
+	std::string id;
+	bool enabled = true;
+	rule_trigger trigger = rule_trigger::SceneActivated;
+	std::string scene; // source name of the scene; empty = any
+	rule_action action = rule_action::Show;
+	std::string target; // lower third or group id
+	int delay_ms = 0;
+};
+
 // -------------------------
 // Core event bus (bidirectional sync point)
 // -------------------------
@@ -132,6 +265,16 @@ enum class event_type : uint32_t {
 	VisibilityChanged = 1,
 	ListChanged       = 2,
 	Reloaded          = 3,
+	// A parameters file changed (SetTemplateParameters or an external writer).
+	// id = lower third id; empty when only the combined parameters.json changed.
+	ParametersChanged = 4,
+	// The active data row of an instanced lower third changed. id = lower third id, id2 = row id.
+	ActiveRowChanged  = 5,
+	// A rundown cue was executed (rundown.hpp). count = cue index, id = cue name, id2 = target,
+	// ok = target found, planned_ms / offset_ms as in rundown_cue_report.
+	RundownCue        = 6,
+	// A scheduled change was queued, applied or cancelled (see schedule_change()).
+	ScheduleChanged   = 7,
 };
 
 enum class list_change_reason : uint32_t {
@@ -156,20 +299,41 @@ struct core_event {
 	std::string id2;
 	bool ok = true;
 	int64_t count = 0;
+
+	// RundownCue
+	int64_t planned_ms = 0;
+	int64_t offset_ms = 0;
 };
 
 using core_event_cb = void (*)(const core_event &ev, void *user);
 
 uint64_t add_event_listener(core_event_cb cb, void *user);
 void remove_event_listener(uint64_t token);
+// Calls the listeners synchronously on the calling thread.
+void emit_event(const core_event &ev);
 
 // -------------------------
 // Output dir + startup
 // -------------------------
 bool has_output_dir();
+// Where live files are read and written and the browser source points: the configured folder, or its
+// hot directory (see below) while that is active.
 std::string output_dir();
+// The folder the user picked (persisted in config.json).
+std::string configured_output_dir();
 bool set_output_dir_and_load(const std::string &dir);
 
+// Hot output directory: when enabled, the live files (state, visibility, parameters, bundle, assets)
+// are served from a RAM-backed copy of the configured folder (hot_dir.hpp). A background checkpointer
+// copies changes back to the configured folder at most every two seconds; startup restores
+// from it. Files the plugin deletes are deleted there too; nothing else is. Toggling persists the
+// setting and reloads from the new location; enabling fails where hot_dir_supported() is false.
+// Leaving a folder (switch, profile change, disable) checkpoints it and deletes its hot directory.
+bool hot_output_enabled();
+bool set_hot_output_enabled(bool enabled);
+// Final checkpoint; the hot directory is deleted once everything is safely on disk. Call on unload.
+void shutdown_hot_output();
+
 // Reads OBS module config: obs_module_config_path("config.json")
 void init_from_disk();
 
@@ -179,9 +343,12 @@ bool save_global_config();
 // -------------------------
 // State access
 // -------------------------
+// The mutable accessors mark what they hand out as possibly edited for the undo history, which
+// compares only those items on the next save; read-only callers use the _const variants.
 std::vector<lower_third_cfg> &all();
 const std::vector<lower_third_cfg> &all_const();
 lower_third_cfg *get_by_id(const std::string &id);
+const lower_third_cfg *get_by_id_const(const std::string &id);
 
 // -------------------------
 // Group state access (persisted in lt-state.json; dock-only)
@@ -197,6 +364,23 @@ bool update_group(const group_cfg &c);
 bool remove_group(const std::string &group_id);
 bool set_group_members(const std::string &group_id, const std::vector<std::string> &members);
 
+// -------------------------
+// Rules (persisted in lt-state.json next to the groups)
+// -------------------------
+const std::vector<rule_cfg> &rules_const();
+// Bumped whenever the rule set changes (edits, loads), so the engine knows to recompile its index.
+uint64_t rules_generation();
+// Persist + notify (ListChanged / Update). Unknown ids in upsert_rule() are added; empty ids get one.
+bool set_rules(std::vector<rule_cfg> rules);
+std::string upsert_rule(const rule_cfg &r);
+bool remove_rule(const std::string &rule_id);
+
+// "scene_activated", "show", ... (the lt-state.json and websocket spelling).
+const char *rule_trigger_name(rule_trigger t);
+bool rule_trigger_from_name(const std::string &name, rule_trigger &out);
+const char *rule_action_name(rule_action a);
+bool rule_action_from_name(const std::string &name, rule_action &out);
+
 
 // -------------------------
 // Visible set
@@ -211,10 +395,18 @@ void toggle_visible_nosave(const std::string &id);
 // High-level (persist + notify)
 bool set_visible_persist(const std::string &id, bool visible);
 bool toggle_visible_persist(const std::string &id);
+// Applies the changes in order with a single lt-visible.json write; unknown ids are skipped. Events
+// are the same as for the equivalent set_visible_persist() calls.
+bool set_visible_batch(const std::vector<std::pair<std::string, bool>> &changes);
 
 // -------------------------
 // Persistence
 // -------------------------
+// lt-state.json is the interchange format. Every successful load/save also writes lt-state-<key>.bin,
+// a versioned binary snapshot named after the JSON's size and mtime; load_state_json() maps it instead of
+// parsing the JSON while it is current, leaving template bodies undecoded until first use.
+// In-memory state is authoritative: CRUD helpers only reload a file whose size/mtime/content hash no
+// longer matches what was last loaded or saved (i.e. it was edited externally).
 bool load_state_json();
 bool save_state_json();
 bool load_visible_json();
@@ -224,8 +416,26 @@ bool save_visible_json();
 // Artifacts files
 // -------------------------
 bool ensure_output_artifacts_exist();
+
+// Synchronous rebuild + swap on the calling (UI) thread. Prefer request_rebuild() for edits.
 bool rebuild_and_swap();
 
+// Debounced background rebuild. Requests arriving close together are coalesced into one render;
+// rendering and writing run off the UI thread and the browser-source swap is posted back to it,
+// rate-limited so back-to-back edits do not trigger a CEF reload each.
+// 'done' resolves once artifacts reflecting at least 'generation' are on disk and swapped.
+// Never wait on 'done' from the UI thread: the swap itself runs there.
+struct rebuild_ticket {
+	uint64_t generation = 0;
+	std::shared_future<bool> done;
+};
+rebuild_ticket request_rebuild();
+uint64_t completed_rebuild_generation();
+
+// Joins the rebuild worker and the render workers; pending requests resolve as failed. Call on module
+// unload, after shutdown_profiles() (profiles.hpp).
+void shutdown_rebuilds();
+
 // Runtime parameters files
 // - Combined file: parameters.json (root object keyed by LT id)
 // - Per-LT file:  parameters_<ID>.json (object with keys/values)
@@ -237,6 +447,31 @@ std::string path_parameters_lt_json(const std::string &id);
 bool set_template_parameters(const std::string &id, const QJsonObject &data);
 bool get_template_parameters(const std::string &id, QJsonObject &out);
 
+// Scheduled changes: visibility and/or parameters that take effect at an absolute time (ms since the
+// Unix epoch, the clock of Date.now() in the overlay). Pending changes are published in lt-schedule.json
+// ahead of time; the overlay arms them and starts the transition on the first frame at or after 'at',
+// instead of on its next lt-visible.json poll. At the same time the scheduler applies them to the core
+// (set_visible_persist / set_template_parameters), which removes them from the file. Changes must
+// reach the overlay before 'at' to land exactly (one poll, 350 ms, plus the fetch); later ones apply
+// immediately. Pending changes are not persisted.
+struct scheduled_change {
+	uint64_t seq = 0; // assigned by schedule_change()
+	std::string id;
+	int64_t at_ms = 0;
+	int visible = -1; // -1 = unchanged, 0 = hide, 1 = show
+	bool has_params = false;
+	QJsonObject params;
+};
+
+std::string path_schedule_json(); // lt-schedule.json
+// Returns the change's seq, 0 when the id is unknown or the change is empty.
+uint64_t schedule_change(scheduled_change c);
+// Cancels the pending changes of one item, or all of them for an empty id. Returns how many.
+size_t cancel_scheduled_changes(const std::string &id);
+std::vector<scheduled_change> scheduled_changes();
+// Called by the scheduler when a change is due; false when it was cancelled meanwhile.
+bool apply_scheduled_change(uint64_t seq);
+
 // Notify UI listeners (dock, websocket bridge, etc.) that the lower-third list
 // has been updated in-place (e.g. settings changed for an existing item).
 // This does not rebuild artifacts; it only emits a core event.
@@ -245,24 +480,98 @@ void notify_list_updated(const std::string &id = std::string());
 // Force reload state+visible from disk and rebuild/swap (with notifications)
 bool reload_from_disk_and_rebuild();
 
+// The core watches output_dir (started by init_from_disk / set_output_dir_and_load). External edits to
+// lt-state.json, lt-visible.json and parameters*.json are debounced, diffed against memory and applied
+// through the usual events; only item changes request a rebuild. Call stop on module unload.
+void stop_output_watcher();
+
+// -------------------------
+// Instanced items (one template, many data rows)
+// -------------------------
+// The bundle holds a single DOM instance per instanced item plus its HTML template with the row
+// placeholders ({{TITLE}}, {{SUBTITLE}}, {{PROFILE_PICTURE_URL}}, {{ROW_ID}}) left in. Rows and the
+// active row are published in lt-rows.json; the overlay swaps row data in on show (and replays a shown
+// item whose row data changed), so row edits and row switches do not rebuild the bundle. Row
+// placeholders in the CSS or JS are rendered with the active row, so for such items a change of the
+// active row or its data requests a rebuild. All helpers persist and emit events.
+std::string path_rows_json(); // lt-rows.json
+
+// Resolved active row (active_row if it exists, else the first row); null when there are no rows.
+const data_row *active_row_of(const lower_third_cfg &c);
+
+// Replaces the row table; rows without an id (or with a duplicate one) get a new id.
+bool set_rows(const std::string &id, std::vector<data_row> rows);
+// Inserts or updates one row (matched by row.id). Returns the row id; empty on failure.
+std::string upsert_row(const std::string &id, data_row row);
+bool remove_row(const std::string &id, const std::string &row_id);
+bool set_active_row(const std::string &id, const std::string &row_id);
+
 // -------------------------
 // Browser source
 // -------------------------
+// Registry of the browser sources by name, maintained from the global source signals (create, remove,
+// destroy, rename) with weak references. Start it before init_from_disk(); lookups below are O(1).
+void start_browser_source_registry();
+void stop_browser_source_registry();
+
+// Sorted; cached until the registry changes.
 std::vector<std::string> list_browser_source_names();
 std::string target_browser_source_name();
 bool set_target_browser_source_name(const std::string &name);
 bool target_browser_source_exists();
+// Disabled sources are not rendered by OBS (auto-idle, idle.hpp). Disabling applies to the target, the
+// shards and the output variants' sources that are enabled, and marks each in its private settings;
+// enabling re-enables only marked browser sources, so sources the user disabled stay off. False when
+// disabling without a target.
+bool set_target_browser_source_enabled(bool enabled);
 bool swap_target_browser_source_to_file(const std::string &absoluteHtmlPath);
+// Points any Browser Source at a local page and reloads it without cache (target and shards).
+bool swap_browser_source_to_file(obs_source_t *src, const std::string &absoluteHtmlPath, int width, int height);
 
 // Browser source dimensions (persisted in module config)
 int target_browser_width();
 int target_browser_height();
 bool set_target_browser_dimensions(int width, int height);
 
+// Split the items into one Browser Source per position zone (shards.hpp). Persisted in module config.
+bool shard_by_position();
+bool set_shard_by_position(bool enabled);
+
+// -------------------------
+// Output variants (persisted in module config)
+// -------------------------
+// Extra renderings of the same state for other canvases, e.g. a 9:16 vertical output next to the 16:9
+// one. A variant has its own Browser Source and frame size and is served lt@<name>.html: the markup of
+// lt.html plus lt@<name>.css, a few lines of layout overrides loaded after the shared lt.css / lt.js.
+// State, visibility, rows and parameters are shared, and one rebuild renders the common files once for
+// every variant. While sharding by position lt.* only holds the items without a zone, so the variant
+// pages load a full-frame lt-full.css / lt-full.js written next to the shards instead.
+struct layout_override {
+	atom position;     // lt-pos-* class; empty = the item's own
+	int scale_pct = 0; // 0 = the variant's scale
+};
+
+struct output_variant {
+	std::string name;           // file name part, sanitized like ids
+	std::string browser_source; // Browser Source pointed at lt@<name>.html
+	int width = 1080;
+	int height = 1920;
+	int safe_margin = -1; // px; -1 = the shared 40px
+	int scale_pct = 100;  // every item
+	std::vector<std::pair<std::string, layout_override>> items; // by lower third id
+};
+
+const std::vector<output_variant> &output_variants();
+// Adds or replaces the variant of that name and rebuilds. Returns the stored name; empty on failure.
+std::string upsert_output_variant(const output_variant &v);
+// Also deletes its lt@<name>.* files.
+bool remove_output_variant(const std::string &name);
+
 // -------------------------
 // Paths
 // -------------------------
 std::string path_state_json();   // lt-state.json
+std::string path_state_bin();    // lt-state-<key>.bin (binary snapshot of the current lt-state.json)
 std::string path_visible_json(); // lt-visible.json
 std::string path_styles_css();   // lt.css
 std::string path_scripts_js();   // lt.js
@@ -277,9 +586,11 @@ std::string new_id();
 // -------------------------
 // CRUD helpers for dock actions (persist + notify)
 // -------------------------
-std::string add_default_lower_third();
-std::string clone_lower_third(const std::string &id);
-bool remove_lower_third(const std::string &id);
+// The change is saved when these return; the overlay follows with the requested rebuild, whose ticket
+// is handed out through 'rebuild' (its result is false when that rebuild failed).
+std::string add_default_lower_third(rebuild_ticket *rebuild = nullptr);
+std::string clone_lower_third(const std::string &id, rebuild_ticket *rebuild = nullptr);
+bool remove_lower_third(const std::string &id, rebuild_ticket *rebuild = nullptr);
 
 // Reorder helpers (persist + notify). delta: -1 (up), +1 (down)
 bool move_lower_third(const std::string &id, int delta);
@@ -292,4 +603,50 @@ bool move_lower_third(const std::string &id, int delta);
 // Persists state and emits a ListChanged event.
 bool sort_lower_thirds_by_group();
 
+// -------------------------
+// Benchmarks
+// -------------------------
+// Off-line measurements behind the BenchmarkRender / BenchmarkStateSave requests. Both work on 'items'
+// synthetic copies of a base item (base_id, else the built-in default), each with its own id, title and
+// subtitle. Nothing is written to disk and neither the live state nor the phase-1 cache is touched. Any
+// thread: the copies are taken on the UI thread, the measured work runs on the caller's.
+struct render_benchmark_run {
+	size_t workers = 0;
+	double ms = 0.0;    // best of the repeats: all three render phases and the concatenation, no file I/O
+	uint64_t bytes = 0; // lt.css + lt.js + lt.html
+	// out_buffer chunk allocations per artifact, spliced per-item buffers included
+	uint64_t css_chunks = 0;
+	uint64_t js_chunks = 0;
+	uint64_t html_chunks = 0;
+};
+
+struct render_benchmark {
+	bool ok = false;
+	std::string error;
+	size_t items = 0;
+	std::vector<render_benchmark_run> runs; // one per worker count, 1..max_workers
+};
+
+// Renders the bundle with 1, 2, ... max_workers workers (0 = one per core; capped at the core count).
+render_benchmark benchmark_render(size_t items, size_t max_workers, int repeats, const std::string &base_id = {});
+
+struct state_save_benchmark {
+	bool ok = false;
+	std::string error;
+	size_t items = 0;
+	// Streaming writer (save_state_json): compact document into an out_buffer.
+	uint64_t stream_bytes = 0;
+	double stream_ms = 0.0;
+	uint64_t stream_peak_bytes = 0; // chunk capacity held by the buffer
+	uint64_t stream_chunk_allocations = 0;
+	// The QJsonObject tree + toJson(Indented) + std::string path it replaced.
+	uint64_t dom_bytes = 0;
+	double dom_ms = 0.0;
+	// QByteArray and std::string copies (exact) plus the tree, estimated as its strings in UTF-16.
+	uint64_t dom_peak_bytes = 0;
+};
+
+// Times both serializers over the same items (best of 'repeats').
+state_save_benchmark benchmark_state_save(size_t items, int repeats, const std::string &base_id = {});
+
 } // namespace vflow
\ No newline at end of file
@@ -0,0 +1,172 @@
+// core_internal.hpp
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core.hpp"
+
+namespace vflow {
+
+// -------------------------
+// Core internals
+// -------------------------
+// Shared by core.cpp and the modules split out of it (history, assets, import, profiles); the rest of
+// the plugin goes through core.hpp and the module headers. UI thread unless noted.
+
+std::string join_path(const std::string &a, const std::string &b);
+bool file_exists(const std::string &path);
+void ensure_dir(const std::string &dir);
+std::string sanitize_id(const std::string &s);
+std::string current_scene_collection_name();
+// Monotonic milliseconds. Any thread.
+int64_t steady_ms();
+// Queues a checkpoint of the hot output directory (no-op when it is off). Any thread.
+void checkpoint_soon();
+// Deletes a top-level file of output_dir() (through the checkpointer in hot mode). Any thread.
+bool remove_output_file(const std::string &name);
+
+lower_third_cfg default_cfg();
+group_cfg default_group_cfg();
+
+// The live items, without marking anything for the undo history the way all() does.
+std::vector<lower_third_cfg> &live_items();
+// ListChanged with the current item count.
+void emit_list_change(list_change_reason reason, const std::string &id);
+// Re-reads state/visibility only when their files were changed by someone else since we last touched them.
+void reload_if_changed_on_disk();
+
+// Scalar fields serialized; template bodies compared by interned identity instead of by content.
+struct item_fingerprint {
+	std::string fields;
+	template_text html, css, js;
+
+	explicit item_fingerprint(const lower_third_cfg &c);
+
+	bool operator==(const item_fingerprint &o) const
+	{
+		return html.same_as(o.html) && css.same_as(o.css) && js.same_as(o.js) && fields == o.fields;
+	}
+	bool operator!=(const item_fingerprint &o) const { return !(*this == o); }
+};
+
+std::string groups_fingerprint();
+
+// -------------------------
+// Output folders (profiles)
+// -------------------------
+
+// Size, mtime and content hash of a file when we last loaded or saved it.
+struct file_stamp {
+	bool valid = false;
+	int64_t size = 0;
+	int64_t mtime_ms = 0;
+	uint64_t hash = 0;
+};
+
+// The state of one output folder, held in memory apart from the live globals.
+struct folder_state {
+	std::string dir;
+	std::vector<lower_third_cfg> items;
+	std::vector<group_cfg> groups;
+	std::vector<rule_cfg> rules;
+	std::vector<std::string> visible;
+	file_stamp state_stamp;
+	file_stamp visible_stamp;
+	uint64_t rows_hash = 0;
+};
+
+// Folder by scene collection (persisted in config.json).
+std::unordered_map<std::string, std::string> &output_dir_bindings();
+
+// Moves the live state into 'out', leaving the globals empty.
+void take_live_state(folder_state &out);
+void install_live_state(folder_state &s);
+// Reads dir's lt-state.json and lt-visible.json without touching any global. Any thread.
+bool read_folder_state(const std::string &dir, folder_state &out);
+// True when lt-state.json or lt-visible.json in output_dir() differ from what 's' was read from.
+bool live_files_changed_since(folder_state &s);
+
+// Leaves the current folder (its hot directory is checkpointed and deleted) and makes 'dir' the live one.
+void enter_output_dir(const std::string &dir);
+void restart_output_watcher();
+bool publish_rows_json();
+std::string bundle_html_current_path();
+
+// No rebuild queued, running or waiting to be swapped. Any thread.
+bool rebuilds_idle();
+// Shows the bundle already written in output_dir() (lt.html and the variant pages) without rebuilding.
+void show_written_bundle();
+// Drops the per-name hashes that let sharded rebuilds skip unchanged pages. Any thread.
+void forget_bundle_hashes();
+
+// Immutable input of one bundle generation. Taken on the UI thread; workers only ever read it.
+struct render_snapshot {
+	std::string output_dir;
+	std::string name = "lt"; // bundle base name
+	std::vector<lower_third_cfg> items;
+	bool local_animate_css = false;
+
+	// Sharding (zones are laid out on the target's frame)
+	bool shard_by_position = false;
+	int frame_width = sltBrowserWidth;
+	int frame_height = sltBrowserHeight;
+
+	std::vector<output_variant> variants;
+
+	size_t workers = 0; // 0: sized by item count; benchmarks pin it
+};
+
+// The current layout settings, without a folder or items.
+render_snapshot render_layout();
+// 'layout' rendering 'items' into 'dir'. Materializes the items' templates, so call it on the thread
+// that owns them (the UI thread for the live state).
+render_snapshot render_snapshot_of(render_snapshot layout, const std::string &dir,
+				   const std::vector<lower_third_cfg> &items);
+
+// lt.* and the variant pages of a folder that is not live, rendered without the phase-1 cache. Opaque
+// outside core.cpp. Any thread.
+struct bundle_render;
+std::shared_ptr<bundle_render> render_folder_bundle(render_snapshot snap, const std::string &ts);
+// Writes them into the snapshot's folder; false when lt.html could not be written.
+bool write_folder_bundle(const bundle_render &r);
+
+// -------------------------
+// history.cpp
+// -------------------------
+// Items handed out mutable are diffed on the next save (see history.hpp).
+void history_touch(const std::string &id);
+void history_touch_all();
+// Takes the live state as the new baseline without recording anything.
+void history_rebase();
+// Diffs the live state against the baseline and records the difference as one entry. Called by
+// save_state_json().
+void history_capture();
+// Changes saved while set are not recorded (active row switches).
+void history_set_untracked(bool untracked);
+// Unlinks the output-dir file once nothing (items, rows, history) references it anymore.
+void history_defer_file_removal(const std::string &rel);
+// lt-state.json was replaced by another writer: entries would apply old diffs on top of its state.
+void reset_history_after_external_load();
+// Counts the output-dir files referenced by the live items and by every snapshot the history holds.
+void count_file_refs(std::unordered_map<std::string, size_t> &refs);
+
+// -------------------------
+// assets.cpp
+// -------------------------
+// Absolute paths go through the asset store; anything else is taken as already relative to the output folder.
+std::string import_picture(const std::string &value);
+
+// -------------------------
+// profiles.cpp
+// -------------------------
+// Drops what is known about the folder; it is about to be loaded as the live one.
+void forget_profile(const std::string &dir);
+// Preloads the bound folders after startup work and folder switches have settled.
+void schedule_profile_preload();
+
+} // namespace vflow
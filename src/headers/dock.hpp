@@ -44,6 +44,7 @@ struct LowerThirdRowUi {
 	QPushButton *downBtn = nullptr;
 	QPushButton *cloneBtn = nullptr;
 	QPushButton *settingsBtn = nullptr;
+	QPushButton *rowsBtn = nullptr; // instanced items only
 	QPushButton *removeBtn = nullptr;
 };
 
@@ -63,7 +64,12 @@ signals:
 
 private slots:
 	void onBrowseOutputFolder();
+	void onHotOutputToggled(bool checked);
+	void onShardToggled(bool checked);
 	void onAddLowerThird();
+	void onImportLowerThirds();
+	void onUndo();
+	void onRedo();
 	void onManageGroups();
 
 private:
@@ -88,10 +94,10 @@ private:
 	void handleToggleVisible(const QString &id);
 	void handleClone(const QString &id);
 	void handleOpenSettings(const QString &id);
+	void handleEditRows(const QString &id);
 	void handleRemove(const QString &id);
 
-	void ensureRepeatTimerStarted();
-	void repeatTick();
+	void ensureCountdownTimerStarted();
 
 	void populateBrowserSources(bool keepSelection = true);
 	void onBrowserSourceChanged(int index);
@@ -110,9 +116,11 @@ protected:
 private:
 	QLineEdit *outputPathEdit = nullptr;
 	QPushButton *outputBrowseBtn = nullptr;
+	QPushButton *hotOutputBtn = nullptr;
 
 	QComboBox *browserSourceCombo = nullptr;
 	QPushButton *refreshSourcesBtn = nullptr;
+	QPushButton *shardBtn = nullptr;
 
 	QSpinBox *browserWidthSpin = nullptr;
 	QSpinBox *browserHeightSpin = nullptr;
@@ -122,6 +130,10 @@ private:
 	QPushButton *toggleCarouselBtn_ = nullptr;
 
 	QPushButton *addBtn = nullptr;
+	QPushButton *importBtn = nullptr;
+	QPushButton *undoBtn = nullptr;
+	QPushButton *redoBtn = nullptr;
+	void updateHistoryButtons();
 
 	QScrollArea *scrollArea = nullptr;
 	QWidget *listContainer = nullptr;
@@ -131,10 +143,7 @@ private:
 	QVector<LowerThirdRowUi> rows;
 	QVector<QShortcut *> shortcuts_;
 
-	QTimer *repeatTimer_ = nullptr;
-	QHash<QString, qint64> nextOnMs_;
-	QHash<QString, qint64> offAtMs_;
-	QHash<QString, qint64> reShowAtMs_;
+	QTimer *countdownTimer_ = nullptr;
 
 	bool populatingSources_ = false;
 	signal_handler_t *obsSignalHandler_ = nullptr;
@@ -0,0 +1,37 @@
+// history.hpp
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace vflow {
+
+// -------------------------
+// Undo / redo
+// -------------------------
+// Every save_state_json() diffs items and groups against the previous save and records what changed as
+// one undo entry. Entries hold immutable per-item snapshots shared with the baseline and with each other,
+// and template bodies are the interned flyweights, so an entry costs roughly the fields of the items it
+// touched. The stack is bounded by entry count and an estimated memory budget (oldest entries dropped).
+// Undo/redo restore those items (and groups), save, and go through request_rebuild(). Files of deleted
+// items stay on disk until the deletion can no longer be undone. Loading another folder,
+// reload_from_disk_and_rebuild() and external edits of lt-state.json clear the history (its entries
+// would apply on top of someone else's state). Active row switches are not recorded, and undo keeps
+// an item's current active row when it still exists.
+struct history_info {
+	size_t undo_count = 0;
+	size_t redo_count = 0;
+	size_t bytes = 0; // estimated
+	std::string undo_label; // e.g. "Edit Speaker 1", "Create 500 lower thirds"
+	std::string redo_label;
+};
+
+bool can_undo();
+bool can_redo();
+bool undo();
+bool redo();
+history_info history_state();
+// Drops all entries and unlinks files whose deletion was only deferred for undo. Call on module unload.
+void clear_history();
+
+} // namespace vflow
@@ -0,0 +1,77 @@
+// hot_dir.hpp
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace vflow {
+
+// True where a RAM-backed directory exists (tmpfs at /dev/shm, i.e. Linux). Temp folders elsewhere are
+// purged by cleaners and are not used.
+bool hot_dir_supported();
+
+// RAM-backed directory for the live files of 'durableDir'. Unique per durable folder and user; created
+// if needed. Empty on failure or when !hot_dir_supported().
+std::string hot_dir_for(const std::string &durableDir);
+
+// Mirrors the top-level files of a hot directory into its durable folder on a background thread.
+// schedule() marks the hot side dirty; the worker then copies new and changed files (by size and mtime,
+// which copies preserve), at most once per interval. Copies go through a temp name, so the durable
+// folder never holds a truncated file. Deletions reach the durable folder only through remove(): a
+// mirrored file that vanished from the hot side otherwise (e.g. purged by the system) is copied back
+// from the durable folder instead. The destructor stops the worker after a final pass.
+class checkpointer {
+public:
+	checkpointer(std::string hotDir, std::string durableDir, int minIntervalMs);
+	~checkpointer();
+	checkpointer(const checkpointer &) = delete;
+	checkpointer &operator=(const checkpointer &) = delete;
+
+	// Durable -> hot, for startup: copies files missing from or older in the hot directory. Newer hot
+	// files (changes not yet checkpointed when the process stopped) are kept. Returns files copied.
+	size_t restore();
+
+	void schedule();
+	// Synchronous pass; waits for one in flight. False if any copy failed.
+	bool flush();
+	// Deletes 'name' from the hot directory, between passes; the next pass deletes the durable copy
+	// (unless the name exists on the hot side again by then). True when the hot file was removed.
+	bool remove(const std::string &name);
+
+	const std::string &hot_dir() const { return hot_; }
+	const std::string &durable_dir() const { return durable_; }
+
+private:
+	struct stamp {
+		uintmax_t size = 0;
+		std::filesystem::file_time_type mtime;
+		bool operator==(const stamp &o) const { return size == o.size && mtime == o.mtime; }
+	};
+
+	void run();
+	bool sync_once();
+
+	std::string hot_;
+	std::string durable_;
+	std::chrono::milliseconds interval_;
+
+	std::mutex mx_; // dirty_, stop_, removals_
+	std::condition_variable cv_;
+	bool dirty_ = false;
+	bool stop_ = false;
+	std::vector<std::string> removals_;
+
+	std::mutex sync_mx_; // serializes passes; guards mirrored_
+	std::unordered_map<std::string, stamp> mirrored_; // name -> hot stamp at its last copy
+
+	std::thread worker_;
+};
+
+} // namespace vflow
@@ -0,0 +1,32 @@
+// idle.hpp
+#pragma once
+
+#include <cstdint>
+
+namespace vflow {
+
+// -------------------------
+// Auto-idle
+// -------------------------
+// Most of a show has no lower third on screen, yet OBS composites the target Browser Source every
+// frame. Once nothing has been visible for a few seconds (out animations and sounds done) and no
+// scheduled show is close, the target source is disabled so OBS stops rendering it; the page hides its
+// root and stops painting on its own. A show wakes the source synchronously from the visibility event,
+// before the overlay can pick it up from lt-visible.json; scheduled shows wake it ahead of time. OBS may
+// save the collection while the source is disabled; it is enabled again whenever a collection loads and
+// on exit. Lives on the UI thread.
+void idle_start();
+void idle_stop();
+
+struct idle_status {
+	bool idle = false;
+	int64_t idle_for_ms = 0;       // current idle period; 0 when awake
+	int64_t idle_total_ms = 0;     // since the plugin loaded, current period included
+	uint64_t frames_skipped = 0;   // estimated from the OBS frame rate
+	uint64_t sleeps = 0;
+	int64_t next_wake_in_ms = -1;  // planned wake for a scheduled show; -1 = none
+};
+
+idle_status idle_status_now();
+
+} // namespace vflow
@@ -0,0 +1,53 @@
+// import.hpp
+#pragma once
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace vflow {
+
+// -------------------------
+// Bulk import
+// -------------------------
+// Creates one lower third per record of a CSV stream (header row required; ',', ';' or tab separated)
+// or of a JSON array / {"items": [...]} object / JSON Lines stream of objects. Records are parsed one
+// at a time and built in memory from a copy of the base item; state is then saved, one rebuild
+// requested and one ListChanged (Create) emitted for the whole batch. When the save fails the batch is
+// taken back out and nothing is rebuilt or emitted.
+// Recognized fields (case, spaces, '_' and '-' ignored): id, label, title, subtitle, picture
+// (alias profile_picture / avatar / image; absolute paths go through import_asset()),
+// group (group id or title; an unknown title creates the group) and hotkey (dropped when already bound
+// to an item or group, or repeated in the input). Other fields are ignored.
+enum class import_format { Auto, Csv, Json };
+
+struct import_options {
+	import_format format = import_format::Auto;
+	std::string base_id;  // item whose templates and styling are copied; empty = built-in default
+	std::string group_id; // group (id or title) for records without a group field; empty = none
+	bool visible = false;
+};
+
+struct import_result {
+	bool ok = false;
+	std::string error;
+	std::vector<std::string> ids; // created items, in input order
+	size_t skipped = 0;           // malformed or empty records
+	size_t groups_created = 0;
+	double elapsed_ms = 0.0; // parse + apply + save; the rebuild runs afterwards in the background
+	double items_per_sec = 0.0;
+};
+
+import_result import_lower_thirds(std::istream &in, const import_options &opt);
+// Format Auto picks by extension (.csv/.tsv/.txt vs .json/.jsonl/.ndjson), else sniffs the content.
+import_result import_lower_thirds_file(const std::string &path, const import_options &opt);
+
+// CSV primitives of the importer, shared with the rundown loader.
+void skip_utf8_bom(std::istream &in);
+// Most frequent of ',', ';' and tab outside quotes.
+char sniff_csv_delimiter(const std::string &headerLine);
+// One RFC 4180 record; false at end of stream.
+bool read_csv_record(std::istream &in, char delim, std::vector<std::string> &out);
+
+} // namespace vflow
@@ -0,0 +1,52 @@
+// json_writer.hpp
+#pragma once
+
+#include "out_buffer.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vflow {
+
+// Forward-only JSON emitter that streams straight into an out_buffer (no DOM, no intermediate copies).
+// Compact by default; 'pretty' indents with two spaces. Callers are responsible for well-formed nesting.
+class json_writer {
+public:
+	explicit json_writer(out_buffer &out, bool pretty = false) : out_(out), pretty_(pretty) {}
+
+	void begin_object() { open('{'); }
+	void end_object() { close('}'); }
+	void begin_array() { open('['); }
+	void end_array() { close(']'); }
+
+	void key(std::string_view k);
+
+	void value(std::string_view v);
+	void value(const std::string &v) { value(std::string_view(v)); }
+	void value(const char *v) { value(std::string_view(v)); }
+	void value(bool v);
+	void value(int v) { value((int64_t)v); }
+	void value(int64_t v);
+
+	template<typename T> void field(std::string_view k, const T &v)
+	{
+		key(k);
+		value(v);
+	}
+
+private:
+	void open(char c);
+	void close(char c);
+	void before_value();
+	void newline();
+	void write_escaped(std::string_view s);
+
+	out_buffer &out_;
+	bool pretty_;
+	bool after_key_ = false;
+	std::vector<bool> first_; // per open container: nothing emitted yet
+};
+
+} // namespace vflow
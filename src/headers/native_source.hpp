@@ -0,0 +1,42 @@
+// native_source.hpp
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace vflow {
+
+// -------------------------
+// Native lower third source
+// -------------------------
+// "VinciFlow Lower Third" (id vflow_lower_third) draws one lower third marked native (title, subtitle,
+// picture and box, laid out like the default template) with QPainter into a CPU buffer and hands OBS
+// async BGRA frames. It follows the item's visibility: the in/out animation classes map to a fade
+// and/or a slide from their direction over animate.css' default second; other effects fade. Frames are
+// only produced while animating; a shown or hidden item costs nothing between changes. HTML/CSS/JS
+// templates, parameters, sounds and the position class are not used: native items are left out of the
+// overlay page and the source is placed like any other. One worker thread per source.
+void native_source_register();
+void native_source_shutdown();
+
+struct native_benchmark {
+	bool ok = false;
+	std::string error;
+	int width = 0; // card size
+	int height = 0;
+	int frames = 0;
+	double draw_us = 0;               // drawing the card (picture decode included), once per change
+	double avg_frame_us = 0;          // one frame of the in animation: compose + the copy handed to OBS
+	double p95_frame_us = 0;
+	double cpu_percent = 0;           // of one core, animating at the OBS frame rate
+	uint64_t frame_bytes = 0;         // native: card + frame buffer, held while animating
+	uint64_t browser_frame_bytes = 0; // target Browser Source texture, for comparison
+};
+
+// Draws the item's card and 'frames' frames of its in animation off-screen and times them. The frame
+// time covers composing and copying the frame the way obs_source_output_video does; OBS' own upload and
+// the worker's pacing are not included. The item is read on the UI thread (blocking until it is), the
+// drawing and timing run on the caller's; do not call it from a thread the UI thread waits on.
+native_benchmark native_source_benchmark(const std::string &id, int frames);
+
+} // namespace vflow
@@ -0,0 +1,77 @@
+// out_buffer.hpp
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vflow {
+
+inline constexpr uint64_t kFnv1a64Basis = 1469598103934665603ull;
+
+// FNV-1a (64-bit). Pass the previous result as 'h' to hash discontiguous data incrementally.
+inline uint64_t fnv1a64(const void *data, size_t n, uint64_t h = kFnv1a64Basis)
+{
+	const unsigned char *p = static_cast<const unsigned char *>(data);
+	for (size_t i = 0; i < n; ++i) {
+		h ^= p[i];
+		h *= 1099511628211ull;
+	}
+	return h;
+}
+
+// Append-only chunked output buffer used to assemble generated artifacts (lt.css / lt.js / lt.html).
+// Appends copy straight into fixed-size chunks, so growing never reallocates or moves earlier bytes;
+// buffers filled by different workers are joined with splice() by moving chunk ownership.
+// write_file_atomic() flushes every chunk with one vectored write into a temp file renamed into place.
+class out_buffer {
+public:
+	static constexpr size_t kDefaultChunkBytes = 64 * 1024;
+
+	explicit out_buffer(size_t chunk_bytes = kDefaultChunkBytes);
+	out_buffer(out_buffer &&) noexcept = default;
+	out_buffer &operator=(out_buffer &&) noexcept = default;
+	out_buffer(const out_buffer &) = delete;
+	out_buffer &operator=(const out_buffer &) = delete;
+
+	out_buffer &append(const char *data, size_t n);
+	out_buffer &append(std::string_view s) { return append(s.data(), s.size()); }
+	out_buffer &append(char c) { return append(&c, 1); }
+	out_buffer &append_int(long long v);
+
+	out_buffer &operator<<(std::string_view s) { return append(s); }
+	out_buffer &operator<<(char c) { return append(c); }
+
+	// Moves all of other's chunks to the end of this buffer; other is left empty.
+	void splice(out_buffer &&other);
+
+	size_t size() const { return size_; }
+	bool empty() const { return size_ == 0; }
+	void clear();
+
+	// Number of chunk allocations made by this buffer (including spliced-in buffers).
+	uint64_t allocations() const { return allocations_; }
+	// Bytes allocated for the chunks currently held (>= size()).
+	size_t capacity() const;
+
+	std::string str() const;
+	uint64_t hash() const; // fnv1a64 of the contents
+	bool write_file_atomic(const std::string &path) const;
+
+private:
+	struct chunk {
+		std::unique_ptr<char[]> data;
+		size_t cap = 0;
+		size_t used = 0;
+	};
+
+	std::vector<chunk> chunks_;
+	size_t chunk_bytes_;
+	size_t size_ = 0;
+	uint64_t allocations_ = 0;
+};
+
+} // namespace vflow
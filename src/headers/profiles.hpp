@@ -0,0 +1,36 @@
+// profiles.hpp
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace vflow {
+
+// -------------------------
+// Scene collection profiles
+// -------------------------
+// An output folder (its items, groups, rules, visibility and bundle) can be
+// bound to a scene collection. Bound folders are preloaded on a worker (read into memory without
+// touching the live state, their bundles rendered and written); a folder switched away from stays
+// parked in memory. Switching to a bound collection swaps the parked state in and points the
+// target at the folder's already-written lt.html: no reload and no rebuild, unless lt-state.json or
+// lt-visible.json changed on disk, the frame layout changed or sharding is on. A switch never waits for
+// the preload: folders it has not reached yet load the usual way and are preloaded afterwards. Collections without a
+// binding keep the current folder; picking a folder while bound rebinds. UI thread.
+struct collection_profile {
+	std::string collection;
+	std::string dir;
+	bool active = false;
+	bool preloaded = false; // parked in memory
+};
+
+std::vector<collection_profile> collection_profiles();
+// Binds the folder to the collection (the current one when empty); an empty dir removes the binding.
+// Binding the current collection switches to the folder right away.
+bool bind_collection_output_dir(const std::string &collection, const std::string &dir);
+// Switches to the current collection's folder, if it has one. True when the folder changed.
+bool activate_collection_profile();
+// Cancels and waits for a running preload. Call on unload, before shutdown_rebuilds().
+void shutdown_profiles();
+
+} // namespace vflow
@@ -0,0 +1,27 @@
+// rules.hpp
+#pragma once
+
+#include "core.hpp"
+
+#include <string>
+
+namespace vflow {
+
+// -------------------------
+// Rule engine
+// -------------------------
+// Evaluates the rules of the core (rule_cfg) on OBS frontend events (program scene changes, streaming,
+// recording) and on the "transition_start" signal of every frontend transition, so scene transition
+// overrides and quick transitions trigger transition_started rules too. Rules are compiled into
+// an index keyed by trigger and scene, recompiled when rules_generation() moves, so a trigger only visits
+// the rules that match it. Visibility actions due at the same moment are applied through
+// set_visible_batch(), one lt-visible.json write per trigger. Delayed actions of scene_activated /
+// scene_deactivated rules are dropped when the program scene changes again before they run. Lives on
+// the UI thread.
+void rules_start();
+void rules_stop();
+
+// Evaluates a trigger as if OBS had raised it (websocket FireRules). Returns the number of rules matched.
+size_t rules_fire(rule_trigger trigger, const std::string &scene);
+
+} // namespace vflow
@@ -0,0 +1,83 @@
+// rundown.hpp
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace vflow {
+
+// -------------------------
+// Rundown (timecoded cue list)
+// -------------------------
+// A rundown is an ordered list of cues executed by the plugin itself against the monotonic clock, so
+// timing does not depend on a remote script and its round trips. Each cue's planned time is its 'at'
+// offset from the anchor: the moment the rundown was started, or the last manual cue was released with
+// rundown_go(). Cues without 'at' run together with the previous one; cues run in list order, so an
+// earlier 'at' than the previous cue's is treated as "right after it". A manual cue stops the clock
+// until rundown_go(). Shows with a duration hide again at planned time + duration. The pictures and
+// sounds of upcoming cues are read ahead so a cold disk does not delay the page. Every executed cue is
+// reported (planned vs actual, see rundown_cue_report) through the RundownCue core event.
+//
+// Cue lists are JSON (an array of cue objects, or an object with a "cues" array) or CSV (header row).
+// Fields, case, spaces, '_' and '-' ignored:
+//   at        "T+00:12:30", "12:30", "00:12:30.250" or seconds ("750", "12.5")
+//   action    show | hide | toggle | run (group run) | stop (group run) | hideall
+//   target    lower third id for show/hide/toggle, group id or title for run/stop (alias id, group)
+//   duration  show only: hide after this long (same formats as 'at')
+//   go        true / yes / 1 / x: manual cue (alias manual)
+//   name      free text, echoed in reports (alias label)
+enum class rundown_action { Show, Hide, Toggle, RunGroup, StopGroup, HideAll };
+
+struct rundown_cue {
+	std::string name;
+	rundown_action action = rundown_action::Show;
+	std::string target;
+	int64_t at_ms = -1;      // offset from the anchor; -1 = with the previous cue
+	int64_t duration_ms = 0; // Show: hide after this long; 0 = stay up
+	bool manual = false;
+};
+
+struct rundown_cue_report {
+	size_t index = 0;
+	int64_t planned_ms = 0; // since the rundown started
+	int64_t actual_ms = 0;  // since the rundown started
+	int64_t offset_ms = 0;  // actual - planned (manual cues: go() to execution)
+	bool ok = true;         // false when the target no longer exists
+};
+
+struct rundown_load_result {
+	bool ok = false;
+	std::string error;
+	size_t cues = 0;
+	size_t skipped = 0; // records without a valid action or target
+};
+
+// JSON (an array, {"cues": [...]} or JSON Lines) or CSV, told apart by the first character.
+rundown_load_result rundown_load(std::istream &in);
+rundown_load_result rundown_load_file(const std::string &path);
+
+// Call once the core is initialized / before it is torn down (UI thread).
+void rundown_init();
+void rundown_shutdown();
+
+// Starts (or restarts) the loaded rundown from its first cue. False when nothing is loaded.
+bool rundown_play();
+void rundown_stop();
+// Releases the manual cue the rundown is waiting on. False when it is not waiting.
+bool rundown_go();
+
+struct rundown_status {
+	size_t cues = 0;
+	bool running = false;
+	bool waiting_go = false;
+	size_t next = 0;         // index of the next cue; == cues once all ran
+	int64_t elapsed_ms = -1; // since start; -1 when not running
+	int64_t next_in_ms = -1; // until the next timed cue; -1 when none or waiting for go
+	std::vector<rundown_cue_report> reports; // executed cues of the current / last run
+};
+
+rundown_status rundown_status_now();
+
+} // namespace vflow
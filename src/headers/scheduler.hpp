@@ -0,0 +1,35 @@
+// scheduler.hpp
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace vflow {
+
+// -------------------------
+// Scheduler
+// -------------------------
+// Owns everything time-driven about visibility: per-item repeats (repeat_every_sec /
+// repeat_visible_sec), group runs and the core's scheduled changes (schedule_change()). Deadlines sit
+// in a min-heap on the monotonic clock and a single precise QTimer is armed for the earliest one, so
+// nothing polls. Follow-up deadlines are computed from the planned time, not from when the timer fired,
+// so runs do not drift. Lives on the UI thread, independently of the dock, and tracks visibility, list
+// and schedule changes through core events.
+void scheduler_start();
+void scheduler_stop();
+
+// Group runs show the members one after another (visible_ms each, interval_ms apart). Repeats of the
+// members are suspended while their group runs.
+bool start_group_run(const std::string &groupId);
+void stop_group_run(const std::string &groupId);
+bool group_run_active(const std::string &groupId);
+
+struct repeat_status {
+	bool in_group_run = false;
+	int64_t hide_in_ms = -1; // pending automatic hide; -1 = none
+	int64_t next_in_ms = -1; // next repeat; -1 = none
+};
+
+repeat_status repeat_status_of(const std::string &id);
+
+} // namespace vflow
@@ -5,8 +5,11 @@
 #include <QString>
 #include <QMultiHash>
 #include <QPointer>
+#include <future>
 #include <vector>
 
+#include "core.hpp"
+
 class QLineEdit;
 class QPlainTextEdit;
 class QComboBox;
@@ -216,10 +219,15 @@ private:
 	void updateColorButton(QPushButton *btn, const QColor &c);
 	void rebuildMarketplaceList();
 	void updateApiBridgeUi();
+	vflow::picture_ingest_result takePictureIngest(int avatarWidth, int avatarHeight);
 
 private:
 	QString currentId;
 	QString pendingProfilePicturePath;
+	// Ingest of pendingProfilePicturePath, started on browse at the avatar size shown then.
+	std::future<vflow::picture_ingest_result> pendingPictureIngest;
+	int pendingIngestWidth = 0;
+	int pendingIngestHeight = 0;
 	QString pendingAnimInSoundPath;
 	QString pendingAnimOutSoundPath;
 
@@ -266,6 +274,8 @@ private:
 	QLabel *apiBridgeStatusValueLabel = nullptr;
 	QPushButton *apiBridgeCopyBtn = nullptr;
 	QPushButton *apiBridgeOpenBtn = nullptr;
+	QCheckBox *instancedCheck = nullptr;
+	QCheckBox *nativeCheck = nullptr;
 
 	QPushButton *importBtn = nullptr;
 	QPushButton *exportBtn = nullptr;
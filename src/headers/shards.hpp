@@ -0,0 +1,34 @@
+// shards.hpp
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace vflow {
+
+// -------------------------
+// Shards (one Browser Source per position zone)
+// -------------------------
+// With shard_by_position() on, the items of each lt_position render into a page of their own
+// (lt-<zone>.html) sized to the zone, shown by a managed Browser Source named "<target> [<zone>]". Shards
+// are added right above the target source in every scene that contains it and placed through the target
+// item's draw transform (alignment, rotation, scale or bounds, crop), so items land where the full-frame
+// page would put them. A shard is only reloaded when its own page changed. UI thread unless noted.
+struct shard_output {
+	std::string slug;      // "bottom-left", ...
+	std::string html_path; // absolute path of lt-<slug>.html
+	int x = 0;             // zone within the target's frame
+	int y = 0;
+	int width = 0;
+	int height = 0;
+	bool changed = true; // page content differs from what the source last loaded
+};
+
+// Creates, reloads and places the shard sources of a rebuild; removes shard sources no longer used.
+void shards_sync(const std::vector<shard_output> &shards);
+void shards_remove_all();
+
+// Names of the shard sources in use. Any thread (auto-idle).
+std::vector<std::string> shard_source_names();
+
+} // namespace vflow
@@ -0,0 +1,583 @@
+#define LOG_TAG "[" PLUGIN_NAME "][history]"
+#include "history.hpp"
+
+#include "assets.hpp"
+#include "core.hpp"
+#include "core_internal.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace vflow {
+
+// -------------------------
+// Undo / redo history
+// -------------------------
+
+static constexpr size_t kHistoryMaxEntries = 200;
+static constexpr size_t kHistoryBudgetBytes = 16u * 1024u * 1024u;
+
+namespace {
+
+// Immutable item version. Baseline, history entries and successive entries share these by pointer, and
+// template bodies inside them are the interned flyweights also held by the live items.
+using item_snapshot = std::shared_ptr<const lower_third_cfg>;
+using groups_snapshot = std::shared_ptr<const std::vector<group_cfg>>;
+
+struct history_item_change {
+	std::string id;
+	item_snapshot before; // null: created by the edit
+	item_snapshot after;  // null: deleted by the edit
+};
+
+struct history_entry {
+	std::string label;
+	std::vector<history_item_change> items;
+	groups_snapshot groups_before; // both null when groups did not change
+	groups_snapshot groups_after;
+	std::vector<std::string> files; // removed with deleted items; unlinked once the entry can no longer be undone
+	size_t bytes = 0;
+};
+
+struct baseline_item {
+	item_snapshot cfg;
+	std::optional<item_fingerprint> fp; // computed on first compare, so loading does not decode templates
+};
+
+} // namespace
+
+static std::unordered_map<std::string, baseline_item> g_hist_base;
+static groups_snapshot g_hist_groups;
+static std::string g_hist_groups_fp;
+static bool g_hist_valid = false;
+static bool g_hist_applying = false; // undo/redo in progress: save_state_json() rebases instead of recording
+static bool g_hist_untracked = false; // same for changes kept out of the history (see history_set_untracked)
+
+// Ids changed since the baseline (handed out by get_by_id, created or removed). Only these are
+// fingerprinted on save unless an edit could touch any item (all(), reordering, loads).
+// Marked from whichever thread looks an item up, so guarded.
+static std::mutex g_hist_dirty_mx;
+static std::unordered_set<std::string> g_hist_dirty;
+static bool g_hist_all_dirty = true;
+
+static std::deque<history_entry> g_undo;
+static std::vector<history_entry> g_redo;
+static size_t g_hist_bytes = 0;
+static std::vector<std::string> g_hist_pending_files;
+
+// History copies are decoded so they never pin a snapshot mapping.
+static void materialize_templates(const lower_third_cfg &c)
+{
+	(void)c.html_template.shared();
+	(void)c.css_template.shared();
+	(void)c.js_template.shared();
+}
+
+static item_snapshot snapshot_item(const lower_third_cfg &c)
+{
+	auto snap = std::make_shared<const lower_third_cfg>(c);
+	materialize_templates(*snap);
+	return snap;
+}
+
+// Approximate heap cost of 'c' given that 'prev' (if any) is retained anyway; shared templates are free.
+static size_t item_bytes(const lower_third_cfg &c, const lower_third_cfg *prev)
+{
+	size_t n = sizeof(lower_third_cfg) + c.id.size() + c.label.size() + c.title.size() + c.subtitle.size() +
+		   c.profile_picture.size() + c.profile_picture_source.size() + c.anim_in_sound.size() +
+		   c.anim_out_sound.size() + c.font_family.size() +
+		   c.api_template.size() + c.hotkey.size() + c.active_row.size();
+	for (const auto &r : c.rows)
+		n += sizeof(data_row) + r.id.size() + r.title.size() + r.subtitle.size() + r.profile_picture.size();
+
+	if (!prev || !c.html_template.same_as(prev->html_template))
+		n += c.html_template.size();
+	if (!prev || !c.css_template.same_as(prev->css_template))
+		n += c.css_template.size();
+	if (!prev || !c.js_template.same_as(prev->js_template))
+		n += c.js_template.size();
+	return n;
+}
+
+static size_t groups_bytes(const std::vector<group_cfg> &groups)
+{
+	size_t n = sizeof(groups);
+	for (const auto &g : groups) {
+		n += sizeof(group_cfg) + g.id.size() + g.title.size() + g.toggle_hotkey.size() + g.dock_color.size();
+		for (const auto &m : g.members)
+			n += sizeof(std::string) + m.size();
+	}
+	return n;
+}
+
+static std::string history_label(const history_entry &e)
+{
+	size_t created = 0, deleted = 0;
+	for (const auto &ch : e.items) {
+		created += !ch.before;
+		deleted += !ch.after;
+	}
+
+	if (e.items.empty())
+		return "Edit groups";
+	if (e.items.size() == 1) {
+		const auto &ch = e.items.front();
+		const lower_third_cfg &c = ch.after ? *ch.after : *ch.before;
+		const std::string name = c.label.empty() ? c.id : c.label;
+		return (created ? "Create " : deleted ? "Delete " : "Edit ") + name;
+	}
+
+	const std::string n = std::to_string(e.items.size());
+	if (created == e.items.size())
+		return "Create " + n + " lower thirds";
+	if (deleted == e.items.size())
+		return "Delete " + n + " lower thirds";
+	return "Edit " + n + " lower thirds";
+}
+
+// Calls fn(name) for every output-dir file an item refers to (pictures and sounds, including data rows).
+template<class F> static void for_each_file_ref(const lower_third_cfg &c, F &&fn)
+{
+	if (!c.profile_picture.empty())
+		fn(c.profile_picture);
+	if (!c.profile_picture_source.empty())
+		fn(c.profile_picture_source);
+	if (!c.anim_in_sound.empty())
+		fn(c.anim_in_sound);
+	if (!c.anim_out_sound.empty())
+		fn(c.anim_out_sound);
+	for (const auto &r : c.rows) {
+		if (!r.profile_picture.empty())
+			fn(r.profile_picture);
+	}
+}
+
+std::vector<std::string> page_files_of(const lower_third_cfg &c)
+{
+	std::vector<std::string> out;
+	for_each_file_ref(c, [&](const std::string &f) {
+		// The original is kept for re-derivation only; the page loads the resampled picture.
+		if (f != c.profile_picture_source || f == c.profile_picture)
+			out.push_back(f);
+	});
+	return out;
+}
+
+static bool file_still_referenced(const std::string &rel)
+{
+	const std::vector<lower_third_cfg> &items = live_items();
+	const auto uses = [&rel](const lower_third_cfg &c) {
+		bool found = false;
+		for_each_file_ref(c, [&](const std::string &f) { found = found || f == rel; });
+		return found;
+	};
+	const auto entryUses = [&uses](const history_entry &e) {
+		for (const auto &ch : e.items) {
+			if ((ch.before && uses(*ch.before)) || (ch.after && uses(*ch.after)))
+				return true;
+		}
+		return false;
+	};
+
+	return std::any_of(items.begin(), items.end(), uses) ||
+	       std::any_of(g_undo.begin(), g_undo.end(), entryUses) ||
+	       std::any_of(g_redo.begin(), g_redo.end(), entryUses);
+}
+
+static void remove_unreferenced_files(const std::vector<std::string> &files)
+{
+	if (!has_output_dir())
+		return;
+
+	for (const auto &rel : files) {
+		if (rel.empty() || file_still_referenced(rel))
+			continue;
+		remove_output_file(rel);
+	}
+}
+
+// Files of items that only exist in discarded redo entries (created, then undone).
+static std::vector<std::string> created_item_files(const std::vector<history_entry> &entries)
+{
+	std::vector<std::string> files;
+	for (const auto &e : entries) {
+		for (const auto &ch : e.items) {
+			if (!ch.before && ch.after)
+				for_each_file_ref(*ch.after, [&files](const std::string &f) { files.push_back(f); });
+		}
+	}
+	return files;
+}
+
+static void discard_redo()
+{
+	if (g_redo.empty())
+		return;
+
+	std::vector<std::string> files = created_item_files(g_redo);
+	for (const auto &e : g_redo)
+		g_hist_bytes -= e.bytes;
+	g_redo.clear();
+	remove_unreferenced_files(files);
+}
+
+static void enforce_history_budget()
+{
+	while (!g_undo.empty() &&
+	       (g_undo.size() > kHistoryMaxEntries || (g_hist_bytes > kHistoryBudgetBytes && g_undo.size() > 1))) {
+		history_entry e = std::move(g_undo.front());
+		g_undo.pop_front();
+		g_hist_bytes -= e.bytes;
+		remove_unreferenced_files(e.files); // the deletion is permanent now
+	}
+}
+
+void history_touch(const std::string &id)
+{
+	std::lock_guard<std::mutex> lk(g_hist_dirty_mx);
+	if (!g_hist_all_dirty)
+		g_hist_dirty.insert(id);
+}
+
+void history_touch_all()
+{
+	std::lock_guard<std::mutex> lk(g_hist_dirty_mx);
+	g_hist_all_dirty = true;
+	g_hist_dirty.clear();
+}
+
+// Takes the dirty marks; true when every item has to be compared.
+static bool history_take_dirty(std::unordered_set<std::string> &out)
+{
+	std::lock_guard<std::mutex> lk(g_hist_dirty_mx);
+	out.clear();
+	out.swap(g_hist_dirty);
+	const bool all = g_hist_all_dirty;
+	g_hist_all_dirty = false;
+	return all;
+}
+
+void history_rebase()
+{
+	{
+		std::unordered_set<std::string> dropped;
+		history_take_dirty(dropped);
+	}
+	const std::vector<lower_third_cfg> &items = live_items();
+	g_hist_base.clear();
+	g_hist_base.reserve(items.size() * 2 + 1);
+	for (const auto &c : items)
+		g_hist_base.emplace(c.id, baseline_item{std::make_shared<const lower_third_cfg>(c), std::nullopt});
+	g_hist_groups = std::make_shared<const std::vector<group_cfg>>(groups());
+	g_hist_groups_fp = groups_fingerprint();
+	g_hist_valid = true;
+}
+
+// Records c against its baseline entry (null when c is new) if they differ; returns the entry to keep.
+static baseline_item history_diff_item(const lower_third_cfg &c, baseline_item *b, history_entry &e)
+{
+	item_fingerprint fp(c);
+	if (b) {
+		if (!b->fp) {
+			b->fp.emplace(*b->cfg);
+			materialize_templates(*b->cfg);
+		}
+		if (*b->fp == fp)
+			return std::move(*b);
+	}
+
+	item_snapshot before = b ? b->cfg : nullptr;
+	item_snapshot after = snapshot_item(c);
+	e.bytes += item_bytes(*after, before.get());
+	e.items.push_back(history_item_change{c.id, std::move(before), after});
+	return baseline_item{std::move(after), std::move(fp)};
+}
+
+static void history_diff_removed(const std::string &id, const baseline_item &b, history_entry &e)
+{
+	materialize_templates(*b.cfg);
+	e.bytes += item_bytes(*b.cfg, nullptr);
+	e.items.push_back(history_item_change{id, b.cfg, nullptr});
+}
+
+// Diffs the dirty items against the baseline in place. False (nothing changed) when the item count
+// shows an add or remove that was not marked; the caller then compares everything.
+static bool history_diff_dirty(const std::unordered_set<std::string> &ids, history_entry &e)
+{
+	const std::vector<lower_third_cfg> &items = live_items();
+	std::vector<std::pair<const std::string *, const lower_third_cfg *>> dirty;
+	dirty.reserve(ids.size());
+	size_t expected = g_hist_base.size();
+	for (const auto &id : ids) {
+		auto it = std::find_if(items.begin(), items.end(),
+				       [&id](const lower_third_cfg &c) { return c.id == id; });
+		const lower_third_cfg *c = it != items.end() ? &*it : nullptr;
+		const bool known = g_hist_base.find(id) != g_hist_base.end();
+		expected += (c && !known) ? 1 : 0;
+		expected -= (!c && known) ? 1 : 0;
+		dirty.emplace_back(&id, c);
+	}
+	if (expected != items.size())
+		return false;
+
+	for (const auto &d : dirty) {
+		auto it = g_hist_base.find(*d.first);
+		if (!d.second) {
+			if (it != g_hist_base.end()) {
+				history_diff_removed(it->first, it->second, e);
+				g_hist_base.erase(it);
+			}
+			continue;
+		}
+		baseline_item kept = history_diff_item(*d.second, it != g_hist_base.end() ? &it->second : nullptr, e);
+		g_hist_base[*d.first] = std::move(kept);
+	}
+	return true;
+}
+
+// Records the difference as one undo entry unless an undo/redo is being applied or the change is
+// untracked, and moves the baseline forward. Unchanged items keep their snapshot. Only dirty items are
+// fingerprinted when the edit was limited to them.
+void history_capture()
+{
+	if (!g_hist_valid) {
+		history_rebase();
+		return;
+	}
+
+	const std::vector<lower_third_cfg> &items = live_items();
+	std::unordered_set<std::string> dirty;
+	const bool allDirty = history_take_dirty(dirty);
+
+	history_entry e;
+	if (allDirty || !history_diff_dirty(dirty, e)) {
+		e.items.clear();
+		e.bytes = 0;
+
+		std::unordered_map<std::string, baseline_item> next;
+		next.reserve(items.size() * 2 + 1);
+		for (const auto &c : items) {
+			auto it = g_hist_base.find(c.id);
+			next.emplace(c.id, history_diff_item(c, it != g_hist_base.end() ? &it->second : nullptr, e));
+		}
+		for (auto &kv : g_hist_base) {
+			if (next.find(kv.first) == next.end())
+				history_diff_removed(kv.first, kv.second, e);
+		}
+		g_hist_base = std::move(next);
+	}
+
+	std::string groupsFp = groups_fingerprint();
+	if (groupsFp != g_hist_groups_fp) {
+		e.groups_before = g_hist_groups;
+		e.groups_after = std::make_shared<const std::vector<group_cfg>>(groups());
+		e.bytes += groups_bytes(*e.groups_after);
+		g_hist_groups = e.groups_after;
+		g_hist_groups_fp = std::move(groupsFp);
+	}
+
+	if (g_hist_applying || g_hist_untracked || (e.items.empty() && !e.groups_after)) {
+		// Nothing to record; files released by an untracked change go right away.
+		std::vector<std::string> files;
+		files.swap(g_hist_pending_files);
+		remove_unreferenced_files(files);
+		return;
+	}
+
+	e.label = history_label(e);
+	e.files.swap(g_hist_pending_files);
+	e.bytes += sizeof(history_entry);
+
+	discard_redo();
+	g_hist_bytes += e.bytes;
+	LOGD("History: recorded '%s' (%zu items, %zu bytes; %zu entries, %zu bytes total)", e.label.c_str(),
+	     e.items.size(), e.bytes, g_undo.size() + 1, g_hist_bytes);
+	g_undo.push_back(std::move(e));
+	enforce_history_budget();
+}
+
+void history_defer_file_removal(const std::string &rel)
+{
+	if (!rel.empty())
+		g_hist_pending_files.push_back(rel);
+}
+
+void history_set_untracked(bool untracked)
+{
+	g_hist_untracked = untracked;
+}
+
+void count_file_refs(std::unordered_map<std::string, size_t> &refs)
+{
+	const auto count = [&refs](const lower_third_cfg &c) {
+		for_each_file_ref(c, [&refs](const std::string &f) { ++refs[f]; });
+	};
+	for (const auto &c : live_items())
+		count(c);
+	const auto countEntry = [&count](const history_entry &e) {
+		for (const auto &ch : e.items) {
+			if (ch.before)
+				count(*ch.before);
+			if (ch.after)
+				count(*ch.after);
+		}
+	};
+	std::for_each(g_undo.begin(), g_undo.end(), countEntry);
+	std::for_each(g_redo.begin(), g_redo.end(), countEntry);
+}
+
+static bool history_apply(const history_entry &e, bool undo)
+{
+	std::vector<lower_third_cfg> &items = live_items();
+	std::vector<std::string> hidden;
+
+	for (const auto &ch : e.items) {
+		const item_snapshot &target = undo ? ch.before : ch.after;
+		history_touch(ch.id);
+		auto it = std::find_if(items.begin(), items.end(),
+				       [&ch](const lower_third_cfg &c) { return c.id == ch.id; });
+		if (!target) {
+			if (it != items.end())
+				items.erase(it);
+			if (is_visible(ch.id)) {
+				set_visible_nosave(ch.id, false);
+				hidden.push_back(ch.id);
+			}
+		} else if (it != items.end()) {
+			// Row switches are not history: keep the live active row if the restored rows have it.
+			std::string activeRow = std::move(it->active_row);
+			*it = *target;
+			if (std::any_of(it->rows.begin(), it->rows.end(),
+					[&activeRow](const data_row &r) { return r.id == activeRow; }))
+				it->active_row = std::move(activeRow);
+		} else {
+			items.push_back(*target);
+		}
+	}
+
+	if (e.groups_after) {
+		const groups_snapshot &g = undo ? e.groups_before : e.groups_after;
+		if (g)
+			groups() = *g;
+	}
+
+	std::sort(items.begin(), items.end(), [](const lower_third_cfg &a, const lower_third_cfg &b) {
+		if (a.order != b.order)
+			return a.order < b.order;
+		return a.id < b.id;
+	});
+
+	g_hist_applying = true;
+	const bool ok = save_state_json();
+	g_hist_applying = false;
+	if (!hidden.empty())
+		save_visible_json();
+
+	request_rebuild();
+
+	emit_list_change(list_change_reason::Update, e.items.size() == 1 ? e.items.front().id : std::string());
+	if (!hidden.empty()) {
+		const std::vector<std::string> visNow = visible_ids();
+		for (const auto &id : hidden) {
+			core_event v;
+			v.type = event_type::VisibilityChanged;
+			v.id = id;
+			v.visible = false;
+			v.visible_ids = visNow;
+			emit_event(v);
+		}
+	}
+
+	LOGI("%s '%s'", undo ? "Undo" : "Redo", e.label.c_str());
+	return ok;
+}
+
+bool can_undo()
+{
+	return !g_undo.empty();
+}
+
+bool can_redo()
+{
+	return !g_redo.empty();
+}
+
+bool undo()
+{
+	if (!has_output_dir())
+		return false;
+
+	ensure_output_artifacts_exist();
+	reload_if_changed_on_disk();
+	if (g_undo.empty())
+		return false;
+
+	history_entry e = std::move(g_undo.back());
+	g_undo.pop_back();
+	const bool ok = history_apply(e, true);
+	g_redo.push_back(std::move(e));
+	return ok;
+}
+
+bool redo()
+{
+	if (!has_output_dir())
+		return false;
+
+	ensure_output_artifacts_exist();
+	reload_if_changed_on_disk();
+	if (g_redo.empty())
+		return false;
+
+	history_entry e = std::move(g_redo.back());
+	g_redo.pop_back();
+	const bool ok = history_apply(e, false);
+	g_undo.push_back(std::move(e));
+	return ok;
+}
+
+history_info history_state()
+{
+	history_info h;
+	h.undo_count = g_undo.size();
+	h.redo_count = g_redo.size();
+	h.bytes = g_hist_bytes;
+	if (!g_undo.empty())
+		h.undo_label = g_undo.back().label;
+	if (!g_redo.empty())
+		h.redo_label = g_redo.back().label;
+	return h;
+}
+
+void reset_history_after_external_load()
+{
+	clear_history();
+	history_rebase();
+}
+
+void clear_history()
+{
+	discard_redo();
+
+	std::vector<std::string> files;
+	files.swap(g_hist_pending_files);
+	for (auto &e : g_undo)
+		files.insert(files.end(), e.files.begin(), e.files.end());
+	g_undo.clear();
+	g_hist_bytes = 0;
+	remove_unreferenced_files(files);
+
+	g_hist_base.clear();
+	g_hist_groups.reset();
+	g_hist_groups_fp.clear();
+	g_hist_valid = false;
+}
+
+} // namespace vflow
@@ -0,0 +1,292 @@
+#define LOG_TAG "[" PLUGIN_NAME "][hot]"
+#include "hot_dir.hpp"
+
+#include "core.hpp"
+#include "out_buffer.hpp"
+
+#include <cstdio>
+#include <unordered_set>
+
+#include <QString>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace vflow {
+
+namespace fs = std::filesystem;
+
+static fs::path hot_base()
+{
+#ifdef __linux__
+	std::error_code ec;
+	if (fs::is_directory("/dev/shm", ec))
+		return "/dev/shm";
+#endif
+	return {};
+}
+
+bool hot_dir_supported()
+{
+	return !hot_base().empty();
+}
+
+std::string hot_dir_for(const std::string &durableDir)
+{
+	std::error_code ec;
+	const fs::path base = hot_base();
+	if (base.empty())
+		return {};
+
+	const fs::path durable = fs::weakly_canonical(fs::path(durableDir), ec);
+	const std::string key = (ec ? fs::path(durableDir) : durable).string();
+	uint64_t h = fnv1a64(key.data(), key.size());
+#ifndef _WIN32
+	const uid_t uid = getuid(); // /dev/shm is shared by all users
+	h = fnv1a64(&uid, sizeof(uid), h);
+#endif
+
+	char name[64];
+	std::snprintf(name, sizeof(name), "%s-%016llx", PLUGIN_NAME, (unsigned long long)h);
+	const fs::path dir = base / name;
+
+	ec.clear();
+	fs::create_directories(dir, ec);
+	if (ec || !fs::is_directory(dir, ec)) {
+		LOGW("Cannot create hot directory '%s' (%d)", dir.string().c_str(), (int)ec.value());
+		return {};
+	}
+	fs::permissions(dir, fs::perms::owner_all, fs::perm_options::replace, ec);
+	return dir.string();
+}
+
+static bool is_temp_name(const std::string &name)
+{
+	return name.size() > 4 && name.compare(name.size() - 4, 4, ".tmp") == 0;
+}
+
+// Copies src over dst through dst.tmp and gives the result src's mtime, so later passes (and the
+// state snapshot freshness check) see both sides as identical.
+static bool copy_with_mtime(const fs::path &src, const fs::path &dst, fs::file_time_type mtime)
+{
+	const fs::path tmp(dst.string() + ".tmp");
+	std::error_code ec;
+	fs::copy_file(src, tmp, fs::copy_options::overwrite_existing, ec);
+	if (!ec)
+		fs::last_write_time(tmp, mtime, ec);
+	if (!ec)
+		fs::rename(tmp, dst, ec);
+	if (ec) {
+		std::error_code ignore;
+		fs::remove(tmp, ignore);
+		// Files replaced between listing and copying are picked up by the next pass.
+		if (!fs::exists(src, ignore))
+			return true;
+		LOGW("Checkpoint copy '%s' -> '%s' failed (%d)", src.string().c_str(), dst.string().c_str(),
+		     (int)ec.value());
+		return false;
+	}
+	return true;
+}
+
+checkpointer::checkpointer(std::string hotDir, std::string durableDir, int minIntervalMs)
+	: hot_(std::move(hotDir)),
+	  durable_(std::move(durableDir)),
+	  interval_(minIntervalMs)
+{
+	worker_ = std::thread([this]() { run(); });
+}
+
+checkpointer::~checkpointer()
+{
+	{
+		std::lock_guard<std::mutex> lk(mx_);
+		stop_ = true;
+	}
+	cv_.notify_all();
+	if (worker_.joinable())
+		worker_.join();
+	flush();
+}
+
+size_t checkpointer::restore()
+{
+	std::lock_guard<std::mutex> lk(sync_mx_);
+
+	size_t copied = 0;
+	std::error_code ec;
+	for (const auto &de : fs::directory_iterator(fs::path(durable_), ec)) {
+		std::error_code fec;
+		const std::string name = de.path().filename().string();
+		if (!de.is_regular_file(fec) || is_temp_name(name))
+			continue;
+
+		stamp d;
+		d.size = de.file_size(fec);
+		d.mtime = de.last_write_time(fec);
+		if (fec)
+			continue;
+
+		const fs::path hot = fs::path(hot_) / name;
+		stamp h;
+		const bool hotExists = fs::exists(hot, fec);
+		if (hotExists) {
+			h.size = fs::file_size(hot, fec);
+			h.mtime = fs::last_write_time(hot, fec);
+		}
+		if (!hotExists || h.mtime < d.mtime) {
+			if (!copy_with_mtime(de.path(), hot, d.mtime))
+				continue;
+			h = d;
+			++copied;
+		}
+		if (h == d)
+			mirrored_[name] = d;
+	}
+	if (ec)
+		LOGW("Cannot list '%s' for restore (%d)", durable_.c_str(), (int)ec.value());
+	return copied;
+}
+
+void checkpointer::schedule()
+{
+	{
+		std::lock_guard<std::mutex> lk(mx_);
+		dirty_ = true;
+	}
+	cv_.notify_all();
+}
+
+bool checkpointer::remove(const std::string &name)
+{
+	// Under the pass lock: a pass seeing the name gone before the removal is queued would restore it.
+	std::lock_guard<std::mutex> slk(sync_mx_);
+	std::error_code ec;
+	const bool removed = fs::remove(fs::path(hot_) / name, ec);
+	{
+		std::lock_guard<std::mutex> lk(mx_);
+		removals_.push_back(name);
+		dirty_ = true;
+	}
+	cv_.notify_all();
+	return removed;
+}
+
+bool checkpointer::flush()
+{
+	{
+		std::lock_guard<std::mutex> lk(mx_);
+		dirty_ = false;
+	}
+	return sync_once();
+}
+
+void checkpointer::run()
+{
+	auto last = std::chrono::steady_clock::now() - interval_;
+
+	std::unique_lock<std::mutex> lk(mx_);
+	while (!stop_) {
+		cv_.wait(lk, [this]() { return dirty_ || stop_; });
+		// Changes arriving before the interval has passed are folded into the same pass.
+		if (cv_.wait_until(lk, last + interval_, [this]() { return stop_; }))
+			break;
+		if (!dirty_)
+			continue;
+		dirty_ = false;
+
+		lk.unlock();
+		sync_once();
+		last = std::chrono::steady_clock::now();
+		lk.lock();
+	}
+}
+
+bool checkpointer::sync_once()
+{
+	std::lock_guard<std::mutex> lk(sync_mx_);
+	const auto t0 = std::chrono::steady_clock::now();
+
+	std::vector<std::string> removals;
+	{
+		std::lock_guard<std::mutex> qlk(mx_);
+		removals.swap(removals_);
+	}
+
+	bool ok = true;
+	size_t copied = 0, removed = 0, reseeded = 0;
+	uint64_t bytes = 0;
+	std::unordered_set<std::string> seen;
+
+	std::error_code ec;
+	for (const auto &de : fs::directory_iterator(fs::path(hot_), ec)) {
+		std::error_code fec;
+		const std::string name = de.path().filename().string();
+		if (!de.is_regular_file(fec) || is_temp_name(name))
+			continue;
+
+		stamp s;
+		s.size = de.file_size(fec);
+		s.mtime = de.last_write_time(fec);
+		if (fec)
+			continue;
+		seen.insert(name);
+
+		auto it = mirrored_.find(name);
+		if (it != mirrored_.end() && it->second == s)
+			continue;
+		if (!copy_with_mtime(de.path(), fs::path(durable_) / name, s.mtime)) {
+			ok = false;
+			continue;
+		}
+		mirrored_[name] = s;
+		++copied;
+		bytes += s.size;
+	}
+	if (ec) {
+		LOGW("Cannot list hot directory '%s' (%d)", hot_.c_str(), (int)ec.value());
+		std::lock_guard<std::mutex> qlk(mx_);
+		removals_.insert(removals_.end(), removals.begin(), removals.end()); // retried next pass
+		return false;
+	}
+
+	// Deletions the owner asked for; a name written again since then is kept.
+	for (const auto &name : removals) {
+		if (seen.count(name))
+			continue;
+		std::error_code rec;
+		if (fs::remove(fs::path(durable_) / name, rec))
+			++removed;
+		mirrored_.erase(name);
+	}
+
+	// Anything else missing on the hot side was not deleted by us: the durable copy is the good one.
+	for (auto it = mirrored_.begin(); it != mirrored_.end();) {
+		if (seen.count(it->first)) {
+			++it;
+			continue;
+		}
+		std::error_code rec;
+		const fs::path durable = fs::path(durable_) / it->first;
+		const fs::file_time_type mtime = fs::last_write_time(durable, rec);
+		if (!rec && copy_with_mtime(durable, fs::path(hot_) / it->first, mtime)) {
+			++reseeded;
+			++it;
+		} else {
+			it = mirrored_.erase(it);
+		}
+	}
+	if (reseeded)
+		LOGW("Checkpoint: %zu files vanished from '%s'; restored them from '%s'", reseeded, hot_.c_str(),
+		     durable_.c_str());
+
+	if (copied || removed) {
+		const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+		LOGD("Checkpoint: %zu copied (%llu bytes), %zu removed in %.1f ms", copied, (unsigned long long)bytes,
+		     removed, ms);
+	}
+	return ok;
+}
+
+} // namespace vflow
@@ -0,0 +1,224 @@
+#define LOG_TAG "[" PLUGIN_NAME "][idle]"
+#include "idle.hpp"
+
+#include "core.hpp"
+
+#include <obs-frontend-api.h>
+#include <obs.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <mutex>
+
+#include <QDateTime>
+#include <QMetaObject>
+#include <QTimer>
+
+namespace vflow {
+
+// Nothing visible for this long before the source is disabled (covers out animations and sounds).
+static constexpr int64_t kIdleAfterMs = 5000;
+// Scheduled shows wake the source this long ahead of their target time.
+static constexpr int64_t kWakeLeadMs = 1000;
+
+static QTimer *g_timer = nullptr;
+static uint64_t g_listener = 0;
+
+// Startup and scene collection switches: stay awake until the collection is loaded.
+static bool g_suspended = true;
+static std::atomic<int64_t> g_next_wake_unix_ms{-1};
+
+// Woken from any thread (visibility events of websocket requests), hence the lock.
+static std::mutex g_mtx;
+static bool g_idle = false;
+static int64_t g_idle_since_ms = 0;
+static int64_t g_idle_total_ms = 0;
+static uint64_t g_sleeps = 0;
+static std::atomic<int64_t> g_last_busy_ms{0}; // last show or hide
+
+static int64_t now_ms()
+{
+	using namespace std::chrono;
+	return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static void wake(const char *why)
+{
+	std::lock_guard<std::mutex> lk(g_mtx);
+	if (!g_idle)
+		return;
+
+	g_idle = false;
+	const int64_t slept = now_ms() - g_idle_since_ms;
+	g_idle_total_ms += slept;
+	set_target_browser_source_enabled(true);
+	LOGD("Awake (%s) after %lld ms idle", why, (long long)slept);
+}
+
+static void sleep_now()
+{
+	std::lock_guard<std::mutex> lk(g_mtx);
+	if (g_idle || !set_target_browser_source_enabled(false))
+		return;
+
+	g_idle = true;
+	g_idle_since_ms = now_ms();
+	++g_sleeps;
+	LOGD("Idle: target Browser Source disabled");
+}
+
+static void arm(int64_t ms)
+{
+	g_timer->start((int)std::clamp<int64_t>(ms, 0, INT_MAX));
+}
+
+static void evaluate()
+{
+	g_timer->stop();
+	g_next_wake_unix_ms = -1;
+
+	if (g_suspended || !has_output_dir() || target_browser_source_name().empty()) {
+		wake("inactive");
+		return;
+	}
+	if (!visible_ids().empty()) {
+		wake("visible"); // normally already done by the event; the next hide re-evaluates
+		return;
+	}
+
+	int64_t nextShow = INT64_MAX;
+	for (const auto &c : scheduled_changes()) {
+		if (c.visible == 1)
+			nextShow = std::min(nextShow, c.at_ms);
+	}
+	const int64_t unixNow = QDateTime::currentMSecsSinceEpoch();
+	if (nextShow != INT64_MAX && nextShow - unixNow <= kWakeLeadMs) {
+		wake("scheduled show");
+		// Normally the show's visibility event re-evaluates first.
+		arm(nextShow - unixNow + kIdleAfterMs);
+		return;
+	}
+
+	const int64_t sleepIn = g_last_busy_ms.load() + kIdleAfterMs - now_ms();
+	if (sleepIn > 0) {
+		arm(sleepIn);
+		return;
+	}
+
+	sleep_now();
+	if (nextShow != INT64_MAX) {
+		g_next_wake_unix_ms = nextShow - kWakeLeadMs;
+		arm(nextShow - kWakeLeadMs - unixNow);
+	}
+}
+
+static void evaluate_on_ui_thread()
+{
+	if (!g_timer)
+		return;
+	QMetaObject::invokeMethod(
+		g_timer,
+		[]() {
+			if (g_timer)
+				evaluate();
+		},
+		Qt::AutoConnection);
+}
+
+static void on_core_event(const core_event &ev, void *)
+{
+	switch (ev.type) {
+	case event_type::VisibilityChanged:
+		g_last_busy_ms = now_ms();
+		// Synchronously, on the emitting thread: lt-visible.json is already written and the overlay may
+		// pick the show up on its next poll.
+		if (ev.visible)
+			wake("show");
+		break;
+	case event_type::ScheduleChanged:
+	case event_type::ListChanged:
+	case event_type::Reloaded:
+		break;
+	default:
+		return;
+	}
+	evaluate_on_ui_thread();
+}
+
+static void on_frontend_event(enum obs_frontend_event event, void *)
+{
+	switch (event) {
+	case OBS_FRONTEND_EVENT_FINISHED_LOADING:
+	case OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGED:
+		// The collection may have been saved while idle; only sources idle disabled are re-enabled.
+		set_target_browser_source_enabled(true);
+		g_suspended = false;
+		g_last_busy_ms = now_ms();
+		evaluate();
+		break;
+	case OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGING:
+	case OBS_FRONTEND_EVENT_EXIT:
+		g_suspended = true;
+		evaluate();
+		break;
+	default:
+		break;
+	}
+}
+
+void idle_start()
+{
+	if (g_timer)
+		return;
+
+	g_timer = new QTimer();
+	g_timer->setSingleShot(true);
+	QObject::connect(g_timer, &QTimer::timeout, g_timer, []() { evaluate(); });
+
+	g_listener = add_event_listener(on_core_event, nullptr);
+	obs_frontend_add_event_callback(on_frontend_event, nullptr);
+}
+
+void idle_stop()
+{
+	if (!g_timer)
+		return;
+
+	obs_frontend_remove_event_callback(on_frontend_event, nullptr);
+	if (g_listener) {
+		remove_event_listener(g_listener);
+		g_listener = 0;
+	}
+
+	wake("shutdown");
+	delete g_timer;
+	g_timer = nullptr;
+
+	const idle_status st = idle_status_now();
+	LOGI("Auto-idle: %llu sleeps, %lld s idle, ~%llu frames not composited", (unsigned long long)st.sleeps,
+	     (long long)(st.idle_total_ms / 1000), (unsigned long long)st.frames_skipped);
+}
+
+idle_status idle_status_now()
+{
+	idle_status st;
+	{
+		std::lock_guard<std::mutex> lk(g_mtx);
+		st.idle = g_idle;
+		st.idle_for_ms = g_idle ? now_ms() - g_idle_since_ms : 0;
+		st.idle_total_ms = g_idle_total_ms + st.idle_for_ms;
+		st.sleeps = g_sleeps;
+	}
+	const int64_t wakeAt = g_next_wake_unix_ms.load();
+	if (st.idle && wakeAt >= 0)
+		st.next_wake_in_ms = std::max<int64_t>(0, wakeAt - QDateTime::currentMSecsSinceEpoch());
+
+	obs_video_info ovi;
+	if (obs_get_video_info(&ovi) && ovi.fps_den > 0)
+		st.frames_skipped = (uint64_t)(st.idle_total_ms * ovi.fps_num / ((int64_t)ovi.fps_den * 1000));
+	return st;
+}
+
+} // namespace vflow
@@ -0,0 +1,563 @@
+#define LOG_TAG "[" PLUGIN_NAME "][import]"
+#include "import.hpp"
+
+#include "core.hpp"
+#include "core_internal.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QKeySequence>
+
+namespace vflow {
+
+// -------------------------
+// Bulk import
+// -------------------------
+
+namespace {
+
+struct import_record {
+	std::string id;
+	std::string label;
+	std::string title;
+	std::string subtitle;
+	std::string picture;
+	std::string group;
+	std::string hotkey;
+};
+
+using import_field = std::string import_record::*;
+
+} // namespace
+
+static import_field import_field_for(const std::string &key)
+{
+	std::string k;
+	k.reserve(key.size());
+	for (unsigned char ch : key) {
+		if (ch == ' ' || ch == '_' || ch == '-')
+			continue;
+		k.push_back((char)std::tolower(ch));
+	}
+
+	static const std::pair<const char *, import_field> kFields[] = {
+		{"id", &import_record::id},
+		{"label", &import_record::label},
+		{"title", &import_record::title},
+		{"subtitle", &import_record::subtitle},
+		{"picture", &import_record::picture},
+		{"profilepicture", &import_record::picture},
+		{"avatar", &import_record::picture},
+		{"image", &import_record::picture},
+		{"group", &import_record::group},
+		{"groupid", &import_record::group},
+		{"hotkey", &import_record::hotkey},
+	};
+	for (const auto &f : kFields) {
+		if (k == f.first)
+			return f.second;
+	}
+	return nullptr;
+}
+
+static std::string trimmed(std::string s)
+{
+	const auto notSpace = [](unsigned char ch) { return !std::isspace(ch); };
+	s.erase(s.begin(), std::find_if(s.begin(), s.end(), notSpace));
+	s.erase(std::find_if(s.rbegin(), s.rend(), notSpace).base(), s.end());
+	return s;
+}
+
+void skip_utf8_bom(std::istream &in)
+{
+	if (in.peek() != 0xEF)
+		return;
+	char bom[3] = {};
+	in.read(bom, 3);
+	if (in.gcount() == 3 && (unsigned char)bom[1] == 0xBB && (unsigned char)bom[2] == 0xBF)
+		return;
+	// Not a BOM: put the bytes back.
+	in.clear();
+	for (std::streamsize i = in.gcount(); i > 0; --i)
+		in.unget();
+}
+
+// Reads one RFC 4180 record; quoted fields may contain the delimiter, "" and line breaks.
+bool read_csv_record(std::istream &in, char delim, std::vector<std::string> &out)
+{
+	out.clear();
+	std::string field;
+	bool quoted = false;
+	bool any = false;
+
+	int ch;
+	while ((ch = in.get()) != std::char_traits<char>::eof()) {
+		any = true;
+		const char c = (char)ch;
+		if (quoted) {
+			if (c != '"')
+				field.push_back(c);
+			else if (in.peek() == '"')
+				field.push_back((char)in.get());
+			else
+				quoted = false;
+			continue;
+		}
+
+		if (c == '"' && trimmed(field).empty()) {
+			field.clear();
+			quoted = true;
+		} else if (c == delim) {
+			out.push_back(std::move(field));
+			field.clear();
+		} else if (c == '\n' || c == '\r') {
+			if (c == '\r' && in.peek() == '\n')
+				in.get();
+			break;
+		} else {
+			field.push_back(c);
+		}
+	}
+
+	if (!any)
+		return false;
+	out.push_back(std::move(field));
+	return true;
+}
+
+// Picks the delimiter that occurs most often (outside quotes) in the header line.
+char sniff_csv_delimiter(const std::string &headerLine)
+{
+	size_t comma = 0, semi = 0, tab = 0;
+	bool quoted = false;
+	for (char c : headerLine) {
+		if (c == '"')
+			quoted = !quoted;
+		else if (!quoted && c == ',')
+			++comma;
+		else if (!quoted && c == ';')
+			++semi;
+		else if (!quoted && c == '\t')
+			++tab;
+	}
+	if (tab > comma && tab >= semi)
+		return '\t';
+	if (semi > comma)
+		return ';';
+	return ',';
+}
+
+// Calls fn(record) for each data row. Returns false when there is no header row.
+template<class F> static bool for_each_csv_record(std::istream &in, F &&fn)
+{
+	std::string headerLine;
+	if (!std::getline(in, headerLine))
+		return false;
+	if (!headerLine.empty() && headerLine.back() == '\r')
+		headerLine.pop_back();
+
+	const char delim = sniff_csv_delimiter(headerLine);
+
+	std::vector<std::string> cells;
+	std::istringstream hs(headerLine);
+	if (!read_csv_record(hs, delim, cells))
+		return false;
+
+	std::vector<import_field> columns;
+	columns.reserve(cells.size());
+	for (const auto &h : cells) {
+		columns.push_back(import_field_for(trimmed(h)));
+		if (!columns.back())
+			LOGD("import: ignoring CSV column '%s'", h.c_str());
+	}
+
+	while (read_csv_record(in, delim, cells)) {
+		import_record rec;
+		bool any = false;
+		for (size_t i = 0; i < cells.size() && i < columns.size(); ++i) {
+			if (!columns[i])
+				continue;
+			rec.*columns[i] = trimmed(std::move(cells[i]));
+			any = any || !(rec.*columns[i]).empty();
+		}
+		// Blank lines come through as one empty cell; report them as skipped like other empty records.
+		fn(any ? &rec : nullptr);
+	}
+	return true;
+}
+
+// Integral numbers (ids, hotkey digits) keep every digit instead of QString::number's 6-digit %g.
+static QString json_number_text(double d)
+{
+	if (std::isfinite(d) && d == std::floor(d) && std::fabs(d) < 9007199254740992.0) // 2^53
+		return QString::number((qint64)d);
+	return QString::number(d, 'g', 17);
+}
+
+// True when the buffered top-level object text ends with an "items" key, i.e. the '[' that follows
+// opens the record array of an {"items": [...]} wrapper.
+static bool ends_with_items_key(const std::string &obj)
+{
+	size_t e = obj.size();
+	const auto skip_space = [&obj, &e]() {
+		while (e > 0 && std::isspace((unsigned char)obj[e - 1]))
+			--e;
+	};
+	skip_space();
+	if (e == 0 || obj[e - 1] != ':')
+		return false;
+	--e;
+	skip_space();
+	static constexpr std::string_view kKey = "\"items\"";
+	return e >= kKey.size() && std::string_view(obj).substr(e - kKey.size(), kKey.size()) == kKey;
+}
+
+// Splits a JSON array of objects, an {"items": [...]} wrapper, JSON Lines or concatenated objects into
+// one object text at a time, so only the current record is buffered and parsed. Calls fn(record) per
+// object.
+template<class F> static void for_each_json_record(std::istream &in, F &&fn)
+{
+	std::string obj;
+	int depth = 0;
+	bool inString = false;
+	bool escaped = false;
+	bool sawRecord = false;
+	bool sawArray = false;
+	bool inWrapper = false;
+
+	const auto parse_object = [&fn](const std::string &text) {
+		QJsonParseError err{};
+		const QJsonDocument doc = QJsonDocument::fromJson(QByteArray::fromStdString(text), &err);
+		if (err.error != QJsonParseError::NoError || !doc.isObject()) {
+			fn(nullptr);
+			return;
+		}
+
+		import_record rec;
+		bool any = false;
+		const QJsonObject o = doc.object();
+		for (auto it = o.begin(); it != o.end(); ++it) {
+			const import_field f = import_field_for(it.key().toStdString());
+			if (!f)
+				continue;
+			const QJsonValue v = it.value();
+			const QString str = v.isString() ? v.toString() : v.isDouble() ? json_number_text(v.toDouble()) : QString();
+			rec.*f = trimmed(str.toStdString());
+			any = any || !(rec.*f).empty();
+		}
+		fn(any ? &rec : nullptr);
+	};
+
+	int ch;
+	while ((ch = in.get()) != std::char_traits<char>::eof()) {
+		const char c = (char)ch;
+		if (depth == 0) {
+			// Between records: '[', ']', ',' and whitespace are skipped.
+			if (c == '{') {
+				depth = 1;
+				obj.assign(1, c);
+			} else if (c == '[') {
+				sawArray = true;
+			} else if (c == ']' && inWrapper) {
+				break; // the rest of the wrapper object holds no records
+			}
+			continue;
+		}
+
+		obj.push_back(c);
+		if (inString) {
+			if (escaped)
+				escaped = false;
+			else if (c == '\\')
+				escaped = true;
+			else if (c == '"')
+				inString = false;
+		} else if (c == '"') {
+			inString = true;
+		} else if (c == '[' && depth == 1 && !sawRecord && !sawArray && ends_with_items_key(obj)) {
+			// The first top-level object is a wrapper: its "items" array elements are the records.
+			inWrapper = true;
+			depth = 0;
+			obj.clear();
+		} else if (c == '{') {
+			++depth;
+		} else if (c == '}' && --depth == 0) {
+			sawRecord = true;
+			parse_object(obj);
+			obj.clear();
+		}
+	}
+
+	if (depth > 0)
+		fn(nullptr); // truncated trailing object
+}
+
+static import_format sniff_import_format(std::istream &in)
+{
+	while (in.good() && std::isspace(in.peek()))
+		in.get();
+	const int c = in.peek();
+	return (c == '[' || c == '{') ? import_format::Json : import_format::Csv;
+}
+
+import_result import_lower_thirds(std::istream &in, const import_options &opt)
+{
+	import_result res;
+	const auto t0 = std::chrono::steady_clock::now();
+
+	if (!has_output_dir()) {
+		res.error = "Output folder not set";
+		return res;
+	}
+
+	ensure_output_artifacts_exist();
+	reload_if_changed_on_disk();
+	std::vector<lower_third_cfg> &items = live_items(); // additions are marked for the history one by one
+	std::vector<group_cfg> &groupList = groups();
+
+	lower_third_cfg base;
+	if (!opt.base_id.empty()) {
+		const lower_third_cfg *b = get_by_id_const(sanitize_id(opt.base_id));
+		if (!b) {
+			res.error = "Invalid baseId";
+			return res;
+		}
+		base = *b;
+	} else {
+		base = default_cfg();
+	}
+
+	// Per-item data is never inherited: pictures are deleted with their item and hotkeys must be unique.
+	base.profile_picture.clear();
+	base.profile_picture_source.clear();
+	base.hotkey.clear();
+	base.instanced = false;
+	base.rows.clear();
+	base.active_row.clear();
+	base.repeat_every_sec = 0;
+	base.repeat_visible_sec = 0;
+
+	// Hotkeys compare in Qt's portable form, like the settings dialog does.
+	const auto hotkey_key = [](const std::string &s) {
+		return QKeySequence(QString::fromStdString(s)).toString(QKeySequence::PortableText).trimmed().toStdString();
+	};
+
+	std::unordered_set<std::string> takenIds;
+	std::unordered_set<std::string> takenHotkeys;
+	takenIds.reserve(items.size() * 2 + 64);
+	int nextOrder = 0;
+	for (const auto &it : items) {
+		takenIds.insert(it.id);
+		nextOrder = std::max(nextOrder, it.order + 1);
+		if (!it.hotkey.empty())
+			takenHotkeys.insert(hotkey_key(it.hotkey));
+	}
+	for (const auto &g : groupList) {
+		if (!g.toggle_hotkey.empty())
+			takenHotkeys.insert(hotkey_key(g.toggle_hotkey));
+	}
+
+	// Group key (id or title) -> group id, covering existing groups and the ones created by this import.
+	std::unordered_map<std::string, std::string> groupByKey;
+	int nextGroupOrder = 0;
+	for (const auto &g : groupList) {
+		groupByKey.emplace(g.title, g.id);
+		groupByKey[g.id] = g.id;
+		nextGroupOrder = std::max(nextGroupOrder, g.order + 1);
+	}
+
+	std::vector<lower_third_cfg> fresh;
+	std::vector<group_cfg> freshGroups;
+	std::vector<std::pair<std::string, std::string>> memberships; // (group id, item id)
+
+	const auto resolve_group = [&](const std::string &key) -> std::string {
+		if (key.empty())
+			return {};
+		auto it = groupByKey.find(key);
+		if (it != groupByKey.end())
+			return it->second;
+
+		group_cfg g = default_group_cfg();
+		while (get_group_by_id(g.id) || groupByKey.count(g.id))
+			g.id = new_id();
+		g.title = key;
+		g.order = nextGroupOrder++;
+		groupByKey.emplace(key, g.id);
+		groupByKey.emplace(g.id, g.id);
+		freshGroups.push_back(g);
+		return g.id;
+	};
+
+	const auto on_record = [&](const import_record *rec) {
+		if (!rec) {
+			++res.skipped;
+			return;
+		}
+
+		lower_third_cfg c = base;
+
+		c.id = rec->id.empty() ? std::string() : sanitize_id(rec->id);
+		if (c.id.empty() || takenIds.count(c.id)) {
+			do
+				c.id = new_id();
+			while (takenIds.count(c.id));
+		}
+		takenIds.insert(c.id);
+
+		if (!rec->title.empty())
+			c.title = rec->title;
+		if (!rec->subtitle.empty())
+			c.subtitle = rec->subtitle;
+		c.label = !rec->label.empty() ? rec->label : !rec->title.empty() ? rec->title : c.label;
+		// Existing bindings win; a duplicate within the input keeps its first occurrence.
+		if (!rec->hotkey.empty()) {
+			const std::string hk = hotkey_key(rec->hotkey);
+			if (hk.empty() || !takenHotkeys.insert(hk).second)
+				LOGW("import: dropping hotkey '%s' of '%s' (invalid or already bound)", rec->hotkey.c_str(),
+				     c.id.c_str());
+			else
+				c.hotkey = hk;
+		}
+		c.profile_picture = import_picture(rec->picture);
+		c.order = nextOrder++;
+
+		const std::string gid = resolve_group(rec->group.empty() ? opt.group_id : rec->group);
+		if (!gid.empty())
+			memberships.emplace_back(gid, c.id);
+
+		fresh.push_back(std::move(c));
+	};
+
+	skip_utf8_bom(in);
+	import_format fmt = opt.format;
+	if (fmt == import_format::Auto)
+		fmt = sniff_import_format(in);
+
+	if (fmt == import_format::Json) {
+		for_each_json_record(in, on_record);
+	} else if (!for_each_csv_record(in, on_record)) {
+		res.error = "Missing CSV header row";
+		return res;
+	}
+
+	if (fresh.empty()) {
+		res.error = "No lower thirds found in input";
+		return res;
+	}
+
+	// Kept to undo the batch if it cannot be saved.
+	const size_t itemsBefore = items.size();
+	const size_t groupsBefore = groupList.size();
+	std::vector<std::pair<std::string, size_t>> membersBefore; // (group id, member count)
+	for (const auto &m : memberships) {
+		if (const group_cfg *g = get_group_by_id(m.first))
+			membersBefore.emplace_back(g->id, g->members.size());
+	}
+
+	// Orders continue after the current maximum, so appending keeps the items sorted.
+	res.ids.reserve(fresh.size());
+	items.reserve(items.size() + fresh.size());
+	for (auto &c : fresh) {
+		res.ids.push_back(c.id);
+		history_touch(c.id);
+		items.push_back(std::move(c));
+	}
+
+	res.groups_created = freshGroups.size();
+	for (auto &g : freshGroups)
+		groupList.push_back(std::move(g));
+	for (const auto &m : memberships) {
+		if (group_cfg *g = get_group_by_id(m.first))
+			g->members.push_back(m.second);
+	}
+
+	if (opt.visible) {
+		for (const auto &id : res.ids)
+			set_visible_nosave(id, true);
+	}
+
+	res.ok = save_state_json();
+	if (!res.ok) {
+		// Nothing of the batch stays in memory; picture files it stored go with the next asset cleanup.
+		if (opt.visible) {
+			for (const auto &id : res.ids)
+				set_visible_nosave(id, false);
+		}
+		for (const auto &m : membersBefore) {
+			if (group_cfg *g = get_group_by_id(m.first))
+				g->members.resize(std::min(g->members.size(), m.second));
+		}
+		groupList.erase(groupList.begin() + (std::ptrdiff_t)groupsBefore, groupList.end());
+		items.erase(items.begin() + (std::ptrdiff_t)itemsBefore, items.end());
+		res.ids.clear();
+		res.groups_created = 0;
+		res.error = "Failed to save state";
+		return res;
+	}
+	if (opt.visible)
+		save_visible_json();
+
+	request_rebuild();
+
+	res.elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+	res.items_per_sec = res.elapsed_ms > 0.0 ? (double)res.ids.size() * 1000.0 / res.elapsed_ms : 0.0;
+	LOGI("Imported %zu lower thirds (%zu skipped, %zu groups created) in %.1f ms (%.0f items/s)",
+	     res.ids.size(), res.skipped, res.groups_created, res.elapsed_ms, res.items_per_sec);
+
+	{
+		core_event l;
+		l.type = event_type::ListChanged;
+		l.reason = list_change_reason::Create;
+		l.id = res.ids.front();
+		l.count = (int64_t)items.size();
+		emit_event(l);
+
+		if (opt.visible) {
+			core_event v;
+			v.type = event_type::VisibilityChanged;
+			v.id = res.ids.front();
+			v.visible = true;
+			v.visible_ids = visible_ids();
+			emit_event(v);
+		}
+	}
+
+	return res;
+}
+
+import_result import_lower_thirds_file(const std::string &path, const import_options &opt)
+{
+	std::ifstream in(std::filesystem::path(path), std::ios::binary);
+	if (!in) {
+		import_result res;
+		res.error = "Cannot open '" + path + "'";
+		return res;
+	}
+
+	import_options o = opt;
+	if (o.format == import_format::Auto) {
+		std::string ext = std::filesystem::path(path).extension().string();
+		std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char ch) { return (char)std::tolower(ch); });
+		if (ext == ".csv" || ext == ".tsv" || ext == ".txt")
+			o.format = import_format::Csv;
+		else if (ext == ".json" || ext == ".jsonl" || ext == ".ndjson")
+			o.format = import_format::Json;
+	}
+	return import_lower_thirds(in, o);
+}
+
+} // namespace vflow
@@ -0,0 +1,119 @@
+#include "json_writer.hpp"
+
+namespace vflow {
+
+void json_writer::newline()
+{
+	if (!pretty_)
+		return;
+	out_ << '\n';
+	for (size_t i = 0; i < first_.size(); ++i)
+		out_ << "  ";
+}
+
+void json_writer::before_value()
+{
+	if (after_key_) {
+		after_key_ = false;
+		return;
+	}
+	if (first_.empty())
+		return;
+	if (!first_.back())
+		out_ << ',';
+	first_.back() = false;
+	newline();
+}
+
+void json_writer::open(char c)
+{
+	before_value();
+	out_ << c;
+	first_.push_back(true);
+}
+
+void json_writer::close(char c)
+{
+	const bool empty = first_.empty() || first_.back();
+	if (!first_.empty())
+		first_.pop_back();
+	if (!empty)
+		newline();
+	out_ << c;
+}
+
+void json_writer::key(std::string_view k)
+{
+	before_value();
+	write_escaped(k);
+	out_ << (pretty_ ? ": " : ":");
+	after_key_ = true;
+}
+
+void json_writer::value(std::string_view v)
+{
+	before_value();
+	write_escaped(v);
+}
+
+void json_writer::value(bool v)
+{
+	before_value();
+	out_ << (v ? "true" : "false");
+}
+
+void json_writer::value(int64_t v)
+{
+	before_value();
+	out_.append_int((long long)v);
+}
+
+void json_writer::write_escaped(std::string_view s)
+{
+	static constexpr char kHex[] = "0123456789abcdef";
+
+	out_ << '"';
+	// Copy unescaped runs in one append; only quotes, backslashes and control characters break a run.
+	size_t run = 0;
+	for (size_t i = 0; i < s.size(); ++i) {
+		const unsigned char ch = (unsigned char)s[i];
+		if (ch >= 0x20 && ch != '"' && ch != '\\')
+			continue;
+
+		out_.append(s.data() + run, i - run);
+		run = i + 1;
+
+		switch (ch) {
+		case '"':
+			out_ << "\\\"";
+			break;
+		case '\\':
+			out_ << "\\\\";
+			break;
+		case '\n':
+			out_ << "\\n";
+			break;
+		case '\r':
+			out_ << "\\r";
+			break;
+		case '\t':
+			out_ << "\\t";
+			break;
+		case '\b':
+			out_ << "\\b";
+			break;
+		case '\f':
+			out_ << "\\f";
+			break;
+		default: {
+			const char esc[6] = {'\\', 'u', '0', '0', kHex[ch >> 4], kHex[ch & 0xF]};
+			out_.append(esc, sizeof(esc));
+			break;
+		}
+		}
+	}
+	out_.append(s.data() + run, s.size() - run);
+	out_ << '"';
+}
+
+} // namespace vflow
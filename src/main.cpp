@@ -2,6 +2,13 @@
 #include "core.hpp"
 #include "dock.hpp"
 #include "headers/api.hpp"
+#include "history.hpp"
+#include "idle.hpp"
+#include "native_source.hpp"
+#include "profiles.hpp"
+#include "rules.hpp"
+#include "rundown.hpp"
+#include "scheduler.hpp"
 #include "websocket_bridge.hpp"
 
 #include <obs-frontend-api.h>
@@ -48,7 +55,11 @@ bool obs_module_load(void)
 {
 	LOGI("Plugin loaded (version %s)", PLUGIN_VERSION);
 
+	vflow::start_browser_source_registry();
 	vflow::init_from_disk();
+	vflow::scheduler_start();
+	vflow::rundown_init();
+	vflow::native_source_register();
 	LowerThird_create_dock();
 	return true;
 }
@@ -56,6 +67,8 @@ bool obs_module_load(void)
 void obs_module_post_load(void)
 {
 	obs_frontend_add_event_callback(on_frontend_event, nullptr);
+	vflow::rules_start();
+	vflow::idle_start();
 	vflow::ws::init();
 
 	// StreamRSC remote API endpoints are no longer reachable.
@@ -73,6 +86,17 @@ void obs_module_unload(void)
 
 	vflow::ws::shutdown();
 	LowerThird_destroy_dock();
+	vflow::idle_stop();
+	vflow::rules_stop();
+	vflow::rundown_shutdown();
+	vflow::native_source_shutdown();
+	vflow::scheduler_stop();
+	vflow::stop_output_watcher();
+	vflow::shutdown_profiles();
+	vflow::shutdown_rebuilds();
+	vflow::clear_history();
+	vflow::shutdown_hot_output();
+	vflow::stop_browser_source_registry();
 
 	LOGI("Plugin %s unloaded", PLUGIN_NAME);
 }
@@ -0,0 +1,626 @@
+#define LOG_TAG "[" PLUGIN_NAME "][native]"
+#include "native_source.hpp"
+
+#include "core.hpp"
+
+#include <obs-module.h>
+#include <obs.h>
+#include <util/platform.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <QColor>
+#include <QCoreApplication>
+#include <QFont>
+#include <QFontMetrics>
+#include <QImage>
+#include <QLinearGradient>
+#include <QMetaObject>
+#include <QPainter>
+#include <QPainterPath>
+#include <QString>
+#include <QThread>
+
+namespace vflow {
+
+static constexpr const char *kSourceId = "vflow_lower_third";
+static constexpr uint64_t kAnimNs = 1000000000ULL; // animate.css' default --animate-duration
+
+// Metrics of the default template (.slt-content padding and gap, .slt-subtitle margin).
+static constexpr int kPadX = 18;
+static constexpr int kPadY = 14;
+static constexpr int kGap = 12;
+static constexpr int kSubtitleGap = 2;
+
+// -------------------------
+// Drawing
+// -------------------------
+
+struct motion {
+	bool fade = true;
+	// Where the card is, in card sizes, while away: at the start of an in, at the end of an out.
+	int dx = 0;
+	int dy = 0;
+
+	bool operator==(const motion &o) const { return fade == o.fade && dx == o.dx && dy == o.dy; }
+};
+
+// animate.css names: animate__<effect><In|Out>[Left|Right|Up|Down][Big]; Up/Down is the direction of travel.
+// Slides only move, fades move when they have a direction; other effects (zoom, bounce, custom) fade.
+static motion motion_of(const std::string &cls, bool in)
+{
+	motion m;
+	const bool slide = cls.find("slide") != std::string::npos;
+	if (!slide && cls.find("fade") == std::string::npos)
+		return m;
+	m.fade = !slide;
+
+	std::string tail = cls;
+	const auto ends = [&tail](const char *s) {
+		const size_t n = strlen(s);
+		return tail.size() >= n && tail.compare(tail.size() - n, n, s) == 0;
+	};
+	if (ends("Big"))
+		tail.resize(tail.size() - 3);
+
+	if (ends("Left"))
+		m.dx = -1;
+	else if (ends("Right"))
+		m.dx = 1;
+	else if (ends("Up"))
+		m.dy = in ? 1 : -1;
+	else if (ends("Down"))
+		m.dy = in ? -1 : 1;
+	return m;
+}
+
+// What a card is drawn from: the item's fields with the active row applied, resolved on the core's side.
+struct card_spec {
+	std::string title;
+	std::string subtitle;
+	std::string picture_path; // absolute; empty = none
+	QString font_family;
+
+	QColor primary;
+	QColor secondary;
+	QColor title_color;
+	QColor subtitle_color;
+
+	int title_size = 46;
+	int subtitle_size = 24;
+	int opacity = 85;
+	int radius = 5;
+	int avatar_width = 100;
+	int avatar_height = 100;
+
+	motion in;
+	motion out;
+
+	bool operator==(const card_spec &o) const
+	{
+		return title == o.title && subtitle == o.subtitle && picture_path == o.picture_path &&
+		       font_family == o.font_family && primary == o.primary && secondary == o.secondary &&
+		       title_color == o.title_color && subtitle_color == o.subtitle_color &&
+		       title_size == o.title_size && subtitle_size == o.subtitle_size && opacity == o.opacity &&
+		       radius == o.radius && avatar_width == o.avatar_width && avatar_height == o.avatar_height &&
+		       in == o.in && out == o.out;
+	}
+	bool operator!=(const card_spec &o) const { return !(*this == o); }
+};
+
+static QColor qcolor_of(const color_rgba &c, const QColor &fallback)
+{
+	if (c.is_hex()) {
+		const uint32_t v = c.rgba();
+		return QColor((int)(v >> 24), (int)((v >> 16) & 0xFF), (int)((v >> 8) & 0xFF), (int)(v & 0xFF));
+	}
+	const QColor q(QString::fromStdString(c.str()));
+	return q.isValid() ? q : fallback;
+}
+
+// First family of a CSS font list, unquoted.
+static QString first_font_family(const std::string &css)
+{
+	QString f = QString::fromStdString(css).section(',', 0, 0).trimmed();
+	if (f.size() >= 2 && (f.front() == '"' || f.front() == '\'') && f.back() == f.front())
+		f = f.mid(1, f.size() - 2);
+	return f.isEmpty() ? QStringLiteral("Inter") : f;
+}
+
+static card_spec spec_of(const lower_third_cfg &c)
+{
+	card_spec s;
+	const data_row *row = c.instanced ? active_row_of(c) : nullptr;
+	s.title = row ? row->title : c.title;
+	s.subtitle = row ? row->subtitle : c.subtitle;
+	const std::string &pic = row ? row->profile_picture : c.profile_picture;
+	if (!pic.empty() && has_output_dir())
+		s.picture_path = output_dir() + "/" + pic;
+	s.font_family = first_font_family(c.font_family);
+
+	s.primary = qcolor_of(c.primary_color, QColor(0x11, 0x18, 0x27));
+	s.secondary = qcolor_of(c.secondary_color, s.primary);
+	s.title_color = qcolor_of(c.title_color, Qt::white);
+	s.subtitle_color = qcolor_of(c.subtitle_color, s.title_color);
+
+	s.title_size = std::clamp<int>(c.title_size, 6, 200);
+	s.subtitle_size = std::clamp<int>(c.subtitle_size, 6, 200);
+	s.opacity = std::clamp<int>(c.opacity, 0, 100);
+	s.radius = std::clamp<int>(c.radius, 0, 100);
+	s.avatar_width = std::clamp<int>(c.avatar_width, 1, 2000);
+	s.avatar_height = std::clamp<int>(c.avatar_height, 1, 2000);
+
+	s.in = motion_of(c.anim_in.str(), true);
+	s.out = motion_of(c.anim_out.str(), false);
+	return s;
+}
+
+// Scaled to cover w x h and center-cropped (object-fit: cover); null when the file does not load.
+static QImage load_cover(const std::string &path, int w, int h)
+{
+	QImage img(QString::fromStdString(path));
+	if (img.isNull())
+		return img;
+	img = img.scaled(w, h, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
+	return img.copy((img.width() - w) / 2, (img.height() - h) / 2, w, h);
+}
+
+// The card at rest, laid out like the default template: gradient box, round picture, title over subtitle.
+static QImage draw_card(const card_spec &s)
+{
+	QFont titleFont(s.font_family);
+	titleFont.setPixelSize(s.title_size);
+	titleFont.setWeight(QFont::Bold);
+	QFont subtitleFont(s.font_family);
+	subtitleFont.setPixelSize(s.subtitle_size);
+
+	const QString title = QString::fromStdString(s.title);
+	const QString subtitle = QString::fromStdString(s.subtitle);
+	const QFontMetrics tm(titleFont);
+	const QFontMetrics sm(subtitleFont);
+
+	const int titleH = title.isEmpty() ? 0 : (int)std::ceil(s.title_size * 1.1); // line-height: 1.1
+	const int subtitleH = subtitle.isEmpty() ? 0 : kSubtitleGap + sm.height();
+	const int textW = std::max(title.isEmpty() ? 0 : tm.horizontalAdvance(title),
+				   subtitle.isEmpty() ? 0 : sm.horizontalAdvance(subtitle));
+	const int textH = titleH + subtitleH;
+
+	const QImage avatar = s.picture_path.empty() ? QImage()
+						     : load_cover(s.picture_path, s.avatar_width, s.avatar_height);
+	const int avatarW = avatar.isNull() ? 0 : s.avatar_width;
+	const int avatarH = avatar.isNull() ? 0 : s.avatar_height;
+
+	const int w = kPadX * 2 + avatarW + (avatarW && textW ? kGap : 0) + textW;
+	const int h = kPadY * 2 + std::max(avatarH, textH);
+
+	QImage card(w, h, QImage::Format_ARGB32_Premultiplied);
+	card.fill(Qt::transparent);
+
+	QPainter p(&card);
+	p.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing | QPainter::SmoothPixmapTransform);
+
+	// .slt-bg: linear-gradient(135deg, primary, secondary) at the item's opacity.
+	const qreal r = std::min<qreal>(s.radius, h / 2.0);
+	QPainterPath box;
+	box.addRoundedRect(QRectF(0, 0, w, h), r, r);
+	QLinearGradient bg(0, 0, w, h);
+	bg.setColorAt(0, s.primary);
+	bg.setColorAt(1, s.secondary);
+	p.setOpacity(s.opacity / 100.0);
+	p.fillPath(box, bg);
+	p.setOpacity(1.0);
+
+	int x = kPadX;
+	if (avatarW) {
+		QPainterPath round;
+		round.addEllipse(QRectF(x, (h - avatarH) / 2.0, avatarW, avatarH));
+		p.setClipPath(round);
+		p.drawImage(x, (h - avatarH) / 2, avatar);
+		p.setClipping(false);
+		x += avatarW + (textW ? kGap : 0);
+	}
+
+	int y = (h - textH) / 2;
+	if (titleH) {
+		p.setFont(titleFont);
+		p.setPen(s.title_color);
+		p.drawText(QRect(x, y, textW, titleH), Qt::AlignLeft | Qt::AlignVCenter, title);
+		y += titleH;
+	}
+	if (subtitleH) {
+		p.setFont(subtitleFont);
+		p.setPen(s.subtitle_color);
+		p.setOpacity(0.9);
+		p.drawText(QRect(x, y + kSubtitleGap, textW, sm.height()), Qt::AlignLeft | Qt::AlignVCenter, subtitle);
+	}
+	return card;
+}
+
+// Places the card at 'shown' (0 = away, 1 = at rest) into 'out', which keeps its buffer between frames.
+// ARGB32 is BGRA in memory with straight alpha, which is how OBS takes async BGRA frames.
+static void compose(const QImage &card, const motion &m, double shown, QImage &out)
+{
+	if (out.size() != card.size())
+		out = QImage(card.size(), QImage::Format_ARGB32);
+	out.fill(Qt::transparent);
+
+	QPainter p(&out);
+	if (m.fade)
+		p.setOpacity(shown);
+	const double away = 1.0 - shown;
+	p.drawImage(QPointF(away * m.dx * card.width(), away * m.dy * card.height()), card);
+}
+
+static double ease_out(double t)
+{
+	return 1.0 - std::pow(1.0 - t, 3.0);
+}
+
+static double ease_in(double t)
+{
+	return t * t * t;
+}
+
+static uint64_t frame_interval_ns()
+{
+	obs_video_info ovi;
+	if (obs_get_video_info(&ovi) && ovi.fps_num > 0)
+		return (uint64_t)ovi.fps_den * 1000000000ULL / ovi.fps_num;
+	return 1000000000ULL / 60;
+}
+
+// -------------------------
+// Source instances
+// -------------------------
+
+struct native_lt {
+	obs_source_t *source = nullptr;
+
+	std::mutex mtx;
+	std::condition_variable cv;
+	std::string item_id;
+	card_spec spec;
+	bool have_spec = false; // item exists
+	bool visible = false;
+	bool spec_changed = true;
+	bool changed = true; // wakes the worker
+	bool quit = false;
+
+	std::thread worker;
+	std::atomic<uint64_t> frames{0};
+};
+
+// Live instances, so the shared core listener never reaches a destroyed one.
+static std::mutex g_live_mtx;
+static std::vector<native_lt *> g_live;
+static uint64_t g_listener = 0;
+static std::atomic<bool> g_refresh_queued{false};
+
+static void output_frame(native_lt *s, const QImage &frame)
+{
+	obs_source_frame f = {};
+	f.data[0] = const_cast<uint8_t *>(frame.constBits());
+	f.linesize[0] = (uint32_t)frame.bytesPerLine();
+	f.width = (uint32_t)frame.width();
+	f.height = (uint32_t)frame.height();
+	f.format = VIDEO_FORMAT_BGRA;
+	f.timestamp = os_gettime_ns();
+	obs_source_output_video(s->source, &f); // copied by OBS
+	++s->frames;
+}
+
+static void run_worker(native_lt *s)
+{
+	enum class phase { Hidden, In, Shown, Out };
+	phase ph = phase::Hidden;
+	uint64_t since = 0;
+	bool settled = false; // the resting state of 'ph' was output
+
+	card_spec spec;
+	QImage card;
+	QImage frame;
+
+	std::unique_lock<std::mutex> lk(s->mtx);
+	while (!s->quit) {
+		s->changed = false;
+		const bool redraw = s->spec_changed;
+		if (redraw) {
+			spec = s->spec;
+			s->spec_changed = false;
+			settled = false;
+		}
+		const bool have = s->have_spec;
+		const bool want = s->visible && have;
+		lk.unlock();
+
+		const uint64_t now = os_gettime_ns();
+		if (want && (ph == phase::Hidden || ph == phase::Out)) {
+			ph = phase::In;
+			since = now;
+		} else if (!want && (ph == phase::In || ph == phase::Shown)) {
+			ph = have ? phase::Out : phase::Hidden;
+			since = now;
+			settled = false;
+		}
+
+		if (redraw)
+			card = have ? draw_card(spec) : QImage();
+
+		bool animating = false;
+		if (ph == phase::In || ph == phase::Out) {
+			const double t = std::min(1.0, (double)(now - since) / (double)kAnimNs);
+			if (t >= 1.0 || card.isNull()) {
+				ph = ph == phase::In ? phase::Shown : phase::Hidden;
+				settled = false;
+			} else {
+				const bool in = ph == phase::In;
+				compose(card, in ? spec.in : spec.out, in ? ease_out(t) : 1.0 - ease_in(t), frame);
+				output_frame(s, frame);
+				animating = true;
+			}
+		}
+		if (!animating && !settled) {
+			if (ph == phase::Shown && !card.isNull()) {
+				compose(card, motion(), 1.0, frame);
+				output_frame(s, frame);
+			} else {
+				obs_source_output_video(s->source, nullptr);
+			}
+			settled = true;
+			frame = QImage(); // nothing to keep between changes
+		}
+
+		lk.lock();
+		if (animating)
+			s->cv.wait_for(lk, std::chrono::nanoseconds(frame_interval_ns()),
+				       [s]() { return s->quit || s->changed; });
+		else
+			s->cv.wait(lk, [s]() { return s->quit || s->changed; });
+	}
+}
+
+// Re-reads the item and wakes the worker if anything it draws from changed; the card (and its picture)
+// is only redrawn when the spec itself differs. UI thread, which owns the items.
+static void refresh(native_lt *s)
+{
+	std::string id;
+	{
+		std::lock_guard<std::mutex> lk(s->mtx);
+		id = s->item_id;
+	}
+
+	const lower_third_cfg *c = id.empty() ? nullptr : get_by_id_const(id);
+	card_spec spec = c ? spec_of(*c) : card_spec();
+	const bool visible = c && is_visible(id);
+
+	std::lock_guard<std::mutex> lk(s->mtx);
+	if (s->item_id != id)
+		return; // settings changed meanwhile; that update refreshes again
+	const bool have = c != nullptr;
+	const bool specChanged = have != s->have_spec || s->spec != spec;
+	if (!specChanged && visible == s->visible)
+		return;
+	if (specChanged) {
+		s->spec = std::move(spec);
+		s->have_spec = have;
+		s->spec_changed = true;
+	}
+	s->visible = visible;
+	s->changed = true;
+	s->cv.notify_one();
+}
+
+static void refresh_all()
+{
+	// Few instances and a cheap re-read each; batches and reloads need no id matching this way.
+	std::lock_guard<std::mutex> lk(g_live_mtx);
+	for (native_lt *s : g_live)
+		refresh(s);
+}
+
+// Any thread: refreshes on the UI thread, right away when already on it. Requests made while one is
+// queued share it.
+static void request_refresh()
+{
+	QCoreApplication *app = QCoreApplication::instance();
+	if (!app || QThread::currentThread() == app->thread()) {
+		refresh_all();
+		return;
+	}
+	if (g_refresh_queued.exchange(true))
+		return;
+	QMetaObject::invokeMethod(
+		app,
+		[]() {
+			g_refresh_queued = false; // before reading, so a later change queues another pass
+			refresh_all();
+		},
+		Qt::QueuedConnection);
+}
+
+static void on_core_event(const core_event &ev, void *)
+{
+	switch (ev.type) {
+	case event_type::VisibilityChanged:
+	case event_type::ListChanged:
+	case event_type::Reloaded:
+	case event_type::ActiveRowChanged:
+		break;
+	default:
+		return;
+	}
+
+	// Events come from whichever thread made the change (websocket requests, hotkeys, timers).
+	request_refresh();
+}
+
+// -------------------------
+// obs_source_info
+// -------------------------
+
+static const char *src_get_name(void *)
+{
+	return "VinciFlow Lower Third";
+}
+
+static void src_update(void *data, obs_data_t *settings)
+{
+	auto *s = static_cast<native_lt *>(data);
+	{
+		std::lock_guard<std::mutex> lk(s->mtx);
+		s->item_id = obs_data_get_string(settings, "item");
+	}
+	request_refresh();
+}
+
+static void *src_create(obs_data_t *settings, obs_source_t *source)
+{
+	auto *s = new native_lt();
+	s->source = source;
+	obs_source_set_async_unbuffered(source, true);
+
+	s->worker = std::thread(run_worker, s);
+	{
+		std::lock_guard<std::mutex> lk(g_live_mtx);
+		g_live.push_back(s);
+	}
+	src_update(s, settings);
+	return s;
+}
+
+static void src_destroy(void *data)
+{
+	auto *s = static_cast<native_lt *>(data);
+	{
+		std::lock_guard<std::mutex> lk(g_live_mtx);
+		g_live.erase(std::remove(g_live.begin(), g_live.end(), s), g_live.end());
+	}
+	{
+		std::lock_guard<std::mutex> lk(s->mtx);
+		s->quit = true;
+		s->cv.notify_one();
+	}
+	if (s->worker.joinable())
+		s->worker.join();
+
+	LOGD("Source '%s' output %llu frames", obs_source_get_name(s->source), (unsigned long long)s->frames.load());
+	delete s;
+}
+
+static obs_properties_t *src_get_properties(void *)
+{
+	obs_properties_t *props = obs_properties_create();
+	obs_property_t *list = obs_properties_add_list(props, "item", "Lower third", OBS_COMBO_TYPE_LIST,
+						       OBS_COMBO_FORMAT_STRING);
+
+	size_t n = 0;
+	for (const auto &c : all_const()) {
+		if (!c.native)
+			continue;
+		const std::string &name = !c.label.empty() ? c.label : !c.title.empty() ? c.title : c.id;
+		obs_property_list_add_string(list, name.c_str(), c.id.c_str());
+		++n;
+	}
+	if (n == 0)
+		obs_property_set_long_description(list, "No lower third is marked native (lower third settings).");
+	return props;
+}
+
+void native_source_register()
+{
+	obs_source_info info = {};
+	info.id = kSourceId;
+	info.type = OBS_SOURCE_TYPE_INPUT;
+	info.output_flags = OBS_SOURCE_ASYNC_VIDEO | OBS_SOURCE_DO_NOT_DUPLICATE;
+	info.icon_type = OBS_ICON_TYPE_TEXT;
+	info.get_name = src_get_name;
+	info.create = src_create;
+	info.destroy = src_destroy;
+	info.update = src_update;
+	info.get_properties = src_get_properties;
+	obs_register_source(&info);
+
+	g_listener = add_event_listener(on_core_event, nullptr);
+}
+
+void native_source_shutdown()
+{
+	remove_event_listener(g_listener);
+	g_listener = 0;
+}
+
+// -------------------------
+// Benchmark
+// -------------------------
+
+native_benchmark native_source_benchmark(const std::string &id, int frames)
+{
+	native_benchmark b;
+
+	// The item is read on the UI thread; drawing and timing stay on the caller's.
+	card_spec spec;
+	bool found = false;
+	auto read = [&]() {
+		if (const lower_third_cfg *c = get_by_id_const(id)) {
+			spec = spec_of(*c);
+			found = true;
+		}
+		b.browser_frame_bytes = (uint64_t)target_browser_width() * (uint64_t)target_browser_height() * 4;
+	};
+	QCoreApplication *app = QCoreApplication::instance();
+	if (app && QThread::currentThread() != app->thread())
+		QMetaObject::invokeMethod(app, read, Qt::BlockingQueuedConnection);
+	else
+		read();
+	if (!found) {
+		b.error = "Unknown id";
+		return b;
+	}
+
+	const uint64_t drawStart = os_gettime_ns();
+	const QImage card = draw_card(spec);
+	b.draw_us = (double)(os_gettime_ns() - drawStart) / 1000.0;
+	QImage frame;
+	std::vector<uint8_t> handedOff; // stands in for the copy obs_source_output_video makes
+
+	b.frames = std::clamp(frames, 1, 10000);
+	std::vector<uint64_t> ns;
+	ns.reserve((size_t)b.frames);
+	for (int i = 0; i < b.frames; ++i) {
+		const double t = b.frames > 1 ? (double)i / (b.frames - 1) : 1.0;
+		const uint64_t t0 = os_gettime_ns();
+		compose(card, spec.in, ease_out(t), frame);
+		handedOff.resize((size_t)frame.sizeInBytes());
+		memcpy(handedOff.data(), frame.constBits(), handedOff.size());
+		ns.push_back(os_gettime_ns() - t0);
+	}
+
+	std::sort(ns.begin(), ns.end());
+	uint64_t total = 0;
+	for (uint64_t v : ns)
+		total += v;
+
+	b.ok = true;
+	b.width = card.width();
+	b.height = card.height();
+	b.avg_frame_us = (double)total / ns.size() / 1000.0;
+	b.p95_frame_us = (double)ns[std::min(ns.size() - 1, ns.size() * 95 / 100)] / 1000.0;
+	b.cpu_percent = b.avg_frame_us * 1000.0 / (double)frame_interval_ns() * 100.0;
+	b.frame_bytes = (uint64_t)card.sizeInBytes() * 2; // card + frame
+
+	LOGI("Benchmark '%s' (%dx%d): card drawn in %.1f us; compose + frame copy %.1f us/frame avg, %.1f us p95, "
+	     "%.2f%% of a core while animating, %llu KiB frame vs %llu KiB for the Browser Source texture",
+	     id.c_str(), b.width, b.height, b.draw_us, b.avg_frame_us, b.p95_frame_us, b.cpu_percent,
+	     (unsigned long long)(b.frame_bytes / 1024), (unsigned long long)(b.browser_frame_bytes / 1024));
+	return b;
+}
+
+} // namespace vflow
@@ -0,0 +1,202 @@
+#define LOG_TAG "[" PLUGIN_NAME "][out]"
+#include "out_buffer.hpp"
+
+#include "core.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#include <QSaveFile>
+#include <QString>
+#else
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace vflow {
+
+out_buffer::out_buffer(size_t chunk_bytes) : chunk_bytes_(std::max<size_t>(chunk_bytes, 256)) {}
+
+out_buffer &out_buffer::append(const char *data, size_t n)
+{
+	if (n == 0)
+		return *this;
+
+	if (!chunks_.empty()) {
+		chunk &tail = chunks_.back();
+		const size_t take = std::min(n, tail.cap - tail.used);
+		if (take) {
+			std::memcpy(tail.data.get() + tail.used, data, take);
+			tail.used += take;
+			size_ += take;
+			data += take;
+			n -= take;
+		}
+	}
+
+	if (n) {
+		// One allocation for whatever is left, even if it exceeds the nominal chunk size.
+		chunk c;
+		c.cap = std::max(chunk_bytes_, n);
+		c.data.reset(new char[c.cap]);
+		std::memcpy(c.data.get(), data, n);
+		c.used = n;
+		size_ += n;
+		++allocations_;
+		chunks_.push_back(std::move(c));
+	}
+	return *this;
+}
+
+size_t out_buffer::capacity() const
+{
+	size_t n = 0;
+	for (const auto &c : chunks_)
+		n += c.cap;
+	return n;
+}
+
+out_buffer &out_buffer::append_int(long long v)
+{
+	char tmp[24];
+	const auto r = std::to_chars(tmp, tmp + sizeof(tmp), v);
+	return append(tmp, (size_t)(r.ptr - tmp));
+}
+
+void out_buffer::splice(out_buffer &&other)
+{
+	if (&other == this || other.chunks_.empty())
+		return;
+
+	chunks_.reserve(chunks_.size() + other.chunks_.size());
+	for (auto &c : other.chunks_)
+		chunks_.push_back(std::move(c));
+
+	size_ += other.size_;
+	allocations_ += other.allocations_;
+
+	other.chunks_.clear();
+	other.size_ = 0;
+	other.allocations_ = 0;
+}
+
+void out_buffer::clear()
+{
+	chunks_.clear();
+	size_ = 0;
+}
+
+std::string out_buffer::str() const
+{
+	std::string s;
+	s.reserve(size_);
+	for (const auto &c : chunks_)
+		s.append(c.data.get(), c.used);
+	return s;
+}
+
+uint64_t out_buffer::hash() const
+{
+	uint64_t h = kFnv1a64Basis;
+	for (const auto &c : chunks_)
+		h = fnv1a64(c.data.get(), c.used, h);
+	return h;
+}
+
+#ifdef _WIN32
+
+bool out_buffer::write_file_atomic(const std::string &path) const
+{
+	QSaveFile f(QString::fromStdString(path));
+	f.setDirectWriteFallback(true);
+	if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+		LOGW("Failed opening '%s' for write (err=%d '%s')", path.c_str(), (int)f.error(),
+		     f.errorString().toUtf8().constData());
+		return false;
+	}
+	for (const auto &c : chunks_) {
+		if (f.write(c.data.get(), (qint64)c.used) != (qint64)c.used) {
+			LOGW("Short write for '%s'", path.c_str());
+			f.cancelWriting();
+			return false;
+		}
+	}
+	if (!f.commit()) {
+		LOGW("Commit failed for '%s' (err=%d '%s')", path.c_str(), (int)f.error(),
+		     f.errorString().toUtf8().constData());
+		return false;
+	}
+	return true;
+}
+
+#else
+
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
+
+bool out_buffer::write_file_atomic(const std::string &path) const
+{
+	const std::string tmp = path + ".tmp";
+	const int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (fd < 0) {
+		LOGW("Failed opening '%s' for write (errno=%d '%s')", tmp.c_str(), errno, std::strerror(errno));
+		return false;
+	}
+
+	std::vector<iovec> iov;
+	iov.reserve(chunks_.size());
+	for (const auto &c : chunks_) {
+		if (c.used)
+			iov.push_back(iovec{c.data.get(), c.used});
+	}
+
+	// Usually a single writev; loops only on partial writes or more than IOV_MAX chunks.
+	size_t first = 0;
+	while (first < iov.size()) {
+		const int cnt = (int)std::min<size_t>(iov.size() - first, IOV_MAX);
+		const ssize_t w = ::writev(fd, iov.data() + first, cnt);
+		if (w < 0) {
+			if (errno == EINTR)
+				continue;
+			LOGW("writev failed for '%s' (errno=%d '%s')", tmp.c_str(), errno, std::strerror(errno));
+			::close(fd);
+			::unlink(tmp.c_str());
+			return false;
+		}
+
+		size_t left = (size_t)w;
+		while (first < iov.size() && left >= iov[first].iov_len) {
+			left -= iov[first].iov_len;
+			++first;
+		}
+		if (left) {
+			iov[first].iov_base = (char *)iov[first].iov_base + left;
+			iov[first].iov_len -= left;
+		}
+	}
+
+	if (::close(fd) != 0) {
+		LOGW("close failed for '%s' (errno=%d '%s')", tmp.c_str(), errno, std::strerror(errno));
+		::unlink(tmp.c_str());
+		return false;
+	}
+
+	if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+		LOGW("rename '%s' -> '%s' failed (errno=%d '%s')", tmp.c_str(), path.c_str(), errno,
+		     std::strerror(errno));
+		::unlink(tmp.c_str());
+		return false;
+	}
+	return true;
+}
+
+#endif
+
+} // namespace vflow
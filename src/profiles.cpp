@@ -0,0 +1,380 @@
+#define LOG_TAG "[" PLUGIN_NAME "][profiles]"
+#include "profiles.hpp"
+
+#include "core.hpp"
+#include "core_internal.hpp"
+#include "history.hpp"
+#include "out_buffer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QMetaObject>
+
+namespace vflow {
+
+// -------------------------
+// Scene collection profiles
+// -------------------------
+// Parked profiles hold the in-memory state of bound folders that are not live: preloaded ones and the
+// folder last switched away from. Switching moves vectors in and out of the globals; the only copy left
+// on the way in is the hot directory restore, when that is enabled. g_parked belongs to the UI thread;
+// the preload worker hands what it reads over through g_preloaded.
+
+struct profile_state : folder_state {
+	uint64_t layout = 0;         // layout_signature() when parked
+	bool bundle_current = false; // lt.* in the folder shows this state (nothing was pending when parked)
+};
+
+static std::unordered_map<std::string, profile_state> g_parked; // by folder
+static std::thread g_profile_worker;
+
+// Preload worker hand-off, all under g_profile_mx: folders it has read (parked on the UI thread by
+// adopt_preloaded_profiles) and bundles it has written (folder -> layout_signature() they were rendered
+// for). A worker started in an older epoch hands over and writes nothing more.
+static std::mutex g_profile_mx;
+static std::vector<profile_state> g_preloaded;
+static std::unordered_map<std::string, uint64_t> g_profile_bundles;
+static uint64_t g_profile_epoch = 0;
+static bool g_profile_running = false;
+static bool g_profile_rerun = false; // a preload was asked for while the worker was still running
+
+// Everything besides the state that shapes the written pages.
+static uint64_t layout_signature()
+{
+	std::string s = std::to_string(target_browser_width()) + 'x' + std::to_string(target_browser_height());
+	for (const auto &v : output_variants()) {
+		s += '|' + v.name + ':' + std::to_string(v.width) + 'x' + std::to_string(v.height) + '/' +
+		     std::to_string(v.safe_margin) + '/' + std::to_string(v.scale_pct);
+		for (const auto &kv : v.items)
+			s += ',' + kv.first + '=' + kv.second.position.str() + '/' + std::to_string(kv.second.scale_pct);
+	}
+	return fnv1a64(s.data(), s.size());
+}
+
+// Parks the folders the worker has read, unless they went live or were parked meanwhile. UI thread.
+static void adopt_preloaded_profiles()
+{
+	std::vector<profile_state> done;
+	{
+		std::lock_guard<std::mutex> lk(g_profile_mx);
+		done.swap(g_preloaded);
+	}
+	const std::string live = configured_output_dir();
+	for (auto &p : done) {
+		if (p.dir == live || g_parked.count(p.dir))
+			continue;
+		const std::string dir = p.dir;
+		g_parked[dir] = std::move(p);
+	}
+}
+
+// Stops the preload worker from handing over or writing anything more and parks what it already read.
+// Does not wait for it: a bundle write in progress finishes first (it holds g_profile_mx), a render in
+// progress is discarded. UI thread.
+static void cancel_profile_preload()
+{
+	{
+		std::lock_guard<std::mutex> lk(g_profile_mx);
+		++g_profile_epoch;
+	}
+	adopt_preloaded_profiles();
+}
+
+void forget_profile(const std::string &dir)
+{
+	cancel_profile_preload();
+	g_parked.erase(dir);
+	{
+		std::lock_guard<std::mutex> lk(g_profile_mx);
+		g_profile_bundles.erase(dir);
+	}
+	schedule_profile_preload(); // the rest of the cancelled batch
+}
+
+static void preload_profiles();
+
+// Reads, renders and writes each folder of a preload batch. Stops at the first step after the epoch moved
+// on (a switch or a forgotten folder); the batch is scheduled again afterwards.
+static void run_profile_preload(const std::vector<std::string> &dirs, const render_snapshot &layout,
+				uint64_t signature, const std::string &ts, uint64_t epoch)
+{
+	const auto t0 = std::chrono::steady_clock::now();
+	QCoreApplication *app = QCoreApplication::instance();
+	size_t loaded = 0;
+
+	for (const auto &dir : dirs) {
+		if (!file_exists(join_path(dir, "lt-state.json")))
+			continue;
+
+		profile_state p;
+		if (!read_folder_state(dir, p)) {
+			LOGW("Profile '%s' not preloaded: lt-state.json could not be read", dir.c_str());
+			continue;
+		}
+		p.layout = signature;
+
+		// Taken while the items are still this thread's own.
+		render_snapshot snap;
+		const bool render = !layout.shard_by_position;
+		if (render)
+			snap = render_snapshot_of(layout, dir, p.items);
+
+		{
+			std::lock_guard<std::mutex> lk(g_profile_mx);
+			if (g_profile_epoch != epoch)
+				break;
+			g_profile_bundles.erase(dir);
+			g_preloaded.push_back(std::move(p));
+		}
+		if (app)
+			QMetaObject::invokeMethod(app, []() { adopt_preloaded_profiles(); }, Qt::QueuedConnection);
+		++loaded;
+
+		if (!render)
+			continue;
+		const std::shared_ptr<bundle_render> r = render_folder_bundle(std::move(snap), ts);
+
+		// Written under the lock, so a switch to this folder waits for the write instead of racing it.
+		std::lock_guard<std::mutex> lk(g_profile_mx);
+		if (g_profile_epoch != epoch)
+			break;
+		if (!write_folder_bundle(*r)) {
+			LOGW("Profile '%s': bundle not written", dir.c_str());
+			continue;
+		}
+		g_profile_bundles[dir] = signature;
+	}
+
+	const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0);
+	LOGI("Preloaded %zu scene collection profiles in %lld ms", loaded, (long long)ms.count());
+
+	bool rerun = false;
+	{
+		std::lock_guard<std::mutex> lk(g_profile_mx);
+		g_profile_running = false;
+		rerun = g_profile_rerun;
+		g_profile_rerun = false;
+	}
+	if (rerun && app)
+		QMetaObject::invokeMethod(app, []() { preload_profiles(); }, Qt::QueuedConnection);
+}
+
+// Loads every bound folder that is neither live nor parked on a worker: reading lt-state.json and
+// lt-visible.json, rendering and writing the bundles all happen there. The live state, its history, the
+// schedule and the phase-1 cache are not touched, so requests on other threads keep seeing the live
+// folder throughout. A folder without lt-state.json has nothing to preload; switching to it creates its
+// files. UI thread.
+static void preload_profiles()
+{
+	if (!has_output_dir())
+		return;
+
+	{
+		std::lock_guard<std::mutex> lk(g_profile_mx);
+		if (g_profile_running) {
+			g_profile_rerun = true;
+			return;
+		}
+	}
+	if (g_profile_worker.joinable())
+		g_profile_worker.join(); // finished: it clears g_profile_running last
+	adopt_preloaded_profiles();
+
+	const std::string live = configured_output_dir();
+	std::vector<std::string> dirs;
+	for (const auto &kv : output_dir_bindings()) {
+		const std::string &dir = kv.second;
+		if (dir != live && !g_parked.count(dir) && std::find(dirs.begin(), dirs.end(), dir) == dirs.end())
+			dirs.push_back(dir);
+	}
+	if (dirs.empty())
+		return;
+
+	uint64_t epoch = 0;
+	{
+		std::lock_guard<std::mutex> lk(g_profile_mx);
+		epoch = g_profile_epoch;
+		g_profile_running = true;
+	}
+	g_profile_worker = std::thread([dirs = std::move(dirs), layout = render_layout(), signature = layout_signature(),
+					ts = now_timestamp_string(), epoch]() {
+		run_profile_preload(dirs, layout, signature, ts, epoch);
+	});
+}
+
+void schedule_profile_preload()
+{
+	if (output_dir_bindings().empty())
+		return;
+
+	if (QCoreApplication *app = QCoreApplication::instance())
+		QMetaObject::invokeMethod(app, []() { preload_profiles(); }, Qt::QueuedConnection);
+}
+
+static bool switch_to_profile(const std::string &dir)
+{
+	cancel_profile_preload(); // constant time: a preload still running is abandoned, not waited for
+	const auto t0 = std::chrono::steady_clock::now();
+
+	clear_history(); // deferred file removals belong to the previous folder
+	cancel_scheduled_changes({});
+
+	if (has_output_dir()) {
+		profile_state prev;
+		take_live_state(prev);
+		prev.layout = layout_signature();
+		prev.bundle_current = !shard_by_position() && rebuilds_idle();
+		std::string prevDir = prev.dir;
+		g_parked[prevDir] = std::move(prev);
+	}
+
+	enter_output_dir(dir);
+	save_global_config();
+	ensure_output_artifacts_exist();
+
+	uint64_t preloadedLayout = 0;
+	{
+		std::lock_guard<std::mutex> lk(g_profile_mx);
+		auto b = g_profile_bundles.find(dir);
+		if (b != g_profile_bundles.end()) {
+			preloadedLayout = b->second;
+			g_profile_bundles.erase(b);
+		}
+	}
+
+	bool installed = false;
+	bool bundleCurrent = false;
+	auto it = g_parked.find(dir);
+	if (it != g_parked.end()) {
+		profile_state p = std::move(it->second);
+		g_parked.erase(it);
+
+		if (!live_files_changed_since(p)) {
+			const uint64_t layout = layout_signature();
+			bundleCurrent = ((p.bundle_current && p.layout == layout) || preloadedLayout == layout) &&
+					!shard_by_position() && file_exists(bundle_html_current_path());
+			install_live_state(p);
+			history_rebase();
+			publish_rows_json(); // a preloaded folder was only read
+			installed = true;
+		} else {
+			LOGI("Profile '%s' changed on disk since it was parked; reloading", dir.c_str());
+		}
+	}
+	if (!installed) {
+		load_state_json();
+		load_visible_json();
+	}
+
+	// Sharded builds skip unchanged pages by name; the names now refer to another folder's files.
+	forget_bundle_hashes();
+
+	bool ok = true;
+	if (bundleCurrent) {
+		show_written_bundle();
+	} else {
+		ok = rebuild_and_swap();
+	}
+
+	core_event l;
+	l.type = event_type::ListChanged;
+	l.reason = list_change_reason::Reload;
+	l.count = (int64_t)all_const().size();
+	emit_event(l);
+
+	restart_output_watcher();
+	schedule_profile_preload(); // whatever the cancelled preload had not reached yet
+
+	const auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t0);
+	LOGI("Switched to profile '%s' in %lld us (%s, %s)", dir.c_str(), (long long)us.count(),
+	     installed ? "parked state" : "loaded", bundleCurrent ? "bundle reused" : "rebuilt");
+	return ok;
+}
+
+std::vector<collection_profile> collection_profiles()
+{
+	const std::string current = current_scene_collection_name();
+	const std::string live = configured_output_dir();
+	const auto &bindings = output_dir_bindings();
+	std::vector<collection_profile> out;
+	out.reserve(bindings.size());
+	for (const auto &kv : bindings) {
+		collection_profile p;
+		p.collection = kv.first;
+		p.dir = kv.second;
+		p.active = kv.first == current && kv.second == live;
+		p.preloaded = g_parked.count(kv.second) != 0;
+		out.push_back(std::move(p));
+	}
+	std::sort(out.begin(), out.end(),
+		  [](const collection_profile &a, const collection_profile &b) { return a.collection < b.collection; });
+	return out;
+}
+
+bool bind_collection_output_dir(const std::string &collection, const std::string &dir)
+{
+	const std::string col = collection.empty() ? current_scene_collection_name() : collection;
+	if (col.empty())
+		return false;
+
+	auto &bindings = output_dir_bindings();
+	if (dir.empty()) {
+		auto it = bindings.find(col);
+		if (it == bindings.end())
+			return true;
+		const std::string old = it->second;
+		bindings.erase(it);
+		if (old != configured_output_dir() &&
+		    std::none_of(bindings.begin(), bindings.end(),
+				 [&old](const auto &kv) { return kv.second == old; }))
+			forget_profile(old);
+		return save_global_config();
+	}
+
+	bindings[col] = QDir::cleanPath(QString::fromStdString(dir)).toStdString();
+	const bool saved = save_global_config();
+	if (col == current_scene_collection_name())
+		activate_collection_profile();
+	schedule_profile_preload();
+	return saved;
+}
+
+bool activate_collection_profile()
+{
+	const auto &bindings = output_dir_bindings();
+	auto it = bindings.find(current_scene_collection_name());
+	if (it == bindings.end() || it->second == configured_output_dir())
+		return false;
+
+	const std::string dir = it->second;
+	if (!switch_to_profile(dir))
+		LOGW("Profile '%s' switched but its bundle could not be written", dir.c_str());
+	return true;
+}
+
+void shutdown_profiles()
+{
+	{
+		std::lock_guard<std::mutex> lk(g_profile_mx);
+		++g_profile_epoch;
+		g_profile_rerun = false;
+	}
+	if (g_profile_worker.joinable())
+		g_profile_worker.join();
+	{
+		std::lock_guard<std::mutex> lk(g_profile_mx);
+		g_preloaded.clear();
+		g_profile_bundles.clear();
+	}
+	g_parked.clear();
+}
+
+} // namespace vflow
@@ -0,0 +1,333 @@
+#define LOG_TAG "[" PLUGIN_NAME "][rules]"
+#include "rules.hpp"
+
+#include "core.hpp"
+#include "scheduler.hpp"
+
+#include <obs-frontend-api.h>
+#include <obs.h>
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include <QMetaObject>
+#include <QObject>
+#include <QThread>
+#include <QTimer>
+
+namespace vflow {
+
+// Trigger byte + scene name -> indices into g_compiled, ascending. Triggers that are not about a scene,
+// and scene rules for any scene, are filed under an empty scene name.
+static std::unordered_map<std::string, std::vector<uint32_t>> g_index;
+static std::vector<rule_cfg> g_compiled;
+static uint64_t g_compiled_gen = 0;
+
+static QObject *g_ctx = nullptr; // owns the delayed actions
+static std::string g_program_scene;
+static uint64_t g_scene_gen = 0;
+// Startup and scene collection switches set the program scene without it being a cut.
+static bool g_loading = true;
+static std::vector<obs_source_t *> g_transitions; // hooked, one reference each
+
+static bool is_scene_trigger(rule_trigger t)
+{
+	return t == rule_trigger::SceneActivated || t == rule_trigger::SceneDeactivated ||
+	       t == rule_trigger::TransitionStarted;
+}
+
+static std::string index_key(rule_trigger t, const std::string &scene)
+{
+	std::string k;
+	k.reserve(scene.size() + 1);
+	k.push_back((char)t);
+	k += scene;
+	return k;
+}
+
+static void compile_if_needed()
+{
+	const uint64_t gen = rules_generation();
+	if (gen == g_compiled_gen)
+		return;
+
+	g_compiled = rules_const();
+	g_index.clear();
+	for (uint32_t i = 0; i < (uint32_t)g_compiled.size(); ++i) {
+		const rule_cfg &r = g_compiled[i];
+		if (!r.enabled)
+			continue;
+		g_index[index_key(r.trigger, is_scene_trigger(r.trigger) ? r.scene : std::string())].push_back(i);
+	}
+	g_compiled_gen = gen;
+	LOGD("Compiled %zu rules into %zu index entries", g_compiled.size(), g_index.size());
+}
+
+// -------------------------
+// Actions
+// -------------------------
+
+static void apply(const std::vector<rule_cfg> &rules)
+{
+	std::vector<std::pair<std::string, bool>> changes;
+	std::unordered_map<std::string, bool> planned; // so toggles see earlier changes of the same batch
+	const auto want = [&](const std::string &id, rule_action a) {
+		auto it = planned.find(id);
+		const bool cur = it != planned.end() ? it->second : is_visible(id);
+		const bool v = a == rule_action::Toggle ? !cur : a == rule_action::Show;
+		planned[id] = v;
+		changes.emplace_back(id, v);
+	};
+
+	std::vector<const rule_cfg *> groupOps;
+	for (const auto &r : rules) {
+		if (r.action == rule_action::RunGroup || r.action == rule_action::StopGroup) {
+			groupOps.push_back(&r);
+			continue;
+		}
+		if (get_by_id_const(r.target)) {
+			want(r.target, r.action);
+		} else if (const group_cfg *g = get_group_by_id(r.target)) {
+			for (const auto &m : g->members)
+				want(m, r.action);
+		} else {
+			LOGW("Rule '%s': unknown target '%s'", r.id.c_str(), r.target.c_str());
+		}
+	}
+
+	if (!changes.empty())
+		set_visible_batch(changes);
+
+	for (const rule_cfg *r : groupOps) {
+		if (!get_group_by_id(r->target)) {
+			LOGW("Rule '%s': unknown group '%s'", r->id.c_str(), r->target.c_str());
+			continue;
+		}
+		if (r->action == rule_action::RunGroup)
+			start_group_run(r->target);
+		else
+			stop_group_run(r->target);
+	}
+}
+
+static size_t evaluate(rule_trigger t, const std::string &scene)
+{
+	compile_if_needed();
+
+	const auto find = [](const std::string &key) -> const std::vector<uint32_t> * {
+		auto it = g_index.find(key);
+		return it == g_index.end() ? nullptr : &it->second;
+	};
+	const std::vector<uint32_t> *exact = find(index_key(t, is_scene_trigger(t) ? scene : std::string()));
+	const std::vector<uint32_t> *any = (is_scene_trigger(t) && !scene.empty()) ? find(index_key(t, {})) : nullptr;
+	if (!exact && !any)
+		return 0;
+
+	// Both lists are ascending; merged, rules run in their configured order.
+	std::vector<uint32_t> matched;
+	static const std::vector<uint32_t> kNone;
+	const auto &a = exact ? *exact : kNone;
+	const auto &b = any ? *any : kNone;
+	std::merge(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(matched));
+
+	std::vector<rule_cfg> now;
+	std::map<int, std::vector<rule_cfg>> later; // by delay
+	for (uint32_t i : matched) {
+		const rule_cfg &r = g_compiled[i];
+		if (r.delay_ms > 0)
+			later[r.delay_ms].push_back(r);
+		else
+			now.push_back(r);
+	}
+
+	LOGD("Trigger %s '%s': %zu rules (%zu delayed)", rule_trigger_name(t), scene.c_str(), matched.size(),
+	     matched.size() - now.size());
+	apply(now);
+
+	const bool sceneBound = t == rule_trigger::SceneActivated || t == rule_trigger::SceneDeactivated;
+	const uint64_t gen = g_scene_gen;
+	for (auto &kv : later) {
+		QTimer::singleShot(kv.first, g_ctx, [rules = std::move(kv.second), sceneBound, gen]() {
+			if (sceneBound && gen != g_scene_gen)
+				return; // the program scene changed again meanwhile
+			apply(rules);
+		});
+	}
+	return matched.size();
+}
+
+// -------------------------
+// OBS hooks
+// -------------------------
+
+static std::string current_program_scene()
+{
+	obs_source_t *src = obs_frontend_get_current_scene();
+	if (!src)
+		return {};
+	const char *name = obs_source_get_name(src);
+	std::string out = name ? name : "";
+	obs_source_release(src);
+	return out;
+}
+
+static void on_program_scene(const std::string &name)
+{
+	if (name == g_program_scene)
+		return;
+
+	const std::string prev = g_program_scene;
+	g_program_scene = name;
+	++g_scene_gen;
+	if (g_loading)
+		return;
+
+	if (!prev.empty())
+		evaluate(rule_trigger::SceneDeactivated, prev);
+	if (!name.empty())
+		evaluate(rule_trigger::SceneActivated, name);
+}
+
+static void on_transition_start(void *, calldata_t *cd)
+{
+	auto *transition = static_cast<obs_source_t *>(calldata_ptr(cd, "source"));
+	if (!transition)
+		return;
+
+	std::string dest;
+	if (obs_source_t *to = obs_transition_get_source(transition, OBS_TRANSITION_SOURCE_B)) {
+		const char *name = obs_source_get_name(to);
+		dest = name ? name : "";
+		obs_source_release(to);
+	}
+
+	// Transitions may be started off the UI thread (e.g. by the websocket).
+	QMetaObject::invokeMethod(
+		g_ctx,
+		[dest]() {
+			if (!g_loading)
+				evaluate(rule_trigger::TransitionStarted, dest);
+		},
+		Qt::AutoConnection);
+}
+
+static void unhook_transitions()
+{
+	for (obs_source_t *t : g_transitions) {
+		signal_handler_disconnect(obs_source_get_signal_handler(t), "transition_start", on_transition_start,
+					  nullptr);
+		obs_source_release(t);
+	}
+	g_transitions.clear();
+}
+
+// Takes over the reference to 't'.
+static void hook_transition(obs_source_t *t)
+{
+	if (!t)
+		return;
+	if (std::find(g_transitions.begin(), g_transitions.end(), t) != g_transitions.end()) {
+		obs_source_release(t);
+		return;
+	}
+	signal_handler_connect(obs_source_get_signal_handler(t), "transition_start", on_transition_start, nullptr);
+	g_transitions.push_back(t);
+}
+
+// Every transition of the frontend's list, not only the current one: per-scene transition overrides and
+// quick transitions run one of them in its place, and only the one that runs signals.
+static void hook_transitions()
+{
+	unhook_transitions();
+
+	obs_frontend_source_list list = {};
+	obs_frontend_get_transitions(&list);
+	for (size_t i = 0; i < list.sources.num; ++i)
+		hook_transition(obs_source_get_ref(list.sources.array[i]));
+	obs_frontend_source_list_free(&list);
+
+	hook_transition(obs_frontend_get_current_transition());
+}
+
+static void on_frontend_event(enum obs_frontend_event event, void *)
+{
+	switch (event) {
+	case OBS_FRONTEND_EVENT_FINISHED_LOADING:
+	case OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGED:
+		g_program_scene = current_program_scene();
+		g_loading = false;
+		hook_transitions();
+		break;
+	case OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGING:
+		g_loading = true;
+		unhook_transitions();
+		break;
+	case OBS_FRONTEND_EVENT_EXIT:
+		g_loading = true;
+		unhook_transitions();
+		break;
+	case OBS_FRONTEND_EVENT_TRANSITION_CHANGED:
+	case OBS_FRONTEND_EVENT_TRANSITION_LIST_CHANGED:
+		hook_transitions();
+		break;
+	case OBS_FRONTEND_EVENT_SCENE_CHANGED:
+		on_program_scene(current_program_scene());
+		break;
+	case OBS_FRONTEND_EVENT_STREAMING_STARTED:
+		evaluate(rule_trigger::StreamingStarted, {});
+		break;
+	case OBS_FRONTEND_EVENT_STREAMING_STOPPED:
+		evaluate(rule_trigger::StreamingStopped, {});
+		break;
+	case OBS_FRONTEND_EVENT_RECORDING_STARTED:
+		evaluate(rule_trigger::RecordingStarted, {});
+		break;
+	case OBS_FRONTEND_EVENT_RECORDING_STOPPED:
+		evaluate(rule_trigger::RecordingStopped, {});
+		break;
+	default:
+		break;
+	}
+}
+
+void rules_start()
+{
+	if (g_ctx)
+		return;
+
+	g_ctx = new QObject();
+	obs_frontend_add_event_callback(on_frontend_event, nullptr);
+}
+
+void rules_stop()
+{
+	if (!g_ctx)
+		return;
+
+	obs_frontend_remove_event_callback(on_frontend_event, nullptr);
+	unhook_transitions();
+	delete g_ctx; // drops pending delayed actions
+	g_ctx = nullptr;
+
+	g_index.clear();
+	g_compiled.clear();
+	g_compiled_gen = 0;
+}
+
+size_t rules_fire(rule_trigger trigger, const std::string &scene)
+{
+	size_t n = 0;
+	if (!g_ctx)
+		return n;
+	if (QThread::currentThread() == g_ctx->thread())
+		n = evaluate(trigger, scene);
+	else
+		QMetaObject::invokeMethod(
+			g_ctx, [&]() { n = evaluate(trigger, scene); }, Qt::BlockingQueuedConnection);
+	return n;
+}
+
+} // namespace vflow
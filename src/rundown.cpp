@@ -0,0 +1,683 @@
+#define LOG_TAG "[" PLUGIN_NAME "][rundown]"
+#include "rundown.hpp"
+
+#include "assets.hpp"
+#include "core.hpp"
+#include "import.hpp"
+#include "scheduler.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <QByteArray>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMetaObject>
+#include <QThread>
+#include <QTimer>
+
+namespace vflow {
+
+namespace {
+
+// Upcoming cues are read ahead this far (and at most this many).
+constexpr int64_t kPrefetchLeadMs = 15000;
+constexpr size_t kPrefetchMaxCues = 8;
+
+struct pending_hide {
+	int64_t due = 0;
+	std::string id;
+};
+
+using cue_fields = std::unordered_map<std::string, std::string>;
+
+} // namespace
+
+static std::vector<rundown_cue> g_cues;
+static std::vector<rundown_cue_report> g_reports;
+static std::vector<bool> g_prefetched; // per cue, for the current run
+
+static bool g_running = false;
+static bool g_waiting_go = false;
+static size_t g_next = 0;
+// Monotonic ms. Planned times are derived from the anchor, never from when the timer fired.
+static int64_t g_start = 0;
+static int64_t g_anchor = 0;
+static int64_t g_last_planned = 0;
+static int64_t g_next_due = -1;
+static std::vector<pending_hide> g_hides;
+
+static QTimer *g_timer = nullptr;
+static std::vector<std::future<void>> g_prefetch;
+
+static void on_rundown_thread(const std::function<void()> &fn)
+{
+	if (!g_timer || QThread::currentThread() == g_timer->thread())
+		fn();
+	else
+		QMetaObject::invokeMethod(g_timer, fn, Qt::BlockingQueuedConnection);
+}
+
+static int64_t now_ms()
+{
+	using namespace std::chrono;
+	return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+// -------------------------
+// Parsing
+// -------------------------
+
+static std::string normalized_key(const std::string &key)
+{
+	std::string k;
+	k.reserve(key.size());
+	for (unsigned char ch : key) {
+		if (ch == ' ' || ch == '_' || ch == '-')
+			continue;
+		k.push_back((char)std::tolower(ch));
+	}
+	return k;
+}
+
+static std::string trimmed(const std::string &s)
+{
+	const auto notSpace = [](unsigned char ch) { return !std::isspace(ch); };
+	const auto b = std::find_if(s.begin(), s.end(), notSpace);
+	const auto e = std::find_if(s.rbegin(), s.rend(), notSpace).base();
+	return b < e ? std::string(b, e) : std::string();
+}
+
+// Longest accepted offset or duration.
+static constexpr double kMaxTimecodeSec = 24.0 * 60.0 * 60.0;
+
+// "T+00:12:30", "12:30", "00:12:30.250", "750", "12.5" -> ms. Fields are plain decimals (no sign,
+// exponent, hex, inf or nan) and the total is at most 24 h.
+static bool parse_timecode(const std::string &text, int64_t &ms)
+{
+	std::string s = trimmed(text);
+	if (s.size() > 1 && (s[0] == 'T' || s[0] == 't') && s[1] == '+')
+		s.erase(0, 2);
+	else if (!s.empty() && s[0] == '+')
+		s.erase(0, 1);
+	if (s.empty())
+		return false;
+
+	double total = 0.0;
+	size_t parts = 0;
+	size_t pos = 0;
+	while (true) {
+		const size_t colon = s.find(':', pos);
+		const std::string part = s.substr(pos, colon == std::string::npos ? std::string::npos : colon - pos);
+		if (part.empty() || ++parts > 3)
+			return false;
+
+		const size_t dots = (size_t)std::count(part.begin(), part.end(), '.');
+		const bool decimal = std::all_of(part.begin(), part.end(), [](unsigned char ch) {
+			return std::isdigit(ch) || ch == '.';
+		});
+		if (!decimal || dots > 1 || part == ".")
+			return false;
+		// Only the seconds field may have a fraction.
+		if (colon != std::string::npos && dots)
+			return false;
+
+		char *end = nullptr;
+		const double v = std::strtod(part.c_str(), &end);
+		if (!end || *end != '\0' || !std::isfinite(v))
+			return false;
+		total = total * 60.0 + v;
+		if (total > kMaxTimecodeSec)
+			return false;
+
+		if (colon == std::string::npos)
+			break;
+		pos = colon + 1;
+	}
+
+	ms = (int64_t)(total * 1000.0 + 0.5);
+	return true;
+}
+
+static bool parse_flag(const std::string &text)
+{
+	const std::string v = normalized_key(text);
+	return v == "1" || v == "true" || v == "yes" || v == "y" || v == "x" || v == "go" || v == "manual";
+}
+
+static bool parse_action(const std::string &text, rundown_action &out)
+{
+	static const std::pair<const char *, rundown_action> kActions[] = {
+		{"show", rundown_action::Show},          {"in", rundown_action::Show},
+		{"hide", rundown_action::Hide},          {"out", rundown_action::Hide},
+		{"toggle", rundown_action::Toggle},      {"run", rundown_action::RunGroup},
+		{"rungroup", rundown_action::RunGroup},  {"startgroup", rundown_action::RunGroup},
+		{"stop", rundown_action::StopGroup},     {"stopgroup", rundown_action::StopGroup},
+		{"hideall", rundown_action::HideAll},    {"clear", rundown_action::HideAll},
+	};
+	const std::string v = normalized_key(text);
+	for (const auto &a : kActions) {
+		if (v == a.first) {
+			out = a.second;
+			return true;
+		}
+	}
+	return false;
+}
+
+static const std::string *field(const cue_fields &f, std::initializer_list<const char *> names)
+{
+	for (const char *n : names) {
+		auto it = f.find(n);
+		if (it != f.end() && !it->second.empty())
+			return &it->second;
+	}
+	return nullptr;
+}
+
+static bool cue_from_fields(const cue_fields &f, rundown_cue &c)
+{
+	const std::string *action = field(f, {"action", "type"});
+	const std::string *target = field(f, {"target", "id", "group", "groupid"});
+	if (!action || !parse_action(*action, c.action))
+		return false;
+	if (target)
+		c.target = *target;
+	if (c.target.empty() && c.action != rundown_action::HideAll)
+		return false;
+
+	if (const std::string *at = field(f, {"at", "time", "timecode"})) {
+		if (!parse_timecode(*at, c.at_ms))
+			return false;
+	}
+	if (const std::string *d = field(f, {"duration", "for"})) {
+		if (!parse_timecode(*d, c.duration_ms))
+			return false;
+	}
+	if (const std::string *go = field(f, {"go", "manual"}))
+		c.manual = parse_flag(*go);
+	if (const std::string *name = field(f, {"name", "label"}))
+		c.name = *name;
+	return true;
+}
+
+static cue_fields fields_of(const QJsonObject &o)
+{
+	cue_fields f;
+	for (auto it = o.begin(); it != o.end(); ++it) {
+		const QJsonValue v = it.value();
+		QString s;
+		if (v.isString())
+			s = v.toString();
+		else if (v.isDouble())
+			s = QString::number(v.toDouble(), 'g', 15);
+		else if (v.isBool())
+			s = v.toBool() ? QStringLiteral("true") : QStringLiteral("false");
+		f[normalized_key(it.key().toStdString())] = trimmed(s.toStdString());
+	}
+	return f;
+}
+
+static void parse_json_cues(const QByteArray &data, std::vector<rundown_cue> &cues, size_t &skipped)
+{
+	const auto add = [&](const QJsonValue &v) {
+		rundown_cue c;
+		if (v.isObject() && cue_from_fields(fields_of(v.toObject()), c))
+			cues.push_back(std::move(c));
+		else
+			++skipped;
+	};
+
+	QJsonParseError err{};
+	const QJsonDocument doc = QJsonDocument::fromJson(data, &err);
+	if (err.error == QJsonParseError::NoError) {
+		const QJsonArray arr = doc.isArray() ? doc.array() : doc.object().value("cues").toArray();
+		for (const auto &v : arr)
+			add(v);
+		return;
+	}
+
+	// JSON Lines: one cue object per line.
+	for (const QByteArray &line : data.split('\n')) {
+		const QByteArray t = line.trimmed();
+		if (t.isEmpty())
+			continue;
+		const QJsonDocument d = QJsonDocument::fromJson(t, &err);
+		add(err.error == QJsonParseError::NoError && d.isObject() ? QJsonValue(d.object()) : QJsonValue());
+	}
+}
+
+static bool parse_csv_cues(std::istream &in, std::vector<rundown_cue> &cues, size_t &skipped)
+{
+	std::string headerLine;
+	if (!std::getline(in, headerLine))
+		return false;
+	if (!headerLine.empty() && headerLine.back() == '\r')
+		headerLine.pop_back();
+
+	const char delim = sniff_csv_delimiter(headerLine);
+	std::vector<std::string> columns;
+	std::istringstream hs(headerLine);
+	if (!read_csv_record(hs, delim, columns))
+		return false;
+	for (auto &c : columns)
+		c = normalized_key(trimmed(c));
+
+	std::vector<std::string> cells;
+	while (read_csv_record(in, delim, cells)) {
+		if (cells.size() == 1 && trimmed(cells[0]).empty())
+			continue; // blank line
+		cue_fields f;
+		for (size_t i = 0; i < cells.size() && i < columns.size(); ++i)
+			f[columns[i]] = trimmed(cells[i]);
+		rundown_cue c;
+		if (cue_from_fields(f, c))
+			cues.push_back(std::move(c));
+		else
+			++skipped;
+	}
+	return true;
+}
+
+// -------------------------
+// Prefetch
+// -------------------------
+
+static std::string resolve_group(const std::string &target)
+{
+	if (get_group_by_id(target))
+		return target;
+	const std::string want = normalized_key(target);
+	for (const auto &g : groups_const()) {
+		if (normalized_key(g.title) == want)
+			return g.id;
+	}
+	return {};
+}
+
+static std::vector<std::string> cue_files(const rundown_cue &c)
+{
+	std::vector<std::string> ids;
+	if (c.action == rundown_action::Show || c.action == rundown_action::Toggle) {
+		ids.push_back(c.target);
+	} else if (c.action == rundown_action::RunGroup) {
+		if (const group_cfg *g = get_group_by_id(resolve_group(c.target)))
+			ids = g->members;
+	}
+
+	const std::filesystem::path dir(output_dir());
+	std::vector<std::string> out;
+	for (const auto &id : ids) {
+		if (const lower_third_cfg *item = get_by_id_const(id)) {
+			for (const auto &f : page_files_of(*item))
+				out.push_back((dir / f).string());
+		}
+	}
+	return out;
+}
+
+// Reads the files once so the browser source finds them in the page cache; the hot output directory
+// already keeps them in RAM, where this costs a memcpy.
+static void warm_files(std::vector<std::string> paths)
+{
+	const auto t0 = std::chrono::steady_clock::now();
+	uint64_t bytes = 0;
+	static thread_local std::vector<char> buf(64 * 1024);
+	for (const auto &p : paths) {
+		std::ifstream f(std::filesystem::path(p), std::ios::binary);
+		while (f.read(buf.data(), (std::streamsize)buf.size()) || f.gcount() > 0)
+			bytes += (uint64_t)f.gcount();
+	}
+	const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+	LOGD("Prefetched %zu files (%llu bytes) in %.1f ms", paths.size(), (unsigned long long)bytes, ms);
+}
+
+static void prefetch_ahead(int64_t now)
+{
+	g_prefetch.erase(std::remove_if(g_prefetch.begin(), g_prefetch.end(),
+					[](std::future<void> &f) {
+						return f.wait_for(std::chrono::seconds(0)) ==
+						       std::future_status::ready;
+					}),
+			 g_prefetch.end());
+
+	std::vector<std::string> paths;
+	std::unordered_set<std::string> seen;
+	int64_t anchor = g_anchor;
+	int64_t planned = g_last_planned;
+	bool manualSeen = false;
+	for (size_t i = g_next, n = 0; i < g_cues.size() && n < kPrefetchMaxCues; ++i, ++n) {
+		const rundown_cue &c = g_cues[i];
+		if (c.manual) {
+			// Cues after a manual one are timed as if it were released right away, the earliest they
+			// can run; a second manual cue ends the look-ahead.
+			if (manualSeen)
+				break;
+			manualSeen = true;
+			anchor = planned = std::max(planned, now);
+		} else {
+			planned = std::max(planned, c.at_ms >= 0 ? anchor + c.at_ms : planned);
+			if (planned > now + kPrefetchLeadMs)
+				break;
+		}
+		if (g_prefetched[i])
+			continue;
+		g_prefetched[i] = true;
+		for (auto &p : cue_files(c)) {
+			if (seen.insert(p).second)
+				paths.push_back(std::move(p));
+		}
+	}
+
+	if (!paths.empty())
+		g_prefetch.push_back(std::async(std::launch::async, warm_files, std::move(paths)));
+}
+
+// -------------------------
+// Execution
+// -------------------------
+
+static void cancel_hide(const std::string &id)
+{
+	g_hides.erase(std::remove_if(g_hides.begin(), g_hides.end(),
+				     [&id](const pending_hide &h) { return h.id == id; }),
+		      g_hides.end());
+}
+
+static bool execute(const rundown_cue &c, int64_t planned)
+{
+	switch (c.action) {
+	case rundown_action::Show:
+		if (!get_by_id_const(c.target))
+			return false;
+		cancel_hide(c.target);
+		if (c.duration_ms > 0)
+			g_hides.push_back(pending_hide{planned + c.duration_ms, c.target});
+		return set_visible_persist(c.target, true);
+	case rundown_action::Hide:
+		if (!get_by_id_const(c.target))
+			return false;
+		cancel_hide(c.target);
+		return set_visible_persist(c.target, false);
+	case rundown_action::Toggle:
+		if (!get_by_id_const(c.target))
+			return false;
+		cancel_hide(c.target);
+		return toggle_visible_persist(c.target);
+	case rundown_action::RunGroup: {
+		const std::string gid = resolve_group(c.target);
+		return !gid.empty() && start_group_run(gid);
+	}
+	case rundown_action::StopGroup: {
+		const std::string gid = resolve_group(c.target);
+		if (gid.empty())
+			return false;
+		stop_group_run(gid);
+		return true;
+	}
+	case rundown_action::HideAll:
+		g_hides.clear();
+		for (const auto &id : visible_ids())
+			set_visible_persist(id, false);
+		return true;
+	}
+	return false;
+}
+
+// Plans g_next: its due time, or a wait for go.
+static void plan_next(int64_t now)
+{
+	g_next_due = -1;
+	g_waiting_go = false;
+	if (g_next >= g_cues.size()) {
+		if (g_running)
+			LOGI("Rundown finished (%zu cues)", g_cues.size());
+		g_running = false;
+		return;
+	}
+
+	const rundown_cue &c = g_cues[g_next];
+	if (c.manual)
+		g_waiting_go = true;
+	else
+		g_next_due = std::max(g_last_planned, c.at_ms >= 0 ? g_anchor + c.at_ms : g_last_planned);
+	prefetch_ahead(now);
+}
+
+static void fire_next(int64_t planned, int64_t now)
+{
+	const size_t index = g_next++;
+	const rundown_cue &c = g_cues[index];
+	g_last_planned = planned;
+
+	const bool ok = execute(c, planned);
+
+	rundown_cue_report r;
+	r.index = index;
+	r.planned_ms = planned - g_start;
+	r.actual_ms = now_ms() - g_start;
+	r.offset_ms = r.actual_ms - r.planned_ms;
+	r.ok = ok;
+	g_reports.push_back(r);
+
+	if (ok)
+		LOGI("Cue %zu '%s' (%s): planned %lld ms, offset %+lld ms", index, c.name.c_str(), c.target.c_str(),
+		     (long long)r.planned_ms, (long long)r.offset_ms);
+	else
+		LOGW("Cue %zu '%s': target '%s' not found", index, c.name.c_str(), c.target.c_str());
+
+	core_event ev;
+	ev.type = event_type::RundownCue;
+	ev.count = (int64_t)index;
+	ev.id = c.name;
+	ev.id2 = c.target;
+	ev.ok = ok;
+	ev.planned_ms = r.planned_ms;
+	ev.offset_ms = r.offset_ms;
+	emit_event(ev);
+
+	plan_next(now);
+}
+
+static void rearm()
+{
+	if (!g_timer)
+		return;
+
+	int64_t due = (g_running && !g_waiting_go) ? g_next_due : -1;
+	for (const auto &h : g_hides)
+		due = due < 0 ? h.due : std::min(due, h.due);
+
+	if (due < 0) {
+		g_timer->stop();
+		return;
+	}
+	const int64_t wait = std::max<int64_t>(0, due - now_ms());
+	g_timer->start((int)std::min<int64_t>(wait, INT32_MAX));
+}
+
+// Runs everything that is due, in order.
+static void drain()
+{
+	const int64_t now = now_ms();
+
+	for (size_t i = 0; i < g_hides.size();) {
+		if (g_hides[i].due > now) {
+			++i;
+			continue;
+		}
+		const std::string id = g_hides[i].id;
+		g_hides.erase(g_hides.begin() + (std::ptrdiff_t)i);
+		if (is_visible(id))
+			set_visible_persist(id, false);
+	}
+
+	while (g_running && !g_waiting_go && g_next_due >= 0 && g_next_due <= now)
+		fire_next(g_next_due, now);
+
+	rearm();
+}
+
+static void stop_now()
+{
+	if (g_running)
+		LOGI("Rundown stopped at cue %zu of %zu", g_next, g_cues.size());
+	g_running = false;
+	g_waiting_go = false;
+	g_next_due = -1;
+	// Items keep their current visibility; only the rundown's own pending hides are dropped.
+	g_hides.clear();
+	rearm();
+}
+
+// -------------------------
+// Public API
+// -------------------------
+
+rundown_load_result rundown_load(std::istream &in)
+{
+	rundown_load_result res;
+	std::vector<rundown_cue> cues;
+
+	skip_utf8_bom(in);
+	while (in.good() && std::isspace(in.peek()))
+		in.get();
+	const int first = in.peek();
+	if (first == '[' || first == '{') {
+		const std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+		parse_json_cues(QByteArray::fromStdString(text), cues, res.skipped);
+	} else if (!parse_csv_cues(in, cues, res.skipped)) {
+		res.error = "Empty cue list";
+		return res;
+	}
+
+	if (cues.empty()) {
+		res.error = res.skipped ? "No valid cues" : "Empty cue list";
+		return res;
+	}
+
+	res.ok = true;
+	res.cues = cues.size();
+	on_rundown_thread([&]() {
+		stop_now();
+		g_cues = std::move(cues);
+		g_reports.clear();
+		g_next = 0;
+	});
+	LOGI("Rundown loaded: %zu cues (%zu skipped)", res.cues, res.skipped);
+	return res;
+}
+
+rundown_load_result rundown_load_file(const std::string &path)
+{
+	std::ifstream in(std::filesystem::path(path), std::ios::binary);
+	if (!in) {
+		rundown_load_result res;
+		res.error = "Cannot open " + path;
+		return res;
+	}
+	return rundown_load(in);
+}
+
+void rundown_init()
+{
+	if (g_timer)
+		return;
+
+	g_timer = new QTimer();
+	g_timer->setSingleShot(true);
+	g_timer->setTimerType(Qt::PreciseTimer);
+	QObject::connect(g_timer, &QTimer::timeout, g_timer, []() { drain(); });
+}
+
+void rundown_shutdown()
+{
+	stop_now();
+	delete g_timer;
+	g_timer = nullptr;
+
+	for (auto &f : g_prefetch)
+		f.wait();
+	g_prefetch.clear();
+	g_cues.clear();
+	g_reports.clear();
+	g_prefetched.clear();
+}
+
+bool rundown_play()
+{
+	bool ok = false;
+	on_rundown_thread([&]() {
+		stop_now();
+		if (g_cues.empty())
+			return;
+
+		const int64_t now = now_ms();
+		g_start = g_anchor = g_last_planned = now;
+		g_next = 0;
+		g_reports.clear();
+		g_prefetched.assign(g_cues.size(), false);
+		g_running = true;
+		LOGI("Rundown started (%zu cues)", g_cues.size());
+
+		plan_next(now);
+		drain();
+		ok = true;
+	});
+	return ok;
+}
+
+void rundown_stop()
+{
+	on_rundown_thread([]() { stop_now(); });
+}
+
+bool rundown_go()
+{
+	bool ok = false;
+	on_rundown_thread([&]() {
+		if (!g_running || !g_waiting_go)
+			return;
+
+		// The released cue is the new anchor for the 'at' times after it.
+		const int64_t now = now_ms();
+		g_anchor = now;
+		g_waiting_go = false;
+		fire_next(now, now);
+		drain();
+		ok = true;
+	});
+	return ok;
+}
+
+rundown_status rundown_status_now()
+{
+	rundown_status st;
+	on_rundown_thread([&]() {
+		const int64_t now = now_ms();
+		st.cues = g_cues.size();
+		st.running = g_running;
+		st.waiting_go = g_waiting_go;
+		st.next = g_next;
+		st.elapsed_ms = g_running ? now - g_start : -1;
+		st.next_in_ms = (g_running && !g_waiting_go && g_next_due >= 0) ? std::max<int64_t>(0, g_next_due - now)
+										  : -1;
+		st.reports = g_reports;
+	});
+	return st;
+}
+
+} // namespace vflow
@@ -0,0 +1,533 @@
+#define LOG_TAG "[" PLUGIN_NAME "][sched]"
+#include "scheduler.hpp"
+
+#include "core.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <climits>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <QDateTime>
+#include <QMetaObject>
+#include <QRandomGenerator>
+#include <QThread>
+#include <QTimer>
+
+namespace vflow {
+
+namespace {
+
+// Repeats whose hide time is unset stay up this long (matches the settings dialog default).
+constexpr int kDefaultRepeatVisibleSec = 3;
+// A repeat that finds its item already visible hides it and shows it again after this gap, so the
+// template replays its in-animation.
+constexpr int64_t kReshowGapMs = 150;
+
+// Timer keys: kind prefix + item or group id.
+constexpr char kRepeatShow = 'S';
+constexpr char kAutoHide = 'H';
+constexpr char kReshow = 'R';
+constexpr char kGroupStep = 'G';
+constexpr char kScheduled = 'C'; // id = scheduled_change::seq
+
+struct heap_entry {
+	int64_t due = 0;
+	uint64_t gen = 0;
+	std::string key;
+};
+
+struct later_first {
+	bool operator()(const heap_entry &a, const heap_entry &b) const { return a.due > b.due; }
+};
+
+struct armed_timer {
+	int64_t due = 0;
+	uint64_t gen = 0;
+};
+
+struct group_run {
+	size_t index = 0;
+	bool phase_show = true;
+	std::string current;
+	int64_t hide_at = 0;
+	std::vector<size_t> seq;
+};
+
+} // namespace
+
+// Cancelled or re-armed timers leave stale heap entries behind; they are skipped by generation.
+static std::priority_queue<heap_entry, std::vector<heap_entry>, later_first> g_heap;
+static std::unordered_map<std::string, armed_timer> g_armed;
+static uint64_t g_gen = 0;
+
+static std::unordered_map<std::string, group_run> g_runs; // present = running
+static std::unordered_map<std::string, int> g_repeat_every; // last seen repeat_every_sec per item
+
+static QTimer *g_timer = nullptr;
+static uint64_t g_listener = 0;
+
+// The public entry points may be called from websocket requests; scheduler state is only touched on
+// the UI thread, which owns the timer.
+static void on_scheduler_thread(const std::function<void()> &fn)
+{
+	if (!g_timer || QThread::currentThread() == g_timer->thread())
+		fn();
+	else
+		QMetaObject::invokeMethod(g_timer, fn, Qt::BlockingQueuedConnection);
+}
+
+static int64_t now_ms()
+{
+	using namespace std::chrono;
+	return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static std::string timer_key(char kind, const std::string &id)
+{
+	std::string k;
+	k.reserve(id.size() + 1);
+	k.push_back(kind);
+	k += id;
+	return k;
+}
+
+static void rearm_qtimer()
+{
+	while (!g_heap.empty()) {
+		const heap_entry &top = g_heap.top();
+		auto it = g_armed.find(top.key);
+		if (it != g_armed.end() && it->second.gen == top.gen)
+			break;
+		g_heap.pop();
+	}
+
+	if (!g_timer)
+		return;
+	if (g_heap.empty()) {
+		g_timer->stop();
+		return;
+	}
+	const int64_t wait = std::max<int64_t>(0, g_heap.top().due - now_ms());
+	g_timer->start((int)std::min<int64_t>(wait, INT32_MAX));
+}
+
+static void arm(char kind, const std::string &id, int64_t due)
+{
+	const std::string key = timer_key(kind, id);
+	const uint64_t gen = ++g_gen;
+	g_armed[key] = armed_timer{due, gen};
+	g_heap.push(heap_entry{due, gen, key});
+
+	// Keep stale entries bounded when timers are re-armed much more often than they fire.
+	if (g_heap.size() > 2 * g_armed.size() + 64) {
+		decltype(g_heap) fresh;
+		for (const auto &kv : g_armed)
+			fresh.push(heap_entry{kv.second.due, kv.second.gen, kv.first});
+		g_heap.swap(fresh);
+	}
+	rearm_qtimer();
+}
+
+static void cancel(char kind, const std::string &id)
+{
+	g_armed.erase(timer_key(kind, id));
+}
+
+static int64_t due_of(char kind, const std::string &id)
+{
+	auto it = g_armed.find(timer_key(kind, id));
+	return it == g_armed.end() ? -1 : it->second.due;
+}
+
+static bool in_running_group(const std::string &id)
+{
+	for (const auto &gid : groups_containing(id)) {
+		if (g_runs.count(gid))
+			return true;
+	}
+	return false;
+}
+
+static int repeat_visible_sec(const lower_third_cfg &c)
+{
+	if (c.repeat_every_sec > 0 && c.repeat_visible_sec <= 0)
+		return kDefaultRepeatVisibleSec;
+	return c.repeat_visible_sec;
+}
+
+// -------------------------
+// Repeats
+// -------------------------
+
+// Brings repeat timers in line with the current items: new or re-timed repeaters start a fresh period,
+// removed items and members of running groups lose theirs.
+static void sync_repeats()
+{
+	const int64_t now = now_ms();
+	std::unordered_set<std::string> alive;
+
+	for (const auto &c : all_const()) {
+		alive.insert(c.id);
+
+		if (in_running_group(c.id)) {
+			cancel(kRepeatShow, c.id);
+			cancel(kAutoHide, c.id);
+			cancel(kReshow, c.id);
+			g_repeat_every.erase(c.id);
+			continue;
+		}
+
+		const int every = c.repeat_every_sec;
+		auto seen = g_repeat_every.find(c.id);
+		const bool retimed = seen == g_repeat_every.end() || seen->second != every;
+		g_repeat_every[c.id] = every;
+
+		if (every > 0) {
+			if (retimed || due_of(kRepeatShow, c.id) < 0)
+				arm(kRepeatShow, c.id, now + (int64_t)every * 1000);
+		} else {
+			cancel(kRepeatShow, c.id);
+			cancel(kReshow, c.id);
+		}
+
+		const int visibleSec = repeat_visible_sec(c);
+		if (visibleSec <= 0)
+			cancel(kAutoHide, c.id);
+		else if (is_visible(c.id) && due_of(kAutoHide, c.id) < 0)
+			arm(kAutoHide, c.id, now + (int64_t)visibleSec * 1000);
+	}
+
+	std::vector<std::string> dead;
+	for (const auto &kv : g_armed) {
+		if (kv.first[0] != kGroupStep && kv.first[0] != kScheduled && !alive.count(kv.first.substr(1)))
+			dead.push_back(kv.first);
+	}
+	for (const auto &k : dead)
+		g_armed.erase(k);
+	for (auto it = g_repeat_every.begin(); it != g_repeat_every.end();) {
+		if (alive.count(it->first))
+			++it;
+		else
+			it = g_repeat_every.erase(it);
+	}
+	rearm_qtimer();
+}
+
+static void on_repeat_show(const std::string &id, int64_t due, int64_t now)
+{
+	const lower_third_cfg *c = get_by_id_const(id);
+	if (!c || c->repeat_every_sec <= 0 || in_running_group(id))
+		return;
+
+	// Next period from the planned time; periods missed entirely (e.g. system sleep) are skipped.
+	const int64_t step = (int64_t)c->repeat_every_sec * 1000;
+	int64_t next = due + step;
+	if (next <= now)
+		next += ((now - next) / step + 1) * step;
+	arm(kRepeatShow, id, next);
+
+	if (!is_visible(id)) {
+		set_visible_persist(id, true); // the visibility listener arms the hide
+	} else if (due_of(kReshow, id) < 0) {
+		set_visible_persist(id, false);
+		arm(kReshow, id, now + kReshowGapMs);
+	}
+}
+
+static void on_visibility_changed(const std::string &id, bool visible)
+{
+	if (!visible) {
+		cancel(kAutoHide, id);
+		rearm_qtimer();
+		return;
+	}
+
+	// Group runs time their own members.
+	const lower_third_cfg *c = get_by_id_const(id);
+	if (!c || in_running_group(id))
+		return;
+
+	const int visibleSec = repeat_visible_sec(*c);
+	if (visibleSec > 0)
+		arm(kAutoHide, id, now_ms() + (int64_t)visibleSec * 1000);
+}
+
+// -------------------------
+// Group runs
+// -------------------------
+
+static void shuffle(std::vector<size_t> &seq)
+{
+	auto *rng = QRandomGenerator::global();
+	for (size_t i = seq.size(); i > 1; --i) {
+		const size_t j = (size_t)rng->bounded((quint32)i);
+		std::swap(seq[i - 1], seq[j]);
+	}
+}
+
+static void finish_group_run(const std::string &groupId)
+{
+	auto it = g_runs.find(groupId);
+	if (it == g_runs.end())
+		return;
+
+	const std::string current = it->second.current;
+	g_runs.erase(it);
+	cancel(kGroupStep, groupId);
+	if (!current.empty())
+		set_visible_persist(current, false);
+
+	// Members' own repeats resume.
+	sync_repeats();
+}
+
+static void on_group_step(const std::string &groupId, int64_t due, int64_t now)
+{
+	auto it = g_runs.find(groupId);
+	if (it == g_runs.end())
+		return;
+
+	const group_cfg *car = get_group_by_id(groupId);
+	if (!car || car->members.empty()) {
+		finish_group_run(groupId);
+		return;
+	}
+
+	const int64_t visibleMs = std::max(0, car->visible_ms);
+	const int64_t intervalMs = std::max(0, car->interval_ms);
+	const size_t count = car->members.size();
+	group_run &rt = it->second;
+
+	if (rt.seq.size() != count) {
+		rt.seq.resize(count);
+		for (size_t i = 0; i < count; ++i)
+			rt.seq[i] = i;
+		if (car->order_mode == 1)
+			shuffle(rt.seq);
+		rt.index = 0;
+	}
+
+	if (!rt.current.empty()) {
+		const std::string prev = rt.current;
+		rt.current.clear();
+		rt.hide_at = 0;
+		set_visible_persist(prev, false);
+	}
+
+	// Late wake-ups (a blocked UI thread) shorten the next phase rather than shifting the whole run.
+	if (rt.phase_show) {
+		if (rt.index >= count) {
+			if (!car->loop) {
+				finish_group_run(groupId);
+				return;
+			}
+			rt.index = 0;
+			if (car->order_mode == 1)
+				shuffle(rt.seq);
+		}
+
+		const std::string id = car->members[rt.seq[rt.index]];
+		rt.current = id;
+		rt.hide_at = std::max(due + visibleMs, now);
+		rt.phase_show = false;
+		arm(kGroupStep, groupId, rt.hide_at);
+		set_visible_persist(id, true);
+	} else {
+		++rt.index;
+		if (!car->loop && rt.index >= count) {
+			finish_group_run(groupId);
+			return;
+		}
+		rt.phase_show = true;
+		arm(kGroupStep, groupId, std::max(due + intervalMs, now));
+	}
+}
+
+static bool start_group_run_now(const std::string &groupId)
+{
+	const group_cfg *car = get_group_by_id(groupId);
+	if (!car || car->members.empty())
+		return false;
+
+	if (g_runs.count(groupId))
+		finish_group_run(groupId);
+	g_runs[groupId] = group_run{};
+	sync_repeats();
+
+	const int64_t now = now_ms();
+	on_group_step(groupId, now, now);
+	return true;
+}
+
+bool start_group_run(const std::string &groupId)
+{
+	bool ok = false;
+	on_scheduler_thread([&]() { ok = start_group_run_now(groupId); });
+	return ok;
+}
+
+void stop_group_run(const std::string &groupId)
+{
+	on_scheduler_thread([&]() { finish_group_run(groupId); });
+}
+
+bool group_run_active(const std::string &groupId)
+{
+	bool active = false;
+	on_scheduler_thread([&]() { active = g_runs.count(groupId) != 0; });
+	return active;
+}
+
+repeat_status repeat_status_of(const std::string &id)
+{
+	repeat_status st;
+	const int64_t now = now_ms();
+	const auto left = [now](int64_t due) { return due < 0 ? -1 : std::max<int64_t>(0, due - now); };
+
+	for (const auto &gid : groups_containing(id)) {
+		auto it = g_runs.find(gid);
+		if (it == g_runs.end())
+			continue;
+		st.in_group_run = true;
+		if (it->second.current == id)
+			st.hide_in_ms = left(it->second.hide_at);
+		return st;
+	}
+
+	st.hide_in_ms = left(due_of(kAutoHide, id));
+	st.next_in_ms = left(due_of(kRepeatShow, id));
+	return st;
+}
+
+// -------------------------
+// Scheduled changes
+// -------------------------
+
+// Arms one timer per pending core change. 'at' is on the system clock; the remaining time is moved onto
+// the monotonic one once, when the change is first seen.
+static void sync_scheduled()
+{
+	const int64_t now = now_ms();
+	const int64_t unixNow = QDateTime::currentMSecsSinceEpoch();
+
+	std::unordered_set<std::string> pending;
+	for (const auto &c : scheduled_changes()) {
+		const std::string key = std::to_string(c.seq);
+		pending.insert(key);
+		if (due_of(kScheduled, key) < 0)
+			arm(kScheduled, key, now + (c.at_ms - unixNow));
+	}
+
+	for (auto it = g_armed.begin(); it != g_armed.end();) {
+		if (it->first[0] == kScheduled && !pending.count(it->first.substr(1)))
+			it = g_armed.erase(it);
+		else
+			++it;
+	}
+	rearm_qtimer();
+}
+
+// -------------------------
+// Timer + events
+// -------------------------
+
+static void on_timeout()
+{
+	const int64_t now = now_ms();
+
+	// Handlers may arm new timers; anything already due runs in this pass.
+	while (!g_heap.empty() && g_heap.top().due <= now) {
+		const heap_entry e = g_heap.top();
+		g_heap.pop();
+
+		auto it = g_armed.find(e.key);
+		if (it == g_armed.end() || it->second.gen != e.gen)
+			continue;
+		g_armed.erase(it);
+
+		const std::string id = e.key.substr(1);
+		switch (e.key[0]) {
+		case kRepeatShow:
+			on_repeat_show(id, e.due, now);
+			break;
+		case kAutoHide:
+			if (is_visible(id))
+				set_visible_persist(id, false);
+			break;
+		case kReshow:
+			if (!is_visible(id))
+				set_visible_persist(id, true);
+			break;
+		case kGroupStep:
+			on_group_step(id, e.due, now);
+			break;
+		case kScheduled:
+			apply_scheduled_change(std::stoull(id));
+			break;
+		default:
+			break;
+		}
+	}
+
+	rearm_qtimer();
+}
+
+static void on_core_event(const core_event &ev, void *)
+{
+	if (ev.type != event_type::VisibilityChanged && ev.type != event_type::ListChanged &&
+	    ev.type != event_type::Reloaded && ev.type != event_type::ScheduleChanged)
+		return;
+
+	// Core events may come from the websocket thread; timers are only touched on the UI thread.
+	QMetaObject::invokeMethod(
+		g_timer,
+		[ev]() {
+			if (!g_timer)
+				return;
+			if (ev.type == event_type::VisibilityChanged)
+				on_visibility_changed(ev.id, ev.visible);
+			else if (ev.type == event_type::ScheduleChanged)
+				sync_scheduled();
+			else
+				sync_repeats();
+		},
+		Qt::AutoConnection);
+}
+
+void scheduler_start()
+{
+	if (g_timer)
+		return;
+
+	g_timer = new QTimer();
+	g_timer->setSingleShot(true);
+	g_timer->setTimerType(Qt::PreciseTimer);
+	QObject::connect(g_timer, &QTimer::timeout, g_timer, []() { on_timeout(); });
+
+	g_listener = add_event_listener(on_core_event, nullptr);
+	sync_repeats();
+	sync_scheduled();
+}
+
+void scheduler_stop()
+{
+	if (g_listener) {
+		remove_event_listener(g_listener);
+		g_listener = 0;
+	}
+
+	delete g_timer;
+	g_timer = nullptr;
+
+	g_heap = {};
+	g_armed.clear();
+	g_runs.clear();
+	g_repeat_every.clear();
+}
+
+} // namespace vflow
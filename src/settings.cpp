@@ -3,6 +3,7 @@
 
 #include "headers/api.hpp"
 
+#include "assets.hpp"
 #include "core.hpp"
 
 #include <obs.h>
@@ -504,14 +505,14 @@ LowerThirdSettingsDialog::LowerThirdSettingsDialog(QWidget *parent) : QDialog(pa
 		row++;
 		g->addWidget(new QLabel(tr("Avatar height (px):"), this), row, 0);
 		avatarHeightSpin = new QSpinBox(this);
-		avatarHeightSpin->setRange(10, 400);
+		avatarHeightSpin->setRange(kAvatarMinPx, kAvatarMaxPx);
 		avatarHeightSpin->setToolTip(tr("Avatar height in pixels for {{AVATAR_HEIGHT}} placeholder"));
 		g->addWidget(avatarHeightSpin, row, 1);
 
 		row++;
 		g->addWidget(new QLabel(tr("Avatar width (px):"), this), row, 0);
 		avatarWidthSpin = new QSpinBox(this);
-		avatarWidthSpin->setRange(10, 400);
+		avatarWidthSpin->setRange(kAvatarMinPx, kAvatarMaxPx);
 		avatarWidthSpin->setToolTip(tr("Avatar width in pixels for {{AVATAR_WIDTH}} placeholder"));
 		g->addWidget(avatarWidthSpin, row, 1);
 
@@ -703,6 +704,20 @@ LowerThirdSettingsDialog::LowerThirdSettingsDialog(QWidget *parent) : QDialog(pa
 
 		phV->addWidget(phText);
 
+		instancedCheck = new QCheckBox(tr("Instanced (one template, many data rows)"), phBox);
+		instancedCheck->setCursor(Qt::PointingHandCursor);
+		instancedCheck->setToolTip(
+			tr("Render this lower third once and fill {{TITLE}}, {{SUBTITLE}} and {{PROFILE_PICTURE_URL}} "
+			   "from the active data row. Edit rows from the dock; switching rows does not rebuild the overlay."));
+		phV->addWidget(instancedCheck);
+
+		nativeCheck = new QCheckBox(tr("Native (drawn without a browser)"), phBox);
+		nativeCheck->setCursor(Qt::PointingHandCursor);
+		nativeCheck->setToolTip(
+			tr("Draw title, subtitle, picture and box directly, skipping the HTML/CSS/JS templates. "
+			   "Add a \"VinciFlow Lower Third\" source for this item to a scene; it only uses CPU while animating."));
+		phV->addWidget(nativeCheck);
+
 		phV->addStretch(1);
 
 		templatesPageLayout->addWidget(editorsBox, /*stretch*/ 1);
@@ -1010,7 +1025,7 @@ void LowerThirdSettingsDialog::loadFromState()
 	if (currentId.isEmpty())
 		return;
 
-	auto *cfg = vflow::get_by_id(currentId.toStdString());
+	const auto *cfg = vflow::get_by_id_const(currentId.toStdString());
 	if (!cfg)
 		return;
 
@@ -1042,13 +1057,13 @@ void LowerThirdSettingsDialog::loadFromState()
 		cb->setCurrentIndex(idx >= 0 ? idx : 0);
 	};
 
-	setCombo(animInCombo, QString::fromStdString(cfg->anim_in));
-	setCombo(animOutCombo, QString::fromStdString(cfg->anim_out));
+	setCombo(animInCombo, QString::fromStdString(cfg->anim_in.str()));
+	setCombo(animOutCombo, QString::fromStdString(cfg->anim_out.str()));
 
 	if (!cfg->font_family.empty())
 		fontCombo->setCurrentFont(QFont(QString::fromStdString(cfg->font_family)));
 
-	setCombo(posCombo, QString::fromStdString(cfg->lt_position));
+	setCombo(posCombo, QString::fromStdString(cfg->lt_position.str()));
 
 	hotkeyEdit->setKeySequence(QKeySequence(QString::fromStdString(cfg->hotkey)));
 	repeatEverySpin->setValue(cfg->repeat_every_sec);
@@ -1060,6 +1075,10 @@ void LowerThirdSettingsDialog::loadFromState()
 	if (apiBridgeEnable)
 		apiBridgeEnable->setChecked(cfg->api_bridge_enabled);
 	updateApiBridgeUi();
+	if (instancedCheck)
+		instancedCheck->setChecked(cfg->instanced);
+	if (nativeCheck)
+		nativeCheck->setChecked(cfg->native);
 
 	if (cfg->profile_picture.empty())
 		profilePictureEdit->clear();
@@ -1085,10 +1104,10 @@ void LowerThirdSettingsDialog::loadFromState()
 	delete currentSubtitleColor;
 	currentSubtitleColor = nullptr;
 
-	QColor primary(QString::fromStdString(cfg->primary_color));
-	QColor secondary(QString::fromStdString(cfg->secondary_color));
-	QColor title(QString::fromStdString(cfg->title_color));
-	QColor subtitle(QString::fromStdString(cfg->subtitle_color));
+	QColor primary(QString::fromStdString(cfg->primary_color.str()));
+	QColor secondary(QString::fromStdString(cfg->secondary_color.str()));
+	QColor title(QString::fromStdString(cfg->title_color.str()));
+	QColor subtitle(QString::fromStdString(cfg->subtitle_color.str()));
 
 	if (!primary.isValid())
 		primary = QColor(17, 24, 39);
@@ -1133,6 +1152,7 @@ void LowerThirdSettingsDialog::loadFromState()
 	}
 
 	pendingProfilePicturePath.clear();
+	pendingPictureIngest = {};
 }
 
 void LowerThirdSettingsDialog::saveToState()
@@ -1213,6 +1233,8 @@ void LowerThirdSettingsDialog::saveToState()
 		cfg->title_size = titleSizeSpin->value();
 	if (subtitleSizeSpin)
 		cfg->subtitle_size = subtitleSizeSpin->value();
+	const bool avatarResized = (avatarWidthSpin && cfg->avatar_width != avatarWidthSpin->value()) ||
+				   (avatarHeightSpin && cfg->avatar_height != avatarHeightSpin->value());
 	if (avatarWidthSpin)
 		cfg->avatar_width = avatarWidthSpin->value();
 	if (avatarHeightSpin)
@@ -1223,98 +1245,47 @@ void LowerThirdSettingsDialog::saveToState()
 	cfg->js_template = jsEdit->toPlainText().toStdString();
 	if (apiBridgeEnable)
 		cfg->api_bridge_enabled = apiBridgeEnable->isChecked();
+	if (instancedCheck)
+		cfg->instanced = instancedCheck->isChecked();
+	if (nativeCheck)
+		cfg->native = nativeCheck->isChecked();
 
 	if (!pendingProfilePicturePath.isEmpty() && vflow::has_output_dir()) {
-		const QString outDir = QString::fromStdString(vflow::output_dir());
-		QDir dir(outDir);
-
-		if (!cfg->profile_picture.empty()) {
-			const QString oldPath = dir.filePath(QString::fromStdString(cfg->profile_picture));
-			if (QFile::exists(oldPath))
-				QFile::remove(oldPath);
-		}
-
-		const QFileInfo fi(pendingProfilePicturePath);
-		const QString ext = fi.suffix().toLower();
-		const qint64 ts = QDateTime::currentMSecsSinceEpoch();
-
-		QString newFileName = QString("%1_%2").arg(QString::fromStdString(cfg->id)).arg(ts);
-		if (!ext.isEmpty())
-			newFileName += "." + ext;
-
-		const QString destPath = dir.filePath(newFileName);
-		QFile::remove(destPath);
-
-		if (QFile::copy(pendingProfilePicturePath, destPath)) {
-			cfg->profile_picture = newFileName.toStdString();
-			profilePictureEdit->setText(newFileName);
-		} else {
-			LOGW("Failed to copy profile picture '%s' -> '%s'",
-			     pendingProfilePicturePath.toUtf8().constData(), destPath.toUtf8().constData());
-		}
+		if (vflow::assign_picture(*cfg, takePictureIngest(cfg->avatar_width, cfg->avatar_height)))
+			profilePictureEdit->setText(QString::fromStdString(cfg->profile_picture));
+		else
+			LOGW("Failed to store profile picture '%s'", pendingProfilePicturePath.toUtf8().constData());
 
 		pendingProfilePicturePath.clear();
+	} else if (avatarResized && !cfg->profile_picture.empty()) {
+		// Re-derive from the original so a larger avatar is not upscaled from the old one.
+		const auto res = vflow::ingest_picture(vflow::picture_source_path(*cfg), cfg->avatar_width,
+						       cfg->avatar_height);
+		if (vflow::assign_picture(*cfg, res))
+			profilePictureEdit->setText(QString::fromStdString(cfg->profile_picture));
 	}
 
 	if (!pendingAnimInSoundPath.isEmpty() && vflow::has_output_dir()) {
-		const QString outDir = QString::fromStdString(vflow::output_dir());
-		QDir dir(outDir);
-
-		if (!cfg->anim_in_sound.empty()) {
-			const QString oldPath = dir.filePath(QString::fromStdString(cfg->anim_in_sound));
-			if (QFile::exists(oldPath))
-				QFile::remove(oldPath);
-		}
-
-		const QFileInfo fi(pendingAnimInSoundPath);
-		const QString ext = fi.suffix().toLower();
-		const qint64 ts = QDateTime::currentMSecsSinceEpoch();
-
-		QString newFileName = QString("%1_in_%2").arg(QString::fromStdString(cfg->id)).arg(ts);
-		if (!ext.isEmpty())
-			newFileName += "." + ext;
-
-		const QString destPath = dir.filePath(newFileName);
-		QFile::remove(destPath);
-
-		if (QFile::copy(pendingAnimInSoundPath, destPath)) {
-			cfg->anim_in_sound = newFileName.toStdString();
-			animInSoundEdit->setText(newFileName);
+		const std::string stored = vflow::import_asset(pendingAnimInSoundPath.toStdString());
+		if (!stored.empty()) {
+			vflow::release_asset(cfg->anim_in_sound);
+			cfg->anim_in_sound = stored;
+			animInSoundEdit->setText(QString::fromStdString(stored));
 		} else {
-			LOGW("Failed to copy anim-in sound '%s' -> '%s'", pendingAnimInSoundPath.toUtf8().constData(),
-			     destPath.toUtf8().constData());
+			LOGW("Failed to store anim-in sound '%s'", pendingAnimInSoundPath.toUtf8().constData());
 		}
 
 		pendingAnimInSoundPath.clear();
 	}
 
 	if (!pendingAnimOutSoundPath.isEmpty() && vflow::has_output_dir()) {
-		const QString outDir = QString::fromStdString(vflow::output_dir());
-		QDir dir(outDir);
-
-		if (!cfg->anim_out_sound.empty()) {
-			const QString oldPath = dir.filePath(QString::fromStdString(cfg->anim_out_sound));
-			if (QFile::exists(oldPath))
-				QFile::remove(oldPath);
-		}
-
-		const QFileInfo fi(pendingAnimOutSoundPath);
-		const QString ext = fi.suffix().toLower();
-		const qint64 ts = QDateTime::currentMSecsSinceEpoch();
-
-		QString newFileName = QString("%1_out_%2").arg(QString::fromStdString(cfg->id)).arg(ts);
-		if (!ext.isEmpty())
-			newFileName += "." + ext;
-
-		const QString destPath = dir.filePath(newFileName);
-		QFile::remove(destPath);
-
-		if (QFile::copy(pendingAnimOutSoundPath, destPath)) {
-			cfg->anim_out_sound = newFileName.toStdString();
-			animOutSoundEdit->setText(newFileName);
+		const std::string stored = vflow::import_asset(pendingAnimOutSoundPath.toStdString());
+		if (!stored.empty()) {
+			vflow::release_asset(cfg->anim_out_sound);
+			cfg->anim_out_sound = stored;
+			animOutSoundEdit->setText(QString::fromStdString(stored));
 		} else {
-			LOGW("Failed to copy anim-out sound '%s' -> '%s'", pendingAnimOutSoundPath.toUtf8().constData(),
-			     destPath.toUtf8().constData());
+			LOGW("Failed to store anim-out sound '%s'", pendingAnimOutSoundPath.toUtf8().constData());
 		}
 
 		pendingAnimOutSoundPath.clear();
@@ -1327,9 +1298,8 @@ void LowerThirdSettingsDialog::onSaveAndApply()
 {
 	saveToState();
 
-	if (vflow::rebuild_and_swap()) {
-		vflow::notify_list_updated(currentId.toStdString());
-	}
+	vflow::request_rebuild();
+	vflow::notify_list_updated(currentId.toStdString());
 	close();
 }
 void LowerThirdSettingsDialog::onBrowseProfilePicture()
@@ -1341,6 +1311,21 @@ void LowerThirdSettingsDialog::onBrowseProfilePicture()
 
 	pendingProfilePicturePath = file;
 	profilePictureEdit->setText(file);
+
+	// Decode and resample on a worker while the dialog stays open; saveToState() picks up the result.
+	pendingIngestWidth = avatarWidthSpin ? avatarWidthSpin->value() : 100;
+	pendingIngestHeight = avatarHeightSpin ? avatarHeightSpin->value() : 100;
+	pendingPictureIngest = vflow::ingest_picture_async(file.toStdString(), pendingIngestWidth, pendingIngestHeight);
+}
+
+vflow::picture_ingest_result LowerThirdSettingsDialog::takePictureIngest(int avatarWidth, int avatarHeight)
+{
+	if (pendingPictureIngest.valid() && pendingIngestWidth == avatarWidth && pendingIngestHeight == avatarHeight)
+		return pendingPictureIngest.get();
+
+	// Avatar size edited since browsing: the prefetched result is the wrong size.
+	pendingPictureIngest = {};
+	return vflow::ingest_picture(pendingProfilePicturePath.toStdString(), avatarWidth, avatarHeight);
 }
 
 void LowerThirdSettingsDialog::onDeleteProfilePicture()
@@ -1364,15 +1349,12 @@ void LowerThirdSettingsDialog::onDeleteProfilePicture()
 	if (btn != QMessageBox::Yes)
 		return;
 
-	if (!cfg->profile_picture.empty() && vflow::has_output_dir()) {
-		QDir dir(QString::fromStdString(vflow::output_dir()));
-		const QString oldPath = dir.filePath(QString::fromStdString(cfg->profile_picture));
-		if (QFile::exists(oldPath))
-			QFile::remove(oldPath);
-	}
-
+	vflow::release_asset(cfg->profile_picture);
+	vflow::release_asset(cfg->profile_picture_source);
 	cfg->profile_picture.clear();
+	cfg->profile_picture_source.clear();
 	pendingProfilePicturePath.clear();
+	pendingPictureIngest = {};
 	profilePictureEdit->clear();
 
 	vflow::save_state_json();
@@ -1398,14 +1380,7 @@ void LowerThirdSettingsDialog::onDeleteAnimInSound()
 	if (!cfg)
 		return;
 
-	if (!cfg->anim_in_sound.empty() && vflow::has_output_dir()) {
-		const QString outDir = QString::fromStdString(vflow::output_dir());
-		QDir dir(outDir);
-		const QString oldPath = dir.filePath(QString::fromStdString(cfg->anim_in_sound));
-		if (QFile::exists(oldPath))
-			QFile::remove(oldPath);
-	}
-
+	vflow::release_asset(cfg->anim_in_sound);
 	cfg->anim_in_sound.clear();
 	pendingAnimInSoundPath.clear();
 	animInSoundEdit->clear();
@@ -1434,14 +1409,7 @@ void LowerThirdSettingsDialog::onDeleteAnimOutSound()
 	if (!cfg)
 		return;
 
-	if (!cfg->anim_out_sound.empty() && vflow::has_output_dir()) {
-		const QString outDir = QString::fromStdString(vflow::output_dir());
-		QDir dir(outDir);
-		const QString oldPath = dir.filePath(QString::fromStdString(cfg->anim_out_sound));
-		if (QFile::exists(oldPath))
-			QFile::remove(oldPath);
-	}
-
+	vflow::release_asset(cfg->anim_out_sound);
 	cfg->anim_out_sound.clear();
 	pendingAnimOutSoundPath.clear();
 	animOutSoundEdit->clear();
@@ -1850,12 +1818,12 @@ void LowerThirdSettingsDialog::onExportTemplateClicked()
 	const QByteArray js = jsEdit->toPlainText().toUtf8();
 
 	QJsonObject o;
-	o["title_size"] = cfg->title_size;
-	o["subtitle_size"] = cfg->subtitle_size;
-	o["avatar_width"] = cfg->avatar_width;
-	o["avatar_height"] = cfg->avatar_height;
-	o["anim_in"] = QString::fromStdString(cfg->anim_in);
-	o["anim_out"] = QString::fromStdString(cfg->anim_out);
+	o["title_size"] = (int)cfg->title_size;
+	o["subtitle_size"] = (int)cfg->subtitle_size;
+	o["avatar_width"] = (int)cfg->avatar_width;
+	o["avatar_height"] = (int)cfg->avatar_height;
+	o["anim_in"] = QString::fromStdString(cfg->anim_in.str());
+	o["anim_out"] = QString::fromStdString(cfg->anim_out.str());
 	o["api_template"] = QString::fromStdString(cfg->api_template);
 
 	{
@@ -1876,15 +1844,15 @@ void LowerThirdSettingsDialog::onExportTemplateClicked()
 		o["sound_out"] = sout;
 	}
 	o["font_family"] = QString::fromStdString(cfg->font_family);
-	o["lt_position"] = QString::fromStdString(cfg->lt_position);
-	o["primary_color"] = QString::fromStdString(cfg->primary_color);
-	o["secondary_color"] = QString::fromStdString(cfg->secondary_color);
-	o["title_color"] = QString::fromStdString(cfg->title_color);
-	o["subtitle_color"] = QString::fromStdString(cfg->subtitle_color);
-	o["bg_color"] = QString::fromStdString(cfg->primary_color);
-	o["text_color"] = QString::fromStdString(cfg->title_color);
-	o["opacity"] = cfg->opacity;
-	o["radius"] = cfg->radius;
+	o["lt_position"] = QString::fromStdString(cfg->lt_position.str());
+	o["primary_color"] = QString::fromStdString(cfg->primary_color.str());
+	o["secondary_color"] = QString::fromStdString(cfg->secondary_color.str());
+	o["title_color"] = QString::fromStdString(cfg->title_color.str());
+	o["subtitle_color"] = QString::fromStdString(cfg->subtitle_color.str());
+	o["bg_color"] = QString::fromStdString(cfg->primary_color.str());
+	o["text_color"] = QString::fromStdString(cfg->title_color.str());
+	o["opacity"] = (int)cfg->opacity;
+	o["radius"] = (int)cfg->radius;
 	o["hotkey"] = QString::fromStdString(cfg->hotkey);
 	o["repeat_every_sec"] = cfg->repeat_every_sec;
 	o["repeat_visible_sec"] = cfg->repeat_visible_sec;
@@ -1897,9 +1865,10 @@ void LowerThirdSettingsDialog::onExportTemplateClicked()
 	ok = ok && zip_write_file(zf, "template.js", js);
 	ok = ok && zip_write_file(zf, "template.json", json);
 
-	if (ok && vflow::has_output_dir() && !cfg->profile_picture.empty()) {
-		const QString picPath = QDir(QString::fromStdString(vflow::output_dir()))
-						.filePath(QString::fromStdString(cfg->profile_picture));
+	// The original, not the resampled avatar: importing re-derives it at the importer's avatar size.
+	const std::string picSource = vflow::picture_source_path(*cfg);
+	if (ok && !picSource.empty()) {
+		const QString picPath = QString::fromStdString(picSource);
 		QFile f(picPath);
 		if (f.open(QIODevice::ReadOnly)) {
 			const QByteArray picData = f.readAll();
@@ -1955,7 +1924,9 @@ QString LowerThirdSettingsDialog::infoLoadText()
 	text += tr("Identity & Text") + "\n";
 	text += "  {{ID}} - " + tr("Unique <li> element id for this lower third (used for scoping).") + "\n";
 	text += "  {{TITLE}} - " + tr("Replaced with the Title field value.") + "\n";
-	text += "  {{SUBTITLE}} - " + tr("Replaced with the Subtitle field value.") + "\n\n";
+	text += "  {{SUBTITLE}} - " + tr("Replaced with the Subtitle field value.") + "\n";
+	text += "  {{ROW_ID}} - " + tr("Id of the active data row (instanced lower thirds only, otherwise empty).") +
+		"\n\n";
 	text += tr("Media") + "\n";
 	text += "  {{PROFILE_PICTURE_URL}} - " +
 		tr("Resolved relative URL for the selected profile picture (\"./<file>\"). Uses \"./\" when none is set.") +
@@ -2038,14 +2009,13 @@ void LowerThirdSettingsDialog::onImportTemplateClicked()
 
 	const QJsonObject obj = doc.object();
 
-	cfg->title_size = obj.value("title_size").toInt(cfg->title_size);
-	cfg->subtitle_size = obj.value("subtitle_size").toInt(cfg->subtitle_size);
-	cfg->title_size = std::max(6, std::min(200, cfg->title_size));
-	cfg->subtitle_size = std::max(6, std::min(200, cfg->subtitle_size));
-	cfg->avatar_width = obj.value("avatar_width").toInt(cfg->avatar_width);
-	cfg->avatar_height = obj.value("avatar_height").toInt(cfg->avatar_height);
-	cfg->avatar_width = std::max(16, std::min(512, cfg->avatar_width));
-	cfg->avatar_height = std::max(16, std::min(512, cfg->avatar_height));
+	// Clamp on the full int before narrowing into the packed fields.
+	cfg->title_size = (uint8_t)std::max(6, std::min(200, obj.value("title_size").toInt(cfg->title_size)));
+	cfg->subtitle_size = (uint8_t)std::max(6, std::min(200, obj.value("subtitle_size").toInt(cfg->subtitle_size)));
+	cfg->avatar_width = (uint16_t)std::clamp(obj.value("avatar_width").toInt(cfg->avatar_width), kAvatarMinPx,
+						     kAvatarMaxPx);
+	cfg->avatar_height = (uint16_t)std::clamp(obj.value("avatar_height").toInt(cfg->avatar_height), kAvatarMinPx,
+						     kAvatarMaxPx);
 	cfg->anim_in = obj.value("anim_in").toString().toStdString();
 	cfg->anim_out = obj.value("anim_out").toString().toStdString();
 	{
@@ -2075,12 +2045,11 @@ void LowerThirdSettingsDialog::onImportTemplateClicked()
 		cfg->secondary_color = cfg->primary_color;
 	if (cfg->subtitle_color.empty())
 		cfg->subtitle_color = cfg->title_color;
-	cfg->opacity = obj.value("opacity").toInt(cfg->opacity);
-	cfg->radius = obj.value("radius").toInt(cfg->radius);
-
-	cfg->opacity = std::max(0, std::min(100, cfg->opacity));
-	cfg->opacity = (cfg->opacity / 5) * 5;
-	cfg->radius = std::max(0, std::min(100, cfg->radius));
+	{
+		const int op = std::max(0, std::min(100, obj.value("opacity").toInt(cfg->opacity)));
+		cfg->opacity = (uint8_t)((op / 5) * 5);
+		cfg->radius = (uint8_t)std::max(0, std::min(100, obj.value("radius").toInt(cfg->radius)));
+	}
 
 	cfg->hotkey = obj.value("hotkey").toString().toStdString();
 	cfg->repeat_every_sec = obj.value("repeat_every_sec").toInt(0);
@@ -2109,70 +2078,25 @@ void LowerThirdSettingsDialog::onImportTemplateClicked()
 		}
 	}
 
-	if (!profilePicPath.isEmpty() && vflow::has_output_dir()) {
-		const QString outDir = QString::fromStdString(vflow::output_dir());
-		if (!outDir.isEmpty()) {
-			QDir dir(outDir);
-
-			if (!cfg->profile_picture.empty()) {
-				const QString oldPath = dir.filePath(QString::fromStdString(cfg->profile_picture));
-				if (QFile::exists(oldPath))
-					QFile::remove(oldPath);
-			}
-
-			const QString ext = QFileInfo(profilePicPath).suffix().toLower();
-			const QString newName =
-				ext.isEmpty() ? QString("%1_profile").arg(QString::fromStdString(cfg->id))
-					      : QString("%1_profile.%2").arg(QString::fromStdString(cfg->id)).arg(ext);
-
-			const QString dest = dir.filePath(newName);
-			QFile::remove(dest);
+	if (vflow::has_output_dir()) {
+		auto importAsset = [](const QString &srcPath, std::string &field) {
+			if (srcPath.isEmpty())
+				return;
 
-			if (QFile::copy(profilePicPath, dest)) {
-				cfg->profile_picture = newName.toStdString();
-			}
+			const std::string stored = vflow::import_asset(srcPath.toStdString());
+			if (stored.empty())
+				return;
+			vflow::release_asset(field);
+			field = stored;
+		};
 
-			if (vflow::has_output_dir()) {
-				const QString outDir = QString::fromStdString(vflow::output_dir());
-				if (!outDir.isEmpty()) {
-					QDir dir(outDir);
-
-					auto importSound = [&](const QString &srcPath, bool isIn) {
-						if (srcPath.isEmpty())
-							return;
-
-						std::string &field = isIn ? cfg->anim_in_sound : cfg->anim_out_sound;
-						if (!field.empty()) {
-							const QString oldPath =
-								dir.filePath(QString::fromStdString(field));
-							if (QFile::exists(oldPath))
-								QFile::remove(oldPath);
-							field.clear();
-						}
-
-						const QString ext = QFileInfo(srcPath).suffix().toLower();
-						const QString base = isIn ? "soundIn" : "soundOut";
-						const QString newName =
-							ext.isEmpty() ? QString("%1_%2")
-										.arg(QString::fromStdString(cfg->id))
-										.arg(base)
-								      : QString("%1_%2.%3")
-										.arg(QString::fromStdString(cfg->id))
-										.arg(base)
-										.arg(ext);
-
-						const QString dest = dir.filePath(newName);
-						QFile::remove(dest);
-						if (QFile::copy(srcPath, dest)) {
-							field = newName.toStdString();
-						}
-					};
-
-					importSound(soundInFilePath, true);
-					importSound(soundOutFilePath, false);
-				}
-			}
+		if (!profilePicPath.isEmpty()) {
+			const auto pic =
+				vflow::ingest_picture(profilePicPath.toStdString(), cfg->avatar_width, cfg->avatar_height);
+			vflow::assign_picture(*cfg, pic);
 		}
+		importAsset(soundInFilePath, cfg->anim_in_sound);
+		importAsset(soundOutFilePath, cfg->anim_out_sound);
 	}
 
 	vflow::save_state_json();
@@ -0,0 +1,250 @@
+#define LOG_TAG "[" PLUGIN_NAME "][shards]"
+#include "shards.hpp"
+
+#include "core.hpp"
+
+#include <obs.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+
+namespace vflow {
+
+static std::mutex g_mtx;
+static std::vector<std::string> g_names; // shard sources in use (names)
+static bool g_swept = false;             // leftovers of earlier sessions removed
+
+static std::string shard_source_name(const std::string &target, const std::string &slug)
+{
+	return target + " [" + slug + "]";
+}
+
+static bool is_managed_shard(obs_source_t *src)
+{
+	const char *id = src ? obs_source_get_id(src) : nullptr;
+	if (!id || strcmp(id, sltBrowserSourceId) != 0)
+		return false;
+
+	obs_data_t *s = obs_source_get_settings(src);
+	const bool shard = obs_data_get_bool(s, "vflow_shard");
+	obs_data_release(s);
+	return shard;
+}
+
+// Strong reference to the shard source (release it); created on first use.
+static obs_source_t *ensure_shard_source(const std::string &name, const shard_output &sh)
+{
+	obs_source_t *src = obs_get_source_by_name(name.c_str());
+	if (src) {
+		if (!is_managed_shard(src)) {
+			LOGW("Source '%s' exists and is not a shard; zone '%s' skipped", name.c_str(), sh.slug.c_str());
+			obs_source_release(src);
+			return nullptr;
+		}
+		if (sh.changed)
+			swap_browser_source_to_file(src, sh.html_path, sh.width, sh.height);
+		return src;
+	}
+
+	obs_data_t *s = obs_data_create();
+	obs_data_set_bool(s, "is_local_file", true);
+	obs_data_set_string(s, "local_file", sh.html_path.c_str());
+	obs_data_set_int(s, "width", (int64_t)sh.width);
+	obs_data_set_int(s, "height", (int64_t)sh.height);
+	obs_data_set_bool(s, "reroute_audio", true);
+	obs_data_set_bool(s, "vflow_managed", true);
+	obs_data_set_bool(s, "vflow_shard", true);
+	src = obs_source_create(sltBrowserSourceId, name.c_str(), s, nullptr);
+	obs_data_release(s);
+
+	if (src)
+		LOGI("Created shard '%s' (%dx%d)", name.c_str(), sh.width, sh.height);
+	return src;
+}
+
+struct placed_shard {
+	obs_source_t *src;
+	const shard_output *zone;
+};
+
+struct place_ctx {
+	std::string target;
+	const std::vector<placed_shard> *shards;
+	size_t scenes = 0;
+};
+
+static int order_index_of(obs_scene_t *scene, obs_sceneitem_t *item)
+{
+	struct find_ctx {
+		obs_sceneitem_t *item;
+		int index = 0;
+		int found = -1;
+	} ctx{item};
+
+	obs_scene_enum_items(
+		scene,
+		[](obs_scene_t *, obs_sceneitem_t *it, void *param) {
+			auto *c = static_cast<find_ctx *>(param);
+			if (it == c->item) {
+				c->found = c->index;
+				return false;
+			}
+			++c->index;
+			return true;
+		},
+		&ctx);
+	return ctx.found;
+}
+
+// Where a shard goes under the anchor: the part of its zone the anchor's crop leaves visible, mapped
+// through the anchor's draw transform (position, alignment, rotation, scale or bounds, crop).
+struct shard_placement {
+	vec2 pos;
+	vec2 scale;
+	float rot = 0.0f;
+	obs_sceneitem_crop crop{};
+};
+
+static shard_placement shard_placement_of(const matrix4 &m, const obs_sceneitem_crop &anchorCrop,
+					  const shard_output &zone)
+{
+	// Visible part of the zone, in target frame pixels.
+	const int visLeft = std::max(zone.x, anchorCrop.left);
+	const int visTop = std::max(zone.y, anchorCrop.top);
+	const int visRight = std::max(visLeft, std::min(zone.x + zone.width, target_browser_width() - anchorCrop.right));
+	const int visBottom =
+		std::max(visTop, std::min(zone.y + zone.height, target_browser_height() - anchorCrop.bottom));
+
+	shard_placement p;
+	p.crop.left = visLeft - zone.x;
+	p.crop.top = visTop - zone.y;
+	p.crop.right = zone.x + zone.width - visRight;
+	p.crop.bottom = zone.y + zone.height - visBottom;
+
+	// The draw transform works on the cropped source, so its origin is the crop's top-left corner.
+	const float lx = (float)(visLeft - anchorCrop.left);
+	const float ly = (float)(visTop - anchorCrop.top);
+	vec2_set(&p.pos, m.x.x * lx + m.y.x * ly + m.t.x, m.x.y * lx + m.y.y * ly + m.t.y);
+
+	// Rows x / y are the transformed unit axes: rotation from x, a flip shows up as a negative y scale.
+	const float rad = atan2f(m.x.y, m.x.x);
+	p.rot = DEG(rad);
+	p.scale.x = sqrtf(m.x.x * m.x.x + m.x.y * m.x.y);
+	p.scale.y = m.y.y * cosf(rad) - m.y.x * sinf(rad);
+	return p;
+}
+
+// Lays the shards over the target's scene item so each zone lands where the full-frame page draws it.
+static void place_in_scene(obs_scene_t *scene, place_ctx &ctx)
+{
+	obs_sceneitem_t *anchor = obs_scene_find_source(scene, ctx.target.c_str());
+	if (!anchor)
+		return;
+	++ctx.scenes;
+
+	matrix4 m;
+	obs_sceneitem_crop anchorCrop;
+	obs_sceneitem_get_draw_transform(anchor, &m);
+	obs_sceneitem_get_crop(anchor, &anchorCrop);
+
+	for (const placed_shard &p : *ctx.shards) {
+		obs_sceneitem_t *item = obs_scene_find_source(scene, obs_source_get_name(p.src));
+		if (!item) {
+			item = obs_scene_add(scene, p.src);
+			if (!item)
+				continue;
+			const int anchorIndex = order_index_of(scene, anchor);
+			if (anchorIndex >= 0)
+				obs_sceneitem_set_order_position(item, anchorIndex + 1);
+			obs_sceneitem_set_visible(item, obs_sceneitem_visible(anchor));
+			obs_sceneitem_set_locked(item, true);
+		}
+
+		const shard_placement at = shard_placement_of(m, anchorCrop, *p.zone);
+		obs_sceneitem_defer_update_begin(item);
+		obs_sceneitem_set_alignment(item, OBS_ALIGN_LEFT | OBS_ALIGN_TOP);
+		obs_sceneitem_set_bounds_type(item, OBS_BOUNDS_NONE);
+		obs_sceneitem_set_pos(item, &at.pos);
+		obs_sceneitem_set_rot(item, at.rot);
+		obs_sceneitem_set_scale(item, &at.scale);
+		obs_sceneitem_set_crop(item, &at.crop);
+		obs_sceneitem_defer_update_end(item);
+	}
+}
+
+// Removes the managed shard sources whose names are not in 'keep'.
+static void remove_unused(const std::vector<std::string> &keep)
+{
+	for (const auto &name : list_browser_source_names()) {
+		if (std::find(keep.begin(), keep.end(), name) != keep.end())
+			continue;
+
+		obs_source_t *src = obs_get_source_by_name(name.c_str());
+		if (src && is_managed_shard(src)) {
+			LOGI("Removing shard '%s'", name.c_str());
+			obs_source_remove(src);
+		}
+		obs_source_release(src);
+	}
+	g_swept = true;
+}
+
+void shards_sync(const std::vector<shard_output> &shards)
+{
+	const std::string target = target_browser_source_name();
+	if (target.empty() || !target_browser_source_exists()) {
+		LOGW("Sharding needs a target Browser Source to anchor the zones");
+		shards_remove_all();
+		return;
+	}
+
+	std::vector<placed_shard> placed;
+	std::vector<std::string> names;
+	for (const auto &sh : shards) {
+		const std::string name = shard_source_name(target, sh.slug);
+		if (obs_source_t *src = ensure_shard_source(name, sh)) {
+			placed.push_back({src, &sh});
+			names.push_back(name);
+		}
+	}
+
+	place_ctx ctx{target, &placed};
+	obs_enum_scenes(
+		[](void *param, obs_source_t *sceneSource) {
+			if (obs_scene_t *scene = obs_scene_from_source(sceneSource))
+				place_in_scene(scene, *static_cast<place_ctx *>(param));
+			return true;
+		},
+		&ctx);
+
+	for (const placed_shard &p : placed)
+		obs_source_release(p.src);
+
+	remove_unused(names);
+	{
+		std::lock_guard<std::mutex> lk(g_mtx);
+		g_names = std::move(names);
+	}
+	LOGD("Synced %zu shards in %zu scenes", placed.size(), ctx.scenes);
+}
+
+void shards_remove_all()
+{
+	{
+		std::lock_guard<std::mutex> lk(g_mtx);
+		if (g_names.empty() && g_swept)
+			return;
+		g_names.clear();
+	}
+	remove_unused({});
+}
+
+std::vector<std::string> shard_source_names()
+{
+	std::lock_guard<std::mutex> lk(g_mtx);
+	return g_names;
+}
+
+} // namespace vflow
@@ -1,7 +1,16 @@
 #define LOG_TAG "[" PLUGIN_NAME "][ws]"
 #include "websocket_bridge.hpp"
 
+#include "assets.hpp"
 #include "core.hpp"
+#include "history.hpp"
+#include "idle.hpp"
+#include "import.hpp"
+#include "native_source.hpp"
+#include "profiles.hpp"
+#include "rules.hpp"
+#include "rundown.hpp"
+#include "scheduler.hpp"
 
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -11,8 +20,14 @@
 
 #include <obs-module.h>
 #include <obs.h>
+#include <util/platform.h>
+
+#include <QDateTime>
 
 #include <algorithm>
+#include <chrono>
+#include <future>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -50,6 +65,64 @@ static void set_error(obs_data_t *response, const char *msg)
 	obs_data_set_string(response, "error", msg ? msg : "unknown");
 }
 
+// request[key] when the client sent it, else def.
+static long long opt_int(obs_data_t *request, const char *key, long long def)
+{
+	return request && obs_data_has_user_value(request, key) ? obs_data_get_int(request, key) : def;
+}
+
+// Requests run off the UI thread, so with "waitForRebuild" they may wait for the rebuild their change
+// requested. A rebuild still running after this long is reported as pending rather than failed.
+static constexpr auto kRebuildWait = std::chrono::seconds(10);
+
+// Sets "generation" (compare with GetRebuildStatus). Waits only when the request asks to; otherwise the
+// response is immediate with "rebuildPending" unless the rebuild already finished. False when a waited-for
+// rebuild failed.
+static bool rebuild_succeeded(obs_data_t *request, const vflow::rebuild_ticket &t, obs_data_t *response)
+{
+	obs_data_set_int(response, "generation", (long long)t.generation);
+	if (!t.done.valid())
+		return true;
+	const bool wait = request && obs_data_get_bool(request, "waitForRebuild");
+	if (t.done.wait_for(wait ? kRebuildWait : std::chrono::seconds(0)) != std::future_status::ready) {
+		obs_data_set_bool(response, "rebuildPending", true);
+		return true;
+	}
+	return t.done.get();
+}
+
+// Scheduled changes further ahead than this are rejected (most likely a unit mix-up).
+static constexpr int64_t kMaxScheduleAheadMs = 24LL * 3600 * 1000;
+
+// Reads the optional target time of a change: "atMs" (Unix ms, as Date.now()), "atObsNs" (OBS clock, as
+// video frame timestamps) or "inMs" (from now). Returns false when none is given; 'error' is set when one
+// is given but unusable.
+static bool scheduled_time(obs_data_t *request, int64_t &atMs, std::string &error)
+{
+	const int64_t unixNow = QDateTime::currentMSecsSinceEpoch();
+	if (obs_data_has_user_value(request, "atMs")) {
+		atMs = (int64_t)obs_data_get_int(request, "atMs");
+	} else if (obs_data_has_user_value(request, "atObsNs")) {
+		const int64_t deltaNs = (int64_t)obs_data_get_int(request, "atObsNs") - (int64_t)os_gettime_ns();
+		atMs = unixNow + deltaNs / 1000000;
+	} else if (obs_data_has_user_value(request, "inMs")) {
+		atMs = unixNow + (int64_t)obs_data_get_int(request, "inMs");
+	} else {
+		return false;
+	}
+
+	if (atMs - unixNow > kMaxScheduleAheadMs)
+		error = "Scheduled time too far ahead";
+	return true;
+}
+
+static void set_scheduled(obs_data_t *response, uint64_t seq, int64_t atMs)
+{
+	obs_data_set_bool(response, "scheduled", true);
+	obs_data_set_int(response, "seq", (long long)seq);
+	obs_data_set_int(response, "atMs", (long long)atMs);
+}
+
 static const char *reason_to_str(vflow::list_change_reason r)
 {
 	using R = vflow::list_change_reason;
@@ -115,6 +188,39 @@ static void on_core_event(const vflow::core_event &ev, void *user)
 		obs_data_release(data);
 		return;
 	}
+
+	if (ev.type == vflow::event_type::ParametersChanged) {
+		obs_data_t *data = obs_data_create();
+		obs_data_set_string(data, "id", ev.id.c_str());
+
+		obs_websocket_vendor_emit_event(g_vendor, "LowerThirdParametersChanged", data);
+		obs_data_release(data);
+		return;
+	}
+
+	if (ev.type == vflow::event_type::ActiveRowChanged) {
+		obs_data_t *data = obs_data_create();
+		obs_data_set_string(data, "id", ev.id.c_str());
+		obs_data_set_string(data, "rowId", ev.id2.c_str());
+
+		obs_websocket_vendor_emit_event(g_vendor, "LowerThirdActiveRowChanged", data);
+		obs_data_release(data);
+		return;
+	}
+
+	if (ev.type == vflow::event_type::RundownCue) {
+		obs_data_t *data = obs_data_create();
+		obs_data_set_int(data, "index", (long long)ev.count);
+		obs_data_set_string(data, "name", ev.id.c_str());
+		obs_data_set_string(data, "target", ev.id2.c_str());
+		obs_data_set_bool(data, "ok", ev.ok);
+		obs_data_set_int(data, "plannedMs", (long long)ev.planned_ms);
+		obs_data_set_int(data, "offsetMs", (long long)ev.offset_ms);
+
+		obs_websocket_vendor_emit_event(g_vendor, "LowerThirdsRundownCue", data);
+		obs_data_release(data);
+		return;
+	}
 }
 
 // -------------------------
@@ -137,17 +243,24 @@ static void req_ListLowerThirds(obs_data_t *request, obs_data_t *response, void
 		obs_data_set_int(it, "repeatVisibleSec", c.repeat_visible_sec);
 		obs_data_set_string(it, "hotkey", c.hotkey.c_str());
 
-		obs_data_set_string(it, "primaryColor", c.primary_color.c_str());
-		obs_data_set_string(it, "secondaryColor", c.secondary_color.c_str());
-		obs_data_set_string(it, "titleColor", c.title_color.c_str());
-		obs_data_set_string(it, "subtitleColor", c.subtitle_color.c_str());
+		obs_data_set_string(it, "primaryColor", c.primary_color.str().c_str());
+		obs_data_set_string(it, "secondaryColor", c.secondary_color.str().c_str());
+		obs_data_set_string(it, "titleColor", c.title_color.str().c_str());
+		obs_data_set_string(it, "subtitleColor", c.subtitle_color.str().c_str());
 
 		// Legacy fields for older docks
-		obs_data_set_string(it, "bgColor", c.primary_color.c_str());
-		obs_data_set_string(it, "textColor", c.title_color.c_str());
+		obs_data_set_string(it, "bgColor", c.primary_color.str().c_str());
+		obs_data_set_string(it, "textColor", c.title_color.str().c_str());
 		obs_data_set_int(it, "opacity", c.opacity);
 		obs_data_set_int(it, "radius", c.radius);
 
+		obs_data_set_bool(it, "instanced", c.instanced);
+		if (c.instanced) {
+			obs_data_set_int(it, "rowCount", (long long)c.rows.size());
+			const vflow::data_row *active = vflow::active_row_of(c);
+			obs_data_set_string(it, "activeRow", active ? active->id.c_str() : "");
+		}
+
 		obs_data_array_push_back(items, it);
 		obs_data_release(it);
 	}
@@ -183,11 +296,34 @@ static void req_SetVisible(obs_data_t *request, obs_data_t *response, void *priv
 	const bool visible = obs_data_get_bool(request, "visible");
 
 	std::string sid = sanitize_id_local(idC ? idC : "");
-	if (sid.empty() || !vflow::get_by_id(sid)) {
+	if (sid.empty() || !vflow::get_by_id_const(sid)) {
 		set_error(response, "Invalid id");
 		return;
 	}
 
+	int64_t atMs = 0;
+	std::string timeError;
+	if (scheduled_time(request, atMs, timeError)) {
+		if (!timeError.empty()) {
+			set_error(response, timeError.c_str());
+			return;
+		}
+		vflow::scheduled_change ch;
+		ch.id = sid;
+		ch.at_ms = atMs;
+		ch.visible = visible ? 1 : 0;
+		const uint64_t seq = vflow::schedule_change(std::move(ch));
+		if (!seq) {
+			set_error(response, "Failed to schedule visibility");
+			return;
+		}
+		set_ok(response, true);
+		obs_data_set_string(response, "id", sid.c_str());
+		obs_data_set_bool(response, "visible", visible);
+		set_scheduled(response, seq, atMs);
+		return;
+	}
+
 	if (!vflow::set_visible_persist(sid, visible)) {
 		set_error(response, "Failed to set visibility");
 		return;
@@ -198,6 +334,43 @@ static void req_SetVisible(obs_data_t *request, obs_data_t *response, void *priv
 	obs_data_set_bool(response, "visible", vflow::is_visible(sid));
 }
 
+static void req_StartGroupRun(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(priv);
+
+	const std::string gid = sanitize_id_local(obs_data_get_string(request, "groupId"));
+	if (gid.empty() || !vflow::get_group_by_id(gid)) {
+		set_error(response, "Invalid groupId");
+		return;
+	}
+
+	if (!vflow::start_group_run(gid)) {
+		set_error(response, "Group has no members");
+		return;
+	}
+
+	set_ok(response, true);
+	obs_data_set_string(response, "groupId", gid.c_str());
+	obs_data_set_bool(response, "running", true);
+}
+
+static void req_StopGroupRun(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(priv);
+
+	const std::string gid = sanitize_id_local(obs_data_get_string(request, "groupId"));
+	if (gid.empty()) {
+		set_error(response, "Invalid groupId");
+		return;
+	}
+
+	vflow::stop_group_run(gid);
+
+	set_ok(response, true);
+	obs_data_set_string(response, "groupId", gid.c_str());
+	obs_data_set_bool(response, "running", false);
+}
+
 static bool parse_json_object(obs_data_t *data, QJsonObject &out)
 {
 	const char *json = obs_data_get_json(data);
@@ -224,7 +397,7 @@ static void req_SetTemplateParameters(obs_data_t *request, obs_data_t *response,
 	}
 
 	const std::string sid = sanitize_id_local(root.value("id").toString().toStdString());
-	if (sid.empty() || !vflow::get_by_id(sid)) {
+	if (sid.empty() || !vflow::get_by_id_const(sid)) {
 		set_error(response, "Invalid id");
 		return;
 	}
@@ -235,13 +408,38 @@ static void req_SetTemplateParameters(obs_data_t *request, obs_data_t *response,
 		return;
 	}
 
-	if (!vflow::set_template_parameters(sid, dataValue.toObject())) {
+	int64_t atMs = 0;
+	std::string timeError;
+	const bool scheduled = scheduled_time(request, atMs, timeError);
+	if (!timeError.empty()) {
+		set_error(response, timeError.c_str());
+		return;
+	}
+
+	uint64_t seq = 0;
+	if (scheduled) {
+		vflow::scheduled_change ch;
+		ch.id = sid;
+		ch.at_ms = atMs;
+		// A visibility change landing on the same frame as the new values.
+		if (root.value("visible").isBool())
+			ch.visible = root.value("visible").toBool() ? 1 : 0;
+		ch.has_params = true;
+		ch.params = dataValue.toObject();
+		seq = vflow::schedule_change(std::move(ch));
+		if (!seq) {
+			set_error(response, "Failed to schedule template parameters");
+			return;
+		}
+	} else if (!vflow::set_template_parameters(sid, dataValue.toObject())) {
 		set_error(response, "Failed to set template parameters");
 		return;
 	}
 
 	set_ok(response, true);
 	obs_data_set_string(response, "id", sid.c_str());
+	if (scheduled)
+		set_scheduled(response, seq, atMs);
 	obs_data_t *dataObj = obs_data_create_from_json(
 		QJsonDocument(dataValue.toObject()).toJson(QJsonDocument::Compact).constData());
 	if (dataObj)
@@ -259,7 +457,7 @@ static void req_GetTemplateParameters(obs_data_t *request, obs_data_t *response,
 	}
 
 	const std::string sid = sanitize_id_local(root.value("id").toString().toStdString());
-	if (sid.empty() || !vflow::get_by_id(sid)) {
+	if (sid.empty() || !vflow::get_by_id_const(sid)) {
 		set_error(response, "Invalid id");
 		return;
 	}
@@ -284,7 +482,7 @@ static void req_ToggleVisible(obs_data_t *request, obs_data_t *response, void *p
 	const char *idC = obs_data_get_string(request, "id");
 	std::string sid = sanitize_id_local(idC ? idC : "");
 
-	if (sid.empty() || !vflow::get_by_id(sid)) {
+	if (sid.empty() || !vflow::get_by_id_const(sid)) {
 		set_error(response, "Invalid id");
 		return;
 	}
@@ -301,7 +499,6 @@ static void req_ToggleVisible(obs_data_t *request, obs_data_t *response, void *p
 
 static void req_CreateLowerThird(obs_data_t *request, obs_data_t *response, void *priv)
 {
-	UNUSED_PARAMETER(request);
 	UNUSED_PARAMETER(priv);
 
 	if (!vflow::has_output_dir()) {
@@ -309,17 +506,95 @@ static void req_CreateLowerThird(obs_data_t *request, obs_data_t *response, void
 		return;
 	}
 
-	const std::string id = vflow::add_default_lower_third();
+	vflow::rebuild_ticket rebuild;
+	const std::string id = vflow::add_default_lower_third(&rebuild);
 	if (id.empty()) {
 		set_error(response, "Failed to create lower third");
 		return;
 	}
+	if (!rebuild_succeeded(request, rebuild, response)) {
+		set_error(response, "Lower third created but the overlay rebuild failed");
+		obs_data_set_string(response, "id", id.c_str());
+		return;
+	}
 
 	set_ok(response, true);
 	obs_data_set_string(response, "id", id.c_str());
 	obs_data_set_int(response, "count", (long long)vflow::all_const().size());
 }
 
+static void req_GetRebuildStatus(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(request);
+	UNUSED_PARAMETER(priv);
+
+	set_ok(response, true);
+	obs_data_set_int(response, "completedGeneration", (long long)vflow::completed_rebuild_generation());
+}
+
+static void req_ImportLowerThirds(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(priv);
+
+	if (!vflow::has_output_dir()) {
+		set_error(response, "No output dir configured");
+		return;
+	}
+
+	vflow::import_options opt;
+	opt.base_id = obs_data_get_string(request, "baseId");
+	opt.group_id = obs_data_get_string(request, "groupId");
+	opt.visible = obs_data_get_bool(request, "visible");
+
+	const std::string format = obs_data_get_string(request, "format");
+	if (format == "csv")
+		opt.format = vflow::import_format::Csv;
+	else if (format == "json")
+		opt.format = vflow::import_format::Json;
+	else if (!format.empty() && format != "auto") {
+		set_error(response, "Invalid format (expected csv, json or auto)");
+		return;
+	}
+
+	// Either a file on the OBS machine ("path") or the content itself ("data").
+	const std::string path = obs_data_get_string(request, "path");
+	vflow::import_result res;
+	if (!path.empty()) {
+		res = vflow::import_lower_thirds_file(path, opt);
+	} else if (obs_data_has_user_value(request, "data")) {
+		std::istringstream in(obs_data_get_string(request, "data"));
+		res = vflow::import_lower_thirds(in, opt);
+	} else {
+		set_error(response, "Missing path or data");
+		return;
+	}
+
+	if (!res.ok) {
+		set_error(response, res.error.empty() ? "Import failed" : res.error.c_str());
+		if (res.ids.empty())
+			return;
+	} else {
+		set_ok(response, true);
+	}
+
+	obs_data_array_t *ids = obs_data_array_create();
+	for (const auto &id : res.ids) {
+		obs_data_t *o = obs_data_create();
+		obs_data_set_string(o, "id", id.c_str());
+		obs_data_array_push_back(ids, o);
+		obs_data_release(o);
+	}
+	obs_data_set_array(response, "ids", ids);
+	obs_data_array_release(ids);
+
+	obs_data_set_int(response, "imported", (long long)res.ids.size());
+	obs_data_set_int(response, "skipped", (long long)res.skipped);
+	obs_data_set_int(response, "groupsCreated", (long long)res.groups_created);
+	obs_data_set_double(response, "elapsedMs", res.elapsed_ms);
+	obs_data_set_double(response, "itemsPerSec", res.items_per_sec);
+	obs_data_set_int(response, "count", (long long)vflow::all_const().size());
+}
+
 static void req_CloneLowerThird(obs_data_t *request, obs_data_t *response, void *priv)
 {
 	UNUSED_PARAMETER(priv);
@@ -327,7 +602,7 @@ static void req_CloneLowerThird(obs_data_t *request, obs_data_t *response, void
 	const char *idC = obs_data_get_string(request, "id");
 	std::string sid = sanitize_id_local(idC ? idC : "");
 
-	if (sid.empty() || !vflow::get_by_id(sid)) {
+	if (sid.empty() || !vflow::get_by_id_const(sid)) {
 		set_error(response, "Invalid id");
 		return;
 	}
@@ -337,11 +612,17 @@ static void req_CloneLowerThird(obs_data_t *request, obs_data_t *response, void
 		return;
 	}
 
-	const std::string newId = vflow::clone_lower_third(sid);
+	vflow::rebuild_ticket rebuild;
+	const std::string newId = vflow::clone_lower_third(sid, &rebuild);
 	if (newId.empty()) {
 		set_error(response, "Failed to clone lower third");
 		return;
 	}
+	if (!rebuild_succeeded(request, rebuild, response)) {
+		set_error(response, "Lower third cloned but the overlay rebuild failed");
+		obs_data_set_string(response, "newId", newId.c_str());
+		return;
+	}
 
 	set_ok(response, true);
 	obs_data_set_string(response, "id", sid.c_str());
@@ -356,16 +637,21 @@ static void req_DeleteLowerThird(obs_data_t *request, obs_data_t *response, void
 	const char *idC = obs_data_get_string(request, "id");
 	std::string sid = sanitize_id_local(idC ? idC : "");
 
-	if (sid.empty() || !vflow::get_by_id(sid)) {
+	if (sid.empty() || !vflow::get_by_id_const(sid)) {
 		set_error(response, "Invalid id");
 		return;
 	}
 
-	const bool ok = vflow::remove_lower_third(sid);
+	vflow::rebuild_ticket rebuild;
+	const bool ok = vflow::remove_lower_third(sid, &rebuild);
 	if (!ok) {
 		set_error(response, "Failed to delete lower third");
 		return;
 	}
+	if (!rebuild_succeeded(request, rebuild, response)) {
+		set_error(response, "Lower third deleted but the overlay rebuild failed");
+		return;
+	}
 
 	set_ok(response, true);
 	obs_data_set_string(response, "id", sid.c_str());
@@ -373,6 +659,688 @@ static void req_DeleteLowerThird(obs_data_t *request, obs_data_t *response, void
 	obs_data_set_int(response, "count", (long long)vflow::all_const().size());
 }
 
+// Resolves "id" to an instanced lower third; sets the error response and returns null otherwise.
+static const vflow::lower_third_cfg *instanced_from_request(obs_data_t *request, obs_data_t *response,
+							   std::string &sid)
+{
+	const char *idC = obs_data_get_string(request, "id");
+	sid = sanitize_id_local(idC ? idC : "");
+
+	const vflow::lower_third_cfg *c = sid.empty() ? nullptr : vflow::get_by_id_const(sid);
+	if (!c) {
+		set_error(response, "Invalid id");
+		return nullptr;
+	}
+	if (!c->instanced) {
+		set_error(response, "Lower third is not instanced");
+		return nullptr;
+	}
+	return c;
+}
+
+static void req_ListLowerThirdRows(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(priv);
+
+	std::string sid;
+	const vflow::lower_third_cfg *c = instanced_from_request(request, response, sid);
+	if (!c)
+		return;
+
+	obs_data_array_t *arr = obs_data_array_create();
+	for (const auto &r : c->rows) {
+		obs_data_t *o = obs_data_create();
+		obs_data_set_string(o, "rowId", r.id.c_str());
+		obs_data_set_string(o, "title", r.title.c_str());
+		obs_data_set_string(o, "subtitle", r.subtitle.c_str());
+		obs_data_set_string(o, "profilePicture", r.profile_picture.c_str());
+		obs_data_array_push_back(arr, o);
+		obs_data_release(o);
+	}
+
+	const vflow::data_row *active = vflow::active_row_of(*c);
+
+	set_ok(response, true);
+	obs_data_set_string(response, "id", sid.c_str());
+	obs_data_set_string(response, "activeRow", active ? active->id.c_str() : "");
+	obs_data_set_array(response, "rows", arr);
+	obs_data_array_release(arr);
+}
+
+static void req_SetLowerThirdRow(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(priv);
+
+	std::string sid;
+	const vflow::lower_third_cfg *c = instanced_from_request(request, response, sid);
+	if (!c)
+		return;
+
+	// Partial update: fields missing from the request keep their current value.
+	vflow::data_row row;
+	row.id = obs_data_get_string(request, "rowId");
+	for (const auto &r : c->rows) {
+		if (!row.id.empty() && r.id == row.id) {
+			row = r;
+			break;
+		}
+	}
+	if (obs_data_has_user_value(request, "title"))
+		row.title = obs_data_get_string(request, "title");
+	if (obs_data_has_user_value(request, "subtitle"))
+		row.subtitle = obs_data_get_string(request, "subtitle");
+	if (obs_data_has_user_value(request, "profilePicture"))
+		row.profile_picture = obs_data_get_string(request, "profilePicture");
+
+	const std::string rowId = vflow::upsert_row(sid, std::move(row));
+	if (rowId.empty()) {
+		set_error(response, "Failed to set row");
+		return;
+	}
+
+	set_ok(response, true);
+	obs_data_set_string(response, "id", sid.c_str());
+	obs_data_set_string(response, "rowId", rowId.c_str());
+}
+
+static void req_DeleteLowerThirdRow(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(priv);
+
+	std::string sid;
+	if (!instanced_from_request(request, response, sid))
+		return;
+
+	const std::string rowId = obs_data_get_string(request, "rowId");
+	if (!vflow::remove_row(sid, rowId)) {
+		set_error(response, "Invalid rowId");
+		return;
+	}
+
+	set_ok(response, true);
+	obs_data_set_string(response, "id", sid.c_str());
+	obs_data_set_string(response, "rowId", rowId.c_str());
+	obs_data_set_bool(response, "removed", true);
+}
+
+static void req_ShowLowerThirdRow(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(priv);
+
+	std::string sid;
+	if (!instanced_from_request(request, response, sid))
+		return;
+
+	const std::string rowId = obs_data_get_string(request, "rowId");
+	if (!vflow::set_active_row(sid, rowId)) {
+		set_error(response, "Invalid rowId");
+		return;
+	}
+
+	// "visible" defaults to true; false only selects the row for the next show.
+	const bool visible = obs_data_has_user_value(request, "visible") ? obs_data_get_bool(request, "visible") : true;
+	if (visible && !vflow::set_visible_persist(sid, true)) {
+		set_error(response, "Failed to set visibility");
+		return;
+	}
+
+	set_ok(response, true);
+	obs_data_set_string(response, "id", sid.c_str());
+	obs_data_set_string(response, "rowId", rowId.c_str());
+	obs_data_set_bool(response, "visible", vflow::is_visible(sid));
+}
+
+static void set_history_fields(obs_data_t *response)
+{
+	const vflow::history_info h = vflow::history_state();
+	obs_data_set_int(response, "undoCount", (long long)h.undo_count);
+	obs_data_set_int(response, "redoCount", (long long)h.redo_count);
+	obs_data_set_string(response, "undoLabel", h.undo_label.c_str());
+	obs_data_set_string(response, "redoLabel", h.redo_label.c_str());
+	obs_data_set_int(response, "historyBytes", (long long)h.bytes);
+}
+
+static void req_Undo(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(request);
+	UNUSED_PARAMETER(priv);
+
+	if (!vflow::can_undo()) {
+		set_error(response, "Nothing to undo");
+		set_history_fields(response);
+		return;
+	}
+
+	const std::string label = vflow::history_state().undo_label;
+	set_ok(response, vflow::undo());
+	obs_data_set_string(response, "undone", label.c_str());
+	set_history_fields(response);
+}
+
+static void req_Redo(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(request);
+	UNUSED_PARAMETER(priv);
+
+	if (!vflow::can_redo()) {
+		set_error(response, "Nothing to redo");
+		set_history_fields(response);
+		return;
+	}
+
+	const std::string label = vflow::history_state().redo_label;
+	set_ok(response, vflow::redo());
+	obs_data_set_string(response, "redone", label.c_str());
+	set_history_fields(response);
+}
+
+static void req_GetHistory(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(request);
+	UNUSED_PARAMETER(priv);
+
+	set_ok(response, true);
+	set_history_fields(response);
+}
+
+// External writers of parameters_<id>.json must use liveDir: with the hot output directory on, the
+// configured folder only receives checkpoints.
+static void req_GetOutputDir(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(request);
+	UNUSED_PARAMETER(priv);
+
+	if (!vflow::has_output_dir()) {
+		set_error(response, "No output dir configured");
+		return;
+	}
+
+	set_ok(response, true);
+	obs_data_set_string(response, "outputDir", vflow::configured_output_dir().c_str());
+	obs_data_set_string(response, "liveDir", vflow::output_dir().c_str());
+	obs_data_set_bool(response, "hot", vflow::output_dir() != vflow::configured_output_dir());
+}
+
+static void req_GetIdleStatus(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(request);
+	UNUSED_PARAMETER(priv);
+
+	const vflow::idle_status st = vflow::idle_status_now();
+	set_ok(response, true);
+	obs_data_set_bool(response, "idle", st.idle);
+	obs_data_set_int(response, "idleForMs", (long long)st.idle_for_ms);
+	obs_data_set_int(response, "idleTotalMs", (long long)st.idle_total_ms);
+	obs_data_set_int(response, "framesSkipped", (long long)st.frames_skipped);
+	obs_data_set_int(response, "sleeps", (long long)st.sleeps);
+	obs_data_set_int(response, "nextWakeInMs", (long long)st.next_wake_in_ms);
+}
+
+static void req_BenchmarkNativeRender(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(priv);
+
+	const std::string id = request ? obs_data_get_string(request, "id") : "";
+	const int frames = request && obs_data_has_user_value(request, "frames") ? (int)obs_data_get_int(request, "frames")
+										: 60;
+	const vflow::native_benchmark b = vflow::native_source_benchmark(id, frames);
+	if (!b.ok) {
+		set_error(response, b.error.c_str());
+		return;
+	}
+
+	set_ok(response, true);
+	obs_data_set_int(response, "width", b.width);
+	obs_data_set_int(response, "height", b.height);
+	obs_data_set_int(response, "frames", b.frames);
+	obs_data_set_double(response, "drawUs", b.draw_us);
+	obs_data_set_double(response, "avgFrameUs", b.avg_frame_us);
+	obs_data_set_double(response, "p95FrameUs", b.p95_frame_us);
+	obs_data_set_double(response, "cpuPercent", b.cpu_percent);
+	obs_data_set_int(response, "frameBytes", (long long)b.frame_bytes);
+	obs_data_set_int(response, "browserFrameBytes", (long long)b.browser_frame_bytes);
+}
+
+static void req_BenchmarkRender(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(priv);
+
+	const long long items = opt_int(request, "items", 100);
+	const long long maxWorkers = opt_int(request, "maxWorkers", 0);
+	if (items <= 0 || maxWorkers < 0) {
+		set_error(response, "items must be > 0 and maxWorkers >= 0");
+		return;
+	}
+	const std::string baseId = request ? obs_data_get_string(request, "baseId") : "";
+
+	const vflow::render_benchmark b =
+		vflow::benchmark_render((size_t)items, (size_t)maxWorkers, (int)opt_int(request, "repeats", 3), baseId);
+	if (!b.ok) {
+		set_error(response, b.error.c_str());
+		return;
+	}
+
+	obs_data_array_t *arr = obs_data_array_create();
+	const double serialMs = b.runs.empty() ? 0.0 : b.runs.front().ms;
+	for (const auto &r : b.runs) {
+		obs_data_t *o = obs_data_create();
+		obs_data_set_int(o, "workers", (long long)r.workers);
+		obs_data_set_double(o, "ms", r.ms);
+		obs_data_set_double(o, "speedup", r.ms > 0.0 ? serialMs / r.ms : 0.0);
+		obs_data_set_int(o, "bytes", (long long)r.bytes);
+		obs_data_set_int(o, "cssChunks", (long long)r.css_chunks);
+		obs_data_set_int(o, "jsChunks", (long long)r.js_chunks);
+		obs_data_set_int(o, "htmlChunks", (long long)r.html_chunks);
+		obs_data_set_int(o, "chunkAllocations", (long long)(r.css_chunks + r.js_chunks + r.html_chunks));
+		obs_data_array_push_back(arr, o);
+		obs_data_release(o);
+	}
+
+	set_ok(response, true);
+	obs_data_set_int(response, "items", (long long)b.items);
+	obs_data_set_array(response, "runs", arr);
+	obs_data_array_release(arr);
+}
+
+static void req_BenchmarkStateSave(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(priv);
+
+	const long long items = opt_int(request, "items", 1000);
+	const int repeats = (int)opt_int(request, "repeats", 3);
+	if (items <= 0) {
+		set_error(response, "items must be > 0");
+		return;
+	}
+	const std::string baseId = request ? obs_data_get_string(request, "baseId") : "";
+
+	const vflow::state_save_benchmark b = vflow::benchmark_state_save((size_t)items, repeats, baseId);
+	if (!b.ok) {
+		set_error(response, b.error.c_str());
+		return;
+	}
+
+	set_ok(response, true);
+	obs_data_set_int(response, "items", (long long)b.items);
+	obs_data_set_int(response, "streamBytes", (long long)b.stream_bytes);
+	obs_data_set_double(response, "streamMs", b.stream_ms);
+	obs_data_set_int(response, "streamPeakBytes", (long long)b.stream_peak_bytes);
+	obs_data_set_int(response, "streamChunkAllocations", (long long)b.stream_chunk_allocations);
+	obs_data_set_int(response, "documentBytes", (long long)b.dom_bytes);
+	obs_data_set_double(response, "documentMs", b.dom_ms);
+	obs_data_set_int(response, "documentPeakBytes", (long long)b.dom_peak_bytes);
+}
+
+static void req_GetScheduledChanges(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(request);
+	UNUSED_PARAMETER(priv);
+
+	obs_data_array_t *arr = obs_data_array_create();
+	for (const auto &c : vflow::scheduled_changes()) {
+		obs_data_t *o = obs_data_create();
+		obs_data_set_int(o, "seq", (long long)c.seq);
+		obs_data_set_string(o, "id", c.id.c_str());
+		obs_data_set_int(o, "atMs", (long long)c.at_ms);
+		if (c.visible >= 0)
+			obs_data_set_bool(o, "visible", c.visible == 1);
+		obs_data_set_bool(o, "params", c.has_params);
+		obs_data_array_push_back(arr, o);
+		obs_data_release(o);
+	}
+
+	set_ok(response, true);
+	obs_data_set_array(response, "changes", arr);
+	obs_data_array_release(arr);
+}
+
+static void req_CancelScheduledChanges(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(priv);
+
+	// No id cancels everything.
+	const std::string sid = sanitize_id_local(obs_data_get_string(request, "id"));
+	const size_t n = vflow::cancel_scheduled_changes(sid);
+
+	set_ok(response, true);
+	obs_data_set_int(response, "cancelled", (long long)n);
+}
+
+static void req_ListRules(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(request);
+	UNUSED_PARAMETER(priv);
+
+	obs_data_array_t *arr = obs_data_array_create();
+	for (const auto &r : vflow::rules_const()) {
+		obs_data_t *o = obs_data_create();
+		obs_data_set_string(o, "id", r.id.c_str());
+		obs_data_set_bool(o, "enabled", r.enabled);
+		obs_data_set_string(o, "trigger", vflow::rule_trigger_name(r.trigger));
+		obs_data_set_string(o, "scene", r.scene.c_str());
+		obs_data_set_string(o, "action", vflow::rule_action_name(r.action));
+		obs_data_set_string(o, "target", r.target.c_str());
+		obs_data_set_int(o, "delayMs", r.delay_ms);
+		obs_data_array_push_back(arr, o);
+		obs_data_release(o);
+	}
+
+	set_ok(response, true);
+	obs_data_set_array(response, "rules", arr);
+	obs_data_array_release(arr);
+}
+
+static void req_SetRule(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(priv);
+
+	if (!request) {
+		set_error(response, "Invalid request payload");
+		return;
+	}
+
+	vflow::rule_cfg r;
+	r.id = sanitize_id_local(obs_data_get_string(request, "id"));
+	r.enabled = !obs_data_has_user_value(request, "enabled") || obs_data_get_bool(request, "enabled");
+	if (!vflow::rule_trigger_from_name(obs_data_get_string(request, "trigger"), r.trigger)) {
+		set_error(response, "Invalid trigger");
+		return;
+	}
+	if (!vflow::rule_action_from_name(obs_data_get_string(request, "action"), r.action)) {
+		set_error(response, "Invalid action");
+		return;
+	}
+	r.scene = obs_data_get_string(request, "scene");
+	r.target = sanitize_id_local(obs_data_get_string(request, "target"));
+	if (r.target.empty()) {
+		set_error(response, "Invalid target");
+		return;
+	}
+	r.delay_ms = (int)std::clamp<long long>(obs_data_get_int(request, "delayMs"), 0, 3600LL * 1000);
+
+	const std::string id = vflow::upsert_rule(r);
+	if (id.empty()) {
+		set_error(response, "Failed to save rule");
+		return;
+	}
+
+	set_ok(response, true);
+	obs_data_set_string(response, "id", id.c_str());
+}
+
+static void req_DeleteRule(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(priv);
+
+	const std::string sid = sanitize_id_local(obs_data_get_string(request, "id"));
+	if (sid.empty()) {
+		set_error(response, "Invalid id");
+		return;
+	}
+	if (!vflow::remove_rule(sid)) {
+		set_error(response, "Failed to delete rule");
+		return;
+	}
+
+	set_ok(response, true);
+	obs_data_set_string(response, "id", sid.c_str());
+}
+
+static void req_ListOutputVariants(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(request);
+	UNUSED_PARAMETER(priv);
+
+	obs_data_array_t *arr = obs_data_array_create();
+	for (const auto &v : vflow::output_variants()) {
+		obs_data_t *o = obs_data_create();
+		obs_data_set_string(o, "name", v.name.c_str());
+		obs_data_set_string(o, "browserSource", v.browser_source.c_str());
+		obs_data_set_int(o, "width", v.width);
+		obs_data_set_int(o, "height", v.height);
+		obs_data_set_int(o, "safeMargin", v.safe_margin);
+		obs_data_set_int(o, "scalePct", v.scale_pct);
+
+		obs_data_array_t *items = obs_data_array_create();
+		for (const auto &kv : v.items) {
+			obs_data_t *io = obs_data_create();
+			obs_data_set_string(io, "id", kv.first.c_str());
+			obs_data_set_string(io, "position", kv.second.position.str().c_str());
+			obs_data_set_int(io, "scalePct", kv.second.scale_pct);
+			obs_data_array_push_back(items, io);
+			obs_data_release(io);
+		}
+		obs_data_set_array(o, "items", items);
+		obs_data_array_release(items);
+
+		obs_data_array_push_back(arr, o);
+		obs_data_release(o);
+	}
+
+	set_ok(response, true);
+	obs_data_set_array(response, "variants", arr);
+	obs_data_array_release(arr);
+}
+
+static void req_SetOutputVariant(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(priv);
+
+	if (!request) {
+		set_error(response, "Invalid request payload");
+		return;
+	}
+
+	vflow::output_variant v;
+	v.name = obs_data_get_string(request, "name");
+	v.browser_source = obs_data_get_string(request, "browserSource");
+	if (obs_data_has_user_value(request, "width"))
+		v.width = (int)obs_data_get_int(request, "width");
+	if (obs_data_has_user_value(request, "height"))
+		v.height = (int)obs_data_get_int(request, "height");
+	if (obs_data_has_user_value(request, "safeMargin"))
+		v.safe_margin = (int)obs_data_get_int(request, "safeMargin");
+	if (obs_data_has_user_value(request, "scalePct"))
+		v.scale_pct = (int)obs_data_get_int(request, "scalePct");
+
+	if (obs_data_array_t *items = obs_data_get_array(request, "items")) {
+		const size_t n = obs_data_array_count(items);
+		for (size_t i = 0; i < n; ++i) {
+			obs_data_t *io = obs_data_array_item(items, i);
+			vflow::layout_override o;
+			o.position = obs_data_get_string(io, "position");
+			o.scale_pct = (int)obs_data_get_int(io, "scalePct");
+			v.items.emplace_back(sanitize_id_local(obs_data_get_string(io, "id")), o);
+			obs_data_release(io);
+		}
+		obs_data_array_release(items);
+	}
+
+	const std::string name = vflow::upsert_output_variant(v);
+	if (name.empty()) {
+		set_error(response, "Failed to save output variant");
+		return;
+	}
+
+	set_ok(response, true);
+	obs_data_set_string(response, "name", name.c_str());
+}
+
+static void req_DeleteOutputVariant(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(priv);
+
+	const std::string name = request ? obs_data_get_string(request, "name") : "";
+	if (!vflow::remove_output_variant(name)) {
+		set_error(response, "Unknown output variant");
+		return;
+	}
+
+	set_ok(response, true);
+	obs_data_set_string(response, "name", name.c_str());
+}
+
+static void req_ListSceneCollectionProfiles(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(request);
+	UNUSED_PARAMETER(priv);
+
+	obs_data_array_t *arr = obs_data_array_create();
+	for (const auto &p : vflow::collection_profiles()) {
+		obs_data_t *o = obs_data_create();
+		obs_data_set_string(o, "sceneCollection", p.collection.c_str());
+		obs_data_set_string(o, "outputDir", p.dir.c_str());
+		obs_data_set_bool(o, "active", p.active);
+		obs_data_set_bool(o, "preloaded", p.preloaded);
+		obs_data_array_push_back(arr, o);
+		obs_data_release(o);
+	}
+
+	set_ok(response, true);
+	obs_data_set_array(response, "profiles", arr);
+	obs_data_array_release(arr);
+}
+
+// An empty outputDir removes the binding; an empty sceneCollection means the current one.
+static void req_SetSceneCollectionOutputDir(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(priv);
+
+	const std::string col = request ? obs_data_get_string(request, "sceneCollection") : "";
+	const std::string dir = request ? obs_data_get_string(request, "outputDir") : "";
+	if (!vflow::bind_collection_output_dir(col, dir)) {
+		set_error(response, "Binding not saved");
+		return;
+	}
+
+	set_ok(response, true);
+	obs_data_set_string(response, "outputDir", vflow::configured_output_dir().c_str());
+}
+
+// Evaluates a trigger as if OBS had raised it, e.g. to rehearse a show's rules without cutting.
+static void req_FireRules(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(priv);
+
+	vflow::rule_trigger t;
+	if (!request || !vflow::rule_trigger_from_name(obs_data_get_string(request, "trigger"), t)) {
+		set_error(response, "Invalid trigger");
+		return;
+	}
+
+	const size_t n = vflow::rules_fire(t, obs_data_get_string(request, "scene"));
+	set_ok(response, true);
+	obs_data_set_int(response, "matched", (long long)n);
+}
+
+static void req_LoadRundown(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(priv);
+
+	// Either a file on the OBS machine ("path") or the content itself ("data").
+	const std::string path = obs_data_get_string(request, "path");
+	vflow::rundown_load_result res;
+	if (!path.empty()) {
+		res = vflow::rundown_load_file(path);
+	} else if (obs_data_has_user_value(request, "data")) {
+		std::istringstream in(obs_data_get_string(request, "data"));
+		res = vflow::rundown_load(in);
+	} else {
+		set_error(response, "Missing path or data");
+		return;
+	}
+
+	if (!res.ok) {
+		set_error(response, res.error.empty() ? "Load failed" : res.error.c_str());
+		return;
+	}
+
+	set_ok(response, true);
+	obs_data_set_int(response, "cues", (long long)res.cues);
+	obs_data_set_int(response, "skipped", (long long)res.skipped);
+}
+
+static void req_StartRundown(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(request);
+	UNUSED_PARAMETER(priv);
+
+	if (!vflow::rundown_play()) {
+		set_error(response, "No rundown loaded");
+		return;
+	}
+	set_ok(response, true);
+}
+
+static void req_StopRundown(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(request);
+	UNUSED_PARAMETER(priv);
+
+	vflow::rundown_stop();
+	set_ok(response, true);
+}
+
+static void req_RundownGo(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(request);
+	UNUSED_PARAMETER(priv);
+
+	if (!vflow::rundown_go()) {
+		set_error(response, "Rundown is not waiting for go");
+		return;
+	}
+	set_ok(response, true);
+}
+
+static void req_GetRundownStatus(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(request);
+	UNUSED_PARAMETER(priv);
+
+	const vflow::rundown_status st = vflow::rundown_status_now();
+
+	set_ok(response, true);
+	obs_data_set_int(response, "cues", (long long)st.cues);
+	obs_data_set_bool(response, "running", st.running);
+	obs_data_set_bool(response, "waitingGo", st.waiting_go);
+	obs_data_set_int(response, "next", (long long)st.next);
+	obs_data_set_int(response, "elapsedMs", (long long)st.elapsed_ms);
+	obs_data_set_int(response, "nextInMs", (long long)st.next_in_ms);
+
+	obs_data_array_t *reports = obs_data_array_create();
+	for (const auto &r : st.reports) {
+		obs_data_t *o = obs_data_create();
+		obs_data_set_int(o, "index", (long long)r.index);
+		obs_data_set_int(o, "plannedMs", (long long)r.planned_ms);
+		obs_data_set_int(o, "actualMs", (long long)r.actual_ms);
+		obs_data_set_int(o, "offsetMs", (long long)r.offset_ms);
+		obs_data_set_bool(o, "ok", r.ok);
+		obs_data_array_push_back(reports, o);
+		obs_data_release(o);
+	}
+	obs_data_set_array(response, "reports", reports);
+	obs_data_array_release(reports);
+}
+
+static void req_CollectUnusedAssets(obs_data_t *request, obs_data_t *response, void *priv)
+{
+	UNUSED_PARAMETER(request);
+	UNUSED_PARAMETER(priv);
+
+	if (!vflow::has_output_dir()) {
+		set_error(response, "No output dir configured");
+		return;
+	}
+
+	uint64_t freed = 0;
+	const size_t removed = vflow::collect_unused_assets(&freed);
+
+	set_ok(response, true);
+	obs_data_set_int(response, "removed", (long long)removed);
+	obs_data_set_int(response, "freedBytes", (long long)freed);
+}
+
 static void req_ReloadFromDisk(obs_data_t *request, obs_data_t *response, void *priv)
 {
 	UNUSED_PARAMETER(request);
@@ -418,6 +1386,8 @@ bool init()
 	ok = ok && obs_websocket_vendor_register_request(g_vendor, "GetVisible", req_GetVisible, nullptr);
 	ok = ok && obs_websocket_vendor_register_request(g_vendor, "SetVisible", req_SetVisible, nullptr);
 	ok = ok && obs_websocket_vendor_register_request(g_vendor, "ToggleVisible", req_ToggleVisible, nullptr);
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "StartGroupRun", req_StartGroupRun, nullptr);
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "StopGroupRun", req_StopGroupRun, nullptr);
 	ok = ok && obs_websocket_vendor_register_request(g_vendor, "SetTemplateParameters", req_SetTemplateParameters,
 							 nullptr);
 	ok = ok && obs_websocket_vendor_register_request(g_vendor, "GetTemplateParameters", req_GetTemplateParameters,
@@ -427,6 +1397,52 @@ bool init()
 	ok = ok && obs_websocket_vendor_register_request(g_vendor, "CloneLowerThird", req_CloneLowerThird, nullptr);
 	ok = ok && obs_websocket_vendor_register_request(g_vendor, "DeleteLowerThird", req_DeleteLowerThird, nullptr);
 	ok = ok && obs_websocket_vendor_register_request(g_vendor, "ReloadFromDisk", req_ReloadFromDisk, nullptr);
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "GetRebuildStatus", req_GetRebuildStatus, nullptr);
+
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "ImportLowerThirds", req_ImportLowerThirds,
+							 nullptr);
+
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "Undo", req_Undo, nullptr);
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "Redo", req_Redo, nullptr);
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "GetHistory", req_GetHistory, nullptr);
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "CollectUnusedAssets", req_CollectUnusedAssets,
+							 nullptr);
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "GetOutputDir", req_GetOutputDir, nullptr);
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "GetIdleStatus", req_GetIdleStatus, nullptr);
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "BenchmarkNativeRender", req_BenchmarkNativeRender,
+							 nullptr);
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "BenchmarkRender", req_BenchmarkRender, nullptr);
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "BenchmarkStateSave", req_BenchmarkStateSave, nullptr);
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "GetScheduledChanges", req_GetScheduledChanges,
+							 nullptr);
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "CancelScheduledChanges",
+							 req_CancelScheduledChanges, nullptr);
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "ListRules", req_ListRules, nullptr);
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "SetRule", req_SetRule, nullptr);
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "DeleteRule", req_DeleteRule, nullptr);
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "FireRules", req_FireRules, nullptr);
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "ListOutputVariants", req_ListOutputVariants,
+							 nullptr);
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "SetOutputVariant", req_SetOutputVariant, nullptr);
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "DeleteOutputVariant", req_DeleteOutputVariant,
+							 nullptr);
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "ListSceneCollectionProfiles",
+							 req_ListSceneCollectionProfiles, nullptr);
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "SetSceneCollectionOutputDir",
+							 req_SetSceneCollectionOutputDir, nullptr);
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "LoadRundown", req_LoadRundown, nullptr);
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "StartRundown", req_StartRundown, nullptr);
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "StopRundown", req_StopRundown, nullptr);
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "RundownGo", req_RundownGo, nullptr);
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "GetRundownStatus", req_GetRundownStatus, nullptr);
+
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "ListLowerThirdRows", req_ListLowerThirdRows,
+							 nullptr);
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "SetLowerThirdRow", req_SetLowerThirdRow, nullptr);
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "DeleteLowerThirdRow", req_DeleteLowerThirdRow,
+							 nullptr);
+	ok = ok && obs_websocket_vendor_register_request(g_vendor, "ShowLowerThirdRow", req_ShowLowerThirdRow,
+							 nullptr);
 
 	// Subscribe to core events AFTER vendor is ready
 	g_core_listener_token = vflow::add_event_listener(on_core_event, nullptr);